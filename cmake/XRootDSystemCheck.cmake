@@ -22,6 +22,9 @@ compiler_define_if_found( HAVE_STRLCPY HAVE_STRLCPY )
 check_function_exists( fstatat HAVE_FSTATAT )
 compiler_define_if_found( HAVE_FSTATAT HAVE_FSTATAT )
 
+check_function_exists( statx HAVE_STATX )
+compiler_define_if_found( HAVE_STATX HAVE_STATX )
+
 check_function_exists( sigwaitinfo HAVE_SIGWTI )
 compiler_define_if_found( HAVE_SIGWTI HAVE_SIGWTI )
 if( NOT HAVE_SIGWTI )
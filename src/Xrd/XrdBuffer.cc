@@ -39,7 +39,9 @@
 #include "XrdSys/XrdSysTimer.hh"
 #include "Xrd/XrdBuffer.hh"
 #include "Xrd/XrdBuffXL.hh"
+#include "Xrd/XrdNuma.hh"
 #include "Xrd/XrdTrace.hh"
+#include "XrdSys/XrdSysMetrics.hh"
 
 /******************************************************************************/
 /*                     E x t e r n a l   L i n k a g e s                      */
@@ -61,6 +63,14 @@ const char *XrdBuffManager::TraceID = "BuffManager";
 namespace
 {
 static const int minBuffSz = 1 << XRD_BUSHIFT;
+
+static_assert(XrdNuma::maxNodes <= XRD_BUNODES, "too few buffer nodes");
+
+// Buffer releases on the node the buffer memory was placed on or not. These
+// only exist when NUMA placement is in effect.
+//
+XrdSysMetrics::Counter *numaLocal  = 0;
+XrdSysMetrics::Counter *numaRemote = 0;
 }
 
 namespace XrdGlobal
@@ -109,10 +119,13 @@ XrdBuffManager::~XrdBuffManager()
    XrdBuffer *bP;
 
    for (int i = 0; i < XRD_BUCKETS; i++)
-       {while((bP = bucket[i].bnext))
-             {bucket[i].bnext = bP->next;
-              delete bP;
-             }
+       {for (int n = 0; n < XRD_BUNODES; n++)
+            {while((bP = bucket[i].node[n].bnext))
+                  {bucket[i].node[n].bnext = bP->next;
+                   delete bP;
+                  }
+             bucket[i].node[n].numbuf = 0;
+            }
         bucket[i].numbuf = 0;
        }
 }
@@ -126,6 +139,15 @@ void XrdBuffManager::Init()
    pthread_t tid;
    int rc;
 
+// Track where buffers are used relative to where they were placed
+//
+   if (XrdNuma::Active())
+      {numaLocal  = new XrdSysMetrics::Counter("xrootd_buff_numa_local",
+                        "Buffers released on the node holding their memory.");
+       numaRemote = new XrdSysMetrics::Counter("xrootd_buff_numa_remote",
+                        "Buffers released on another node than their memory.");
+      }
+
 // Start the reshaper thread
 //
    if ((rc = XrdSysThread::Run(&tid, XrdReshaper, static_cast<void *>(this), 0,
@@ -141,7 +163,7 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
 {
    XrdBuffer *bp;
    char *memp;
-   int mk, pk, bindex;
+   int mk, pk, bindex, node;
 
 // Make sure the request is within our limits
 //
@@ -157,12 +179,17 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
    if (bindex >= slots) return 0;    // Should never happen!
 
 // Obtain a lock on the bucket array and try to give away an existing buffer
+// whose memory is on our node (there is only node 0 without NUMA placement).
 //
+    node = XrdNuma::MyNode();
     Reshaper.Lock();
     totreq++;
     bucket[bindex].numreq++;
-    if ((bp = bucket[bindex].bnext))
-       {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;}
+    if ((bp = bucket[bindex].node[node].bnext))
+       {bucket[bindex].node[node].bnext = bp->next;
+        bucket[bindex].node[node].numbuf--;
+        bucket[bindex].numbuf--;
+       }
     Reshaper.UnLock();
 
 // Check if we really allocated a buffer
@@ -174,9 +201,13 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
    pk = (mk < pagsz ? mk : pagsz);
    if (posix_memalign((void **)&memp, pk, mk)) return 0;
 
+// Place whole pages on our node before they are touched
+//
+   if (mk >= pagsz) XrdNuma::Place(memp, mk, node);
+
 // Wrap the memory with a buffer object
 //
-   if (!(bp = new XrdBuffer(memp, mk, bindex))) {free(memp); return 0;}
+   if (!(bp = new XrdBuffer(memp, mk, bindex, node))) {free(memp); return 0;}
 
 // Update statistics
 //
@@ -220,17 +251,25 @@ int XrdBuffManager::Recalc(int sz)
   
 void XrdBuffManager::Release(XrdBuffer *bp)
 {
-   int bindex = bp->bindex;
+   int bindex = bp->bindex, node = bp->bnode;
 
 // Check if we should release this via the big buffer object
 //
    if (bindex >= slots) {xlBuff.Release(bp); return;}
 
-// Obtain a lock on the bucket array and reclaim the buffer
+// Record whether the buffer was used on the node holding its memory
+//
+   if (numaLocal)
+      {if (XrdNuma::MyNode() == node) numaLocal->Add();
+          else numaRemote->Add();
+      }
+
+// Obtain a lock on the bucket array and reclaim the buffer to its node
 //
     Reshaper.Lock();
-    bp->next = bucket[bp->bindex].bnext;
-    bucket[bp->bindex].bnext = bp;
+    bp->next = bucket[bindex].node[node].bnext;
+    bucket[bindex].node[node].bnext = bp;
+    bucket[bindex].node[node].numbuf++;
     bucket[bindex].numbuf++;
     Reshaper.UnLock();
 }
@@ -279,13 +318,19 @@ while(1)
       for (i = slots-1; i >= 0 && memhave > memtarget; i--)
           {Reshaper.Lock();
            while(bucket[i].numbuf > bufprof[i])
-                if ((bp = bucket[i].bnext))
-                   {bucket[i].bnext = bp->next;
-                    delete bp;
-                    bucket[i].numbuf--; numfreed++;
-                    memhave -= memslot; totalo  -= memslot;
-                    totbuf--;
-                   } else {bucket[i].numbuf = 0; break;}
+                {int n = 0;
+                 for (int k = 1; k < XRD_BUNODES; k++)
+                     if (bucket[i].node[k].numbuf > bucket[i].node[n].numbuf)
+                        n = k;
+                 if ((bp = bucket[i].node[n].bnext))
+                    {bucket[i].node[n].bnext = bp->next;
+                     delete bp;
+                     bucket[i].node[n].numbuf--;
+                     bucket[i].numbuf--; numfreed++;
+                     memhave -= memslot; totalo  -= memslot;
+                     totbuf--;
+                    } else {bucket[i].numbuf = 0; break;}
+                }
            Reshaper.UnLock();
            memslot = memslot>>1;
           }
@@ -323,19 +368,29 @@ void XrdBuffManager::Set(int maxmem, int minw)
 int XrdBuffManager::Stats(char *buff, int blen, int do_sync)
 {
     static char statfmt[] = "<stats id=\"buff\"><reqs>%d</reqs>"
-                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s</stats>";
-    char xlStats[1024];
+                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s%s</stats>";
+    static char numafmt[] = "<numa><nodes>%d</nodes><local>%lld</local>"
+                "<remote>%lld</remote></numa>";
+    char xlStats[1024], numaStats[sizeof(numafmt) + 16*3] = "";
     int nlen;
 
 // If only size wanted, return it
 //
-   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0);
+   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0)
+                   + sizeof(numaStats);
+
+// Format the NUMA usage if we are tracking it
+//
+   if (numaLocal)
+      snprintf(numaStats, sizeof(numaStats), numafmt, XrdNuma::Nodes(),
+               numaLocal->Value(), numaRemote->Value());
 
 // Return formatted stats
 //
    if (do_sync) Reshaper.Lock();
    xlBuff.Stats(xlStats, sizeof(xlStats), do_sync);
-   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats);
+   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats,
+                   numaStats);
    if (do_sync) Reshaper.UnLock();
    return nlen;
 }
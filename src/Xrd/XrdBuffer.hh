@@ -45,8 +45,10 @@ public:
 char *   buff;     // -> buffer
 int      bsize;    // size of this buffer
 
-         XrdBuffer(char *bp, int sz, int ix)
-                      {buff = bp; bsize = sz; bindex = ix; next = 0;}
+         XrdBuffer(char *bp, int sz, int ix, int nd=0)
+                      {buff = bp; bsize = sz; bindex = ix; bnode = nd;
+                       next = 0;
+                      }
 
         ~XrdBuffer() {if (buff) free(buff);}
 
@@ -55,6 +57,7 @@ int      bsize;    // size of this buffer
 private:
 
 int        bindex;
+int        bnode;    // NUMA node the memory was placed on
 XrdBuffer *next;
 static int pagesz;
 };
@@ -65,6 +68,7 @@ static int pagesz;
 
 #define XRD_BUCKETS 12
 #define XRD_BUSHIFT 10
+#define XRD_BUNODES  8
 
 // There should be only one instance of this class per buffer pool.
 //
@@ -99,7 +103,9 @@ const int  shift;
 const int  pagsz;
 const int  maxsz;
 
-struct {XrdBuffer *bnext;
+struct {struct {XrdBuffer *bnext;
+                int        numbuf;
+               } node[XRD_BUNODES];    // Free buffers by NUMA node
         int         numbuf;
         int         numreq;
        } bucket[XRD_BUCKETS];          // 1K to 1<<(szshift+slots-1)M buffers
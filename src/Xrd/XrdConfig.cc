@@ -59,6 +59,7 @@
 #include "Xrd/XrdInfo.hh"
 #include "Xrd/XrdLink.hh"
 #include "Xrd/XrdLinkCtl.hh"
+#include "Xrd/XrdNuma.hh"
 #include "Xrd/XrdPoll.hh"
 #include "Xrd/XrdScheduler.hh"
 #include "Xrd/XrdStats.hh"
@@ -270,6 +271,9 @@ XrdConfig::XrdConfig()
    repDest[1] = 0;
    repInt     = 600;
    repOpts    = 0;
+   mtrShm     = 0;
+   mtrProm    = 0;
+   mtrInt     = 1;
    ppNet      = 0;
    tlsOpts    = 9ULL | XrdTlsContext::servr | XrdTlsContext::logVF;
    tlsNoVer   = false;
@@ -812,6 +816,8 @@ int XrdConfig::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest)
    TS_Xeq("allow",         xallow);
    TS_Xeq("homepath",      xhpath);
    TS_Xeq("maxfd",         xmaxfd);
+   TS_Xeq("metrics",       xmetrics);
+   TS_Xeq("numa",          xnuma);
    TS_Xeq("pidpath",       xpidf);
    TS_Xeq("port",          xport);
    TS_Xeq("protocol",      xprot);
@@ -1283,6 +1289,20 @@ int XrdConfig::Setup(char *dfltp, char *libProt)
 //
    TRACE(NET,"sendfile " <<(XrdLink::sfOK ? "enabled." : "disabled!"));
 
+// Discover the NUMA topology if placement is wanted. This must be done before
+// any buffers, workers, or pollers come into being.
+//
+   if (XrdNuma::Wanted())
+      {int n = XrdNuma::Init();
+       if (XrdNuma::Active())
+          {char buff[80];
+           snprintf(buff, sizeof(buff), "%d nodes with %d pinned workers each",
+                    n, XrdNuma::WorkersPerNode());
+           Log.Say("Config NUMA placement over ", buff, ".");
+          } else Log.Say("Config warning: NUMA placement not done; ",
+                         (n ? "only one node present." : "topology unknown."));
+      }
+
 // Initialize the buffer manager
 //
    BuffPool.Init();
@@ -1389,6 +1409,10 @@ int XrdConfig::Setup(char *dfltp, char *libProt)
    if (repDest[0] != 0 && repOpts) 
       ProtInfo.Stats->Report(repDest, repInt, repOpts);
 
+// Check if we have to export the metrics
+//
+   if (mtrShm || mtrProm) ProtInfo.Stats->Export(mtrShm, mtrProm, mtrInt);
+
 // All done
 //
    return 0;
@@ -1701,6 +1725,101 @@ int XrdConfig::xmaxfd(XrdSysError *eDest, XrdOucStream &Config)
     return 0;
 }
 
+/******************************************************************************/
+/*                              x m e t r i c s                               */
+/******************************************************************************/
+
+/* Function: xmetrics
+
+   Purpose:  To parse the directive: metrics [every <sec>] [shm <spath>]
+                                             [prom <ppath>]
+
+             <sec>      the export interval. The default is 1 second.
+             <spath>    file to hold a binary snapshot of the metrics that
+                        can be mapped by a reader (e.g. in /dev/shm).
+             <ppath>    file to hold the metrics in Prometheus text format
+                        (e.g. for the node exporter textfile collector).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int XrdConfig::xmetrics(XrdSysError *eDest, XrdOucStream &Config)
+{
+    char *val, **pathP;
+
+    while((val = Config.GetWord()))
+         {if (!strcmp("every", val))
+             {if (!(val = Config.GetWord()))
+                 {eDest->Emsg("Config", "metrics every value not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2tm(*eDest,"metrics every",val,&mtrInt,1))
+                 return 1;
+              continue;
+             }
+               if (!strcmp("shm",  val)) pathP = &mtrShm;
+          else if (!strcmp("prom", val)) pathP = &mtrProm;
+          else {eDest->Emsg("Config", "invalid metrics option -", val);
+                return 1;
+               }
+          if (!(val = Config.GetWord()) || *val != '/')
+             {eDest->Emsg("Config", "metrics file path not specified or not "
+                                    "absolute");
+              return 1;
+             }
+          if (*pathP) free(*pathP);
+          *pathP = strdup(val);
+         }
+
+    if (!mtrShm && !mtrProm)
+       {eDest->Emsg("Config", "metrics file not specified"); return 1;}
+    return 0;
+}
+
+/******************************************************************************/
+/*                                 x n u m a                                  */
+/******************************************************************************/
+
+/* Function: xnuma
+
+   Purpose:  To parse the directive: numa {off | on [workers <n>]}
+
+             off       do not place threads and memory by NUMA node (default).
+             on        place pollers and buffer memory on the NUMA nodes and
+                       route connections to a poller on the node of the
+                       network interface they arrived on.
+             <n>       the number of scheduler workers to pin to each node.
+                       The default is 8; other workers float.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdConfig::xnuma(XrdSysError *eDest, XrdOucStream &Config)
+{
+    char *val;
+    int  wpn = 8;
+
+    if (!(val = Config.GetWord()))
+       {eDest->Emsg("Config", "numa option not specified"); return 1;}
+
+    if (!strcmp("off", val)) {XrdNuma::Config(-1); return 0;}
+    if (strcmp("on", val))
+       {eDest->Emsg("Config", "invalid numa option -", val); return 1;}
+
+    if ((val = Config.GetWord()))
+       {if (strcmp("workers", val))
+           {eDest->Emsg("Config", "invalid numa option -", val); return 1;}
+        if (!(val = Config.GetWord()))
+           {eDest->Emsg("Config", "numa workers value not specified");
+            return 1;
+           }
+        if (XrdOuca2x::a2i(*eDest, "numa workers", val, &wpn, 0, 4096))
+           return 1;
+       }
+
+    XrdNuma::Config(wpn);
+    return 0;
+}
+
 /******************************************************************************/
 /*                                  x n e t                                   */
 /******************************************************************************/
@@ -77,8 +77,10 @@ int   xapath(XrdSysError *edest, XrdOucStream &Config);
 int   xhpath(XrdSysError *edest, XrdOucStream &Config);
 int   xbuf(XrdSysError *edest, XrdOucStream &Config);
 int   xmaxfd(XrdSysError *edest, XrdOucStream &Config);
+int   xmetrics(XrdSysError *edest, XrdOucStream &Config);
 int   xnet(XrdSysError *edest, XrdOucStream &Config);
 int   xnkap(XrdSysError *edest, char *val);
+int   xnuma(XrdSysError *edest, XrdOucStream &Config);
 int   xlog(XrdSysError *edest, XrdOucStream &Config);
 int   xpidf(XrdSysError *edest, XrdOucStream &Config);
 int   xport(XrdSysError *edest, XrdOucStream &Config);
@@ -111,6 +113,8 @@ char               *caDir;
 char               *caFile;
 char               *ConfigFN;
 char               *repDest[2];
+char               *mtrShm;
+char               *mtrProm;
 XrdConfigProt      *Firstcp;
 XrdConfigProt      *Lastcp;
 int                 Net_Blen;
@@ -125,6 +129,7 @@ int                 PortTLS;      // TCP port to listen on for TLS connections
 int                 AdminMode;
 int                 HomeMode;
 int                 repInt;
+int                 mtrInt;
 
 uint64_t            tlsOpts;
 bool                tlsNoVer;
@@ -54,6 +54,7 @@
 #include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
+#include "XrdSys/XrdSysMetrics.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 
 #include "Xrd/XrdBuffer.hh"
@@ -1079,6 +1080,52 @@ void XrdLinkXeq::Shutdown(bool getLock)
    if (getLock) LinkInfo.opMutex.UnLock();
 }
 
+/******************************************************************************/
+/*                               M e t r i c s                                */
+/******************************************************************************/
+
+namespace
+{
+long long getInt(void *vP) {return AtomicGet(*static_cast<int *>(vP));}
+
+long long getLL(void *vP)  {return AtomicGet(*static_cast<long long *>(vP));}
+}
+
+// Register the link counters with the metrics registry. Like an unsynced
+// report, the totals only include the activity of links that have been
+// synced (i.e. have closed or were swept by a "sync" report).
+//
+void XrdLinkXeq::Metrics()
+{
+   new XrdSysMetrics::Probe("xrd_link_connections",
+                            "Number of connected links.",
+                            XrdSysMetrics::isGauge, getInt, &LinkCount);
+   new XrdSysMetrics::Probe("xrd_link_connections_max",
+                            "Largest number of connected links.",
+                            XrdSysMetrics::isGauge, getInt, &LinkCountMax);
+   new XrdSysMetrics::Probe("xrd_link_connections_total",
+                            "Number of links accepted.",
+                            XrdSysMetrics::isCounter, getLL, &LinkCountTot);
+   new XrdSysMetrics::Probe("xrd_link_received_bytes_total",
+                            "Bytes received over synced links.",
+                            XrdSysMetrics::isCounter, getLL, &LinkBytesIn);
+   new XrdSysMetrics::Probe("xrd_link_sent_bytes_total",
+                            "Bytes sent over synced links.",
+                            XrdSysMetrics::isCounter, getLL, &LinkBytesOut);
+   new XrdSysMetrics::Probe("xrd_link_connect_seconds_total",
+                            "Connect time of synced links.",
+                            XrdSysMetrics::isCounter, getLL, &LinkConTime);
+   new XrdSysMetrics::Probe("xrd_link_timeouts_total",
+                            "Number of read timeouts.",
+                            XrdSysMetrics::isCounter, getInt, &LinkTimeOuts);
+   new XrdSysMetrics::Probe("xrd_link_stalls_total",
+                            "Number of partial reads.",
+                            XrdSysMetrics::isCounter, getInt, &LinkStalls);
+   new XrdSysMetrics::Probe("xrd_link_sendfile_interrupts_total",
+                            "Number of interrupted sendfile calls.",
+                            XrdSysMetrics::isCounter, getInt, &LinkSfIntr);
+}
+
 /******************************************************************************/
 /*                                 S t a t s                                  */
 /******************************************************************************/
@@ -114,6 +114,8 @@ void          setProtName(const char *name);
 
 bool          setTLS(bool enable, XrdTlsContext *ctx=0);
 
+static void   Metrics();
+
        void   Shutdown(bool getLock);
 
 static int    Stats(char *buff, int blen, bool do_sync=false);
@@ -0,0 +1,352 @@
+/******************************************************************************/
+/*                                                                            */
+/*                            X r d N u m a . c c                             */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+#include "Xrd/XrdNuma.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+
+namespace
+{
+struct ifNode   {char name[IF_NAMESIZE]; int node;};
+struct addrNode {struct sockaddr_storage addr; int node;};
+
+static const int maxIF = 64;
+
+cpu_set_t   nodeCPUs[XrdNuma::maxNodes];
+int         osNodes[XrdNuma::maxNodes];
+int         allNodes[1024];
+int         numAll = 0;
+short       cpuNode[CPU_SETSIZE];
+int         numFound = 0;
+
+ifNode      ifTab[maxIF];
+int         ifNum = 0;
+addrNode    addrTab[maxIF];
+int         addrNum = 0;
+
+XrdSysMutex pinMutex;
+int         pinCnt[XrdNuma::maxNodes];
+
+thread_local int myPin = -1;
+
+// Compare the address part of two socket addresses, treating an IPv4 mapped
+// IPv6 address as the IPv4 address it is.
+//
+bool SameAddr(const struct sockaddr *a1, const struct sockaddr *a2)
+{
+   const unsigned char *b1, *b2;
+   int l1, l2;
+
+   for (int i = 0; i < 2; i++)
+       {const struct sockaddr *sP = (i ? a2 : a1);
+        const unsigned char **bP = (i ? &b2 : &b1);
+        int *lP = (i ? &l2 : &l1);
+        if (sP->sa_family == AF_INET)
+           {*bP = (const unsigned char *)
+                  &((const struct sockaddr_in *)sP)->sin_addr; *lP = 4;
+           } else if (sP->sa_family == AF_INET6)
+           {const struct in6_addr *a6 =
+                  &((const struct sockaddr_in6 *)sP)->sin6_addr;
+            if (IN6_IS_ADDR_V4MAPPED(a6)) {*bP = a6->s6_addr+12; *lP = 4;}
+               else {*bP = a6->s6_addr; *lP = 16;}
+           } else return false;
+       }
+   return l1 == l2 && !memcmp(b1, b2, l1);
+}
+}
+
+int XrdNuma::cfgWPN   = -1;
+int XrdNuma::numNodes =  0;
+
+/******************************************************************************/
+/*                                  B i n d                                   */
+/******************************************************************************/
+
+int XrdNuma::Bind(int node)
+{
+   if (node < 0 || node >= numFound) return -EINVAL;
+   if (sched_setaffinity(0, sizeof(cpu_set_t), &nodeCPUs[node])) return -errno;
+   myPin = node;
+   return 0;
+}
+
+/******************************************************************************/
+/* Private:                        D e n s e                                  */
+/******************************************************************************/
+
+int XrdNuma::Dense(int osNode)
+{
+   for (int i = 0; i < numAll; i++)
+       if (allNodes[i] == osNode) return i % maxNodes;
+   return -1;
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+int XrdNuma::Init(const char *sysRoot)
+{
+   struct dirent *dE;
+   struct ifaddrs *ifList;
+   DIR  *dP;
+   char  path[1024];
+   int   n = 0, v;
+
+// Start afresh
+//
+   numNodes = numFound = numAll = ifNum = addrNum = 0;
+   for (int i = 0; i < CPU_SETSIZE; i++) cpuNode[i] = -1;
+   for (int i = 0; i < maxNodes;    i++) {CPU_ZERO(&nodeCPUs[i]); pinCnt[i] = 0;}
+
+// Find all of the nodes. Node numbers need not be dense so we sort them and
+// use their position instead.
+//
+   snprintf(path, sizeof(path), "%s/devices/system/node", sysRoot);
+   if (!(dP = opendir(path))) return 0;
+   while((dE = readdir(dP)) && n < 1024)
+        {if (!strncmp(dE->d_name, "node", 4)
+         &&  sscanf(dE->d_name+4, "%d", &v) == 1 && v >= 0) allNodes[n++] = v;
+        }
+   closedir(dP);
+   std::sort(allNodes, allNodes+n);
+   numAll = n;
+
+// Obtain the cpus on each node. Nodes past the maximum share a slot.
+//
+   numFound = n;
+   for (int i = 0; i < n; i++)
+       {if (i < maxNodes) osNodes[i] = allNodes[i];
+        snprintf(path, sizeof(path), "%s/devices/system/node/node%d/cpulist",
+                 sysRoot, allNodes[i]);
+        Parse(path, i % maxNodes);
+       }
+   if (n > maxNodes) numFound = maxNodes;
+
+// Find the node of each network interface that has one
+//
+   snprintf(path, sizeof(path), "%s/class/net", sysRoot);
+   if ((dP = opendir(path)))
+      {while((dE = readdir(dP)) && ifNum < maxIF)
+            {FILE *fP;
+             if (*dE->d_name == '.' || strlen(dE->d_name) >= IF_NAMESIZE)
+                continue;
+             snprintf(path, sizeof(path), "%s/class/net/%s/device/numa_node",
+                      sysRoot, dE->d_name);
+             if (!(fP = fopen(path, "r"))) continue;
+             if (fscanf(fP, "%d", &v) == 1 && v >= 0 && (v = Dense(v)) >= 0)
+                {strcpy(ifTab[ifNum].name, dE->d_name);
+                 ifTab[ifNum++].node = v;
+                }
+             fclose(fP);
+            }
+       closedir(dP);
+      }
+
+// Map the addresses of those interfaces to their node so that a connection
+// can be routed by its local address.
+//
+   if (ifNum && !getifaddrs(&ifList))
+      {for (struct ifaddrs *ifP = ifList; ifP && addrNum < maxIF;
+            ifP = ifP->ifa_next)
+           {if (!ifP->ifa_addr || (ifP->ifa_addr->sa_family != AF_INET
+            &&  ifP->ifa_addr->sa_family != AF_INET6)) continue;
+            if ((v = NodeOfIF(ifP->ifa_name)) < 0) continue;
+            memcpy(&addrTab[addrNum].addr, ifP->ifa_addr,
+                   (ifP->ifa_addr->sa_family == AF_INET
+                    ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6)));
+            addrTab[addrNum++].node = v;
+           }
+       freeifaddrs(ifList);
+      }
+
+// Activate placement if so wanted and it makes sense
+//
+   numNodes = (cfgWPN >= 0 && numFound > 1 ? numFound : 0);
+   return n;
+}
+
+/******************************************************************************/
+/*                                M y N o d e                                 */
+/******************************************************************************/
+
+int XrdNuma::MyNode()
+{
+   int node;
+
+   if (!numNodes) return 0;
+   if (myPin >= 0) return myPin;
+   return ((node = NodeOfCPU(sched_getcpu())) < 0 ? 0 : node);
+}
+
+/******************************************************************************/
+/*                             N o d e O f C P U                              */
+/******************************************************************************/
+
+int XrdNuma::NodeOfCPU(int cpu)
+{
+   return (cpu >= 0 && cpu < CPU_SETSIZE ? cpuNode[cpu] : -1);
+}
+
+/******************************************************************************/
+/*                              N o d e O f I F                               */
+/******************************************************************************/
+
+int XrdNuma::NodeOfIF(const char *ifName)
+{
+   for (int i = 0; i < ifNum; i++)
+       if (!strcmp(ifName, ifTab[i].name)) return ifTab[i].node;
+   return -1;
+}
+
+/******************************************************************************/
+/*                            N o d e O f S o c k                             */
+/******************************************************************************/
+
+int XrdNuma::NodeOfSock(int fd)
+{
+   struct sockaddr_storage myAddr;
+   socklen_t aLen = sizeof(myAddr);
+
+// Find the interface the connection came in on by its local address
+//
+   if (!addrNum
+   ||  getsockname(fd, (struct sockaddr *)&myAddr, &aLen)) return -1;
+
+   for (int i = 0; i < addrNum; i++)
+       if (SameAddr((struct sockaddr *)&myAddr,
+                    (struct sockaddr *)&addrTab[i].addr)) return addrTab[i].node;
+   return -1;
+}
+
+/******************************************************************************/
+/* Private:                        P a r s e                                  */
+/******************************************************************************/
+
+int XrdNuma::Parse(const char *path, int node)
+{
+   char buff[4096], *bP, *eP;
+   int fd, rlen, beg, end, n = 0;
+
+// Read the cpu list (e.g. "0-7,16-23")
+//
+   if ((fd = open(path, O_RDONLY)) < 0) return 0;
+   rlen = read(fd, buff, sizeof(buff)-1);
+   close(fd);
+   if (rlen <= 0) return 0;
+   buff[rlen] = 0;
+
+// Record each cpu in the list
+//
+   bP = buff;
+   while(*bP >= '0' && *bP <= '9')
+        {beg = end = strtol(bP, &eP, 10);
+         if (*eP == '-') end = strtol(eP+1, &eP, 10);
+         for (int cpu = beg; cpu <= end && cpu < CPU_SETSIZE; cpu++)
+             {CPU_SET(cpu, &nodeCPUs[node]); cpuNode[cpu] = node; n++;}
+         if (*eP != ',') break;
+         bP = eP+1;
+        }
+   return n;
+}
+
+/******************************************************************************/
+/*                                 P l a c e                                  */
+/******************************************************************************/
+
+void XrdNuma::Place(void *addr, size_t len, int node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+   static const int mpolPreferred = 1;
+   unsigned long mask;
+
+// We prefer rather than bind so that an exhausted node does not fail the
+// allocation; the memory simply comes from elsewhere.
+//
+   if (!numNodes || node < 0 || node >= numNodes || osNodes[node] >= 64) return;
+   mask = 1UL << osNodes[node];
+   syscall(SYS_mbind, addr, len, mpolPreferred, &mask, 65, 0);
+#endif
+}
+
+/******************************************************************************/
+/*                                   P i n                                    */
+/******************************************************************************/
+
+int XrdNuma::Pin()
+{
+   int node = -1;
+
+// Find the node with the fewest pinned workers that is below its quota
+//
+   if (!numNodes || cfgWPN <= 0) return -1;
+   pinMutex.Lock();
+   for (int i = 0; i < numNodes; i++)
+       if (pinCnt[i] < cfgWPN && (node < 0 || pinCnt[i] < pinCnt[node]))
+          node = i;
+   if (node >= 0) pinCnt[node]++;
+   pinMutex.UnLock();
+
+// Bind the thread to that node
+//
+   if (node >= 0 && Bind(node)) {Unpin(node); node = -1;}
+   return node;
+}
+
+/******************************************************************************/
+/*                                 U n p i n                                  */
+/******************************************************************************/
+
+void XrdNuma::Unpin(int node)
+{
+   if (node < 0 || node >= numNodes) return;
+   pinMutex.Lock();
+   if (pinCnt[node] > 0) pinCnt[node]--;
+   pinMutex.UnLock();
+}
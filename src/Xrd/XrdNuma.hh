@@ -0,0 +1,115 @@
+#ifndef __XRD_NUMA_H__
+#define __XRD_NUMA_H__
+/******************************************************************************/
+/*                                                                            */
+/*                            X r d N u m a . h h                             */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <cstddef>
+
+/******************************************************************************/
+/*                         C l a s s   X r d N u m a                          */
+/******************************************************************************/
+
+// XrdNuma places pollers, a subset of scheduler workers, and buffer pool
+// memory on the NUMA nodes of the machine (see the xrd.numa directive). The
+// topology is taken from sysfs so no NUMA library is needed. When placement
+// is not active every method is a cheap no-op and all memory is on node 0
+// as far as the buffer manager is concerned.
+
+class XrdNuma
+{
+public:
+
+// The maximum number of nodes we distinguish; others fold onto these.
+//
+static const int maxNodes = 8;
+
+// Indicate whether or not placement is in effect.
+//
+static bool Active() {return numNodes > 1;}
+
+// Bind the calling thread to the cpus of a node. Returns 0 upon success and
+// -errno otherwise.
+//
+static int  Bind(int node);
+
+// Record the xrd.numa directive; wpn is the number of scheduler workers to
+// pin to each node, negative when placement was turned off.
+//
+static void Config(int wpn) {cfgWPN = wpn;}
+
+// Discover the topology. Returns the number of nodes found, 0 if the
+// topology could not be determined. Placement is activated only when asked
+// for and there is more than one node.
+//
+static int  Init(const char *sysRoot="/sys");
+
+// Return the node the calling thread is running on.
+//
+static int  MyNode();
+
+// Return the node of a cpu, a network interface, or the interface that
+// carries a connected socket; -1 if not known.
+//
+static int  NodeOfCPU(int cpu);
+static int  NodeOfIF(const char *ifName);
+static int  NodeOfSock(int fd);
+
+// Return the number of nodes discovered.
+//
+static int  Nodes() {return numNodes;}
+
+// Ask the kernel to back a page aligned region of memory from a node.
+//
+static void Place(void *addr, size_t len, int node);
+
+// Pin a starting scheduler worker to the node with the fewest pinned workers
+// if any node is below its quota. Returns the node or -1. Unpin() must be
+// called with the returned value when the worker exits.
+//
+static int  Pin();
+static void Unpin(int node);
+
+// Indicate whether placement was asked for and return the number of
+// scheduler workers to pin to each node.
+//
+static bool Wanted() {return cfgWPN >= 0;}
+
+static int  WorkersPerNode() {return (cfgWPN > 0 ? cfgWPN : 0);}
+
+private:
+
+static int  Dense(int osNode);
+static int  Parse(const char *path, int node);
+
+static int  cfgWPN;
+static int  numNodes;
+};
+#endif
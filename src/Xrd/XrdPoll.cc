@@ -36,6 +36,7 @@
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "Xrd/XrdLink.hh"
+#include "Xrd/XrdNuma.hh"
 #include "Xrd/XrdProtocol.hh"
 
 #define  TRACE_IDENT pInfo.Link.ID
@@ -76,7 +77,8 @@ int           Stats(char *buff, int blen, int do_sync=0) {return 0;}
 /*                           G l o b a l   D a t a                            */
 /******************************************************************************/
   
-       XrdPoll   *XrdPoll::Pollers[XRD_NUMPOLLERS] = {0, 0, 0};
+       XrdPoll   *XrdPoll::Pollers[XRD_MAXPOLLERS] = {0};
+       int        XrdPoll::numPollers = XRD_NUMPOLLERS;
 
        XrdSysMutex  XrdPoll::doingAttach;
 
@@ -97,6 +99,7 @@ using namespace XrdGlobal;
 struct XrdPollArg
        {XrdPoll      *Poller;
         int            retcode;
+        int            node;
         XrdSysSemaphore PollSync;
 
         XrdPollArg() : PollSync(0, "poll sync") {}
@@ -107,6 +110,7 @@ struct XrdPollArg
 void *XrdStartPolling(void *parg)
 {
      struct XrdPollArg *PArg = (struct XrdPollArg *)parg;
+     if (PArg->node >= 0 && XrdNuma::Bind(PArg->node)) PArg->Poller->Node = -1;
      PArg->Poller->Start(&(PArg->PollSync), PArg->retcode);
      return (void *)0;
 }
@@ -120,6 +124,7 @@ XrdPoll::XrdPoll()
    int fildes[2];
 
    TID=0;
+   Node=-1;
    numAttached=numEnabled=numEvents=numInterrupts=0;
 
    if (XrdSysFD_Pipe(fildes) == 0)
@@ -143,18 +148,31 @@ int XrdPoll__Attach(XrdLink *lp) {return lp->Activate();}
 
 int XrdPoll::Attach(XrdPollInfo &pInfo)
 {
-   int i;
-   XrdPoll *pp;
+   int i, node;
+   XrdPoll *pp = 0;
+
+// When placing by NUMA node we want a poller on the node of the interface the
+// connection arrived on, if it is known.
+//
+   node = (XrdNuma::Active() ? XrdNuma::NodeOfSock(pInfo.FD) : -1);
 
 // We allow only one attach at a time to simplify the processing
 //
    doingAttach.Lock();
 
-// Find a poller with the smallest number of entries
+// Find a poller with the smallest number of entries, preferring those on the
+// wanted node.
 //
-   pp = Pollers[0];
-   for (i = 1; i < XRD_NUMPOLLERS; i++)
-       if (pp->numAttached > Pollers[i]->numAttached) pp = Pollers[i];
+   if (node >= 0)
+      for (i = 0; i < numPollers; i++)
+          if (Pollers[i]->Node == node
+          &&  (!pp || pp->numAttached > Pollers[i]->numAttached))
+             pp = Pollers[i];
+   if (!pp)
+      {pp = Pollers[0];
+       for (i = 1; i < numPollers; i++)
+           if (pp->numAttached > Pollers[i]->numAttached) pp = Pollers[i];
+      }
 
 // Include this FD into the poll set of the poller
 //
@@ -166,7 +184,7 @@ int XrdPoll::Attach(XrdPollInfo &pInfo)
    pp->numAttached++;
    doingAttach.UnLock();
    TRACEI(POLL, "FD " <<pInfo.FD <<" attached to poller " <<pp->PID
-                <<"; num=" <<pp->numAttached);
+                <<" node " <<pp->Node <<"; num=" <<pp->numAttached);
    return 1;                                                           
 }
 
@@ -291,23 +309,33 @@ char *XrdPoll::Poll2Text(short events)
 int XrdPoll::Setup(int numfd)
 {
    pthread_t tid;
-   int maxfd, retc, i;
+   int maxfd, retc, i, nodes = XrdNuma::Nodes();
    struct XrdPollArg PArg;
 
+// When placing by NUMA node, each node gets the same number of pollers and
+// there are at least as many as we would otherwise have.
+//
+   if (XrdNuma::Active())
+      {numPollers = (XRD_NUMPOLLERS + nodes - 1) / nodes * nodes;
+       if (numPollers > XRD_MAXPOLLERS) numPollers = XRD_MAXPOLLERS;
+      }
+
 // Calculate the number of table entries per poller
 //
-   maxfd  = (numfd / XRD_NUMPOLLERS) + 16;
+   maxfd  = (numfd / numPollers) + 16;
 
 // Verify that we initialized the poller table
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {if (!(Pollers[i] = newPoller(i, maxfd))) return 0;
         Pollers[i]->PID = i;
+        if (XrdNuma::Active()) Pollers[i]->Node = i % nodes;
 
    // Now start a thread to handle this poller object
    //
         PArg.Poller = Pollers[i];
         PArg.retcode= 0;
+        PArg.node   = Pollers[i]->Node;
         TRACE(POLL, "Starting poller " <<i);
         if ((retc = XrdSysThread::Run(&tid,XrdStartPolling,(void *)&PArg,
                                       XRDSYSTHREAD_BIND, "Poller")))
@@ -338,13 +366,13 @@ int XrdPoll::Stats(char *buff, int blen, int do_sync)
 
 // Return number of bytes if so wanted
 //
-   if (!buff) return (sizeof(statfmt)+(4*16))*XRD_NUMPOLLERS;
+   if (!buff) return (sizeof(statfmt)+(4*16))*numPollers;
 
 // Get statistics. While we wish we could honor do_sync, doing so would be
 // costly and hardly worth it. So, we do not include code such as:
 //    x = pp->y; if (do_sync) while(x != pp->y) x = pp->y; tot += x;
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {pp = Pollers[i];
         numatt += pp->numAttached; 
         numen  += pp->numEnabled;
@@ -33,6 +33,7 @@
 #include "XrdSys/XrdSysPthread.hh"
 
 #define XRD_NUMPOLLERS 3
+#define XRD_MAXPOLLERS 32
 
 class XrdPollInfo;
 class XrdSysSemaphore;
@@ -81,10 +82,12 @@ static  int   Stats(char *buff, int blen, int do_sync=0);
 //
            int         PID;       // Poller ID
            pthread_t   TID;       // Thread ID
+           int         Node;      // NUMA node of the thread or -1
 
 // The following table reference the pollers in effect
 //
-static     XrdPoll   *Pollers[XRD_NUMPOLLERS];
+static     XrdPoll   *Pollers[XRD_MAXPOLLERS];
+static     int        numPollers;
 
            XrdPoll();
 virtual   ~XrdPoll() {}
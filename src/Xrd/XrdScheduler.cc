@@ -40,10 +40,12 @@
 #endif
 
 #include "Xrd/XrdJob.hh"
+#include "Xrd/XrdNuma.hh"
 #include "Xrd/XrdScheduler.hh"
 #include "XrdOuc/XrdOucTrace.hh"    // For ABI compatibility only!
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysMetrics.hh"
 
 #define XRD_TRACE XrdTrace->
 #include "Xrd/XrdTrace.hh"
@@ -86,7 +88,9 @@ void *XrdStartTSched(void *carg)
 
 void *XrdStartWorking(void *carg)
       {XrdScheduler *sp = (XrdScheduler *)carg;
+       int node = XrdNuma::Pin();
        sp->Run();
+       XrdNuma::Unpin(node);
        return (void *)0;
       }
 
@@ -588,6 +592,46 @@ void XrdScheduler::Start() // Serialized one time call!
    TRACE(SCHED, "Starting with " <<num_Workers <<" workers" );
 }
 
+/******************************************************************************/
+/*                               M e t r i c s                                */
+/******************************************************************************/
+
+namespace
+{
+long long getInt(void *vP) {return *static_cast<volatile int *>(vP);}
+}
+
+// Register the scheduler counters with the metrics registry. They are read
+// without a lock, as an unsynced report would.
+//
+void XrdScheduler::Metrics()
+{
+   new XrdSysMetrics::Probe("xrd_sched_jobs_total",
+                            "Number of jobs scheduled.",
+                            XrdSysMetrics::isCounter, getInt, &num_Jobs);
+   new XrdSysMetrics::Probe("xrd_sched_queued_jobs",
+                            "Number of jobs waiting for a thread.",
+                            XrdSysMetrics::isGauge, getInt, &num_JobsinQ);
+   new XrdSysMetrics::Probe("xrd_sched_queued_jobs_max",
+                            "Longest the job queue has been.",
+                            XrdSysMetrics::isGauge, getInt, &max_QLength);
+   new XrdSysMetrics::Probe("xrd_sched_threads",
+                            "Number of scheduler threads.",
+                            XrdSysMetrics::isGauge, getInt, &num_Workers);
+   new XrdSysMetrics::Probe("xrd_sched_idle_threads",
+                            "Number of idle scheduler threads.",
+                            XrdSysMetrics::isGauge, getInt, &idl_Workers);
+   new XrdSysMetrics::Probe("xrd_sched_threads_created_total",
+                            "Number of scheduler threads created.",
+                            XrdSysMetrics::isCounter, getInt, &num_TCreate);
+   new XrdSysMetrics::Probe("xrd_sched_threads_destroyed_total",
+                            "Number of scheduler threads destroyed.",
+                            XrdSysMetrics::isCounter, getInt, &num_TDestroy);
+   new XrdSysMetrics::Probe("xrd_sched_thread_limit_total",
+                            "Number of times the thread limit was reached.",
+                            XrdSysMetrics::isCounter, getInt, &num_Limited);
+}
+
 /******************************************************************************/
 /*                                 S t a t s                                  */
 /******************************************************************************/
@@ -67,6 +67,8 @@ void          Schedule(XrdJob *jp, time_t atime);
 
 void          setParms(int minw, int maxw, int avlt, int maxi, int once=0);
 
+void          Metrics();
+
 void          Start();
 
 int           Stats(char *buff, int blen, int do_sync=0);
@@ -27,8 +27,13 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <sys/resource.h>
   
@@ -36,11 +41,13 @@
 #include "Xrd/XrdBuffer.hh"
 #include "Xrd/XrdJob.hh"
 #include "Xrd/XrdLink.hh"
+#include "Xrd/XrdLinkXeq.hh"
 #include "Xrd/XrdPoll.hh"
 #include "Xrd/XrdProtLoad.hh"
 #include "Xrd/XrdScheduler.hh"
 #include "Xrd/XrdStats.hh"
 #include "XrdNet/XrdNetMsg.hh"
+#include "XrdSys/XrdSysMetrics.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysTimer.hh"
 
@@ -58,21 +65,48 @@ class XrdStatsJob : XrdJob
 {
 public:
 
-     void DoIt() {Stats->Report();
+     void DoIt() {if (doExp) Stats->Export();
+                     else   Stats->Report();
                   Sched->Schedule((XrdJob *)this, time(0)+iVal);
                  }
 
-          XrdStatsJob(XrdScheduler *schP, XrdStats *sP, int iV)
-                     : XrdJob("stats reporter"),
-                       Sched(schP), Stats(sP), iVal(iV)
+          XrdStatsJob(XrdScheduler *schP, XrdStats *sP, int iV, bool exp=false)
+                     : XrdJob(exp ? "metrics exporter" : "stats reporter"),
+                       Sched(schP), Stats(sP), iVal(iV), doExp(exp)
                      {Sched->Schedule((XrdJob *)this, time(0)+iVal);}
          ~XrdStatsJob() {}
 private:
 XrdScheduler *Sched;
 XrdStats     *Stats;
 int           iVal;
+bool          doExp;
 };
 
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+long long cpuUsr(void *)
+{
+   struct rusage r_usage;
+
+   if (getrusage(RUSAGE_SELF, &r_usage)) return 0;
+   return static_cast<long long>(r_usage.ru_utime.tv_sec) * 1000000LL
+        + static_cast<long long>(r_usage.ru_utime.tv_usec);
+}
+
+long long cpuSys(void *)
+{
+   struct rusage r_usage;
+
+   if (getrusage(RUSAGE_SELF, &r_usage)) return 0;
+   return static_cast<long long>(r_usage.ru_stime.tv_sec) * 1000000LL
+        + static_cast<long long>(r_usage.ru_stime.tv_usec);
+}
+}
+
 /******************************************************************************/
 /*                           C o n s t r c u t o r                            */
 /******************************************************************************/
@@ -99,6 +133,43 @@ XrdStats::XrdStats(XrdSysError *eP, XrdScheduler *sP, XrdBuffManager *bP,
    myHost = hname;
    myName = iname;
    myPort = port;
+   mtrShm = 0;
+   mtrProm= 0;
+   shmMem = 0;
+   shmLen = 0;
+   shmFD  = -1;
+}
+
+/******************************************************************************/
+/*                                E x p o r t                                 */
+/******************************************************************************/
+
+void XrdStats::Export(const char *shmPath, const char *promPath, int iVal)
+{
+
+// If we have a path then this is for initialization. Register the metrics
+// of the base components and schedule the export job.
+//
+   if (shmPath || promPath)
+      {if (shmPath)  mtrShm  = strdup(shmPath);
+       if (promPath) mtrProm = strdup(promPath);
+       XrdLinkXeq::Metrics();
+       XrdSched->Metrics();
+       new XrdSysMetrics::Probe("xrd_process_cpu_user_microseconds_total",
+                                "User CPU time used by the process.",
+                                XrdSysMetrics::isCounter, cpuUsr);
+       new XrdSysMetrics::Probe("xrd_process_cpu_system_microseconds_total",
+                                "System CPU time used by the process.",
+                                XrdSysMetrics::isCounter, cpuSys);
+       new XrdStatsJob(XrdSched, this, iVal, true);
+       return;
+      }
+
+// This is a re-entry from the export job. Should an export fail we stop doing
+// it rather than complaining every interval.
+//
+   if (mtrShm  && !ExportShm())  {free(mtrShm);  mtrShm  = 0;}
+   if (mtrProm && !ExportProm()) {free(mtrProm); mtrProm = 0;}
 }
  
 /******************************************************************************/
@@ -168,6 +239,86 @@ void XrdStats::Stats(XrdStats::CallBack *cbP, int opts)
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
+/******************************************************************************/
+/*                            E x p o r t P r o m                             */
+/******************************************************************************/
+
+bool XrdStats::ExportProm()
+{
+   std::string text, tmpPath(mtrProm);
+   const char *bP;
+   int fd, n, left;
+
+// Format the metrics
+//
+   XrdSysMetrics::Prometheus(text);
+
+// Write them to a temporary file and rename it over the real one so that a
+// scraper never sees a partial file.
+//
+   tmpPath += ".tmp";
+   if ((fd = open(tmpPath.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644)) < 0)
+      {XrdLog->Emsg("Stats", errno, "create metrics file", tmpPath.c_str());
+       return false;
+      }
+   bP = text.data(); left = text.size();
+   while(left > 0)
+        {if ((n = write(fd, bP, left)) < 0)
+            {if (errno == EINTR) continue;
+             XrdLog->Emsg("Stats", errno, "write metrics file",tmpPath.c_str());
+             close(fd); unlink(tmpPath.c_str());
+             return false;
+            }
+         bP += n; left -= n;
+        }
+   close(fd);
+
+   if (rename(tmpPath.c_str(), mtrProm))
+      {XrdLog->Emsg("Stats", errno, "rename metrics file", tmpPath.c_str());
+       unlink(tmpPath.c_str());
+       return false;
+      }
+   return true;
+}
+
+/******************************************************************************/
+/*                             E x p o r t S h m                              */
+/******************************************************************************/
+
+// The snapshot is rewritten in place. Readers use the generation number in
+// the header as a sequence lock: it is odd while the snapshot is changing, so
+// a reader that sees the same even generation before and after copying the
+// snapshot has a consistent copy.
+//
+bool XrdStats::ExportShm()
+{
+   uint64_t *genP, gen;
+   int need;
+
+// Map the file the first time through
+//
+   if (!shmMem && !ShmMap(65536)) return false;
+
+// Mark the snapshot as changing
+//
+   genP = reinterpret_cast<uint64_t *>(shmMem + 8);
+   gen  = __atomic_load_n(genP, __ATOMIC_RELAXED);
+   __atomic_store_n(genP, gen | 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+// Produce the snapshot, growing the file if need be
+//
+   while((need = XrdSysMetrics::Binary(shmMem, shmLen)) > shmLen)
+        {if (!ShmMap(need)) return false;
+         genP = reinterpret_cast<uint64_t *>(shmMem + 8);
+        }
+
+// Mark the snapshot as stable
+//
+   __atomic_store_n(genP, (gen | 1) + 1, __ATOMIC_RELEASE);
+   return true;
+}
+
 /******************************************************************************/
 /*                              G e n S t a t s                               */
 /******************************************************************************/
@@ -258,6 +409,42 @@ const char *XrdStats::GenStats(int &rsz, int opts) // statsMutex must be locked!
    return buff;
 }
 
+/******************************************************************************/
+/*                                S h m M a p                                 */
+/******************************************************************************/
+
+bool XrdStats::ShmMap(int size)
+{
+   static const int mapUnit = 65536;
+   void *mP;
+
+// Open the file if we have not done so yet
+//
+   if (shmFD < 0
+   && (shmFD = open(mtrShm, O_RDWR|O_CREAT|O_TRUNC, 0644)) < 0)
+      {XrdLog->Emsg("Stats", errno, "create metrics file", mtrShm);
+       return false;
+      }
+
+// Size the file and (re)map it
+//
+   size = (size + mapUnit - 1) / mapUnit * mapUnit;
+   if (ftruncate(shmFD, size))
+      {XrdLog->Emsg("Stats", errno, "size metrics file", mtrShm);
+       return false;
+      }
+   if (shmMem) munmap(shmMem, shmLen);
+   shmMem = 0; shmLen = 0;
+   mP = mmap(0, size, PROT_READ|PROT_WRITE, MAP_SHARED, shmFD, 0);
+   if (mP == MAP_FAILED)
+      {XrdLog->Emsg("Stats", errno, "map metrics file", mtrShm);
+       return false;
+      }
+   shmMem = static_cast<char *>(mP);
+   shmLen = size;
+   return true;
+}
+
 /******************************************************************************/
 /*                             I n f o S t a t s                              */
 /******************************************************************************/
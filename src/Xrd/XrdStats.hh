@@ -54,6 +54,12 @@ public:
 
 void  Report(char **Dest=0, int iVal=600, int Opts=0);
 
+// Periodically export the metrics registry as a binary snapshot in a shared
+// memory file and/or as Prometheus text. Called with no arguments by the
+// export job to do the actual export.
+//
+void  Export(const char *shmPath=0, const char *promPath=0, int iVal=1);
+
 class CallBack
      {public: virtual void Info(const char *data, int dlen) = 0;
                            CallBack() {}
@@ -71,9 +77,12 @@ virtual ~XrdStats() {if (buff) free(buff);}
 
 private:
 
+bool        ExportProm();
+bool        ExportShm();
 const char *GenStats(int &rsz, int opts);
 int        InfoStats(char *buff, int blen, int dosync=0);
 int        ProcStats(char *buff, int blen, int dosync=0);
+bool        ShmMap(int size);
 
 static long     tBoot;       // Time at boot time
 
@@ -89,5 +98,11 @@ char       *Head;
 const char *myHost;
 const char *myName;
 int         myPort;
+
+char       *mtrShm;      // Used by the export job only
+char       *mtrProm;
+char       *shmMem;
+int         shmLen;
+int         shmFD;
 };
 #endif
@@ -44,6 +44,7 @@
 #include "XrdOuc/XrdOucUtils.hh"
 #include "XrdSec/XrdSecEntityAttr.hh"
 #include "XrdSys/XrdSysPlugin.hh"
+#include "XrdSys/XrdSysTimer.hh"
   
 /******************************************************************************/
 /*                   E x t e r n a l   R e f e r e n c e s                    */
@@ -91,7 +92,8 @@ XrdAccAuthorize *XrdAccDefaultAuthorizeObject(XrdSysLogger *lp,
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
   
-XrdAccAccess::XrdAccAccess(XrdSysError *erp)
+XrdAccAccess::XrdAccAccess(XrdSysError *erp) : Atab(new XrdAccAccess_Tables),
+                                               Epoch(0)
 {
 // Get the audit option that we should use
 //
@@ -112,7 +114,8 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
    XrdAccCapability *cp;
    XrdAccEntity     *aeP;
    XrdAccEntityInfo  eInfo;
-   int plen = strlen(path);
+   XrdAccAccess_Tables *tP;
+   int plen = strlen(path), rdrSlot;
    long phash = XrdOucHashVal2(path, plen);
    bool isuser;
 
@@ -137,23 +140,23 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
        isuser = false;
       }
 
-// Get a shared context for these potentially long running routines
+// Get the current tables, they stay valid until we drop them
 //
-   Access_Context.Lock(xs_Shared);
+   tP = TabHold(rdrSlot);
 
 // Setup the host entry in the eInfo structure (it may need to be resolved)
 //
-   eInfo.host = (hostRefX ? Resolve(Entity) : "?");
+   eInfo.host = (tP->hostRefX ? Resolve(Entity) : "?");
 
 // Run through the exclusive list first as only one rule will apply
 //
-   if (Atab.SXList)
-      {XrdAccAccess_ID *xlP = Atab.SXList;
+   if (tP->SXList)
+      {XrdAccAccess_ID *xlP = tP->SXList;
        do {int aSeq = 0;
            while(aeP->Next(aSeq, eInfo))
                 {if (xlP->Applies(eInfo))
                     {xlP->caps->Privs(caps, path, plen, phash);
-                     Access_Context.UnLock(xs_Shared);
+                     TabDrop(rdrSlot);
                      return Access(caps, Entity, path, oper);
                     }
                 }
@@ -163,42 +166,42 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 
 // Check if we really need to resolve the host name
 //
-//???   if (Atab.D_List || Atab.H_Hash || Atab.N_Hash) host = Resolve(Entity);
-   if (!hostRefX && hostRefY) eInfo.host = Resolve(Entity);
+//???   if (tP->D_List || tP->H_Hash || tP->N_Hash) host = Resolve(Entity);
+   if (!tP->hostRefX && tP->hostRefY) eInfo.host = Resolve(Entity);
 
 // Establish default privileges
 //
-   if (Atab.Z_List) Atab.Z_List->Privs(caps, path, plen, phash);
+   if (tP->Z_List) tP->Z_List->Privs(caps, path, plen, phash);
 
 // Next add in the host domain privileges
 //
-   if (Atab.D_List && (cp = Atab.D_List->Find(eInfo.host)))
+   if (tP->D_List && (cp = tP->D_List->Find(eInfo.host)))
       cp->Privs(caps, path, plen, phash);
 
 // Next add in the host-specific privileges
 //
-   if (Atab.H_Hash && (cp = Atab.H_Hash->Find(eInfo.host)))
+   if (tP->H_Hash && (cp = tP->H_Hash->Find(eInfo.host)))
       cp->Privs(caps, path, plen, phash);
 
 // Now add in the netgroup privileges
 //
-   if (Atab.N_Hash && *eInfo.host != '?' &&
+   if (tP->N_Hash && *eInfo.host != '?' &&
        (glp = XrdAccConfiguration.GroupMaster.NetGroups(eInfo.name,eInfo.host)))
       {char *gname;
        while((gname = (char *)glp->Next()))
-            if ((cp = Atab.N_Hash->Find((const char *)gname)))
+            if ((cp = tP->N_Hash->Find((const char *)gname)))
                cp->Privs(caps, path, plen, phash);
        delete glp;
       }
 
 // Check for user fungible privileges
 //
-   if (isuser && Atab.X_List)
-      Atab.X_List->Privs(caps, path, plen, phash, eInfo.name);
+   if (isuser && tP->X_List)
+      tP->X_List->Privs(caps, path, plen, phash, eInfo.name);
 
 // Add in specific user privileges
 //
-   if (isuser && Atab.U_Hash && (cp = Atab.U_Hash->Find(eInfo.name)))
+   if (isuser && tP->U_Hash && (cp = tP->U_Hash->Find(eInfo.name)))
       cp->Privs(caps, path, plen, phash);
 
 // The following privileges are based on multiple attributes. Orgs and roles
@@ -211,28 +214,28 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
         {
          // Add in the group privileges.
          //
-         if (Atab.G_Hash && eInfo.grup && (cp = Atab.G_Hash->Find(eInfo.grup)))
+         if (tP->G_Hash && eInfo.grup && (cp = tP->G_Hash->Find(eInfo.grup)))
             cp->Privs(caps, path, plen, phash);
 
          // Add in the org-specific privileges
          //
-         if (Atab.O_Hash && eInfo.vorg && eInfo.vorg != vorgPrev)
+         if (tP->O_Hash && eInfo.vorg && eInfo.vorg != vorgPrev)
             {vorgPrev = eInfo.vorg;
-             if ((cp = Atab.O_Hash->Find(eInfo.vorg)))
+             if ((cp = tP->O_Hash->Find(eInfo.vorg)))
                 cp->Privs(caps, path, plen, phash);
             }
 
          // Add in the role-specific privileges
          //
-         if (Atab.R_Hash && eInfo.role && eInfo.role != rolePrev)
+         if (tP->R_Hash && eInfo.role && eInfo.role != rolePrev)
             {rolePrev = eInfo.role;
-             if ((cp = Atab.R_Hash->Find(eInfo.role)))
+             if ((cp = tP->R_Hash->Find(eInfo.role)))
                 cp->Privs(caps, path, plen, phash);
             }
 
          // Finally run through the inclusive list and apply all relevant rules
          //
-         XrdAccAccess_ID *ylP = Atab.SYList;
+         XrdAccAccess_ID *ylP = tP->SYList;
          while (ylP)
                {if (ylP->Applies(eInfo))
                    ylP->caps->Privs(caps, path, plen, phash);
@@ -240,9 +243,9 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
                }
         }
 
-// We are now done with looking at changeable data
+// We are now done with looking at the tables
 //
-   Access_Context.UnLock(xs_Shared);
+   TabDrop(rdrSlot);
 
 // Return the privileges as needed
 //
@@ -348,64 +351,107 @@ const char *XrdAccAccess::Resolve(const XrdSecEntity *Entity)
 /*                              S w a p T a b s                               */
 /******************************************************************************/
 
-#define XrdAccSWAP(x) oldtab.x = Atab.x;   Atab.x  =  newtab.x; \
-                      newtab.x = oldtab.x; oldtab.x = 0;
+#define XrdAccMOVE(x) tabP->x = newtab.x; newtab.x = 0;
 
 void XrdAccAccess::SwapTabs(struct XrdAccAccess_Tables &newtab)
 {
-   struct XrdAccAccess_Tables oldtab;
-   bool hRefX = false, hRefY = false;
+   XrdAccAccess_Tables *tabP = new XrdAccAccess_Tables, *oldP;
+   unsigned int epoch;
 
 // Determine if we need to resolve the host name early
 //
    XrdAccAccess_ID *xlP = newtab.SXList;
    while(xlP)
-        {if (xlP->host) {hRefX = true; break;}
+        {if (xlP->host) {tabP->hostRefX = true; break;}
          xlP = xlP->next;
         }
 
 // Determine if we need to resolve the hostname at all.
 //
-   if (!hRefX)
-      {if (newtab.D_List || newtab.H_Hash || newtab.N_Hash) hRefY = true;
+   if (!tabP->hostRefX)
+      {if (newtab.D_List || newtab.H_Hash || newtab.N_Hash)
+          tabP->hostRefY = true;
           else {XrdAccAccess_ID *ylP = newtab.SYList;
                 while (ylP)
-                      {if (ylP->host) {hRefY = true; break;}
+                      {if (ylP->host) {tabP->hostRefY = true; break;}
                        ylP = ylP->next;
                       }
                }
       }
 
-// Get an exclusive context to change the table pointers
-//
-   Access_Context.Lock(xs_Exclusive);
-
-// Save the old pointer while replacing it with the new pointer
-//
-   XrdAccSWAP(D_List);
-   XrdAccSWAP(E_List);
-   XrdAccSWAP(G_Hash);
-   XrdAccSWAP(H_Hash);
-   XrdAccSWAP(N_Hash);
-   XrdAccSWAP(O_Hash);
-   XrdAccSWAP(R_Hash);
-   XrdAccSWAP(S_Hash);
-   XrdAccSWAP(T_Hash);
-   XrdAccSWAP(U_Hash);
-   XrdAccSWAP(X_List);
-   XrdAccSWAP(Z_List);
-   XrdAccSWAP(SXList);
-   XrdAccSWAP(SYList);
-   hostRefX = hRefX;
-   hostRefY = hRefY;
+// Take over the new tables, leaving the caller with nothing to delete
+//
+   XrdAccMOVE(D_List);
+   XrdAccMOVE(E_List);
+   XrdAccMOVE(G_Hash);
+   XrdAccMOVE(H_Hash);
+   XrdAccMOVE(N_Hash);
+   XrdAccMOVE(O_Hash);
+   XrdAccMOVE(R_Hash);
+   XrdAccMOVE(S_Hash);
+   XrdAccMOVE(T_Hash);
+   XrdAccMOVE(U_Hash);
+   XrdAccMOVE(X_List);
+   XrdAccMOVE(Z_List);
+   XrdAccMOVE(SXList);
+   XrdAccMOVE(SYList);
+
+// Publish the new tables. New searchers will only see these.
+//
+   oldP = Atab.exchange(tabP);
 
 // When we set new access tables, we should purge the group cache
 //
    XrdAccConfiguration.GroupMaster.PurgeCache();
 
-// We can now let loose new table searchers
+// Searchers that picked up the old tables have counted themselves under either
+// epoch parity. Flip the epoch so that the counters for the old parity only
+// drain and wait for that, then do the same for the other parity.
+//
+   epoch = Epoch.fetch_add(1);
+   TabWait(epoch & 1);
+   epoch = Epoch.fetch_add(1);
+   TabWait(epoch & 1);
+
+// Nobody can be looking at the old tables anymore
+//
+   delete oldP;
+}
+
+/******************************************************************************/
+/*                               T a b H o l d                                */
+/******************************************************************************/
+
+XrdAccAccess_Tables *XrdAccAccess::TabHold(int &rdrSlot)
+{
+   static std::atomic<int> nextShard(0);
+   static thread_local int myShard = -1;
+
+// Assign this thread a counter so that searchers rarely share a cache line
+//
+   if (myShard < 0) myShard = nextShard.fetch_add(1) % rdrShards;
+
+// Count ourselves as a searcher under the current epoch before looking at
+// the tables; SwapTabs() will not delete any tables we may see until we leave.
+//
+   rdrSlot = (Epoch.load() & 1) * rdrShards + myShard;
+   Readers[rdrSlot].num.fetch_add(1);
+   return Atab.load();
+}
+
+/******************************************************************************/
+/*                               T a b W a i t                                */
+/******************************************************************************/
+
+void XrdAccAccess::TabWait(int parity)
+{
+   rdrCount *rP = &Readers[parity * rdrShards];
+
+// Searchers are short lived but may have to resolve netgroups, so sleep
+// rather than spin while waiting for them.
 //
-   Access_Context.UnLock(xs_Exclusive);
+   for (int i = 0; i < rdrShards; i++)
+       while(rP[i].num.load(std::memory_order_acquire)) XrdSysTimer::Wait(1);
 }
 
 /******************************************************************************/
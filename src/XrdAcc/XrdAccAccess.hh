@@ -34,10 +34,11 @@
 #include "XrdAcc/XrdAccAuthorize.hh"
 #include "XrdAcc/XrdAccCapability.hh"
 #include "XrdSec/XrdSecEntity.hh"
-#include "XrdOuc/XrdOucHash.hh"
-#include "XrdSys/XrdSysXSLock.hh"
+#include "XrdOuc/XrdOucFlatHash.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 
+#include <atomic>
+
 /******************************************************************************/
 /*                     S e t T a b s   P a r a m e t e r                      */
 /******************************************************************************/
@@ -83,20 +84,22 @@ struct XrdAccAccess_ID
        };
   
 struct XrdAccAccess_Tables
-       {XrdOucHash<XrdAccCapability> *G_Hash;  // Groups
-        XrdOucHash<XrdAccCapability> *H_Hash;  // Hosts
-        XrdOucHash<XrdAccCapability> *N_Hash;  // Netgroups
-        XrdOucHash<XrdAccCapability> *O_Hash;  // Organizations
-        XrdOucHash<XrdAccCapability> *R_Hash;  // Roles
-        XrdOucHash<XrdAccAccess_ID>  *S_Hash;  // Sets
-        XrdOucHash<XrdAccCapability> *T_Hash;  // Templates
-        XrdOucHash<XrdAccCapability> *U_Hash;  // Users
-                  XrdAccCapName     *D_List;  // Domains
-                  XrdAccCapName     *E_List;  // Domains (end of list)
-                  XrdAccCapability  *X_List;  // Fungable capbailities
-                  XrdAccCapability  *Z_List;  // Default  capbailities
-                  XrdAccAccess_ID   *SXList;  // 's' exclusive list
-                  XrdAccAccess_ID   *SYList;  // 's' inclusive list
+       {XrdOucFlatHash<XrdAccCapability> *G_Hash;  // Groups
+        XrdOucFlatHash<XrdAccCapability> *H_Hash;  // Hosts
+        XrdOucFlatHash<XrdAccCapability> *N_Hash;  // Netgroups
+        XrdOucFlatHash<XrdAccCapability> *O_Hash;  // Organizations
+        XrdOucFlatHash<XrdAccCapability> *R_Hash;  // Roles
+        XrdOucFlatHash<XrdAccAccess_ID>  *S_Hash;  // Sets
+        XrdOucFlatHash<XrdAccCapability> *T_Hash;  // Templates
+        XrdOucFlatHash<XrdAccCapability> *U_Hash;  // Users
+                      XrdAccCapName     *D_List;  // Domains
+                      XrdAccCapName     *E_List;  // Domains (end of list)
+                      XrdAccCapability  *X_List;  // Fungable capbailities
+                      XrdAccCapability  *Z_List;  // Default  capbailities
+                      XrdAccAccess_ID   *SXList;  // 's' exclusive list
+                      XrdAccAccess_ID   *SYList;  // 's' inclusive list
+                      bool               hostRefX;// Resolve host for 'x' rules
+                      bool               hostRefY;// Resolve host for others
 
         XrdAccAccess_Tables() {G_Hash = 0; H_Hash = 0; N_Hash = 0;
                                O_Hash = 0; R_Hash = 0;
@@ -104,6 +107,7 @@ struct XrdAccAccess_Tables
                                D_List = 0; E_List = 0;
                                X_List = 0; Z_List = 0;
                                SXList = 0; SYList = 0;
+                               hostRefX = hostRefY = false;
                               }
        ~XrdAccAccess_Tables() {if (G_Hash) delete G_Hash;
                                if (H_Hash) delete H_Hash;
@@ -145,7 +149,8 @@ static
 const char       *Resolve(const XrdSecEntity *Entity);
 
 // SwapTabs() is used by the configuration object to establish new access
-// control tables. It may be called whenever the tables change.
+// control tables. It may be called whenever the tables change and returns
+// once the old tables are no longer in use and have been deleted.
 //
 void              SwapTabs(struct XrdAccAccess_Tables &newtab);
 
@@ -162,11 +167,26 @@ XrdAccPrivs Access(      XrdAccPrivCaps  &caps,
                    const char            *path,
                    const Access_Operation oper);
 
-struct XrdAccAccess_Tables Atab;
-bool   hostRefX; // True if we need to resolve hostname for exclusive rules
-bool   hostRefY; // True if we need to resolve hostname for any other rules
+XrdAccAccess_Tables *TabHold(int &rdrSlot);
+void                 TabDrop(int  rdrSlot)
+                            {Readers[rdrSlot].num.fetch_sub(1,
+                                              std::memory_order_release);
+                            }
+void                 TabWait(int  parity);
+
+// The tables in use are replaced as a whole and never changed, so lookups
+// take no lock. A reader counts itself in one of two sets of counters, chosen
+// by the low bit of the epoch, for as long as it uses the tables. Having
+// swapped in new tables, SwapTabs() flips the epoch and waits for each set in
+// turn to drain before deleting the old ones.
+//
+static const int rdrShards = 16;
+
+struct alignas(64) rdrCount {std::atomic<int> num{0};};
 
-XrdSysXSLock Access_Context;
+std::atomic<XrdAccAccess_Tables *> Atab;
+std::atomic<unsigned int>          Epoch;
+rdrCount                           Readers[2*rdrShards];
 
 XrdAccAudit *Auditor;
 };
@@ -0,0 +1,202 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d A c c C a p T r i e . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "XrdAcc/XrdAccCapability.hh"
+#include "XrdAcc/XrdAccCapTrie.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+struct capEnt
+      {const char     *path;
+       int             plen;
+       int             order;
+       XrdAccPrivCaps  priv;
+      };
+
+struct capJob
+      {int             node;
+       int             lo;
+       int             hi;
+       int             depth;
+      };
+
+bool capLess(const capEnt &a, const capEnt &b)
+{
+   int rc = memcmp(a.path, b.path, (a.plen < b.plen ? a.plen : b.plen));
+   if (rc) return rc < 0;
+   if (a.plen != b.plen) return a.plen < b.plen;
+   return a.order < b.order;
+}
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdAccCapTrie::XrdAccCapTrie(XrdAccCapability *caps)
+{
+   std::vector<XrdAccCapability *> todo;
+   std::vector<capEnt> ent;
+   std::vector<capJob> job;
+   std::vector<Node>   nvec;
+   XrdAccCapability *cp;
+   size_t lsz = 0;
+   int order = 0;
+
+// Flatten the list in the order its entries are tried, expanding templates.
+// A template is a list of its own and is tried in its entirety where it
+// appears, so we keep a stack of where to resume once it is done.
+//
+   cp = caps;
+   while(cp || !todo.empty())
+        {if (!cp) {cp = todo.back(); todo.pop_back(); continue;}
+         if (cp->ctmp) {todo.push_back(cp->next); cp = cp->ctmp; continue;}
+         ent.push_back({cp->path, cp->plen, order++, cp->priv});
+         lsz += cp->plen;
+         cp = cp->next;
+        }
+   entNum = ent.size();
+
+// Copy all the paths into one buffer that the trie labels refer to
+//
+   label = (char *)malloc(lsz ? lsz : 1);
+   lsz = 0;
+   for (auto &e : ent)
+       {memcpy(label+lsz, e.path, e.plen);
+        e.path = label+lsz;
+        lsz   += e.plen;
+       }
+
+// Sort the entries by path. Entries sharing a prefix are now adjacent, with
+// an entry ending at a given length before all those that extend it.
+//
+   std::sort(ent.begin(), ent.end(), capLess);
+
+// Build the trie from a stack of jobs. Each job finishes a node whose entries all
+// share the first depth bytes: the entries that end there decide its order
+// and the others are split by their next byte into its children. The label
+// of a child runs to the longest prefix its entries have in common, which no
+// entry ends within as it would then sort before the others.
+//
+   Node root = {0, 0, 0, 0, INT_MAX, XrdAccPrivCaps(), 0};
+   nvec.push_back(root);
+   job.push_back({0, 0, (int)ent.size(), 0});
+   while(!job.empty())
+        {capJob j = job.back(); job.pop_back();
+         int lo = j.lo, kids = nvec.size(), kNum = 0;
+
+         while(lo < j.hi && ent[lo].plen == j.depth)
+              {if (ent[lo].order < nvec[j.node].order)
+                  {nvec[j.node].order = ent[lo].order;
+                   nvec[j.node].priv  = ent[lo].priv;
+                  }
+               lo++;
+              }
+
+         for (int a = lo, b; a < j.hi; a = b)
+             {unsigned char c = ent[a].path[j.depth];
+              for (b = a+1; b < j.hi
+                   && (unsigned char)ent[b].path[j.depth] == c; b++) {}
+              const capEnt &e1 = ent[a], &e2 = ent[b-1];
+              int lcp = j.depth+1;
+              while(lcp < e1.plen && lcp < e2.plen
+                    && e1.path[lcp] == e2.path[lcp]) lcp++;
+              Node kid = {(int)(e1.path - label) + j.depth, lcp - j.depth,
+                          0, 0, nvec[j.node].order, nvec[j.node].priv, c};
+              nvec.push_back(kid);
+              job.push_back({kids + kNum, a, b, lcp});
+              kNum++;
+             }
+         nvec[j.node].kids = kids;
+         nvec[j.node].kNum = kNum;
+        }
+
+// Copy the nodes into their final resting place
+//
+   nodeNum = nvec.size();
+   node = new Node[nodeNum];
+   std::copy(nvec.begin(), nvec.end(), node);
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdAccCapTrie::~XrdAccCapTrie()
+{
+   delete [] node;
+   free(label);
+}
+
+/******************************************************************************/
+/*                                 P r i v s                                  */
+/******************************************************************************/
+
+int XrdAccCapTrie::Privs(XrdAccPrivCaps &pathpriv, const char *pathname,
+                         int pathlen) const
+{
+   const Node *np = node, *kp;
+   int pos = 0, lo, hi, mid;
+
+// Walk down the trie for as long as the path matches a whole label
+//
+   while(pos < pathlen && np->kNum)
+        {unsigned char c = pathname[pos];
+         lo = np->kids; hi = np->kids + np->kNum - 1; kp = 0;
+         while(lo <= hi)
+              {mid = (lo + hi) / 2;
+                    if (node[mid].first < c) lo = mid + 1;
+               else if (node[mid].first > c) hi = mid - 1;
+               else {kp = &node[mid]; break;}
+              }
+         if (!kp || kp->lLen > pathlen - pos
+         ||  memcmp(label + kp->lOff, pathname + pos, kp->lLen)) break;
+         pos += kp->lLen;
+         np   = kp;
+        }
+
+// The node reached knows which matching entry comes first, if any
+//
+   if (np->order == INT_MAX) return 0;
+   pathpriv.pprivs = (XrdAccPrivs)(pathpriv.pprivs | np->priv.pprivs);
+   pathpriv.nprivs = (XrdAccPrivs)(pathpriv.nprivs | np->priv.nprivs);
+   return 1;
+}
@@ -0,0 +1,86 @@
+#ifndef __ACC_CAPTRIE__
+#define __ACC_CAPTRIE__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d A c c C a p T r i e . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include "XrdAcc/XrdAccPrivs.hh"
+
+class XrdAccCapability;
+
+/******************************************************************************/
+/*                         X r d A c c C a p T r i e                          */
+/******************************************************************************/
+
+// XrdAccCapTrie is an immutable radix trie compiled from a capability list,
+// with the templates it refers to expanded in place. A list grants the
+// privileges of its first entry whose path is a prefix of the path being
+// checked. Each node of the trie records which of the entries ending at or
+// above it comes first, so a lookup walks down the trie along the path and
+// takes the answer from the deepest node reached. The time taken depends on
+// the length of the path and not on the number of entries in the list.
+
+class XrdAccCapTrie
+{
+public:
+
+// Privs() does what XrdAccCapability::Privs() does for a path without a
+// substitution: or's in the privileges of the first matching entry and
+// returns 1, or returns 0 if no entry matches.
+//
+int            Privs(XrdAccPrivCaps &pathpriv, const char *pathname,
+                     int pathlen) const;
+
+// Return the number of entries and of nodes in the trie.
+//
+int            Entries() const {return entNum;}
+int            Nodes()   const {return nodeNum;}
+
+               XrdAccCapTrie(XrdAccCapability *caps);
+              ~XrdAccCapTrie();
+
+private:
+
+struct Node
+      {int            lOff;   // Offset of the label leading to this node
+       int            lLen;   // Length of that label
+       int            kids;   // Index of the first child
+       int            kNum;   // Number of children, sorted by their first byte
+       int            order;  // Order of the first entry ending here or above
+       XrdAccPrivCaps priv;   // Privileges of that entry
+       unsigned char  first;  // First byte of the label
+      };
+
+Node          *node;
+char          *label;
+int            nodeNum;
+int            entNum;
+};
+#endif
@@ -29,6 +29,7 @@
 /******************************************************************************/
 
 #include "XrdAcc/XrdAccCapability.hh"
+#include "XrdAcc/XrdAccCapTrie.hh"
 
 /******************************************************************************/
 /*                   E x t e r n a l   R e f e r e n c e s                    */
@@ -46,7 +47,7 @@ XrdAccCapability::XrdAccCapability(char *pathval, XrdAccPrivCaps &privval)
 
 // Do common initialization
 //
-   next = 0; ctmp = 0;
+   next = 0; ctmp = 0; trie = 0;
    priv.pprivs = privval.pprivs; priv.nprivs = privval.nprivs;
    plen = strlen(pathval); pins = 0; prem = 0;
    pkey = XrdOucHashVal2((const char *)pathval, plen);
@@ -71,10 +72,22 @@ XrdAccCapability::~XrdAccCapability()
      XrdAccCapability *cp, *np = next;
 
      if (path) {free(path); path = 0;}
+     if (trie) {delete trie; trie = 0;}
 
      while(np) {cp = np; np = np->next; cp->next = 0; delete cp;}
      next = 0;
 }
+/******************************************************************************/
+/*                               C o m p i l e                                */
+/******************************************************************************/
+
+int XrdAccCapability::Compile()
+{
+   if (trie) delete trie;
+   trie = new XrdAccCapTrie(this);
+   return trie->Entries();
+}
+
 /******************************************************************************/
 /*                                 P r i v s                                  */
 /******************************************************************************/
@@ -87,6 +100,8 @@ int XrdAccCapability::Privs(      XrdAccPrivCaps &pathpriv,
 {XrdAccCapability *cp=this;
  const int psl = (pathsub ? strlen(pathsub) : 0);
 
+ if (trie && !pathsub) return trie->Privs(pathpriv, pathname, pathlen);
+
  do {if (cp->ctmp)
        {if (cp->ctmp->Privs(pathpriv,pathname,pathlen,pathhash,pathsub))
            return 1;
@@ -36,6 +36,8 @@
 
 #include "XrdAcc/XrdAccPrivs.hh"
 
+class XrdAccCapTrie;
+
 /******************************************************************************/
 /*                      X r d A c c C a p a b i l i t y                       */
 /******************************************************************************/
@@ -47,6 +49,12 @@ void                Add(XrdAccCapability *newcap) {next = newcap;}
 
 XrdAccCapability   *Next() {return next;}
 
+// Compile() builds a prefix trie from this list, which must be complete, and
+// uses it in Privs() when there is no substitution. It should be called on the
+// head of the list and returns the number of entries compiled.
+//
+int                 Compile();
+
 // Privs() searches the associated capability for a prefix matching path. If one
 // is found, the privileges are or'd into the passed XrdAccPrivCaps struct and
 // a 1 is returned. Otherwise, 0 is returned and XrdAccPrivCaps is unchanged.
@@ -79,14 +87,17 @@ int                 Subcomp(const char *pathname, const int pathlen,
                   XrdAccCapability(char *pathval, XrdAccPrivCaps &privval);
 
                   XrdAccCapability(XrdAccCapability *taddr)
-                        {next = 0; ctmp = taddr;
+                        {next = 0; ctmp = taddr; trie = 0;
                          pkey = 0; path = 0; plen = 0; pins = 0; prem = 0;
                         }
 
                  ~XrdAccCapability();
 private:
+friend class XrdAccCapTrie;
+
 XrdAccCapability *next;      // -> Next capability
 XrdAccCapability *ctmp;      // -> Capability template
+XrdAccCapTrie    *trie;      // -> Compiled list (list head only)
 
 /*----------- The below fields are valid when template is zero -----------*/
 
@@ -33,7 +33,7 @@
 #include <grp.h>
 #include <limits.h>
 
-#include "XrdOuc/XrdOucHash.hh"
+#include "XrdOuc/XrdOucFlatHash.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
 /******************************************************************************/
@@ -166,9 +166,9 @@ int         HaveNetGroups;
 XrdSysMutex  Group_Build_Context, Group_Name_Context;
 XrdSysMutex  Group_Cache_Context, NetGroup_Cache_Context;
 
-XrdOucHash<XrdAccGroupList> NetGroup_Cache;
-XrdOucHash<XrdAccGroupList>    Group_Cache;
-XrdOucHash<char>               Group_Names;
-XrdOucHash<char>            NetGroup_Names;
+XrdOucFlatHash<XrdAccGroupList> NetGroup_Cache;
+XrdOucFlatHash<XrdAccGroupList>    Group_Cache;
+XrdOucFlatHash<char>               Group_Names;
+XrdOucFlatHash<char>            NetGroup_Names;
 };
 #endif
@@ -90,6 +90,7 @@ namespace XrdCl
   const int DefaultNoTlsOK                 = 0;
   const int DefaultTlsNoData               = 0;
   const int DefaultTlsMetalink             = 0;
+  const int DefaultTlsReuse                = 1;
   const int DefaultZipMtlnCksum            = 0;
   const int DefaultIPNoShuffle             = 0;
   const int DefaultWantTlsOnNoPgrw         = 0;
@@ -158,6 +159,7 @@ namespace XrdCl
       { to_lower( "NoTlsOK" ),                 DefaultNoTlsOK },
       { to_lower( "TlsNoData" ),               DefaultTlsNoData },
       { to_lower( "TlsMetalink" ),             DefaultTlsMetalink },
+      { to_lower( "TlsReuse" ),                DefaultTlsReuse },
       { to_lower( "ZipMtlnCksum" ),            DefaultZipMtlnCksum },
       { to_lower( "IPNoShuffle" ),             DefaultIPNoShuffle },
       { to_lower( "WantTlsOnNoPgrw" ),         DefaultWantTlsOnNoPgrw },
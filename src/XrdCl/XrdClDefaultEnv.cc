@@ -299,6 +299,7 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "NoTlsOK",                 DefaultNoTlsOK                 );
     REGISTER_VAR_INT( varsInt, "TlsNoData",               DefaultTlsNoData               );
     REGISTER_VAR_INT( varsInt, "TlsMetalink",             DefaultTlsMetalink             );
+    REGISTER_VAR_INT( varsInt, "TlsReuse",                DefaultTlsReuse                );
     REGISTER_VAR_INT( varsInt, "ZipMtlnCksum",            DefaultZipMtlnCksum            );
     REGISTER_VAR_INT( varsInt, "IPNoShuffle",             DefaultIPNoShuffle             );
     REGISTER_VAR_INT( varsInt, "WantTlsOnNoPgrw",         DefaultWantTlsOnNoPgrw         );
@@ -135,6 +135,15 @@ namespace XrdCl
       return false;
     }
 
+    //--------------------------------------------------------------------------
+    // Remember sessions so that further connections to the same server can
+    // skip the full handshake
+    //--------------------------------------------------------------------------
+    int reuse = DefaultTlsReuse;
+    env->GetInt("TlsReuse", reuse);
+    if (reuse)
+      tlsContext->SessionCache(XrdTlsContext::scClnt);
+
     return true;
   }
 
@@ -165,6 +174,17 @@ namespace XrdCl
     const char *verhost = 0;
     if( thehost != "localhost" && thehost != "127.0.0.1" && thehost != "[::1]" )
       verhost = thehost.c_str();
+
+    //--------------------------------------------------------------------------
+    // Offer the last session with this server, this only has an effect before
+    // the hand-shake starts
+    //--------------------------------------------------------------------------
+    if( netInfo )
+    {
+      std::string peer = thehost + ":" + std::to_string( netInfo->Port() );
+      pTls->Resume( peer.c_str() );
+    }
+
     XrdTls::RC error = pTls->Connect( verhost, &errmsg );
     XRootDStatus status = ToStatus( error );
     if( !status.IsOK() )
@@ -1,6 +1,7 @@
 
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
 #include <ctime>
 
@@ -26,6 +27,10 @@ public:
     const std::string &GetSecName() const {return m_sec_name;}
     const std::string &GetErrorMessage() const {return m_emsg;}
 
+    // Returns true if one of the verifiers below accepts the caveat, which is
+    // how libmacaroons decides whether a caveat is satisfied.
+    bool Satisfies(const std::string &caveat);
+
     static int verify_before_s(void *authz_ptr,
                                const unsigned char *pred,
                                size_t pred_sz);
@@ -108,6 +113,43 @@ static XrdAccPrivs AddPriv(Access_Operation op, XrdAccPrivs privs)
 }
 
 
+// Accept the caveats that AuthzCheck knows how to evaluate, recording them so
+// they can be evaluated for each request without verifying the macaroon again.
+// Any other caveat fails verification, as it would for AuthzCheck.
+int record_caveat(void *caveats_ptr,
+                  const unsigned char *pred,
+                  size_t pred_sz)
+{
+    static const char *known[] = {"before:", "activity:", "path:", "name:"};
+    const char *pred_str = reinterpret_cast<const char *>(pred);
+
+    for (const char *prefix : known)
+    {
+        size_t len = strlen(prefix);
+        if ((pred_sz >= len) && !memcmp(pred_str, prefix, len))
+        {
+            static_cast<std::vector<std::string> *>(caveats_ptr)->emplace_back(pred_str, pred_sz);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+// Return the time named by a "before:" caveat or -1 if it is not one.
+time_t caveat_time(const std::string &caveat)
+{
+    struct tm caveat_tm;
+    if (strncmp("before:", caveat.c_str(), 7) ||
+        strptime(caveat.c_str() + 7, "%Y-%m-%dT%H:%M:%SZ", &caveat_tm) == nullptr)
+    {
+        return -1;
+    }
+    caveat_tm.tm_isdst = -1;
+    return timegm(&caveat_tm);
+}
+
+
 // Accept any value of the path, name, or activity caveats
 int validate_verify_empty(void *emsg_ptr,
                           const unsigned char *pred,
@@ -128,8 +170,16 @@ int validate_verify_empty(void *emsg_ptr,
 }
 
 
+struct Authz::Claims
+{
+    std::string id;
+    std::vector<std::string> caveats;
+};
+
+
 Authz::Authz(XrdSysLogger *log, char const *config, XrdAccAuthorize *chain)
-    : m_max_duration(86400),
+    : m_cache("plugin=\"macaroons\""),
+    m_max_duration(86400),
     m_chain(chain),
     m_log(log, "macarons_"),
     m_authz_behavior(static_cast<int>(Handler::AuthzBehavior::PASSTHROUGH))
@@ -188,84 +238,136 @@ Authz::Access(const XrdSecEntity *Entity, const char *path,
         return OnMissing(Entity, path, oper, env);
     }
 
+    // A client normally presents the same macaroon with every request. Its
+    // signature only needs to be verified once; the caveats still have to be
+    // evaluated against each request.
+    time_t now = time(NULL);
+    std::shared_ptr<Claims> claims = m_cache.Find(authz, now);
+    if (!claims)
+    {
+        VerifyResult result;
+        claims = Verify(authz, now, result);
+        switch (result) {
+            case VerifyResult::VALID:
+                break;
+            case VerifyResult::NOT_MACAROON:
+                return OnMissing(Entity, path, oper, env);
+            case VerifyResult::REJECTED:
+                return m_chain ? m_chain->Access(Entity, path, oper, env) : XrdAccPriv_None;
+            case VerifyResult::FAILED:
+                return XrdAccPriv_None;
+        }
+    }
+
+    if (!path)
+    {
+        m_log.Emsg("Access", "Request with no provided path.");
+        return XrdAccPriv_None;
+    }
+
+    AuthzCheck check_helper(path, oper, m_max_duration, m_log);
+
+    for (const auto &caveat : claims->caveats)
+    {
+        if (!check_helper.Satisfies(caveat))
+        {
+            m_log.Log(LogMask::Debug, "Access", "Macaroon verification failed");
+            return m_chain ? m_chain->Access(Entity, path, oper, env) : XrdAccPriv_None;
+        }
+    }
+
+    m_log.Log(LogMask::Info, "Access", "Macaroon verification successful; ID", claims->id.c_str());
+
+    // Copy the name, if present into the macaroon, into the credential object.
+    if (Entity && check_helper.GetSecName().size()) {
+        const std::string &username = check_helper.GetSecName();
+        m_log.Log(LogMask::Debug, "Access", "Setting the request name to", username.c_str());
+        Entity->eaAPI->Add("request.name", username,true);
+    }
+
+    // We passed verification - give the correct privilege.
+    return AddPriv(oper, XrdAccPriv_None);
+}
+
+
+std::shared_ptr<Authz::Claims>
+Authz::Verify(const char *authz, time_t now, VerifyResult &result)
+{
+    struct timespec vbeg, vend;
+    clock_gettime(CLOCK_MONOTONIC, &vbeg);
+
     macaroon_returncode mac_err = MACAROON_SUCCESS;
-    struct macaroon* macaroon = macaroon_deserialize(
-        authz,
-        &mac_err);
+    std::unique_ptr<struct macaroon, decltype(&macaroon_destroy)> macaroon(
+        macaroon_deserialize(authz, &mac_err),
+        &macaroon_destroy);
     if (!macaroon)
     {
         // Do not log - might be other token type!
         //m_log.Emsg("Access", "Failed to parse the macaroon");
-        return OnMissing(Entity, path, oper, env);
+        result = VerifyResult::NOT_MACAROON;
+        return nullptr;
     }
 
-    struct macaroon_verifier *verifier = macaroon_verifier_create();
+    // Anything that goes wrong from here on is an internal error.
+    result = VerifyResult::FAILED;
+
+    std::unique_ptr<struct macaroon_verifier, decltype(&macaroon_verifier_destroy)> verifier(
+        macaroon_verifier_create(), &macaroon_verifier_destroy);
     if (!verifier)
     {
         m_log.Emsg("Access", "Failed to create a new macaroon verifier");
-        return XrdAccPriv_None;
-    }
-    if (!path)
-    {
-        m_log.Emsg("Access", "Request with no provided path.");
-        macaroon_verifier_destroy(verifier);
-        return XrdAccPriv_None;
+        return nullptr;
     }
 
-    AuthzCheck check_helper(path, oper, m_max_duration, m_log);
-
-    if (macaroon_verifier_satisfy_general(verifier, AuthzCheck::verify_before_s, &check_helper, &mac_err) ||
-        macaroon_verifier_satisfy_general(verifier, AuthzCheck::verify_activity_s, &check_helper, &mac_err) ||
-        macaroon_verifier_satisfy_general(verifier, AuthzCheck::verify_name_s, &check_helper, &mac_err) ||
-        macaroon_verifier_satisfy_general(verifier, AuthzCheck::verify_path_s, &check_helper, &mac_err))
+    std::shared_ptr<Claims> claims(new Claims);
+    if (macaroon_verifier_satisfy_general(verifier.get(), record_caveat, &claims->caveats, &mac_err))
     {
         m_log.Emsg("Access", "Failed to configure caveat verifier:");
-        macaroon_verifier_destroy(verifier);
-        return XrdAccPriv_None;
+        return nullptr;
     }
 
     const unsigned char *macaroon_loc;
     size_t location_sz;
-    macaroon_location(macaroon, &macaroon_loc, &location_sz);
+    macaroon_location(macaroon.get(), &macaroon_loc, &location_sz);
     if (strncmp(reinterpret_cast<const char *>(macaroon_loc), m_location.c_str(), location_sz))
     {
         std::string location_str(reinterpret_cast<const char *>(macaroon_loc), location_sz);
         m_log.Emsg("Access", "Macaroon is for incorrect location", location_str.c_str());
-        macaroon_verifier_destroy(verifier);
-        macaroon_destroy(macaroon);
-        return m_chain ? m_chain->Access(Entity, path, oper, env) : XrdAccPriv_None;
+        result = VerifyResult::REJECTED;
+        return nullptr;
     }
 
-    if (macaroon_verify(verifier, macaroon,
+    if (macaroon_verify(verifier.get(), macaroon.get(),
                          reinterpret_cast<const unsigned char *>(m_secret.c_str()),
                          m_secret.size(),
                          NULL, 0, // discharge macaroons
                          &mac_err))
     {
         m_log.Log(LogMask::Debug, "Access", "Macaroon verification failed");
-        macaroon_verifier_destroy(verifier);
-        macaroon_destroy(macaroon);
-        return m_chain ? m_chain->Access(Entity, path, oper, env) : XrdAccPriv_None;
+        result = VerifyResult::REJECTED;
+        return nullptr;
     }
-    macaroon_verifier_destroy(verifier);
 
     const unsigned char *macaroon_id;
     size_t id_sz;
-    macaroon_identifier(macaroon, &macaroon_id, &id_sz);
-
-    std::string macaroon_id_str(reinterpret_cast<const char *>(macaroon_id), id_sz);
-    m_log.Log(LogMask::Info, "Access", "Macaroon verification successful; ID", macaroon_id_str.c_str());
-    macaroon_destroy(macaroon);
+    macaroon_identifier(macaroon.get(), &macaroon_id, &id_sz);
+    claims->id.assign(reinterpret_cast<const char *>(macaroon_id), id_sz);
 
-    // Copy the name, if present into the macaroon, into the credential object.
-    if (Entity && check_helper.GetSecName().size()) {
-        const std::string &username = check_helper.GetSecName();
-        m_log.Log(LogMask::Debug, "Access", "Setting the request name to", username.c_str());
-        Entity->eaAPI->Add("request.name", username,true);
+    // The macaroon is of no use past its earliest "before" caveat; one
+    // without any is kept no longer than the longest allowed duration.
+    time_t expiry = now + (m_max_duration > 0 ? m_max_duration : 86400);
+    for (const auto &caveat : claims->caveats)
+    {
+        time_t before = caveat_time(caveat);
+        if (before >= 0 && before < expiry) {expiry = before;}
     }
 
-    // We passed verification - give the correct privilege.
-    return AddPriv(oper, XrdAccPriv_None);
+    clock_gettime(CLOCK_MONOTONIC, &vend);
+    m_cache.Verified((vend.tv_sec - vbeg.tv_sec) * 1000000000LL
+                     + (vend.tv_nsec - vbeg.tv_nsec));
+    m_cache.Add(authz, claims, expiry);
+    result = VerifyResult::VALID;
+    return claims;
 }
 
 bool Authz::Validate(const char   *token,
@@ -340,6 +442,17 @@ bool Authz::Validate(const char   *token,
 }
 
 
+bool
+AuthzCheck::Satisfies(const std::string &caveat)
+{
+    const unsigned char *pred = reinterpret_cast<const unsigned char *>(caveat.c_str());
+    size_t pred_sz = caveat.size();
+
+    return !verify_before(pred, pred_sz) || !verify_activity(pred, pred_sz) ||
+           !verify_name(pred, pred_sz) || !verify_path(pred, pred_sz);
+}
+
+
 AuthzCheck::AuthzCheck(const char *req_path, const Access_Operation req_oper, ssize_t max_duration, XrdSysError &log)
       : m_max_duration(max_duration),
         m_log(log),
@@ -1,5 +1,6 @@
 
 #include "XrdAcc/XrdAccAuthorize.hh"
+#include "XrdSciTokens/XrdSciTokensCache.hh"
 #include "XrdSciTokens/XrdSciTokensHelper.hh"
 #include "XrdSys/XrdSysError.hh"
 
@@ -51,6 +52,21 @@ private:
                           const Access_Operation  oper,
                                 XrdOucEnv        *env);
 
+    // The identifier and caveats of a macaroon whose signature was verified.
+    struct Claims;
+
+    // What became of a token that had to be verified.
+    enum class VerifyResult {
+        VALID,
+        NOT_MACAROON,
+        REJECTED,
+        FAILED
+    };
+
+    std::shared_ptr<Claims> Verify(const char *authz, time_t now,
+                                   VerifyResult &result);
+
+    XrdSciTokensCache<Claims> m_cache;
     ssize_t m_max_duration;
     XrdAccAuthorize *m_chain;
     XrdSysError m_log;
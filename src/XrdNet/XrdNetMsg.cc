@@ -134,6 +134,48 @@ int XrdNetMsg::Send(const struct iovec iov[], int iovcnt,
    return Send(buff, (int)(bp-buff), dest, -1);
 }
   
+/******************************************************************************/
+
+int XrdNetMsg::Send(struct msghdr mVec[], int mNum)
+{
+   int i, retc;
+
+   if (!destOK)
+      {eDest->Emsg("Msg", "Destination not specified."); return -1;}
+
+   for (i = 0; i < mNum; i++)
+       {mVec[i].msg_name    = (void *)dfltDest.SockAddr();
+        mVec[i].msg_namelen = dfltDest.SockSize();
+       }
+
+#ifdef __linux__
+   static const int mMax = 64;
+   struct mmsghdr mmVec[mMax];
+   int n, numSent = 0;
+
+   while(numSent < mNum)
+        {n = (mNum - numSent > mMax ? mMax : mNum - numSent);
+         for (i = 0; i < n; i++)
+             {mmVec[i].msg_hdr = mVec[numSent+i]; mmVec[i].msg_len = 0;}
+         do {retc = sendmmsg(FD, mmVec, n, 0);}
+             while (retc < 0 && errno == EINTR);
+         if (retc <= 0)
+            {if (retc < 0) retErr(errno, &dfltDest);
+             return (numSent ? numSent : retc);
+            }
+         numSent += retc;
+        }
+   return numSent;
+#else
+   for (i = 0; i < mNum; i++)
+       {do {retc = sendmsg(FD, &mVec[i], 0);}
+           while (retc < 0 && errno == EINTR);
+        if (retc < 0) {retErr(errno, &dfltDest); return (i ? i : -1);}
+       }
+   return mNum;
+#endif
+}
+  
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
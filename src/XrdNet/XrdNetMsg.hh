@@ -109,6 +109,19 @@ int           Send(const struct  iovec iov[], // Remaining parms as above
                          int     iovcnt,      // Number of elements in iovec
                    const char   *dest=0,      // Hostname to send UDP datagram
                          int     tmo=-1);     // Timeout in ms (-1 = none)
+//------------------------------------------------------------------------------
+//! Send a batch of UDP messages to the default endpoint using as few system
+//! calls as possible (i.e. sendmmsg() where the platform supports it).
+//!
+//! @param  mVec     The messages to send. Only msg_iov and msg_iovlen need be
+//!                  set; the destination is filled in from the constructor.
+//! @param  mNum     The number of elements in mVec.
+//! @return <0       No message sent due to error.
+//! @return >=0      The number of leading messages in mVec that were sent.
+//------------------------------------------------------------------------------
+
+int           Send(struct msghdr mVec[], int mNum);
+
 //------------------------------------------------------------------------------
 //! Constructor
 //!
@@ -244,11 +244,8 @@ extern XrdOfsStats OfsStats;
 /*                        S t a t i c   O b j e c t s                         */
 /******************************************************************************/
   
-XrdSysMutex   XrdOfsHandle::myMutex;
-XrdOfsHanTab  XrdOfsHandle::roTable;
-XrdOfsHanTab  XrdOfsHandle::rwTable;
-XrdOssDF     *XrdOfsHandle::ossDF = (XrdOssDF *)new XrdOfsHanOss;
-XrdOfsHandle *XrdOfsHandle::Free = 0;
+XrdOfsHanShard XrdOfsHandle::hanShard[XrdOfsHandle::hanShards];
+XrdOssDF      *XrdOfsHandle::ossDF = (XrdOssDF *)new XrdOfsHanOss;
 
 /******************************************************************************/
 /*                    c l a s s   X r d O f s H a n d l e                     */
@@ -259,34 +256,34 @@ XrdOfsHandle *XrdOfsHandle::Free = 0;
   
 int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 {
-   XrdOfsHandle *hP;
-   XrdOfsHanTab *theTable = (Opts & opRW ? &rwTable : &roTable);
-   XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
-   int          retc;
-
-// Lock the search table and try to find the key. If found, increment the
-// the link count (can only be done with the global lock) then release the
-// lock and try to lock the handle. It can't escape between lock calls because
-// the link count is positive. If we can't lock the handle then it must be the
-// that a long running operation is occuring. Return the handle to its former
-// state and return a delay. Otherwise, return the handle.
-//
-   myMutex.Lock();
+   XrdOfsHandle   *hP;
+   XrdOfsHanKey    theKey(thePath, (int)strlen(thePath));
+   XrdOfsHanShard &hS = hanShard[theKey.Hash % hanShards];
+   XrdOfsHanTab   *theTable = (Opts & opRW ? &hS.rwTable : &hS.roTable);
+   int             retc;
+
+// Lock the shard and try to find the key. If found, increment the link count
+// then release the lock and try to lock the handle. It can't escape between
+// lock calls because the link count is positive. If we can't lock the handle
+// then it must be that a long running operation is occuring. Return the
+// handle to its former state and return a delay. Otherwise, return the handle.
+//
+   hS.hLock.Lock();
    if ((hP = theTable->Find(theKey)))
-      {hP->Path.Links++; myMutex.UnLock();
+      {hP->Links++; hS.hLock.UnLock();
        if (hP->WaitLock()) {*Handle = hP; return 0;}
-       myMutex.Lock(); hP->Path.Links--; myMutex.UnLock();
+       hP->Links--;
        return nolokDelay;
       }
 
 // Get a new handle
 //
-   if (!(retc = Alloc(theKey, Opts, Handle))) theTable->Add(*Handle);
+   if (!(retc = Alloc(hS, theKey, Opts, Handle))) theTable->Add(*Handle);
+   hS.hLock.UnLock();
    OfsStats.Add(OfsStats.Data.numHandles);
 
 // All done
 //
-   myMutex.UnLock();
    return retc;
 }
 
@@ -297,12 +294,13 @@ int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
 {
     XrdOfsHanKey myKey("dummy", 5);
+    XrdOfsHanShard &hS = hanShard[myKey.Hash % hanShards];
     int retc;
 
-    myMutex.Lock();
-    if (!(retc = Alloc(myKey, 0, Handle))) 
-       {(*Handle)->Path.Links = 0; (*Handle)->UnLock();}
-    myMutex.UnLock();
+    hS.hLock.Lock();
+    if (!(retc = Alloc(hS, myKey, 0, Handle)))
+       {(*Handle)->Links = 0; (*Handle)->UnLock();}
+    hS.hLock.UnLock();
     return retc;
 }
 
@@ -310,22 +308,27 @@ int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
 /* private                      A l l o c   # 3                               */
 /******************************************************************************/
   
-int XrdOfsHandle::Alloc(XrdOfsHanKey theKey, int Opts, XrdOfsHandle **Handle)
+// The shard must be locked upon entry.
+
+int XrdOfsHandle::Alloc(XrdOfsHanShard &hS, XrdOfsHanKey theKey, int Opts,
+                        XrdOfsHandle **Handle)
 {
    static const int minAlloc = 4096/sizeof(XrdOfsHandle);
    XrdOfsHandle *hP;
 
-// No handle currently in the table. Get a new one off the free list
+// No handle currently in the table. Get a new one off the shard's free list.
+// As a handle is returned to the shard of its path, each free list is only
+// replenished by opens that hash to that shard.
 //
-   if (!Free && (hP = new XrdOfsHandle[minAlloc]))
-      {int i = minAlloc; while(i--) {hP->Next = Free; Free = hP; hP++;}}
-   if ((hP = Free)) Free = hP->Next;
+   if (!hS.Free && (hP = new XrdOfsHandle[minAlloc]))
+      {int i = minAlloc; while(i--) {hP->Next = hS.Free; hS.Free = hP; hP++;}}
+   if ((hP = hS.Free)) hS.Free = hP->Next;
 
 // Initialize the new handle, if we have one, and add it to the table
 //
    if (hP)
       {hP->Path         = theKey;
-       hP->Path.Links   = 1;
+       hP->Links        = 1;
        hP->isChanged    = 0;                       // File changed
        hP->isCompressed = 0;                       // Compression
        hP->isPending    = 0;                       // Pending output
@@ -345,16 +348,17 @@ int XrdOfsHandle::Alloc(XrdOfsHanKey theKey, int Opts, XrdOfsHandle **Handle)
 
 void XrdOfsHandle::Hide(const char *thePath)
 {
-   XrdOfsHandle *hP;
-   XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
+   XrdOfsHandle   *hP;
+   XrdOfsHanKey    theKey(thePath, (int)strlen(thePath));
+   XrdOfsHanShard &hS = hanShard[theKey.Hash % hanShards];
 
 // Lock the search table and try to find the key in each table. If found,
 // clear the length field to effectively hide the item.
 //
-   myMutex.Lock();
-   if ((hP = roTable.Find(theKey))) hP->Path.Len = 0;
-   if ((hP = rwTable.Find(theKey))) hP->Path.Len = 0;
-   myMutex.UnLock();
+   hS.hLock.Lock();
+   if ((hP = hS.roTable.Find(theKey))) hP->Path.Len = 0;
+   if ((hP = hS.rwTable.Find(theKey))) hP->Path.Len = 0;
+   hS.hLock.UnLock();
 }
 
 /******************************************************************************/
@@ -373,7 +377,7 @@ int XrdOfsHandle::PoscGet(short &Mode, int Done)
        Mode = Posc->Mode;
        if (Done)
           {pP = Posc; Posc = 0;
-           if (pP->xprP) {myMutex.Lock(); Path.Links--; myMutex.UnLock();}
+           if (pP->xprP) Links--;
            pP->Recycle();
           }
        return pnum;
@@ -457,30 +461,45 @@ const char *XrdOfsHandle::PoscUsr()
 
 int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 {
+   XrdOfsHanShard &hS = Shard();
    XrdOssDF *mySSI;
    int numLeft;
 
-// Get the global lock as the links field can only be manipulated with it.
-// Decrement the links count and if zero, remove it from the table and
-// place it on the free list. Otherwise, it is still in use.
+// If this is not the last link simply drop it; no lock is needed for that.
 //
    retc = 0;
-   myMutex.Lock();
-   if (Path.Links == 1)
+   numLeft = Links;
+   while(numLeft > 1)
+        {if (Links.compare_exchange_weak(numLeft, numLeft-1))
+            {UnLock(); return numLeft-1;}
+        }
+
+// Lock the shard so that no one can find the handle while we look at the
+// links count again, as an open may have found it in the meantime and may
+// even be dropping its link concurrently. If this is the last link, remove
+// it from the table and place it on the free list. Otherwise, it is in use.
+//
+   hS.hLock.Lock();
+   numLeft = Links;
+   while(numLeft > 1)
+        {if (Links.compare_exchange_weak(numLeft, numLeft-1))
+            {UnLock(); hS.hLock.UnLock(); return numLeft-1;}
+        }
+   if (numLeft == 1)
       {if (buff) strlcpy(buff, Path.Val, blen);
        numLeft = 0; OfsStats.Dec(OfsStats.Data.numHandles);
-       if ( (isRW ? rwTable.Remove(this) : roTable.Remove(this)) )
+       if ( (isRW ? hS.rwTable.Remove(this) : hS.roTable.Remove(this)) )
          {if (Posc) {Posc->Recycle(); Posc = 0;}
           if (Path.Val) {free((void *)Path.Val); Path.Val = (char *)"";}
           Path.Len = 0; mySSI = ssi; ssi = ossDF;
-          Next = Free; Free = this; UnLock(); myMutex.UnLock();
+          Next = hS.Free; hS.Free = this; UnLock(); hS.hLock.UnLock();
           if (mySSI && mySSI != ossDF)
              {retc = mySSI->Close(retsz); delete mySSI;}
          } else {
-          UnLock(); myMutex.UnLock();
+          UnLock(); hS.hLock.UnLock();
           OfsEroute.Emsg("Retire", "Lost handle to", buff);
         }
-      } else {numLeft = --Path.Links; UnLock(); myMutex.UnLock();}
+      } else {numLeft = --Links; UnLock(); hS.hLock.UnLock();}
    return numLeft;
 }
 
@@ -495,14 +514,16 @@ int XrdOfsHandle::Retire(XrdOfsHanCB *cbP, int hTime)
 // The handle can only be held by one reference and only if it's a POSC and
 // deferred handling was properly set up.
 //
-   myMutex.Lock();
+   XrdOfsHanShard &hS = Shard();
+
+   hS.hLock.Lock();
    if (!Posc || !allOK)
       {OfsEroute.Emsg("Retire", "ignoring deferred retire of", Path.Val);
-       if (Path.Links != 1 || !Posc || !cbP) myMutex.UnLock();
-          else {myMutex.UnLock(); cbP->Retired(this);}
+       if (Links != 1 || !Posc || !cbP) hS.hLock.UnLock();
+          else {hS.hLock.UnLock(); cbP->Retired(this);}
        return Retire(retc);
       }
-   myMutex.UnLock();
+   hS.hLock.UnLock();
 
 // If this object already has an xpr object (happens for bouncing connections)
 // then reuse that object. Otherwise create a new one and put it on the queue.
@@ -554,16 +575,18 @@ do{xP = XrdOfsHanXpr::Get(); hP = xP->Handle;
             hP->UnLock(); delete xP; continue;
            }
 
-// As the handle is locked we can get the global handle lock to prevent
-// additions and removals of handles as we need a stable reference count to
-// effect the callout, if any. Do so only if the reference count is one (for us)
-// and the handle is active. In all cases, drop the global lock.
+// As the handle is locked we can lock its shard to prevent additions
+// and removals of handles as we need a stable reference count to effect the
+// callout, if any. Do so only if the reference count is one (for us) and the
+// handle is active. In all cases, drop the shard lock.
 //
-   myMutex.Lock();
-   if (hP->Path.Links != 1 || !xP->Call) myMutex.UnLock();
-      else {myMutex.UnLock();
+  {XrdOfsHanShard &hS = hP->Shard();
+   hS.hLock.Lock();
+   if (hP->Links != 1 || !xP->Call) hS.hLock.UnLock();
+      else {hS.hLock.UnLock();
             xP->Call->Retired(hP);
            }
+  }
 
 // We can now officially retire the handle and delete the xpr object
 //
@@ -34,6 +34,7 @@
    appropriate size (yes, that means dbx has a tough time).
 */
 
+#include <atomic>
 #include <cstdlib>
 
 #include "XrdOuc/XrdOucCRC.hh"
@@ -48,7 +49,6 @@ class XrdOfsHanKey
 public:
 
 const char          *Val;
-unsigned int         Links;
 unsigned int         Hash;
 short                Len;
 
@@ -69,7 +69,7 @@ inline int           operator!=(const XrdOfsHanKey &oth)
                                  }
 
                     XrdOfsHanKey(const char *key=0, int kln=0)
-                                : Val(key), Links(0), Len(kln)
+                                : Val(key), Len(kln)
                     {Hash = (key && kln ?
                           XrdOucCRC::CRC32((const unsigned char *)key,kln) : 0);
                     }
@@ -98,7 +98,7 @@ int            Remove(XrdOfsHandle *rip);
 // sure that the previous number is the correct Fibonocci antecedent. The
 // series is simply n[j] = n[j-1] + n[j-2].
 //
-    XrdOfsHanTab(int psize = 987, int size = 1597);
+    XrdOfsHanTab(int psize = 55, int size = 89);
    ~XrdOfsHanTab() {} // Never gets deleted
 
 private:
@@ -114,6 +114,27 @@ int              nashnum;
 int              Threshold;
 };
 
+/******************************************************************************/
+/*                  C l a s s   X r d O f s H a n S h a r d                   */
+/******************************************************************************/
+
+// Handles are spread over a number of shards by the hash of their path so that
+// opens and closes of unrelated files do not contend. Each shard has its own
+// tables, free list, and lock. The lock is needed to find, add, or remove a
+// handle and to decide that a link is the last one. Link counts are atomic so
+// that dropping any other link needs no lock at all.
+
+struct alignas(64) XrdOfsHanShard
+{
+XrdSysMutex   hLock;
+XrdOfsHanTab  roTable;    // File handles open r/o
+XrdOfsHanTab  rwTable;    // File Handles open r/w
+XrdOfsHandle *Free;       // List of free handles
+
+              XrdOfsHanShard() : Free(0) {}
+             ~XrdOfsHanShard() {} // Never gets deleted
+};
+
 /******************************************************************************/
 /*                    C l a s s   X r d O f s H a n d l e                     */
 /******************************************************************************/
@@ -164,17 +185,19 @@ static       int    StartXpr(int Init=0);         // Internal use only!
 
              void   Suppress(int rrc=-EDOM, int wrc=-EDOM); // Only for R/W!
 
-             int    Usage() {return Path.Links;}
+             int    Usage() {return Links;}
 
 inline       void   Lock()   {hMutex.Lock();}
 inline       void   UnLock() {hMutex.UnLock();}
 
-          XrdOfsHandle() : Path(0,0) {}
+          XrdOfsHandle() : Path(0,0), Links(0) {}
 
          ~XrdOfsHandle() {int retc; Retire(retc);}
 
 private:
-static int           Alloc(XrdOfsHanKey, int Opts, XrdOfsHandle **Handle);
+static int           Alloc(XrdOfsHanShard &hS, XrdOfsHanKey theKey, int Opts,
+                           XrdOfsHandle **Handle);
+inline XrdOfsHanShard &Shard() {return hanShard[Path.Hash % hanShards];}
        int           WaitLock(void);
 
 static const int     LockTries =   3; // Times to try for a lock
@@ -182,16 +205,16 @@ static const int     LockWait  = 333; // Mills to wait between tries
 static const int     nolokDelay=   3; // Secs to delay client when lock failed
 static const int     nomemDelay=  15; // Secs to delay client when ENOMEM
 
-static XrdSysMutex   myMutex;
-static XrdOfsHanTab  roTable;    // File handles open r/o
-static XrdOfsHanTab  rwTable;    // File Handles open r/w
+static const int     hanShards = 64;
+
+static XrdOfsHanShard hanShard[hanShards];
 static XrdOssDF     *ossDF;      // Dummy storage sysem
-static XrdOfsHandle *Free;       // List of free handles
 
        XrdSysMutex   hMutex;
        XrdOssDF     *ssi;        // Storage System Interface
        XrdOfsHandle *Next;
        XrdOfsHanKey  Path;       // Path for this handle
+std::atomic<int>     Links;      // Number of references to this handle
        XrdOfsHanPsc *Posc;       // -> Info for posc-type files
 };
   
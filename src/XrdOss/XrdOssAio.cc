@@ -44,6 +44,7 @@
 #endif
 
 #include "XrdOss/XrdOssApi.hh"
+#include "XrdOss/XrdOssDio.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
@@ -158,13 +159,20 @@ int XrdOssFile::Read(XrdSfsAio *aiop)
    EPNAME("AioRead");
    int rc;
 
-// Complete the aio request block and do the operation
+// Complete the aio request block and do the operation. Direct I/O files can
+// only be read asynchronously when the request is suitably aligned, which is
+// the case for requests using the protocol's aio buffers; otherwise the read
+// is done synchronously through the bounce buffer.
 //
-   if (XrdOssSys::AioAllOk)
-      {aiop->sfsAio.aio_fildes = fd;
+   if (XrdOssSys::AioAllOk
+   &&  (dioFD < 0 || XrdOssDio::Aligned((void *)aiop->sfsAio.aio_buf,
+                                        (off_t)aiop->sfsAio.aio_offset,
+                                        (size_t)aiop->sfsAio.aio_nbytes)))
+      {int rdFD = (dioFD >= 0 ? dioFD : fd);
+       aiop->sfsAio.aio_fildes = rdFD;
        aiop->sfsAio.aio_sigevent.sigev_signo  = OSS_AIO_READ_DONE;
        aiop->TIdent = tident;
-       TRACE(Debug,  "fd=" <<fd <<" read " <<aiop->sfsAio.aio_nbytes <<'@'
+       TRACE(Debug,  "fd=" <<rdFD <<" read " <<aiop->sfsAio.aio_nbytes <<'@'
                            <<aiop->sfsAio.aio_offset <<" started; aiocb="
                            <<Xrd::hex1 <<aiop);
 
@@ -37,6 +37,7 @@
 #include <signal.h>
 #include <strings.h>
 #include <cstdio>
+#include <ctime>
 #include <sys/file.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -51,8 +52,11 @@
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssCache.hh"
 #include "XrdOss/XrdOssConfig.hh"
+#include "XrdOss/XrdOssDio.hh"
+#include "XrdOss/XrdOssDirStat.hh"
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
+#include "XrdOss/XrdOssStatCache.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
@@ -284,7 +288,9 @@ int XrdOssSys::Chmod(const char *path, mode_t mode, XrdOucEnv *envP)
 
 // Change the file only in the local filesystem.
 //
-   return (chmod(local_path, mode) ? -errno : XrdOssOK);
+   if (chmod(local_path, mode)) return -errno;
+   Uncache(local_path);
+   return XrdOssOK;
 }
 
 /******************************************************************************/
@@ -322,7 +328,7 @@ int XrdOssSys::Mkdir(const char *path, mode_t mode, int mkpath, XrdOucEnv *envP)
 
 // Create the directory or full path only in the loal file system
 //
-   if (!mkdir(local_path, mode))  return XrdOssOK;
+   if (!mkdir(local_path, mode))  {Uncache(local_path, true); return XrdOssOK;}
    if (mkpath && errno == ENOENT){return Mkpath(local_path, mode);}
    if (errno != EEXIST)           return -errno;
 
@@ -369,13 +375,15 @@ int XrdOssSys::Mkpath(const char *path, mode_t mode)
    next_path = local_path;
    while((next_path = index(next_path+1, int('/'))))
         {*next_path = '\0';
-         if (mkdir(local_path, mode) && errno != EEXIST) return -errno;
+         if (!mkdir(local_path, mode)) Uncache(local_path, true);
+            else if (errno != EEXIST) return -errno;
          *next_path = '/';
         }
 
 // Create last component and return
 //
-   if (mkdir(local_path, mode) && errno != EEXIST) return -errno;
+   if (!mkdir(local_path, mode)) Uncache(local_path, true);
+      else if (errno != EEXIST) return -errno;
    return XrdOssOK;
 }
   
@@ -403,7 +411,8 @@ int XrdOssSys::Stats(char *buff, int blen)
 
 // If only size wanted, return what size we need
 //
-   if (!buff) return statflen + getStats(0,0);
+   if (!buff) return statflen + getStats(0,0)
+                   + (StatCache ? StatCache->Stats(0,0) : 0);
 
 // Make sure we have enough space
 //
@@ -416,6 +425,13 @@ int XrdOssSys::Stats(char *buff, int blen)
    n = getStats(bp, blen);
    bp += n; blen -= n;
 
+// Generate stat cache statistics
+//
+   if (StatCache)
+      {n = StatCache->Stats(bp, blen);
+       bp += n; blen -= n;
+      }
+
 // Add trailer
 //
    if (blen >= (int)sizeof(statfmt2))
@@ -472,6 +488,7 @@ int XrdOssSys::Truncate(const char *path, unsigned long long size,
 // Change the file only in the local filesystem and make space adjustemt
 //
    if (truncate(local_path, size)) return -errno;
+   Uncache(local_path);
    XrdOssCache::Adjust(local_path,static_cast<long long>(size)-oldsz,&statbuff);
    return XrdOssOK;
 }
@@ -583,6 +600,7 @@ int XrdOssDir::Opendir(const char *dir_path, XrdOucEnv &Env)
 int XrdOssDir::Readdir(char *buff, int blen)
 {
    struct dirent *rp;
+   int rc;
 
 // Check if this object is actually open
 //
@@ -591,12 +609,13 @@ int XrdOssDir::Readdir(char *buff, int blen)
 // Perform local reads if this is a local directory
 //
    if (lclfd)
-      {errno = 0;
+      {if (dsP && Stat) return dsP->Next(buff, blen, Stat);
+       errno = 0;
        while((rp = readdir(lclfd)))
             {strlcpy(buff, rp->d_name, blen);
 #ifdef HAVE_FSTATAT
-             if (Stat && fstatat(fd, rp->d_name, Stat, 0))
-                {if (errno != ENOENT) return -errno;
+             if (Stat && (rc = XrdOssDirStat::StatAt(fd, rp->d_name, Stat)))
+                {if (rc != ENOENT) return -rc;
                  errno = 0;
                  continue;
                 }
@@ -651,6 +670,11 @@ int XrdOssDir::StatRet(struct stat *buff)
    return -ENOTSUP;
 #endif
 
+// Read ahead and stat entries in batches if so configured
+//
+   if (buff && XrdOssDirStat::BatchSize && !dsP)
+      dsP = new XrdOssDirStat(lclfd);
+
 // All is well
 //
    Stat = buff;
@@ -682,6 +706,7 @@ int XrdOssDir::Close(long long *retsz)
 
 // Close whichever handle is open
 //
+    if (dsP) {delete dsP; dsP = 0;}
     if (lclfd)
        {if (!(retc = closedir(lclfd)))
            {lclfd = 0;
@@ -766,7 +791,10 @@ int XrdOssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
        if (!retc && !(buf.st_mode & S_IFREG))
           {close(fd); fd = (buf.st_mode & S_IFDIR ? -EISDIR : -ENOTBLK);}
        if (Oflag & (O_WRONLY | O_RDWR))
-          {FSize = buf.st_size; cacheP = XrdOssCache::Find(local_path);}
+          {FSize = buf.st_size; cacheP = XrdOssCache::Find(local_path);
+           if (cacheP && fd >= 0 && XrdOssCache::LoadAware)
+              cacheP->fsdata->wrActive++;
+          }
           else {if (buf.st_mode & XRDSFS_POSCPEND && fd >= 0)
                    {close(fd); fd=-ETXTBSY;}
                 FSize = -1; cacheP = 0;
@@ -794,6 +822,27 @@ int XrdOssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
        if (mopts) mmFile = XrdOssMio::Map(local_path, fd, mopts);
       } else mmFile = 0;
 
+// Files opened for writing are kept out of the stat cache until closed, as
+// every write may change them. The open itself may have created the file, so
+// drop its parent directories as well.
+//
+   if (fd >= 0 && XrdOssSS->StatCache && popts & XRDEXP_STATCACHE
+   &&  (Oflag & (O_WRONLY | O_RDWR)))
+      {scPath = strdup(local_path);
+       XrdOssSS->StatCache->Pin(scPath);
+       if (Oflag & O_CREAT) XrdOssSS->Uncache(scPath, true);
+      }
+
+// Files in a directio export that are opened for reading get a second file
+// descriptor that bypasses the page cache and is used for all reads. Should
+// the filesystem not support direct I/O we silently use buffered reads.
+//
+   if (fd >= 0 && popts & XRDEXP_DIRECTIO && !mmFile && !cxobj
+   &&  !(Oflag & (O_WRONLY | O_RDWR)))
+      {int dfd = XrdOssDio::Open(local_path);
+       dioFD = (dfd >= 0 ? dfd : -1);
+      }
+
 // Return the result of this open
 //
    return (fd < 0 ? fd : XrdOssOK);
@@ -820,7 +869,10 @@ int XrdOssFile::Close(long long *retsz)
         if (cacheP && FSize != buf.st_size)
            XrdOssCache::Adjust(cacheP, buf.st_size - FSize);
         if (retsz) *retsz = buf.st_size;
+        if (cacheP && XrdOssCache::LoadAware) cacheP->fsdata->wrActive--;
        }
+    if (dioFD >= 0) {close(dioFD); dioFD = -1;}
+    if (scPath) {XrdOssSS->StatCache->UnPin(scPath); free(scPath); scPath=0;}
     if (close(fd)) return -errno;
     if (mmFile) {XrdOssMio::Recycle(mmFile); mmFile = 0;}
 #ifdef XRDOSSCX
@@ -849,7 +901,7 @@ ssize_t XrdOssFile::Read(off_t offset, size_t blen)
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
 #if defined(__linux__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))
-     posix_fadvise(fd, offset, blen, POSIX_FADV_WILLNEED);
+     if (dioFD < 0) posix_fadvise(fd, offset, blen, POSIX_FADV_WILLNEED);
 #endif
 
      return 0;  // We haven't implemented this yet!
@@ -878,6 +930,8 @@ ssize_t XrdOssFile::Read(void *buff, off_t offset, size_t blen)
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+     if (dioFD >= 0) return XrdOssDio::Read(dioFD, buff, offset, blen);
+
 #ifdef XRDOSSCX
      if (cxobj)  
         if (XrdOssSS->DirFlags & XrdOssNOSSDEC) return (ssize_t)-XRDOSS_E8021;
@@ -912,6 +966,19 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
    ssize_t rdsz, totBytes = 0;
    int i;
 
+// Direct reads bypass the page cache so there is nothing to pre-advise
+//
+   if (dioFD >= 0)
+      {for (i = 0; i < n; i++)
+           {rdsz = XrdOssDio::Read(dioFD, readV[i].data, readV[i].offset,
+                                          readV[i].size);
+            if (rdsz < 0 || rdsz != readV[i].size)
+               return (rdsz < 0 ? rdsz : -ESPIPE);
+            totBytes += rdsz;
+           }
+       return totBytes;
+      }
+
 // For platforms that support fadvise, pre-advise what we will be reading
 //
 #if (defined(__linux__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))) && defined(HAVE_ATOMICS)
@@ -994,6 +1061,8 @@ ssize_t XrdOssFile::ReadRaw(void *buff, off_t offset, size_t blen)
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+     if (dioFD >= 0) return XrdOssDio::Read(dioFD, buff, offset, blen);
+
 #ifdef XRDOSSCX
      if (cxobj)   retval = cxobj->ReadRaw((char *)buff, blen, offset);
         else 
@@ -1021,6 +1090,8 @@ ssize_t XrdOssFile::ReadRaw(void *buff, off_t offset, size_t blen)
 
 ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
 {
+     XrdOssCache_FSData *fsdP;
+     struct timespec tBeg, tEnd;
      ssize_t retval;
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
@@ -1028,9 +1099,20 @@ ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
      if (XrdOssSS->MaxSize && (long long)(offset+blen) > XrdOssSS->MaxSize)
         return (ssize_t)-XRDOSS_E8007;
 
+// When placement follows the write load we time writes to cache space files
+//
+     fsdP = (cacheP && XrdOssCache::LoadAware ? cacheP->fsdata : 0);
+     if (fsdP) clock_gettime(CLOCK_MONOTONIC, &tBeg);
+
      do { retval = pwrite(fd, buff, blen, offset); }
           while(retval < 0 && errno == EINTR);
 
+     if (fsdP && retval > 0)
+        {clock_gettime(CLOCK_MONOTONIC, &tEnd);
+         fsdP->NoteWrite(retval, (tEnd.tv_sec  - tBeg.tv_sec) * 1000000000LL
+                                + tEnd.tv_nsec - tBeg.tv_nsec);
+        }
+
      if (retval < 0) retval = (retval == EBADF && cxobj ? -XRDOSS_E8022 : -errno);
      return retval;
 }
@@ -48,6 +48,8 @@
 /*                              o o s s _ D i r                               */
 /******************************************************************************/
 
+class XrdOssDirStat;
+
 class XrdOssDir : public XrdOssDF
 {
 public:
@@ -60,7 +62,7 @@ int     getFD() {return fd;}
         // Constructor and destructor
         XrdOssDir(const char *tid, DIR *dP=0)
                  : XrdOssDF(tid, DF_isDir),
-                   lclfd(dP), mssfd(0), Stat(0), ateof(false),
+                   lclfd(dP), mssfd(0), Stat(0), dsP(0), ateof(false),
                    isopen(dP != 0), dOpts(0) {if (dP) fd = dirfd(dP);}
 
        ~XrdOssDir() {if (isopen) Close();}
@@ -68,6 +70,7 @@ private:
          DIR       *lclfd;
          void      *mssfd;
 struct   stat      *Stat;
+XrdOssDirStat      *dsP;
          bool       ateof;
          bool       isopen;
 unsigned char       dOpts;
@@ -102,7 +105,7 @@ int     Fstat(struct stat *);
 int     Fsync();
 int     Fsync(XrdSfsAio *aiop);
 int     Ftruncate(unsigned long long);
-int     getFD() {return fd;}
+int     getFD() {return (dioFD >= 0 ? -1 : fd);}
 off_t   getMmap(void **addr);
 int     isCompressed(char *cxidp=0);
 ssize_t Read(               off_t, size_t);
@@ -116,8 +119,8 @@ int     Write(XrdSfsAio *aiop);
         // Constructor and destructor
         XrdOssFile(const char *tid, int fdnum=-1)
                   : XrdOssDF(tid, DF_isFile, fdnum),
-                    cxobj(0), cacheP(0), mmFile(0),
-                    rawio(0), cxpgsz(0) {cxid[0] = '\0';}
+                    cxobj(0), cacheP(0), mmFile(0), scPath(0),
+                    dioFD(-1), rawio(0), cxpgsz(0) {cxid[0] = '\0';}
 
 virtual ~XrdOssFile() {if (fd >= 0) Close();}
 
@@ -129,6 +132,8 @@ oocx_CXFile    *cxobj;
 XrdOssCache_FS *cacheP;
 XrdOssMioFile  *mmFile;
 long long       FSize;
+char           *scPath;
+int             dioFD;
 int             rawio;
 int             cxpgsz;
 char            cxid[4];
@@ -147,6 +152,7 @@ class XrdOucName2Name;
 class XrdOucProg;
 class XrdOssSpace;
 class XrdOssStage_Req;
+class XrdOssStatCache;
 
 struct XrdVersionInfo;
 
@@ -193,6 +199,7 @@ int       StatVS(XrdOssVSInfo *sP, const char *sname=0, int updt=0);
 int       StatXA(const char *path, char *buff, int &blen, XrdOucEnv *Env=0);
 int       StatXP(const char *path, unsigned long long &attr, XrdOucEnv *Env=0);
 int       Truncate(const char *, unsigned long long Size, XrdOucEnv *eP=0);
+void      Uncache(const char *lclPath, bool parents=false);
 int       Unlink(const char *, int Opts=0, XrdOucEnv *eP=0);
 
 int       Stats(char *bp, int bl);
@@ -279,6 +286,14 @@ int               prActive;  //    preread activity count
 short             prDepth;   //    preread depth
 short             prQSize;   //    preread maximum allowed
 
+XrdOssStatCache  *StatCache; // -> Stat cache or nil if none
+int               scMaxEnt;  //    Stat cache maximum entries
+int               scTTL;     //    Stat cache entry lifetime in ms
+int               scNTTL;    //    Stat cache ENOENT entry lifetime in ms
+int               dsThreads; //    Directory stat helper threads
+int               dsBatch;   //    Directory entries read ahead and stat'ed
+bool              dsNoSync;  //    Directory stats may use cached attributes
+
 XrdVersionInfo   *myVersion; //    Compilation version set by constructor
    
          XrdOssSys();
@@ -290,6 +305,7 @@ protected:
 long long minalloc;          //    Minimum allocation
 int       ovhalloc;          //    Allocation overage
 int       fuzalloc;          //    Allocation fuzz
+bool      loadalloc;         //    Allocation follows the write load
 int       cscanint;          //    Seconds between cache scans
 int       xfrspeed;          //    Average transfer speed (bytes/second)
 int       xfrovhd;           //    Minimum seconds to get a file
@@ -350,6 +366,7 @@ int    xalloc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcache(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcachescan(XrdOucStream &Config, XrdSysError &Eroute);
 int    xdefault(XrdOucStream &Config, XrdSysError &Eroute);
+int    xdirst(XrdOucStream &Config, XrdSysError &Eroute);
 int    xfdlimit(XrdOucStream &Config, XrdSysError &Eroute);
 int    xmaxsz(XrdOucStream &Config, XrdSysError &Eroute);
 int    xmemf(XrdOucStream &Config, XrdSysError &Eroute);
@@ -361,6 +378,7 @@ int    xspace(XrdOucStream &Config, XrdSysError &Eroute,
               const char *grp, bool isAsgn);
 int    xspaceBuild(OssSpaceConfig &sInfo, XrdSysError &Eroute);
 int    xstg(XrdOucStream &Config, XrdSysError &Eroute);
+int    xstatc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xstl(XrdOucStream &Config, XrdSysError &Eroute);
 int    xusage(XrdOucStream &Config, XrdSysError &Eroute);
 int    xtrace(XrdOucStream &Config, XrdSysError &Eroute);
@@ -77,6 +77,7 @@ XrdOssCache_FS     *XrdOssCache::fsfirst = 0;
 XrdOssCache_FS     *XrdOssCache::fslast  = 0;
 XrdOssCache_FSData *XrdOssCache::fsdata  = 0;
 double              XrdOssCache::fuzAlloc= 0.0;
+bool                XrdOssCache::LoadAware=false;
 long long           XrdOssCache::minAlloc= 0;
 int                 XrdOssCache::fsCount = 0;
 int                 XrdOssCache::ovhAlloc= 0;
@@ -121,6 +122,10 @@ XrdOssCache_FSData::XrdOssCache_FSData(const char *fsp,
      updt = time(0);
      next = 0;
      stat = 0;
+     wrActive = 0;
+     alSecond = 0;
+     alCount  = 0;
+     wrCost   = 0;
 
 // This is created only for new partitions!
 //
@@ -137,6 +142,49 @@ XrdOssCache_FSData::XrdOssCache_FSData(const char *fsp,
         }
 }
   
+/******************************************************************************/
+/*         X r d O s s C a c h e _ F S D a t a : : N o t e A l l o c          */
+/******************************************************************************/
+
+void XrdOssCache_FSData::NoteAlloc(int now)
+{
+   int then = alSecond.load(std::memory_order_relaxed);
+
+// Start a new count when the second has changed. Racing threads may lose a
+// count at the boundary, which is of no consequence.
+//
+   if (then != now && alSecond.compare_exchange_strong(then, now))
+      alCount.store(1, std::memory_order_relaxed);
+      else alCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/******************************************************************************/
+/*         X r d O s s C a c h e _ F S D a t a : : N o t e W r i t e          */
+/******************************************************************************/
+
+// The cost of a write is its time per MB divided by the number of files being
+// written at the time, an estimate of what the device takes for one writer.
+// Small writes mostly measure the system call and are not counted. The
+// average weighs each new sample by 1/8.
+
+void XrdOssCache_FSData::NoteWrite(size_t bytes, long long nsec)
+{
+   static const size_t minBytes = 64*1024;
+   long long cost, newCost, curCost;
+   int writers;
+
+   if (bytes < minBytes) return;
+   writers = wrActive.load(std::memory_order_relaxed);
+   cost = nsec * (1024*1024) / static_cast<long long>(bytes);
+   if (writers > 1) cost /= writers;
+
+   curCost = wrCost.load(std::memory_order_relaxed);
+   do {newCost = (curCost ? curCost + (cost - curCost)/8 : cost);
+       if (newCost < 1) newCost = 1;
+      } while(!wrCost.compare_exchange_weak(curCost, newCost,
+                                            std::memory_order_relaxed));
+}
+
 /******************************************************************************/
 /*            X r d O s s C a c h e _ F S   C o n s t r u c t o r             */
 /******************************************************************************/
@@ -394,6 +442,9 @@ int  XrdOssCache_FS::getSpace(XrdOssCache_Space &Space, XrdOssCache_Group *fsg,
 /*                                A d j u s t                                 */
 /******************************************************************************/
   
+// The filesystem list is fixed after configuration and the values adjusted
+// are atomic, so no lock is needed (the usage file has its own).
+
 void  XrdOssCache::Adjust(dev_t devid, off_t size)
 {
    EPNAME("Adjust")
@@ -406,11 +457,10 @@ void  XrdOssCache::Adjust(dev_t devid, off_t size)
 
 // Adjust file system free space
 //
-   Mutex.Lock();
    if (fsdp) 
       {DEBUG("free=" <<fsdp->frsz <<'-' <<size <<" path=" <<fsdp->path);
-       if ((fsdp->frsz  -= size) < 0) fsdp->frsz = 0;
-       fsdp->stat |= XrdOssFSData_ADJUSTED;
+       fsdp->AddFree(-size);
+       fsdp->stat.fetch_or(XrdOssFSData_ADJUSTED, std::memory_order_relaxed);
       } else {
        DEBUG("dev " <<devid <<" not found.");
       }
@@ -420,14 +470,9 @@ void  XrdOssCache::Adjust(dev_t devid, off_t size)
    if (XrdOssCache_Group::PubGroup)
       {DEBUG("usage=" <<XrdOssCache_Group::PubGroup->Usage <<'+' <<size 
              <<" space=" <<XrdOssCache_Group::PubGroup->group);
-       if ((XrdOssCache_Group::PubGroup->Usage += size) < 0)
-          XrdOssCache_Group::PubGroup->Usage = 0;
+       XrdOssCache_Group::PubGroup->AddUsage(size);
        if (Usage) XrdOssSpace::Adjust(XrdOssCache_Group::PubGroup->GRPid, size);
       }
-
-// All done
-//
-   Mutex.UnLock();
 }
 
 /******************************************************************************/
@@ -476,12 +521,10 @@ void XrdOssCache::Adjust(XrdOssCache_FS *fsp, off_t size)
       {fsdp = fsp->fsdata;
        DEBUG("used=" <<fsp->fsgroup->Usage <<'+' <<size <<" path=" <<fsp->path);
        DEBUG("free=" <<fsdp->frsz <<'-' <<size <<" path=" <<fsdp->path);
-       Mutex.Lock();
-       if ((fsp->fsgroup->Usage += size) < 0) fsp->fsgroup->Usage = 0;
-       if (        (fsdp->frsz  -= size) < 0) fsdp->frsz = 0;
-       fsdp->stat |= XrdOssFSData_ADJUSTED;
+       fsp->fsgroup->AddUsage(size);
+       fsdp->AddFree(-size);
+       fsdp->stat.fetch_or(XrdOssFSData_ADJUSTED, std::memory_order_relaxed);
        if (Usage) XrdOssSpace::Adjust(fsp->fsgroup->GRPid, size);
-       Mutex.UnLock();
       }
 }
 
@@ -489,16 +532,19 @@ void XrdOssCache::Adjust(XrdOssCache_FS *fsp, off_t size)
 /*                                 A l l o c                                  */
 /******************************************************************************/
 
+// Selection takes no lock. The filesystem ring is fixed after configuration
+// and free space is read and reserved atomically, so concurrent allocations
+// may see slightly different values but never lose an update.
+
 int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
 {
    EPNAME("Alloc");
    static const mode_t theMode = S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH;
-   XrdSysMutexHelper myMutex(&Mutex);
-   double diffree;
    XrdOssPath::fnInfo Info;
-   XrdOssCache_FS *fsp, *fspend, *fsp_sel;
+   XrdOssCache_FSData *fsdp;
+   XrdOssCache_FS *fsp_sel;
    XrdOssCache_Group *cgp = 0;
-   long long size, maxfree, curfree;
+   long long size;
    int rc, madeDir, datfd = 0;
 
 // Compute appropriate allocation size
@@ -513,33 +559,22 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
    while(cgp && strcmp(aInfo.cgName, cgp->group)) cgp = cgp->next;
    if (!cgp) return -ENOENT;
 
-// Find a cache that will fit this allocation request. We start with the next
-// entry past the last one we selected and go full round looking for a
-// compatable entry (enough space and in the right space group).
+// Find a cache that will fit this allocation request
 //
-   fsp_sel = 0; maxfree = 0;
-   fsp = cgp->curr->next; fspend = fsp; // End when we hit the start again
-   do {
-       if (strcmp(aInfo.cgName, fsp->group)
-       || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
-                        ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))) continue;
-       curfree = fsp->fsdata->frsz;
-       if (size > curfree) continue;
-
-             if (fuzAlloc > 0.999) {fsp_sel = fsp; break;}
-       else  if (!fuzAlloc || !fsp_sel)
-                {if (curfree > maxfree) {fsp_sel = fsp; maxfree = curfree;}}
-       else {diffree = (!(curfree + maxfree) ? 0.0
-                     : static_cast<double>(XRDABS(maxfree - curfree)) /
-                       static_cast<double>(       maxfree + curfree));
-             if (diffree > fuzAlloc) {fsp_sel = fsp; maxfree = curfree;}
-            }
-      } while((fsp = fsp->next) != fspend);
+   fsp_sel = (LoadAware ? SelectLoad(cgp, aInfo, size)
+                        : Select    (cgp, aInfo, size));
 
 // Check if we can realy fit this file. If so, update current scan pointer
+// and temporarily adjust down the free space right away so that concurrent
+// allocations see it. The space is given back should we fail.
 //
    if (!fsp_sel) return -ENOSPC;
-   cgp->curr = fsp_sel;
+   cgp->curr.store(fsp_sel, std::memory_order_relaxed);
+   fsdp = fsp_sel->fsdata;
+   if (LoadAware) fsdp->NoteAlloc(static_cast<int>(time(0)));
+   DEBUG("free=" <<fsdp->frsz <<'-' <<size <<" path=" <<fsdp->path);
+   fsdp->AddFree(-size);
+   fsdp->stat.fetch_or(XrdOssFSData_REFRESH, std::memory_order_relaxed);
 
 // Construct the target filename
 //
@@ -551,7 +586,7 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
 
 // Verify that target name was constructed
 //
-   if (!(*aInfo.cgPFbf)) return -ENAMETOOLONG;
+   if (!(*aInfo.cgPFbf)) {fsdp->AddFree(size); return -ENAMETOOLONG;}
 
 // Simply open the file in the local filesystem, creating it if need be.
 //
@@ -563,15 +598,15 @@ int XrdOssCache::Alloc(XrdOssCache::allocInfo &aInfo)
            *Info.Slash='\0'; rc=mkdir(aInfo.cgPFbf,theMode); *Info.Slash='/';
            madeDir = 1;
           } while(!rc);
-       if (datfd < 0) return (errno ? -errno : -EFAULT);
+       if (datfd < 0)
+          {rc = (errno ? -errno : -EFAULT);
+           fsdp->AddFree(size);
+           return rc;
+          }
       }
 
-// All done (temporarily adjust down the free space)x
+// All done
 //
-   DEBUG("free=" <<fsp_sel->fsdata->frsz <<'-' <<size <<" path=" 
-                 <<fsp_sel->fsdata->path);
-   fsp_sel->fsdata->frsz -= size;
-   fsp_sel->fsdata->stat |= XrdOssFSData_REFRESH;
    aInfo.cgFSp  = fsp_sel;
    return datfd;
 }
@@ -665,13 +700,14 @@ int XrdOssCache::Init(const char *UPath, const char *Qfile, int isSOL, int us)
 
 /******************************************************************************/
 
-int XrdOssCache::Init(long long aMin, int ovhd, int aFuzz)
+int XrdOssCache::Init(long long aMin, int ovhd, int aFuzz, bool aLoad)
 {
 // Set values
 //
    minAlloc = aMin;
    ovhAlloc = ovhd;
    fuzAlloc = static_cast<double>(aFuzz)/100.0;
+   LoadAware= aLoad;
    return 0;
 }
 
@@ -836,6 +872,102 @@ char *XrdOssCache::Parse(const char *token, char *cbuff, int cblen)
    return Path;
 }
 
+/******************************************************************************/
+/* Private:                       S e l e c t                                 */
+/******************************************************************************/
+
+// Select a filesystem by free space. We start with the next entry past the
+// last one we selected and go full round looking for a compatable entry
+// (enough space and in the right space group).
+
+XrdOssCache_FS *XrdOssCache::Select(XrdOssCache_Group *cgp, allocInfo &aInfo,
+                                    long long size)
+{
+   XrdOssCache_FS *fsp, *fspend, *fsp_sel = 0;
+   long long maxfree = 0, curfree;
+   double diffree;
+
+   fsp = cgp->curr.load(std::memory_order_relaxed)->next;
+   fspend = fsp; // End when we hit the start again
+   do {
+       if (strcmp(aInfo.cgName, fsp->group)
+       || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
+                        ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))) continue;
+       curfree = fsp->fsdata->frsz.load(std::memory_order_relaxed);
+       if (size > curfree) continue;
+
+             if (fuzAlloc > 0.999) {fsp_sel = fsp; break;}
+       else  if (!fuzAlloc || !fsp_sel)
+                {if (curfree > maxfree) {fsp_sel = fsp; maxfree = curfree;}}
+       else {diffree = (!(curfree + maxfree) ? 0.0
+                     : static_cast<double>(XRDABS(maxfree - curfree)) /
+                       static_cast<double>(       maxfree + curfree));
+             if (diffree > fuzAlloc) {fsp_sel = fsp; maxfree = curfree;}
+            }
+      } while((fsp = fsp->next) != fspend);
+
+   return fsp_sel;
+}
+
+/******************************************************************************/
+/* Private:                   S e l e c t L o a d                             */
+/******************************************************************************/
+
+// Select the compatable filesystem where a new file is expected to be written
+// fastest. That is the number of files being written, plus those allocated in
+// the last second that may not be open yet, plus the new one, times what the
+// device takes per MB for one writer. Devices not yet measured are assumed to
+// be as fast as the fastest one measured. Loads that differ by no more than
+// the fuzz are taken as equal and then the most free space wins.
+
+XrdOssCache_FS *XrdOssCache::SelectLoad(XrdOssCache_Group *cgp,
+                                        allocInfo &aInfo, long long size)
+{
+   XrdOssCache_FS *fsp, *fspend, *fsp_sel = 0;
+   XrdOssCache_FSData *fsdp;
+   long long curfree, maxfree = 0, cost, minCost = 0;
+   double curLoad, minLoad = 0.0, diff;
+   int now = static_cast<int>(time(0));
+
+// Skip incompatible filesystems and find the lowest measured cost
+//
+   fsp = cgp->curr.load(std::memory_order_relaxed)->next;
+   fspend = fsp;
+   do {
+       if (strcmp(aInfo.cgName, fsp->group)
+       || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
+                        ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))) continue;
+       if ((cost = fsp->fsdata->wrCost.load(std::memory_order_relaxed))
+       &&  (!minCost || cost < minCost)) minCost = cost;
+      } while((fsp = fsp->next) != fspend);
+   if (!minCost) minCost = 1;
+
+// Now pick the least loaded filesystem with enough space
+//
+   do {
+       if (strcmp(aInfo.cgName, fsp->group)
+       || (aInfo.cgPath && (aInfo.cgPlen > fsp->plen
+                        ||  strncmp(aInfo.cgPath,fsp->path,aInfo.cgPlen)))) continue;
+       fsdp = fsp->fsdata;
+       curfree = fsdp->frsz.load(std::memory_order_relaxed);
+       if (size > curfree) continue;
+
+       if (!(cost = fsdp->wrCost.load(std::memory_order_relaxed))) cost = minCost;
+       curLoad = static_cast<double>(cost)
+               * (fsdp->wrActive.load(std::memory_order_relaxed)
+                  + fsdp->Recent(now) + 1);
+
+       if (fsp_sel)
+          {diff = (curLoad - minLoad) / (curLoad + minLoad);
+           if (diff > fuzAlloc || (diff >= -fuzAlloc && curfree <= maxfree))
+              continue;
+          }
+       fsp_sel = fsp; maxfree = curfree; minLoad = curLoad;
+      } while((fsp = fsp->next) != fspend);
+
+   return fsp_sel;
+}
+
 /******************************************************************************/
 /*                                  S c a n                                   */
 /******************************************************************************/
@@ -846,8 +978,10 @@ void *XrdOssCache::Scan(int cscanint)
    XrdOssCache_FSData *fsdp;
    XrdOssCache_Group  *fsgp;
    const struct timespec naptime = {cscanint, 0};
+   const int scanFlags = XrdOssFSData_REFRESH | XrdOssFSData_ADJUSTED;
    long long frsz, llT; // llT is a dummy temporary
-   int retc, dbgMsg, dbgNoMsg, dbgDoMsg;
+   long long totFree, maxFree, maxSize;
+   int fsFlags, dbgMsg, dbgNoMsg, dbgDoMsg;
 
 // Try to prevent floodingthe log with scan messages
 //
@@ -862,41 +996,42 @@ void *XrdOssCache::Scan(int cscanint)
          dbgDoMsg = !dbgNoMsg--;
          if (dbgDoMsg) dbgNoMsg = dbgMsg;
 
-        // Get the cache context lock
-        //
-           Mutex.Lock();
-
         // Scan through all filesystems skip filesystem that have been
-        // recently adjusted to avoid fs statstics latency problems.
+        // recently adjusted to avoid fs statstics latency problems. This is
+        // done without a lock so that allocations proceed while we wait for
+        // the filesystems to respond. The flags are cleared before asking so
+        // that an allocation made meanwhile asks for another refresh.
         //
-           fsSize =  0;
-           fsTotFr=  0;
-           fsFree =  0;
+           totFree = maxFree = maxSize = 0;
            fsdp = fsdata;
            while(fsdp)
-                {retc = 0;
-                 if ((fsdp->stat & XrdOssFSData_REFRESH)
-                 || !(fsdp->stat & XrdOssFSData_ADJUSTED) || cscanint <= 0)
-                     {frsz = XrdOssCache_FS::freeSpace(llT,fsdp->path);
-                      if (frsz < 0) OssEroute.Emsg("CacheScan", errno ,
+                {fsFlags = fsdp->stat.load(std::memory_order_relaxed);
+                 if ((fsFlags & XrdOssFSData_REFRESH)
+                 || !(fsFlags & XrdOssFSData_ADJUSTED) || cscanint <= 0)
+                     {fsdp->stat.fetch_and(~scanFlags);
+                      frsz = XrdOssCache_FS::freeSpace(llT,fsdp->path);
+                      if (frsz < 0)
+                         {OssEroute.Emsg("CacheScan", errno ,
                                     "state file system ",(char *)fsdp->path);
+                          fsdp->stat.fetch_or(fsFlags & scanFlags);
+                         }
                          else {fsdp->frsz = frsz;
-                               fsdp->stat &= ~(XrdOssFSData_REFRESH |
-                                               XrdOssFSData_ADJUSTED);
                                if (dbgDoMsg)
-                                  {DEBUG("New free=" <<fsdp->frsz <<" path=" <<fsdp->path);}
+                                  {DEBUG("New free=" <<frsz <<" path=" <<fsdp->path);}
                                }
-                     } else fsdp->stat |= XrdOssFSData_REFRESH;
-                 if (!retc)
-                    {if (fsdp->frsz > fsFree)
-                        {fsFree = fsdp->frsz; fsSize = fsdp->size;}
-                     fsTotFr += fsdp->frsz;
-                    }
+                     } else fsdp->stat.fetch_or(XrdOssFSData_REFRESH);
+                 frsz = fsdp->frsz.load(std::memory_order_relaxed);
+                 if (frsz > maxFree) {maxFree = frsz; maxSize = fsdp->size;}
+                 totFree += frsz;
                  fsdp = fsdp->next;
                 }
 
-        // Unlock the cache and if we have quotas check them out
+        // Publish the totals and if we have quotas check them out
         //
+           Mutex.Lock();
+           fsSize  = maxSize;
+           fsTotFr = totFree;
+           fsFree  = maxFree;
            Mutex.UnLock();
            if (cscanint <= 0) return (void *)0;
            if (Quotas) XrdOssSpace::Quotas();
@@ -904,12 +1039,10 @@ void *XrdOssCache::Scan(int cscanint)
         // Update usage information if we are keeping track of it
            if (Usage && XrdOssSpace::Readjust())
               {fsgp = XrdOssCache_Group::fsgroups;
-               Mutex.Lock();
                while(fsgp)
                     {fsgp->Usage = XrdOssSpace::Usage(fsgp->GRPid);
                      fsgp = fsgp->next;
                     }
-               Mutex.UnLock();
               }
         }
 
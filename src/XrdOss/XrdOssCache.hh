@@ -30,6 +30,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <ctime>
 #include <sys/stat.h>
 #include "XrdOuc/XrdOucDLlist.hh"
@@ -103,21 +104,51 @@ long long          Quota;
 #define XrdOssFSData_ADJUSTED 0x0002
 #define XrdOssFSData_REFRESH  0x0004
 
+// The free space, flags, and write load are updated without a lock as files
+// are allocated, written, and closed. Everything else is set during
+// configuration. The write load is only tracked for load-aware placement.
+//
 class XrdOssCache_FSData
 {
 public:
 
 XrdOssCache_FSData *next;
 long long           size;
-long long           frsz;
+std::atomic<long long> frsz;
 dev_t               fsid;
 const char         *path;
 const char         *pact;
 const char         *devN;
 time_t              updt;
-int                 stat;
+std::atomic<int>    stat;
 unsigned short      bdevID;
 unsigned short      partID;
+std::atomic<int>    wrActive; // Files open for writing
+std::atomic<int>    alSecond; // Second of the most recent allocations
+std::atomic<int>    alCount;  // Allocations made in that second
+std::atomic<long long> wrCost; // Nanoseconds per MB for one writer, 0 unknown
+
+// Add delta to the free space, which never goes below zero.
+//
+inline void         AddFree(long long delta)
+                           {long long cur = frsz.load(std::memory_order_relaxed);
+                            while(!frsz.compare_exchange_weak(cur,
+                                  (cur + delta < 0 ? 0 : cur + delta),
+                                  std::memory_order_relaxed)) {}
+                           }
+
+// Record an allocation and return the number made in the current second.
+//
+void                NoteAlloc(int now);
+int                 Recent(int now)
+                          {return (alSecond.load(std::memory_order_relaxed)
+                                   == now ? alCount.load(std::memory_order_relaxed)
+                                          : 0);
+                          }
+
+// Record the time taken by a write to fold into the average cost.
+//
+void                NoteWrite(size_t bytes, long long nsec);
 
        XrdOssCache_FSData(const char *, STATFS_t &, dev_t);
       ~XrdOssCache_FSData() {if (path) free((void *)path);}
@@ -185,9 +216,9 @@ public:
 
 XrdOssCache_Group   *next;
 char                *group;
-XrdOssCache_FS      *curr;
+std::atomic<XrdOssCache_FS *> curr; // Last filesystem selected
 XrdOssCache_FSAP    *fsVec; // Partitions where space may be allocated
-long long            Usage;
+std::atomic<long long> Usage;
 long long            Quota;
 int                  GRPid;
 short                fsNum;
@@ -198,6 +229,15 @@ static long long     PubQuota;
 
 static XrdOssCache_Group *fsgroups;
 
+// Add delta to the usage, which never goes below zero.
+//
+inline void          AddUsage(long long delta)
+                             {long long cur = Usage.load(std::memory_order_relaxed);
+                              while(!Usage.compare_exchange_weak(cur,
+                                    (cur + delta < 0 ? 0 : cur + delta),
+                                    std::memory_order_relaxed)) {}
+                             }
+
        XrdOssCache_Group(const char *grp, XrdOssCache_FS *fsp=0) 
                         : next(0), group(strdup(grp)), curr(fsp), fsVec(0),
                           Usage(0), Quota(-1), GRPid(-1), fsNum(0), rsvd(0)
@@ -239,6 +279,11 @@ struct allocInfo
 
 static int             Alloc(allocInfo &aInfo);
 
+// When true, Alloc() places files on the filesystem with the lowest expected
+// write load rather than by free space alone (see SelectLoad()).
+//
+static bool            LoadAware;
+
 static void            DevInfo(struct stat &buf, bool limits=false);
 
 static XrdOssCache_FS *Find(const char *Path, int lklen=0);
@@ -246,7 +291,8 @@ static XrdOssCache_FS *Find(const char *Path, int lklen=0);
 static int             Init(const char *UDir, const char *Qfile,
                             int isSOL, int usync=0);
 
-static int             Init(long long aMin, int ovhd, int aFuzz);
+static int             Init(long long aMin, int ovhd, int aFuzz,
+                            bool aLoad=false);
 
 static void            List(const char *lname, XrdSysError &Eroute);
 
@@ -259,7 +305,7 @@ static void           *Scan(int cscanint);
                        XrdOssCache() {}
                       ~XrdOssCache() {}
 
-static XrdSysMutex         Mutex;    // Cache context lock
+static XrdSysMutex         Mutex;    // Serializes the totals below
 
 static long long           fsTotal;  // Total number of bytes known
 static long long           fsLarge;  // Total number of bytes in largest fspart
@@ -273,6 +319,10 @@ static int                 fsCount;  // Number of file systems
 
 private:
 static bool MapDM(const char *ldm, char *buff, int blen);
+static XrdOssCache_FS *Select(XrdOssCache_Group *cgp, allocInfo &aInfo,
+                              long long size);
+static XrdOssCache_FS *SelectLoad(XrdOssCache_Group *cgp, allocInfo &aInfo,
+                                  long long size);
 
 static long long           minAlloc;
 static double              fuzAlloc;
@@ -48,10 +48,12 @@
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssCache.hh"
 #include "XrdOss/XrdOssConfig.hh"
+#include "XrdOss/XrdOssDirStat.hh"
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
 #include "XrdOss/XrdOssOpaque.hh"
 #include "XrdOss/XrdOssSpace.hh"
+#include "XrdOss/XrdOssStatCache.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdOuc/XrdOuca2x.hh"
 #include "XrdOuc/XrdOucEnv.hh"
@@ -187,6 +189,7 @@ XrdOssSys::XrdOssSys()
    minalloc      = 0;
    ovhalloc      = 0;
    fuzalloc      = 0;
+   loadalloc     = false;
    xfrspeed      = 9*1024*1024;
    xfrovhd       = 30;
    xfrhold       =  3*60*60;
@@ -221,6 +224,13 @@ XrdOssSys::XrdOssSys()
    STT_DoN2N     = 1;
    STT_V2        = 0;
    STT_DoARE     = 0;
+   StatCache     = 0;
+   scMaxEnt      = 0;
+   scTTL         = XrdOssStatCache::defTTL;
+   scNTTL        = XrdOssStatCache::defNTTL;
+   dsThreads     = -1;
+   dsBatch       = XrdOssDirStat::defBatch;
+   dsNoSync      = false;
 }
   
 /******************************************************************************/
@@ -312,7 +322,7 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
    if (m1 || m2) Eroute.Say("++++++ Configuring ", m1, m2, "mode . . .");
   }
    NoGo |= XrdOssCache::Init(UDir, QFile, Solitary, USync)
-          |XrdOssCache::Init(minalloc, ovhalloc, fuzalloc);
+          |XrdOssCache::Init(minalloc, ovhalloc, fuzalloc, loadalloc);
 
 // Configure the MSS interface including staging
 //
@@ -338,6 +348,23 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
 //
    ConfigSpace(Eroute);
 
+// Create the stat cache if any path wants it
+//
+  {unsigned long long allFlags = DirFlags;
+   XrdOucPList *fp = RPList.First();
+   while(fp) {allFlags |= fp->Flag(); fp = fp->Next();}
+   if (allFlags & XRDEXP_STATCACHE)
+      {if (!scMaxEnt) scMaxEnt = XrdOssStatCache::defMax;
+       StatCache = new XrdOssStatCache(scMaxEnt, scTTL, scNTTL);
+      } else if (scMaxEnt)
+                Eroute.Say("Config warning: statcache ignored; no path has "
+                           "the statcache option.");
+  }
+
+// Start the helpers that stat directory entries in parallel
+//
+   dsThreads = XrdOssDirStat::Start(dsThreads, dsBatch, dsNoSync);
+
 // Set the prefix for files in cache file systems  
    if ( OptFlags & XrdOss_CacheFS ) 
        if (!NoGo) {
@@ -412,7 +439,7 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
         else cloc = ConfigFN;
 
      snprintf(buff, sizeof(buff), "Config effective %s oss configuration:\n"
-                                  "       oss.alloc        %lld %d %d\n"
+                                  "       oss.alloc        %lld %d %d%s\n"
                                   "       oss.spacescan    %d\n"
                                   "       oss.fdlimit      %d %d\n"
                                   "       oss.maxsize      %lld\n"
@@ -425,7 +452,7 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
                                   "       oss.trace        %x\n"
                                   "       oss.xfr          %d deny %d keep %d",
              cloc,
-             minalloc, ovhalloc, fuzalloc,
+             minalloc, ovhalloc, fuzalloc, (loadalloc ? " load" : ""),
              cscanint,
              FDFence, FDLimit, MaxSize,
              XrdOssConfig_Val(N2N_Lib,    namelib),
@@ -442,6 +469,16 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
 
      XrdOssMio::Display(Eroute);
 
+     snprintf(buff, sizeof(buff), "       oss.dirstat      threads %d batch %d%s",
+              dsThreads, dsBatch, (dsNoSync ? " nosync" : ""));
+     Eroute.Say(buff);
+
+     if (StatCache)
+        {snprintf(buff, sizeof(buff), "       oss.statcache    entries %d "
+                  "ttl %d nttl %d", scMaxEnt, scTTL, scNTTL);
+         Eroute.Say(buff);
+        }
+
      XrdOssCache::List("       oss.", Eroute);
            List_Path("       oss.defaults ", "", DirFlags, Eroute);
      fp = RPList.First();
@@ -1051,6 +1088,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    TS_Xeq("cachescan",     xcachescan); // Backward compatibility
    TS_Xeq("spacescan",     xcachescan);
    TS_Xeq("defaults",      xdefault);
+   TS_Xeq("dirstat",       xdirst);
    TS_Xeq("fdlimit",       xfdlimit);
    TS_Xeq("maxsize",       xmaxsz);
    TS_Xeq("memfile",       xmemf);
@@ -1059,6 +1097,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    TS_Xeq("preread",       xprerd);
    TS_Xeq("space",         xspace);
    TS_Xeq("stagecmd",      xstg);
+   TS_Xeq("statcache",     xstatc);
    TS_Xeq("statlib",       xstl);
    TS_Xeq("trace",         xtrace);
    TS_Xeq("usage",         xusage);
@@ -1120,7 +1159,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
 
 /* Function: aalloc
 
-   Purpose:  To parse the directive: alloc <min> [<headroom> [<fuzz>]]
+   Purpose:  To parse the directive: alloc <min> [<headroom> [<fuzz>]] [load]
 
              <min>       minimum amount of free space needed in a partition.
                          (asterisk uses default).
@@ -1130,6 +1169,10 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
                          quantities that may be ignored when selecting a space
                            0 - reduces to finding the largest free space
                          100 - reduces to simple round-robin allocation
+             load        select the space where a new file is expected to be
+                         written fastest given the files being written to it
+                         and its measured write speed; the fuzz then applies
+                         to the expected load and free space breaks ties.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -1140,25 +1183,34 @@ int XrdOssSys::xalloc(XrdOucStream &Config, XrdSysError &Eroute)
     long long mina = 0;
     int       fuzz = 0;
     int       hdrm = 0;
+    bool      load = false;
 
     if (!(val = Config.GetWord()))
        {Eroute.Emsg("Config", "alloc minfree not specified"); return 1;}
     if (strcmp(val, "*") &&
         XrdOuca2x::a2sz(Eroute, "alloc minfree", val, &mina, 0)) return 1;
 
-    if ((val = Config.GetWord()))
+    if ((val = Config.GetWord()) && strcmp(val, "load"))
        {if (strcmp(val, "*") &&
             XrdOuca2x::a2i(Eroute,"alloc headroom",val,&hdrm,0,100)) return 1;
 
-        if ((val = Config.GetWord()))
+        if ((val = Config.GetWord()) && strcmp(val, "load"))
            {if (strcmp(val, "*") &&
             XrdOuca2x::a2i(Eroute, "alloc fuzz", val, &fuzz, 0, 100)) return 1;
+            val = Config.GetWord();
            }
        }
 
+    if (val)
+       {if (strcmp(val, "load"))
+           {Eroute.Emsg("Config", "invalid alloc option -", val); return 1;}
+        load = true;
+       }
+
     minalloc = mina;
     ovhalloc = hdrm;
     fuzalloc = fuzz;
+    loadalloc= load;
     return 0;
 }
 
@@ -1238,6 +1290,61 @@ int XrdOssSys::xdefault(XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
   
+/******************************************************************************/
+/*                                x d i r s t                                 */
+/******************************************************************************/
+
+/* Function: xdirst
+
+   Purpose:  To parse the directive: dirstat [threads <n>] [batch <b>]
+                                             [nosync | sync]
+
+             <n>      the number of threads that help stat directory entries
+                      when a listing wants stat information. The default is
+                      one less than the number of cpus, up to 4. Zero has the
+                      listing thread do all of the stat calls.
+             <b>      the number of entries read and stat'ed at a time. The
+                      default is 256. Zero reads and stats one entry at a time.
+             nosync   allows network filesystems to return cached attributes
+                      for directory entries instead of asking the server.
+             sync     always obtains current attributes (the default).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xdirst(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    int num;
+
+    while((val = Config.GetWord()))
+         {     if (!strcmp(val, "threads"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config","dirstat threads not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute, "dirstat threads", val,
+                                      &num, 0, 64)) return 1;
+                   dsThreads = num;
+                  }
+          else if (!strcmp(val, "batch"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config","dirstat batch not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute, "dirstat batch", val,
+                                      &num, 0, 16384)) return 1;
+                   dsBatch = num;
+                  }
+          else if (!strcmp(val, "nosync")) dsNoSync = true;
+          else if (!strcmp(val, "sync"))   dsNoSync = false;
+          else {Eroute.Emsg("Config", "invalid dirstat option -", val);
+                return 1;
+               }
+         }
+    return 0;
+}
+  
 /******************************************************************************/
 /*                              x f d l i m i t                               */
 /******************************************************************************/
@@ -1804,6 +1911,62 @@ int XrdOssSys::xstg(XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
 
+/******************************************************************************/
+/*                                x s t a t c                                 */
+/******************************************************************************/
+
+/* Function: xstatc
+
+   Purpose:  To parse the directive: statcache [entries <n>] [ttl <ms>]
+                                               [nttl <ms>]
+
+             <n>      the maximum number of entries to keep. The default is
+                      65536.
+             ttl      how long a successful stat() result is used. The default
+                      is 5000 milliseconds.
+             nttl     how long a file not found result is used. The default
+                      is 1000 milliseconds.
+
+   Notes: The cache only applies to paths that have the statcache option.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xstatc(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    int num, maxEnt = XrdOssStatCache::defMax;
+
+    while((val = Config.GetWord()))
+         {     if (!strcmp(val, "entries"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config","statcache entries not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute, "statcache entries", val,
+                                      &maxEnt, 64, 16*1024*1024)) return 1;
+                  }
+          else if (!strcmp(val, "ttl") || !strcmp(val, "nttl"))
+                  {bool isNeg = (*val == 'n');
+                   if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config", "statcache", (isNeg ? "nttl"
+                                   : "ttl"), "value not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute, "statcache ttl", val, &num,
+                                      1, 3600*1000)) return 1;
+                   if (isNeg) scNTTL = num;
+                      else    scTTL  = num;
+                  }
+          else {Eroute.Emsg("Config", "invalid statcache option -", val);
+                return 1;
+               }
+         }
+
+    scMaxEnt = maxEnt;
+    return 0;
+}
+
 /******************************************************************************/
 /*                                  x s t l                                   */
 /******************************************************************************/
@@ -2097,6 +2260,8 @@ void XrdOssSys::List_Path(const char *pfx, const char *pname,
      if (flags & XRDEXP_INPLACE) ss += " inplace";
      if (flags & XRDEXP_LOCAL)   ss += " local";
      if (flags & XRDEXP_GLBLRO)  ss += " globalro";
+     if (flags & XRDEXP_DIRECTIO) ss += " directio";
+     if (flags & XRDEXP_STATCACHE) ss += " statcache";
 
      if (!(flags & XRDEXP_PFCACHE))
         {if (flags & XRDEXP_PFCACHE_X) ss += " nocache";
@@ -167,6 +167,7 @@ int XrdOssSys::Create(const char *tident, const char *path, mode_t access_mode,
                         XrdOssCache::Adjust(local_path, -theSize, &buf);
                        }
           }
+       Uncache(local_path);
        return 0;
       }
 
@@ -214,6 +215,10 @@ int XrdOssSys::Create(const char *tident, const char *path, mode_t access_mode,
        if (plP) plP->Set(plP->Flag() | XRDEXP_NOXATTR);
       }
 
+// A new name may have been added along with its directories
+//
+   if (retc == XrdOssOK) Uncache(local_path, true);
+
 // All done.
 //
    return retc;
@@ -0,0 +1,181 @@
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d O s s D i o . c c                           */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "XrdOss/XrdOssDio.hh"
+#include "XrdSys/XrdSysMetrics.hh"
+
+/******************************************************************************/
+/*                        L o c a l   O b j e c t s                           */
+/******************************************************************************/
+
+namespace
+{
+XrdSysMetrics::Counter dioDirect("xrootd_oss_directio_bytes_total",
+                                 "Bytes read using direct I/O.",
+                                 "mode=\"direct\"");
+
+XrdSysMetrics::Counter dioBounce("xrootd_oss_directio_bytes_total",
+                                 "Bytes read using direct I/O.",
+                                 "mode=\"bounce\"");
+
+// Each thread gets its own bounce buffer on first use; it is freed when the
+// thread exits.
+//
+struct BounceBuff
+      {char *Get() {if (!buff
+                    &&  posix_memalign((void **)&buff, XrdOssDio::Align,
+                                       XrdOssDio::BounceSize)) buff = 0;
+                    return buff;
+                   }
+       char *buff = 0;
+      ~BounceBuff() {if (buff) free(buff);}
+      };
+
+thread_local BounceBuff myBounce;
+}
+  
+/******************************************************************************/
+/*                                  O p e n                                   */
+/******************************************************************************/
+  
+int XrdOssDio::Open(const char *path)
+{
+   int fd;
+
+#if defined(O_DIRECT)
+   do {fd = open(path, O_RDONLY | O_DIRECT | O_CLOEXEC);}
+      while(fd < 0 && errno == EINTR);
+   return (fd < 0 ? -errno : fd);
+#elif defined(F_NOCACHE)
+   do {fd = open(path, O_RDONLY | O_CLOEXEC);} while(fd < 0 && errno == EINTR);
+   if (fd < 0) return -errno;
+   if (fcntl(fd, F_NOCACHE, 1)) {close(fd); return -EINVAL;}
+   return fd;
+#else
+   return -EINVAL;
+#endif
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+  
+ssize_t XrdOssDio::Read(int fd, void *buff, off_t offs, size_t blen)
+{
+   char   *bP   = (char *)buff;
+   size_t  skew = offs & (Align-1);
+   ssize_t rdsz, total = 0;
+
+// Aligned requests are read in place
+//
+   if (Aligned(buff, offs, blen)) return Direct(fd, bP, offs, blen);
+
+// When the buffer and offset are misaligned by the same amount only the head
+// and the tail need to be bounced. This is the usual case for requests that
+// continue a sequential read at an odd offset.
+//
+   if (((uintptr_t)buff & (Align-1)) == skew && blen >= (size_t)Align*2)
+      {size_t head = (skew ? Align - skew : 0);
+       size_t body = (blen - head) & ~(size_t)(Align-1);
+       if (head)
+          {if ((rdsz = Bounce(fd, bP, offs, head)) < (ssize_t)head) return rdsz;
+           total = head; bP += head; offs += head;
+          }
+       if ((rdsz = Direct(fd, bP, offs, body)) < (ssize_t)body)
+          return (rdsz < 0 ? rdsz : total + rdsz);
+       total += body; bP += body; offs += body; blen -= head + body;
+       if (!blen) return total;
+       if ((rdsz = Bounce(fd, bP, offs, blen)) < 0) return rdsz;
+       return total + rdsz;
+      }
+
+// Everything else goes through the bounce buffer
+//
+   while(blen)
+        {size_t chunk = std::min(blen, (size_t)(BounceSize - Align));
+         if ((rdsz = Bounce(fd, bP, offs, chunk)) < 0) return rdsz;
+         total += rdsz;
+         if ((size_t)rdsz < chunk) break;
+         bP += rdsz; offs += rdsz; blen -= rdsz;
+        }
+   return total;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                B o u n c e                                 */
+/******************************************************************************/
+
+// Read the aligned extent covering [offs, offs+blen) into the bounce buffer
+// and copy out the requested part. The extent must fit in the bounce buffer.
+  
+ssize_t XrdOssDio::Bounce(int fd, char *buff, off_t offs, size_t blen)
+{
+   off_t   base = offs & ~(off_t)(Align-1);
+   size_t  lead = offs - base;
+   size_t  span = (lead + blen + Align - 1) & ~(size_t)(Align-1);
+   char   *bbP  = myBounce.Get();
+   ssize_t rdsz;
+
+   if (!bbP) return -ENOMEM;
+
+   do {rdsz = pread(fd, bbP, span, base);} while(rdsz < 0 && errno == EINTR);
+   if (rdsz < 0) return -errno;
+   if ((size_t)rdsz <= lead) return 0;
+
+   rdsz = std::min((size_t)rdsz - lead, blen);
+   memcpy(buff, bbP + lead, rdsz);
+   dioBounce.Add(rdsz);
+   return rdsz;
+}
+
+/******************************************************************************/
+/*                                D i r e c t                                 */
+/******************************************************************************/
+  
+ssize_t XrdOssDio::Direct(int fd, char *buff, off_t offs, size_t blen)
+{
+   ssize_t rdsz;
+
+   do {rdsz = pread(fd, buff, blen, offs);} while(rdsz < 0 && errno == EINTR);
+   if (rdsz < 0) return -errno;
+   dioDirect.Add(rdsz);
+   return rdsz;
+}
@@ -0,0 +1,78 @@
+#ifndef __XRDOSSDIO_HH__
+#define __XRDOSSDIO_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d O s s D i o . h h                           */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <cstdint>
+#include <sys/types.h>
+
+/******************************************************************************/
+/*                       C l a s s   X r d O s s D i o                        */
+/******************************************************************************/
+
+// XrdOssDio reads files opened for direct I/O (i.e. O_DIRECT), bypassing the
+// page cache. The kernel requires the buffer, offset, and length of such reads
+// to be block aligned, which client requests seldom are. Aligned requests go
+// straight to the device. When the buffer and offset are misaligned by the same
+// amount only the unaligned head and tail are read through a per-thread bounce
+// buffer and the rest is read in place. Anything else is read through the bounce
+// buffer a chunk at a time. Alignment is the page size, which satisfies every
+// device's logical block size.
+
+class XrdOssDio
+{
+public:
+
+static const int Align      = 4096;
+static const int BounceSize = 1024*1024;
+
+// Return true if a read can be done directly into buff.
+//
+static bool    Aligned(const void *buff, off_t offs, size_t blen)
+                      {return !(((uintptr_t)buff | (uintptr_t)offs | blen)
+                               & (Align-1));
+                      }
+
+// Open path read/only for direct I/O. Returns the file descriptor or -errno
+// (-EINVAL when the filesystem does not support direct I/O).
+//
+static int     Open(const char *path);
+
+// Read blen bytes at offs from fd, opened by Open(), into buff. Returns the
+// number of bytes read, which is less than blen only at end of file, or -errno.
+//
+static ssize_t Read(int fd, void *buff, off_t offs, size_t blen);
+
+private:
+static ssize_t Bounce(int fd, char *buff, off_t offs, size_t blen);
+static ssize_t Direct(int fd, char *buff, off_t offs, size_t blen);
+};
+#endif
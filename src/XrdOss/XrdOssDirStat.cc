@@ -0,0 +1,276 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O s s D i r S t a t . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/sysmacros.h>
+
+#include "XrdOss/XrdOssDirStat.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+int                      XrdOssDirStat::BatchSize  = XrdOssDirStat::defBatch;
+int                      XrdOssDirStat::numHelpers = 0;
+int                      XrdOssDirStat::statFlags  = 0;
+
+XrdOssDirStat::Pool     *XrdOssDirStat::poolP      = 0;
+
+XrdSysMetrics::Counter   XrdOssDirStat::byCaller(
+                         "xrootd_oss_dirstat_entries_total",
+                         "Directory entries stat'ed while listing.",
+                         "by=\"caller\"");
+XrdSysMetrics::Counter   XrdOssDirStat::byHelper(
+                         "xrootd_oss_dirstat_entries_total",
+                         "Directory entries stat'ed while listing.",
+                         "by=\"helper\"");
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+  
+XrdOssDirStat::XrdOssDirStat(DIR *dP)
+             : dirP(dP), numEnt(0), nextEnt(0), rdErr(0), atEOF(false)
+{
+   ents  = new Entry[BatchSize];
+   names = new char[BatchSize*nameAvg + NAME_MAX + 1];
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+  
+XrdOssDirStat::~XrdOssDirStat()
+{
+   delete [] ents;
+   delete [] names;
+}
+
+/******************************************************************************/
+/*                                 B a t c h                                  */
+/******************************************************************************/
+  
+void XrdOssDirStat::Batch(int dfd, Entry *eP, int n)
+{
+   Job theJob(dfd, eP, n);
+   int nHelp = std::min(numHelpers, n/minShare - 1);
+
+// Offer the job to as many helpers as the batch can keep busy
+//
+   if (nHelp > 0)
+      {poolP->qCV.Lock();
+       for (int i = 0; i < nHelp; i++) poolP->jobQ.push_back(&theJob);
+       poolP->qCV.Broadcast();
+       poolP->qCV.UnLock();
+      }
+
+// Do our share and then withdraw any offers no helper took up. We must wait
+// for the helpers that did as the job lives on our stack.
+//
+   byCaller.Add(Work(&theJob));
+
+   if (nHelp > 0)
+      {std::deque<Job *> &jobQ = poolP->jobQ;
+       poolP->qCV.Lock();
+       auto it = std::remove(jobQ.begin(), jobQ.end(), &theJob);
+       nHelp -= jobQ.end() - it;
+       jobQ.erase(it, jobQ.end());
+       poolP->qCV.UnLock();
+       while(nHelp--) theJob.done.Wait();
+      }
+}
+
+/******************************************************************************/
+/*                                  N e x t                                   */
+/******************************************************************************/
+  
+int XrdOssDirStat::Next(char *buff, int blen, struct stat *sBuff)
+{
+   while(true)
+        {while(nextEnt < numEnt)
+              {Entry &eR = ents[nextEnt++];
+               if (eR.rc == ENOENT) continue;
+               if (eR.rc) return -eR.rc;
+               strlcpy(buff, eR.name, blen);
+               *sBuff = eR.sBuff;
+               return 0;
+              }
+         if (atEOF) {*buff = '\0'; return rdErr;}
+         Fill();
+        }
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+  
+int XrdOssDirStat::Start(int threads, int batch, bool nosync)
+{
+   pthread_t tid;
+
+#ifdef HAVE_STATX
+   if (nosync) statFlags = AT_STATX_DONT_SYNC;
+#endif
+   BatchSize = batch;
+   if (threads < 0) threads = std::min((int)sysconf(_SC_NPROCESSORS_ONLN) - 1,
+                                       (int)defThreads);
+   if (!batch || threads <= 0) return numHelpers;
+
+   if (!poolP) poolP = new Pool;
+
+   while(numHelpers < threads)
+        {if (XrdSysThread::Run(&tid, Helper, 0, 0, "dirstat")) break;
+         numHelpers++;
+        }
+   return numHelpers;
+}
+
+/******************************************************************************/
+/*                                S t a t A t                                 */
+/******************************************************************************/
+
+// When cached attributes are acceptable we use statx() as only it can say so.
+// It is no faster than fstatat() otherwise. We ask for just the basic fields
+// and return them as a stat.
+  
+int XrdOssDirStat::StatAt(int dfd, const char *name, struct stat *buff)
+{
+#ifdef HAVE_STATX
+   if (statFlags)
+      {struct statx sx;
+
+       if (statx(dfd, name, statFlags, STATX_BASIC_STATS, &sx)) return errno;
+
+       memset(buff, 0, sizeof(struct stat));
+       buff->st_dev          = makedev(sx.stx_dev_major, sx.stx_dev_minor);
+       buff->st_ino          = sx.stx_ino;
+       buff->st_mode         = sx.stx_mode;
+       buff->st_nlink        = sx.stx_nlink;
+       buff->st_uid          = sx.stx_uid;
+       buff->st_gid          = sx.stx_gid;
+       buff->st_rdev         = makedev(sx.stx_rdev_major, sx.stx_rdev_minor);
+       buff->st_size         = sx.stx_size;
+       buff->st_blksize      = sx.stx_blksize;
+       buff->st_blocks       = sx.stx_blocks;
+       buff->st_atim.tv_sec  = sx.stx_atime.tv_sec;
+       buff->st_atim.tv_nsec = sx.stx_atime.tv_nsec;
+       buff->st_mtim.tv_sec  = sx.stx_mtime.tv_sec;
+       buff->st_mtim.tv_nsec = sx.stx_mtime.tv_nsec;
+       buff->st_ctim.tv_sec  = sx.stx_ctime.tv_sec;
+       buff->st_ctim.tv_nsec = sx.stx_ctime.tv_nsec;
+       return 0;
+      }
+#endif
+
+#ifdef HAVE_FSTATAT
+   return (fstatat(dfd, name, buff, 0) ? errno : 0);
+#else
+   return ENOTSUP;
+#endif
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                  F i l l                                   */
+/******************************************************************************/
+
+// Read the next batch of names and stat them. Names are packed into a single
+// buffer and a batch ends early should that fill up.
+  
+void XrdOssDirStat::Fill()
+{
+   const int nMax = BatchSize*nameAvg;
+   struct dirent *rp;
+   int nLen, nOff = 0;
+
+   numEnt = nextEnt = 0;
+   errno = 0;
+   while(numEnt < BatchSize && nOff < nMax)
+        {if (!(rp = readdir(dirP)))
+            {atEOF = true; rdErr = -errno;
+             break;
+            }
+         nLen = strlen(rp->d_name) + 1;
+         memcpy(names+nOff, rp->d_name, nLen);
+         ents[numEnt++].name = names+nOff;
+         nOff += nLen;
+        }
+
+   if (numEnt) Batch(dirfd(dirP), ents, numEnt);
+}
+
+/******************************************************************************/
+/*                                H e l p e r                                 */
+/******************************************************************************/
+  
+void *XrdOssDirStat::Helper(void *)
+{
+   Pool *pP = poolP;
+   Job  *jP;
+
+   while(true)
+        {pP->qCV.Lock();
+         while(pP->jobQ.empty()) pP->qCV.Wait();
+         jP = pP->jobQ.front();
+         pP->jobQ.pop_front();
+         pP->qCV.UnLock();
+         byHelper.Add(Work(jP));
+         jP->done.Post();
+        }
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                  W o r k                                   */
+/******************************************************************************/
+
+// Stat unclaimed entries of a job until there are none left. Returns the
+// number of entries done.
+  
+int XrdOssDirStat::Work(Job *jP)
+{
+   int i, n = 0;
+
+   while((i = jP->next.fetch_add(1, std::memory_order_relaxed)) < jP->num)
+        {Entry &eR = jP->ents[i];
+         eR.rc = StatAt(jP->dfd, eR.name, &eR.sBuff);
+         n++;
+        }
+   return n;
+}
@@ -0,0 +1,140 @@
+#ifndef __XRDOSSDIRSTAT_HH__
+#define __XRDOSSDIRSTAT_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O s s D i r S t a t . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <atomic>
+#include <deque>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "XrdSys/XrdSysMetrics.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                   C l a s s   X r d O s s D i r S t a t                    */
+/******************************************************************************/
+
+// XrdOssDirStat reads a local directory ahead in batches and obtains the stat
+// information of each batch at once for XrdOssDir::Readdir() when autostat
+// is in effect. The stat calls of a batch are shared between the caller and
+// a small pool of helper threads so that listing a large directory proceeds
+// at the concurrency the filesystem supports rather than one call at a time,
+// which matters most for network filesystems.
+
+class XrdOssDirStat
+{
+public:
+
+struct Entry
+      {const char  *name;
+       struct stat  sBuff;
+       int          rc;      // 0 or the errno from stat
+      };
+
+// Obtain stat information, relative to the directory open as dfd, for n
+// entries. Helpers are used when there are enough entries to share.
+//
+static void Batch(int dfd, Entry *eP, int n);
+
+// Return the next entry and its stat information. At the end of the directory
+// buff is set to the null string. Returns 0 upon success or -errno. Entries
+// that vanished before they could be stat'ed are skipped.
+//
+int         Next(char *buff, int blen, struct stat *sBuff);
+
+// Set the number of entries per batch and start the helper threads. A batch
+// size of zero disables reading ahead. A negative number of threads uses one
+// less than the number of cpus, up to defThreads, as helpers only compete
+// with the caller when there are no idle cpus. When nosync is true, network
+// filesystems may answer from attributes they have cached rather than asking
+// the server (see AT_STATX_DONT_SYNC). Returns the number of helpers.
+//
+static int  Start(int threads, int batch, bool nosync=false);
+
+// Obtain stat information for name relative to the directory open as dfd.
+// Returns 0 upon success or the errno.
+//
+static int  StatAt(int dfd, const char *name, struct stat *buff);
+
+static int  BatchSize; // Entries read ahead, 0 -> XrdOssDir does not use us
+
+static const int defThreads = 4;
+static const int defBatch   = 256;
+
+            XrdOssDirStat(DIR *dP);
+           ~XrdOssDirStat();
+
+private:
+
+struct Job
+      {Entry            *ents;
+       int               num;
+       int               dfd;
+       std::atomic<int>  next;
+       XrdSysSemaphore   done;
+       Job(int fd, Entry *eP, int n) : ents(eP), num(n), dfd(fd), next(0),
+                                       done(0) {}
+      };
+
+// The job queue exists only when there are helpers and, as they never exit,
+// is never deleted.
+//
+struct Pool
+      {XrdSysCondVar     qCV;
+       std::deque<Job *> jobQ;
+       Pool() : qCV(0) {}
+      };
+
+static const int minShare = 16;    // Fewest entries worth giving a helper
+static const int nameAvg  = 64;    // Name space per entry in a batch
+
+void        Fill();
+static
+void       *Helper(void *);
+static int  Work(Job *jP);
+
+static Pool               *poolP;
+static int                 numHelpers;
+static int                 statFlags;
+
+static XrdSysMetrics::Counter byCaller;
+static XrdSysMetrics::Counter byHelper;
+
+DIR        *dirP;
+Entry      *ents;
+char       *names;
+int         numEnt;
+int         nextEnt;
+int         rdErr;
+bool        atEOF;
+};
+#endif
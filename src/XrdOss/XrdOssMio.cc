@@ -48,7 +48,7 @@
 /*                      S t a t i c   V a r i a b l e s                       */
 /******************************************************************************/
 
-XrdOucHash<XrdOssMioFile> XrdOssMio::MM_Hash;
+XrdOucFlatHash<XrdOssMioFile> XrdOssMio::MM_Hash;
 
 XrdSysMutex    XrdOssMio::MM_Mutex;
 
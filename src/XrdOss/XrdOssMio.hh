@@ -31,7 +31,7 @@
 /******************************************************************************/
 
 #include "XrdSys/XrdSysError.hh"
-#include "XrdOuc/XrdOucHash.hh"
+#include "XrdOuc/XrdOucFlatHash.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdOss/XrdOssMioFile.hh"
 
@@ -64,7 +64,7 @@ private:
 static int  Reclaim(off_t amount);
 static int  Reclaim(XrdOssMioFile *mp);
 
-static XrdOucHash<XrdOssMioFile> MM_Hash;
+static XrdOucFlatHash<XrdOssMioFile> MM_Hash;
 
 static XrdSysMutex    MM_Mutex;
 static XrdOssMioFile *MM_Perm;
@@ -43,6 +43,7 @@
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssCache.hh"
 #include "XrdOss/XrdOssError.hh"
+#include "XrdOss/XrdOssStatCache.hh"
 #include "XrdOss/XrdOssPath.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdOuc/XrdOucExport.hh"
@@ -131,6 +132,14 @@ int XrdOssSys::Rename(const char *oldname, const char *newname,
                else if (rename(local_path_Old, local_path_New)) retc = -errno;
     DEBUG("lcl rc=" <<retc <<" op=" <<local_path_Old <<" np=" <<local_path_New);
 
+// Drop stat cache entries for both names. Renaming a directory changes every
+// path below it so, as that is rare, we simply drop everything.
+//
+    if (!retc && StatCache)
+       {if (S_ISDIR(statbuff.st_mode)) StatCache->Flush();
+           else {Uncache(local_path_Old, true); Uncache(local_path_New, true);}
+       }
+
 // Now rename the data file in the remote system if the local rename "worked".
 // Do not do this if we really should not use the MSS.
 //
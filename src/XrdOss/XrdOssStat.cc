@@ -47,6 +47,7 @@
 #include "XrdOss/XrdOssOpaque.hh"
 #include "XrdOss/XrdOssPath.hh"
 #include "XrdOss/XrdOssSpace.hh"
+#include "XrdOss/XrdOssStatCache.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
 #include "XrdOuc/XrdOucPList.hh"
@@ -89,11 +90,16 @@ int XrdOssSys::Stat(const char *path, struct stat *buff, int opts,
 
 // Stat the file in the local filesystem first. If there. make sure the mode
 // bits correspond to our reality and update access time if so requested.
+// Results of plain stat() calls may come from the stat cache, except when
+// the access time must be updated as that needs the file to be there now.
 //
    if (STT_Func)
       {retc = (STT_V2 ? (*STT_Fund)(local_path, buff, opts, EnvP, path)
                       : (*STT_Func)(local_path, buff, opts, EnvP));
-      } else retc = stat(local_path, buff);
+      } else if (StatCache && popts & XRDEXP_STATCACHE
+             &&  !(opts & XRDOSS_updtatm))
+                retc = StatCache->Stat(local_path, buff);
+                else retc = stat(local_path, buff);
    if (!retc)
       {if (popts & XRDEXP_NOTRW) buff->st_mode &= ro_Mode;
        if (opts & XRDOSS_updtatm && (buff->st_mode & S_IFMT) == S_IFREG)
@@ -276,6 +282,7 @@ int XrdOssSys::StatLS(XrdOucEnv &env, const char *path, char *buff, int &blen)
 int XrdOssSys::StatPF(const char *path, struct stat *buff, int opts)
 {
    char lcl_path[MAXPATHLEN+1];
+   bool useSC;
    int retc;
 
 // If just the maximum values wanted then we can return these right away
@@ -293,6 +300,10 @@ int XrdOssSys::StatPF(const char *path, struct stat *buff, int opts)
        return 0;
       }
 
+// Only logical paths tell us whether the stat cache may be used
+//
+   useSC = StatCache && (opts & PF_isLFN) && (PathOpts(path) & XRDEXP_STATCACHE);
+
 // Check if we should do lfn2pfn conversion (previously we didn't allow it)
 //
    if (lcl_N2N && (opts & PF_isLFN))
@@ -304,7 +315,9 @@ int XrdOssSys::StatPF(const char *path, struct stat *buff, int opts)
 // We no longer use the custom stat plug-in for this function. It never
 // worked in the first place, anyway.
 //
-   if (stat(path, buff)) return (errno ? -errno : -ENOMSG);
+   if (useSC) retc = StatCache->Stat(path, buff);
+      else    retc = stat(path, buff);
+   if (retc) return (errno ? -errno : -ENOMSG);
 
 // Check of general stat information is to be returned
 //
@@ -448,6 +461,23 @@ int XrdOssSys::StatXP(const char *path, unsigned long long &attr,
    return XrdOssOK;
 }
   
+/******************************************************************************/
+/*                               U n c a c h e                                */
+/******************************************************************************/
+
+/*
+  Function: Drop stat cache entries for a path changed through the oss.
+
+  Input:    lclPath     - Is the local (physical) path that was changed.
+            parents     - When true, a name was added or removed and the
+                          entries for the parent directories are dropped too.
+*/
+
+void XrdOssSys::Uncache(const char *lclPath, bool parents)
+{
+   if (StatCache) StatCache->Invalidate(lclPath, parents);
+}
+
 /******************************************************************************/
 /*                              g e t C n a m e                               */
 /******************************************************************************/
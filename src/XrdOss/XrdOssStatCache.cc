@@ -0,0 +1,278 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s S t a t C a c h e . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "XrdOss/XrdOssStatCache.hh"
+
+/******************************************************************************/
+/*                        L o c a l   F u n c t i o n s                       */
+/******************************************************************************/
+
+namespace
+{
+long long Now()
+{
+   return std::chrono::duration_cast<std::chrono::milliseconds>
+          (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+  
+XrdOssStatCache::XrdOssStatCache(int maxEnt, int ttlMs, int nttlMs)
+   : maxPerShard(maxEnt/numShards > 0 ? maxEnt/numShards : 1),
+     posTTL(ttlMs), negTTL(nttlMs),
+     numEnt ("xrootd_oss_statcache_entries",
+             "Entries in the oss stat cache.", 0, true),
+     numHits("xrootd_oss_statcache_hits_total",
+             "Stat requests answered by the oss stat cache.",
+             "result=\"found\""),
+     numNHits("xrootd_oss_statcache_hits_total",
+             "Stat requests answered by the oss stat cache.",
+             "result=\"enoent\""),
+     numMiss("xrootd_oss_statcache_misses_total",
+             "Stat requests that went to the filesystem."),
+     numExpd("xrootd_oss_statcache_expired_total",
+             "Stat cache entries found to have expired."),
+     numEvct("xrootd_oss_statcache_evictions_total",
+             "Stat cache entries evicted to make room."),
+     numInvd("xrootd_oss_statcache_invalidations_total",
+             "Stat cache entries dropped because the oss changed the path."),
+     hitAge ("xrootd_oss_statcache_hit_age_ms_total",
+             "Sum of the ages of stat cache entries when they were used.")
+{}
+
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+  
+void XrdOssStatCache::Flush()
+{
+   for (int i = 0; i < numShards; i++)
+       {Shard &sP = shards[i];
+        sP.sMutex.Lock();
+        numInvd.Add(sP.sMap.size());
+        numEnt.Sub(sP.sMap.size());
+        sP.sMap.clear();
+        sP.sLRU.clear();
+        sP.sGen++;
+        sP.sMutex.UnLock();
+       }
+}
+  
+/******************************************************************************/
+/*                            I n v a l i d a t e                             */
+/******************************************************************************/
+  
+void XrdOssStatCache::Invalidate(const char *path, bool parents)
+{
+   std::string key;
+   size_t slash;
+
+   MakeKey(key, path);
+   Drop(key);
+
+   if (parents)
+      while((slash = key.rfind('/')) != std::string::npos && slash)
+           {key.erase(slash);
+            Drop(key);
+           }
+}
+
+/******************************************************************************/
+/*                                   P i n                                    */
+/******************************************************************************/
+
+void XrdOssStatCache::Pin(const char *path)
+{
+   std::string key;
+
+   MakeKey(key, path);
+   Drop(key, 1);
+}
+
+/******************************************************************************/
+/*                                  S t a t                                   */
+/******************************************************************************/
+  
+int XrdOssStatCache::Stat(const char *path, struct stat *buff)
+{
+   std::string key;
+   MakeKey(key, path);
+   Shard &sP = ShardOf(key);
+   long long now = Now(), tExp;
+   unsigned long long sGen;
+   int rc;
+
+// Look for a live entry. A hit moves the entry to the front of the LRU list.
+//
+   sP.sMutex.Lock();
+   if (!sP.sPins.empty() && sP.sPins.count(key))
+      {sP.sMutex.UnLock();
+       numMiss.Add();
+       return stat(path, buff);
+      }
+   auto it = sP.sMap.find(key);
+   if (it != sP.sMap.end())
+      {Entry &eP = it->second;
+       if (eP.tExpire > now)
+          {if ((rc = eP.rc)) numNHits.Add();
+              else {*buff = eP.sBuff; numHits.Add();}
+           hitAge.Add(now - eP.tAdded);
+           sP.sLRU.splice(sP.sLRU.begin(), sP.sLRU, eP.lruP);
+           sP.sMutex.UnLock();
+           if (rc) {errno = rc; return -1;}
+           return 0;
+          }
+       sP.sLRU.erase(eP.lruP);
+       sP.sMap.erase(it);
+       numEnt.Sub();
+       numExpd.Add();
+      }
+   sGen = sP.sGen;
+   sP.sMutex.UnLock();
+   numMiss.Add();
+
+// Ask the filesystem. Only success and ENOENT are worth remembering.
+//
+   if (!stat(path, buff)) {rc = 0; tExp = now + posTTL;}
+      else if (errno != ENOENT) return -1;
+              else {rc = ENOENT; tExp = now + negTTL;}
+
+// Add the result unless the path was changed while we were looking at it. If
+// the shard is full, evict the least recently used entry.
+//
+   sP.sMutex.Lock();
+   if (sGen == sP.sGen)
+      {if ((it = sP.sMap.find(key)) == sP.sMap.end())
+          {if ((int)sP.sMap.size() >= maxPerShard)
+              {sP.sMap.erase(sP.sLRU.back());
+               sP.sLRU.pop_back();
+               numEvct.Add();
+              } else numEnt.Add();
+           sP.sLRU.push_front(key);
+           it = sP.sMap.emplace(key, Entry()).first;
+           it->second.lruP = sP.sLRU.begin();
+          }
+       Entry &eP = it->second;
+       if (!rc) eP.sBuff = *buff;
+       eP.tAdded = now; eP.tExpire = tExp; eP.rc = rc;
+      }
+   sP.sMutex.UnLock();
+
+   if (rc) {errno = rc; return -1;}
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+  
+int XrdOssStatCache::Stats(char *buff, int blen)
+{
+   static const char sFmt[] = "<statcache><ent>%lld</ent><hit>%lld</hit>"
+          "<nhit>%lld</nhit><miss>%lld</miss><expd>%lld</expd>"
+          "<evct>%lld</evct><invd>%lld</invd><age>%lld</age></statcache>";
+   long long hits, nhits, age;
+   int n;
+
+   if (!buff) return sizeof(sFmt) + (8*20);
+
+   hits = numHits.Value(); nhits = numNHits.Value(); age = hitAge.Value();
+   n = snprintf(buff, blen, sFmt, numEnt.Value(), hits, nhits, numMiss.Value(),
+                numExpd.Value(), numEvct.Value(), numInvd.Value(),
+                (hits + nhits ? age / (hits + nhits) : 0LL));
+   return (n < blen ? n : 0);
+}
+
+/******************************************************************************/
+/*                                 U n P i n                                  */
+/******************************************************************************/
+
+void XrdOssStatCache::UnPin(const char *path)
+{
+   std::string key;
+
+   MakeKey(key, path);
+   Drop(key, -1);
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                  D r o p                                   */
+/******************************************************************************/
+  
+void XrdOssStatCache::Drop(std::string &key, int pin)
+{
+   Shard &sP = ShardOf(key);
+
+// Drop the entry and make sure that a stat() that started before now does
+// not put back what it found. Adjust the pin count, if so wanted.
+//
+   sP.sMutex.Lock();
+   if (pin > 0) sP.sPins[key]++;
+      else if (pin < 0)
+              {auto pt = sP.sPins.find(key);
+               if (pt != sP.sPins.end() && !--(pt->second)) sP.sPins.erase(pt);
+              }
+   auto it = sP.sMap.find(key);
+   if (it != sP.sMap.end())
+      {sP.sLRU.erase(it->second.lruP);
+       sP.sMap.erase(it);
+       numEnt.Sub();
+       numInvd.Add();
+      }
+   sP.sGen++;
+   sP.sMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                               M a k e K e y                                */
+/******************************************************************************/
+
+// Paths are keyed without trailing slashes so that "/a/b/" and "/a/b" share
+// an entry.
+  
+void XrdOssStatCache::MakeKey(std::string &key, const char *path)
+{
+   size_t n = strlen(path);
+
+   while(n > 1 && path[n-1] == '/') n--;
+   key.assign(path, n);
+}
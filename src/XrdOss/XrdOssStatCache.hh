@@ -0,0 +1,132 @@
+#ifndef __XRDOSSSTATCACHE_HH__
+#define __XRDOSSSTATCACHE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O s s S t a t C a c h e . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <sys/stat.h>
+
+#include "XrdSys/XrdSysMetrics.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                 C l a s s   X r d O s s S t a t C a c h e                  */
+/******************************************************************************/
+
+// XrdOssStatCache remembers the result of stat() on physical paths for a short
+// time so that repeated stat, open existence checks, and locates do not each
+// go to the filesystem. Both positive results and ENOENT are cached, each with
+// its own time to live. Operations through the oss that change metadata drop
+// the affected entries and files open for writing are not cached at all;
+// changes made behind the server's back are seen once the entry expires. The
+// cache is split into shards, each an LRU list bounded to its share of the
+// maximum number of entries.
+
+class XrdOssStatCache
+{
+public:
+
+// Drop all entries. This is used when a change may affect many paths, such
+// as renaming a directory.
+//
+void        Flush();
+
+// Drop the entry for path, if any. When parents is true also drop the entries
+// of all its parent directories, as adding or removing a name changes those.
+//
+void        Invalidate(const char *path, bool parents=false);
+
+// Keep path out of the cache while it is pinned, as a file open for writing
+// changes with every write. Pins nest; each Pin() needs its own UnPin().
+//
+void        Pin(const char *path);
+
+void        UnPin(const char *path);
+
+// Equivalent to stat(2), served from the cache when possible. Returns 0 upon
+// success and -1 with errno set otherwise.
+//
+int         Stat(const char *path, struct stat *buff);
+
+// Place statistics as xml in buff and return its length. When buff is nil,
+// return the maximum length needed. The age is the average age, in
+// milliseconds, of the entries used to answer requests.
+//
+int         Stats(char *buff, int blen);
+
+            XrdOssStatCache(int maxEnt, int ttlMs, int nttlMs);
+           ~XrdOssStatCache() {} // Never gets deleted
+
+static const int defMax  = 65536;
+static const int defTTL  = 5000;
+static const int defNTTL = 1000;
+
+private:
+
+struct Entry
+      {struct stat sBuff;
+       long long   tAdded;
+       long long   tExpire;
+       int         rc;
+       std::list<std::string>::iterator lruP;
+      };
+
+struct alignas(64) Shard
+      {XrdSysMutex                            sMutex;
+       std::unordered_map<std::string, Entry> sMap;
+       std::list<std::string>                 sLRU;
+       std::unordered_map<std::string, int>   sPins; // Paths being written
+       unsigned long long                     sGen = 0; // Bumped on changes
+      };
+
+static const int numShards = 64;
+
+void        Drop(std::string &key, int pin=0);
+static void MakeKey(std::string &key, const char *path);
+Shard      &ShardOf(const std::string &key)
+                   {return shards[std::hash<std::string>()(key) % numShards];}
+
+Shard       shards[numShards];
+int         maxPerShard;
+long long   posTTL;
+long long   negTTL;
+
+XrdSysMetrics::Counter numEnt;
+XrdSysMetrics::Counter numHits;
+XrdSysMetrics::Counter numNHits;
+XrdSysMetrics::Counter numMiss;
+XrdSysMetrics::Counter numExpd;
+XrdSysMetrics::Counter numEvct;
+XrdSysMetrics::Counter numInvd;
+XrdSysMetrics::Counter hitAge;
+};
+#endif
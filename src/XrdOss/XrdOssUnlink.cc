@@ -134,6 +134,7 @@ int XrdOssSys::Unlink(const char *path, int Opts, XrdOucEnv *eP)
                        {i = strlen(local_path);
                         if (local_path[i-1] != '/') strcpy(local_path+i, "/");
                         if ((retc = rmdir(local_path))) retc = -errno;
+                           else Uncache(local_path, true);
                         DEBUG("dir rc=" <<retc <<" path=" <<local_path);
                         return retc;
                        } else doAdjust = 1;
@@ -142,7 +143,8 @@ int XrdOssSys::Unlink(const char *path, int Opts, XrdOucEnv *eP)
 //
    if (!retc)
       {if (unlink(local_path)) retc = -errno;
-          else {i = strlen(local_path); //fnp = &local_path[i];
+          else {Uncache(local_path, true);
+                i = strlen(local_path); //fnp = &local_path[i];
                 if (doAdjust && statbuff.st_size)
                    XrdOssCache::Adjust(statbuff.st_dev, -statbuff.st_size);
                }
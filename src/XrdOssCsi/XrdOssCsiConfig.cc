@@ -37,6 +37,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 
+#include <cstdlib>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -86,6 +87,23 @@ int XrdOssCsiConfig::Init(XrdSysError &Eroute, const char *config_fn, const char
       {
          disableLooseWrite_ = true;
       }
+      else if (item == "tagcache")
+      {
+         char *eptr;
+         const long nb = value.empty() ? -1 : strtol(value.c_str(), &eptr, 10);
+         if (nb < 0 || *eptr)
+         {
+            Eroute.Emsg("Config", "tagcache requires a number of blocks");
+            NoGo = 1;
+         }
+         else tagCacheBlocks_ = nb;
+      }
+      else if (item == "tagwriteback")
+      {
+         Eroute.Say("Config warning: tagwriteback may write data before its "
+                    "tags; after a crash the tags may not match the data!");
+         tagCacheWriteBack_ = true;
+      }
    }
 
    if (NoGo) return NoGo;
@@ -99,6 +117,8 @@ int XrdOssCsiConfig::Init(XrdSysError &Eroute, const char *config_fn, const char
    Eroute.Say("       allow files without CRCs: ", allowMissingTags_ ? "yes" : "no");
    Eroute.Say("       pgWrite can extend      : ", disablePgExtend_ ? "no" : "yes");
    Eroute.Say("       loose writes            : ", disableLooseWrite_ ? "no" : "yes");
+   Eroute.Say("       tag cache blocks        : ", std::to_string((long long int)tagCacheBlocks_).c_str());
+   Eroute.Say("       tag cache write-back    : ", (tagCacheBlocks_ && tagCacheWriteBack_) ? "yes" : "no");
    Eroute.Say("       trace level             : ", std::to_string((long long int)OssCsiTrace.What).c_str());
    Eroute.Say("       prefix                  : ", tagParam_.prefix_.empty() ? "[empty]" : tagParam_.prefix_.c_str());
 
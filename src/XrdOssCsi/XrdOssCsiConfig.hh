@@ -162,7 +162,8 @@ class XrdOssCsiConfig
 {
 public:
 
-  XrdOssCsiConfig() : fillFileHole_(true), xrdtSpaceName_("public"), allowMissingTags_(true), disablePgExtend_(false), disableLooseWrite_(false) { }
+  XrdOssCsiConfig() : fillFileHole_(true), xrdtSpaceName_("public"), allowMissingTags_(true), disablePgExtend_(false), disableLooseWrite_(false),
+                      tagCacheBlocks_(0), tagCacheWriteBack_(false) { }
   ~XrdOssCsiConfig() { }
 
   int Init(XrdSysError &, const char *, const char *, XrdOucEnv *);
@@ -177,6 +178,10 @@ public:
 
   bool disableLooseWrite() const { return disableLooseWrite_; }
 
+  size_t tagCacheBlocks() const { return tagCacheBlocks_; }
+
+  bool tagCacheWriteBack() const { return tagCacheWriteBack_; }
+
   TagPath tagParam_;
 
 private:
@@ -191,6 +196,8 @@ private:
   bool allowMissingTags_;
   bool disablePgExtend_;
   bool disableLooseWrite_;
+  size_t tagCacheBlocks_;
+  bool tagCacheWriteBack_;
 };
 
 #endif
@@ -31,4 +31,26 @@
 
 #include "XrdOssCsiCrcUtils.hh"
 
-const uint8_t XrdOssCsiCrcUtils::g_bz[XrdSys::PageSize] = {0};
+struct XrdOssCsiCrcTables
+{
+   uint32_t x2n[XrdOssCsiCrcUtils::ntab];
+   uint32_t xm2n[XrdOssCsiCrcUtils::ntab];
+
+   XrdOssCsiCrcTables()
+   {
+      // x^1, and x^-1 which is the polynomial without its constant
+      // term divided by x
+      x2n[0] = (uint32_t)1 << 30;
+      xm2n[0] = (XrdOssCsiCrcUtils::CrcPoly << 1) | 1;
+      for (int k = 1; k < XrdOssCsiCrcUtils::ntab; k++)
+      {
+         x2n[k] = XrdOssCsiCrcUtils::multmodp(x2n[k-1], x2n[k-1]);
+         xm2n[k] = XrdOssCsiCrcUtils::multmodp(xm2n[k-1], xm2n[k-1]);
+      }
+   }
+};
+
+static const XrdOssCsiCrcTables crcTables;
+
+const uint32_t *const XrdOssCsiCrcUtils::g_x2n = crcTables.x2n;
+const uint32_t *const XrdOssCsiCrcUtils::g_xm2n = crcTables.xm2n;
@@ -45,16 +45,13 @@ public:
    // len2: length of data2
    //
    // returns crc of concatenation of data1|data2
-   // note: using Calc32C: some optimisation could be made
    static uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2)
    {
       if (len2==0)
          return crc1;
 
       assert(len2<=XrdSys::PageSize);
-
-      const uint32_t c1 = XrdOucCRC::Calc32C(g_bz, len2, ~crc1);
-      return ~c1^crc2;
+      return multmodp(xtobytes(len2, g_x2n), crc1) ^ crc2;
    }
 
    // crc32c_split1
@@ -64,19 +61,13 @@ public:
    // len2:   length of data2
    //
    // returns crc of data1
-   // note: crc bitshift to right, significant optimisation likely
-   //       possible with intrinsics or a precomputed table
    static uint32_t crc32c_split1(uint32_t crctot, uint32_t crc2, size_t len2)
    {
       if (len2==0)
          return crctot;
 
       assert(len2<=XrdSys::PageSize);
-      uint32_t crc = (crctot ^ crc2);
-      for(size_t i=0;i<8*len2;i++) {
-         crc = (crc<<1)^((crc&0x80000000) ? (CrcPoly << 1 | 0x1) : 0);
-      }
-      return crc;
+      return multmodp(xtobytes(len2, g_xm2n), crctot ^ crc2);
    }
 
    // crc32c_split2
@@ -86,15 +77,13 @@ public:
    // len2:   length of data2
    //
    // returns crc of data2
-   // note: using Calc32C: some optimisation could be made
    static uint32_t crc32c_split2(uint32_t crctot, uint32_t crc1, size_t len2)
    {
       if (len2==0)
          return 0;
 
       assert(len2<=XrdSys::PageSize);
-      uint32_t c1 = XrdOucCRC::Calc32C(g_bz, len2, ~crc1);
-      return ~c1^crctot;
+      return multmodp(xtobytes(len2, g_x2n), crc1) ^ crctot;
    }
 
    // crc32c_extendwith_zero
@@ -103,22 +92,61 @@ public:
    // len: number of zero bytes to append
    //
    // returns crc of data|[0x00 x len]
-   // note: using Calc32C: some optimisation could be made
    static uint32_t crc32c_extendwith_zero(uint32_t crc, size_t len)
    {
       if (len==0)
          return crc;
 
       assert(len<=XrdSys::PageSize);
-      return XrdOucCRC::Calc32C(g_bz, len, crc);
+      return ~multmodp(xtobytes(len, g_x2n), ~crc);
    }
 
 private:
 
-   static const uint8_t g_bz[XrdSys::PageSize];
+   // The crc register is shifted by n bytes by multiplying it by x^(8n)
+   // modulo the crc polynomial, or unshifted by multiplying by x^(-8n).
+   // Both are done from tables of x^(2^k) and x^(-2^k), in at most one
+   // product per bit of n, rather than by processing n bytes of zeros
+   // or 8n single bit steps.
+
+   // a*b modulo the crc polynomial, in the reflected bit order of the crc
+   static uint32_t multmodp(uint32_t a, uint32_t b)
+   {
+      uint32_t m = (uint32_t)1 << 31, p = 0;
+      for (;;) {
+         if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0)
+               break;
+         }
+         m >>= 1;
+         b = (b & 1) ? (b >> 1) ^ CrcPoly : b >> 1;
+      }
+      return p;
+   }
+
+   // x^(8n) (or x^(-8n)) given a table of x^(2^k) (or x^(-2^k))
+   static uint32_t xtobytes(size_t n, const uint32_t *tab)
+   {
+      uint32_t p = (uint32_t)1 << 31;   // x^0
+      int k = 3;
+      while (n) {
+         if (n & 1)
+            p = multmodp(tab[k], p);
+         n >>= 1;
+         k++;
+      }
+      return p;
+   }
+
+   static const int ntab = 64;
+   static const uint32_t *const g_x2n;
+   static const uint32_t *const g_xm2n;
 
    // CRC-32C (iSCSI) polynomial in reversed bit order.
    static const uint32_t CrcPoly = 0x82F63B78;
+
+   friend struct XrdOssCsiCrcTables;
 };
 
 #endif
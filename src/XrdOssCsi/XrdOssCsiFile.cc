@@ -258,7 +258,8 @@ int XrdOssCsiFile::createPageUpdater(const int Oflag, XrdOucEnv &Env)
 
    std::unique_ptr<XrdOssDF> integFile(parentOss_->newFile(tident));
    std::unique_ptr<XrdOssCsiTagstore> ts(new
-      XrdOssCsiTagstoreFile(pmi_->dpath, std::move(integFile), tident));
+      XrdOssCsiTagstoreFile(pmi_->dpath, std::move(integFile), tident,
+                         config_.tagCacheBlocks(), config_.tagCacheWriteBack()));
    std::unique_ptr<XrdOssCsiPages> pages(new
       XrdOssCsiPages(pmi_->dpath, std::move(ts), config_.fillFileHole(), config_.allowMissingTags(),
                      config_.disablePgExtend(), config_.disableLooseWrite(), tident));
@@ -392,6 +393,7 @@ ssize_t XrdOssCsiFile::ReadV(XrdOucIOVec *readV, int n)
    // standard OSS gives -ESPIPE in case of partial read of an element
    ssize_t rret = successor_->ReadV(readV, n);
    if (rret<0) return rret;
+   Pages()->PrefetchTags(readV, n);
    for (int i=0; i<n; i++)
    {
       if (readV[i].size == 0) continue;
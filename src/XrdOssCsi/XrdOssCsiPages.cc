@@ -39,6 +39,9 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <vector>
+
 extern XrdOucTrace  OssCsiTrace;
 
 XrdOssCsiPages::XrdOssCsiPages(const std::string &fn, std::unique_ptr<XrdOssCsiTagstore> ts, bool wh, bool am, bool dpe, bool dlw, const char *tid) :
@@ -267,6 +270,42 @@ int XrdOssCsiPages::VerifyRange(XrdOssDF *const fd, const void *buff, const off_
    return vret;
 }
 
+// Used by ReadV: Before the elements are verified one by one, ask the tagstore
+// to fetch the tags for all the pages covered. Elements whose pages are adjacent
+// or overlap are merged so that the tag store sees as few requests as possible.
+// Errors are ignored, they will be reported during verification.
+//
+void XrdOssCsiPages::PrefetchTags(const XrdOucIOVec *readV, const int n)
+{
+   if (hasMissingTags_ || n<2) return;
+
+   std::vector<std::pair<off_t,off_t> > pgs;
+   pgs.reserve(n);
+   for(int i=0;i<n;i++)
+   {
+      if (readV[i].size <= 0 || readV[i].offset < 0) continue;
+      const off_t p1 = readV[i].offset / XrdSys::PageSize;
+      const off_t p2 = (readV[i].offset + readV[i].size - 1) / XrdSys::PageSize;
+      pgs.push_back(std::make_pair(p1,p2));
+   }
+   if (pgs.empty()) return;
+   std::sort(pgs.begin(), pgs.end());
+
+   off_t p1 = pgs[0].first, p2 = pgs[0].second;
+   for(size_t i=1;i<pgs.size();i++)
+   {
+      if (pgs[i].first <= p2+1)
+      {
+         p2 = std::max(p2, pgs[i].second);
+         continue;
+      }
+      (void)ts_->PrefetchTags(p1, p2-p1+1);
+      p1 = pgs[i].first;
+      p2 = pgs[i].second;
+   }
+   (void)ts_->PrefetchTags(p1, p2-p1+1);
+}
+
 // apply_sequential_aligned_modify: Internal func used during Write/pgWrite
 //                                  (both aligned/unaligned cases) to update multiple tags.
 //
@@ -33,6 +33,7 @@
 
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdSys/XrdSysPageSize.hh"
+#include "XrdOuc/XrdOucIOVec.hh"
 
 #include "XrdOssCsiTagstore.hh"
 #include "XrdOssCsiRanges.hh"
@@ -56,6 +57,7 @@ public:
 
    int UpdateRange(XrdOssDF *, const void *, off_t, size_t, XrdOssCsiRangeGuard&);
    int VerifyRange(XrdOssDF *, const void *, off_t, size_t, XrdOssCsiRangeGuard&);
+   void PrefetchTags(const XrdOucIOVec *, int);
    void Flush();
    int Fsync();
 
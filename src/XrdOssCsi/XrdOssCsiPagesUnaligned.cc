@@ -619,6 +619,11 @@ int XrdOssCsiPages::VerifyRangeUnaligned(XrdOssDF *const fd, const void *const b
 // offset: offset in file for start of read
 // blen:   total length of read
 //
+// Only the parts of the page not already in the user's buffer are read from the file.
+// The crc of the page is formed by combining the crcs of those parts with the crc of
+// the user's data. The overlapping part is read again only if that crc mismatches,
+// to report whether the user's buffer differs from the file.
+//
 int XrdOssCsiPages::FetchRangeUnaligned_preblock(XrdOssDF *const fd, const void *const buff, const off_t offset, const size_t blen,
                                                  const off_t trackinglen, uint32_t *const tbuf, uint32_t *const csvec, const uint64_t opts)
 {
@@ -633,22 +638,45 @@ int XrdOssCsiPages::FetchRangeUnaligned_preblock(XrdOssDF *const fd, const void
    // bcommon is length of data in this page that user wants
    const size_t bcommon = std::min(bavail - p1_off, blen);
 
+   // btail is length of data in this page after that which the user wants
+   const size_t btail = bavail - p1_off - bcommon;
+
+   // will need the rest of the page to either verify or return crc of the user's data
+   // (in case of no verify and no csvec FetchRange() returns early)
    uint8_t b[XrdSys::PageSize];
-   const uint8_t *ub = (uint8_t*)buff;
-   if (bavail>bcommon)
+   uint32_t crchead = 0, crctail = 0;
+   if (p1_off>0)
    {
-      // will need more data to either verify or return crc of the user's data
-      // (in case of no verify and no csvec FetchRange() returns early)
-      const ssize_t rret = XrdOssCsiPages::fullread(fd, b, XrdSys::PageSize*p1, bavail);
+      const ssize_t rret = XrdOssCsiPages::fullread(fd, b, XrdSys::PageSize*p1, p1_off);
       if (rret<0)
       {
          TRACE(Warn, PageReadError(bavail, p1, rret));
          return rret;
       }
-      // if we're going to verify, make sure we just read the same overlapping data as that in the user's buffer
-      if ((opts & XrdOssDF::Verify))
+      crchead = XrdOucCRC::Calc32C(b, p1_off, 0U);
+   }
+   if (btail>0)
+   {
+      const ssize_t rret = XrdOssCsiPages::fullread(fd, &b[p1_off+bcommon], XrdSys::PageSize*p1+p1_off+bcommon, btail);
+      if (rret<0)
       {
-         if (memcmp(buff, &b[p1_off], bcommon))
+         TRACE(Warn, PageReadError(bavail, p1, rret));
+         return rret;
+      }
+      crctail = XrdOucCRC::Calc32C(&b[p1_off+bcommon], btail, 0U);
+   }
+
+   // verify; based on the crc of the user's data combined with the rest of the page
+   if ((opts & XrdOssDF::Verify))
+   {
+      const uint32_t crcuser = XrdOucCRC::Calc32C(buff, bcommon, 0U);
+      const uint32_t crc32calc = CrcUtils.crc32c_combine(CrcUtils.crc32c_combine(crchead, crcuser, bcommon), crctail, btail);
+      if (tbuf[0] != crc32calc)
+      {
+         // before blaming the page, check the user's buffer still matches the file: if
+         // not the data was probably modified concurrently, which is reported as such
+         if (bcommon>0 && XrdOssCsiPages::fullread(fd, &b[p1_off], XrdSys::PageSize*p1+p1_off, bcommon)>=0
+             && memcmp(buff, &b[p1_off], bcommon))
          {
             size_t badoff;
             for(badoff=0;badoff<bcommon;badoff++) { if (((uint8_t*)buff)[badoff] != b[p1_off+badoff]) break; }
@@ -656,47 +684,31 @@ int XrdOssCsiPages::FetchRangeUnaligned_preblock(XrdOssDF *const fd, const void
             TRACE(Warn, ByteMismatchError(bavail, XrdSys::PageSize*p1+p1_off+badoff, ((uint8_t*)buff)[badoff], b[p1_off+badoff]));
             return -EDOM;
          }
-      }
-      ub = b;
-   }
-   // verify; based on whole block, or user's buffer (if it contains the whole block)
-   if ((opts & XrdOssDF::Verify))
-   {
-      const uint32_t crc32calc = XrdOucCRC::Calc32C(ub, bavail, 0U);
-      if (tbuf[0] != crc32calc)
-      {
          TRACE(Warn, CRCMismatchError(bavail, p1, crc32calc, tbuf[0]));
          return -EDOM;
       }
+      // the page has been verified, so the crc of the user's part is that of the user's data
+      if (bavail>bcommon && csvec)
+      {
+         csvec[0] = crcuser;
+      }
+      return 0;
    }
 
    // if we're returning csvec values and this first block
    // needs adjustment because user requested a subset..
    if (bavail>bcommon && csvec)
    {
-     // make sure csvec[0] corresponds to only the data the user wanted, not whole page.
-     // if we have already verified the page + common part matches user's, take checksum of common.
-     // (Use local copy of page, perhaps less chance of accidental concurrent modification than buffer)
-     // Otherwise base on saved checksum.
-     if ((opts & XrdOssDF::Verify))
-     {
-        csvec[0] = XrdOucCRC::Calc32C(&b[p1_off], bcommon, 0u);
-     }
-     else
-     {
-       // calculate expected user checksum based on block's recorded checksum, adjusting
-       // for data not included in user's request. If either the returned data or the
-       // data not included in the user's request are corrupt the returned checksum and
-       // returned data will (probably) mismatch.
-
-       // remove block data before p1_off from checksum
-       uint32_t crc32c = XrdOucCRC::Calc32C(b, p1_off, 0u);
-       csvec[0] = CrcUtils.crc32c_split2(csvec[0], crc32c, bavail-p1_off);
-
-       // remove block data after p1_off+bcommon upto bavail
-       crc32c = XrdOucCRC::Calc32C(&b[p1_off+bcommon], bavail-p1_off-bcommon, 0u);
-       csvec[0] = CrcUtils.crc32c_split1(csvec[0], crc32c, bavail-p1_off-bcommon);
-     }
+      // calculate expected user checksum based on block's recorded checksum, adjusting
+      // for data not included in user's request. If either the returned data or the
+      // data not included in the user's request are corrupt the returned checksum and
+      // returned data will (probably) mismatch.
+
+      // remove block data before p1_off from checksum
+      csvec[0] = CrcUtils.crc32c_split2(csvec[0], crchead, bavail-p1_off);
+
+      // remove block data after p1_off+bcommon upto bavail
+      csvec[0] = CrcUtils.crc32c_split1(csvec[0], crctail, btail);
    }
    return 0;
 }
@@ -707,6 +719,8 @@ int XrdOssCsiPages::FetchRangeUnaligned_preblock(XrdOssDF *const fd, const void
 // offset: offset in file for start of read
 // blen:   total length of read
 //
+// As for the preblock only the data after the end of the user's buffer is read.
+//
 int XrdOssCsiPages::FetchRangeUnaligned_postblock(XrdOssDF *const fd, const void *const buff, const off_t offset, const size_t blen,
                                                  const off_t trackinglen, uint32_t *const tbuf, uint32_t *const csvec, const size_t tidx, const uint64_t opts)
 {
@@ -721,20 +735,28 @@ int XrdOssCsiPages::FetchRangeUnaligned_postblock(XrdOssDF *const fd, const void
    // how much of that data is not being returned
    const size_t bremain = (p2_off < bavail) ? bavail-p2_off : 0;
    uint8_t b[XrdSys::PageSize];
-   const uint8_t *ub = &((uint8_t*)buff)[blen-p2_off];
+   uint32_t crctail = 0;
    if (bremain>0)
    {
-      const ssize_t rret = XrdOssCsiPages::fullread(fd, b, XrdSys::PageSize*p2, bavail);
+      const ssize_t rret = XrdOssCsiPages::fullread(fd, b, XrdSys::PageSize*p2+p2_off, bremain);
       if (rret<0)
       {
          TRACE(Warn, PageReadError(bavail, p2, rret));
          return rret;
       }
-      // if we're verifying make sure overlapping part of data just read matches user's buffer
-      if ((opts & XrdOssDF::Verify))
+      crctail = XrdOucCRC::Calc32C(b, bremain, 0U);
+   }
+   if ((opts & XrdOssDF::Verify))
+   {
+      const uint8_t *const p = (uint8_t*)buff;
+      const uint32_t crcuser = XrdOucCRC::Calc32C(&p[blen-p2_off], p2_off, 0U);
+      const uint32_t crc32calc = CrcUtils.crc32c_combine(crcuser, crctail, bremain);
+      if (tbuf[tidx] != crc32calc)
       {
-         const uint8_t *const p = (uint8_t*)buff;
-         if (memcmp(&p[blen-p2_off], b, p2_off))
+         // as for the preblock, tell a user's buffer that no longer matches the file
+         // apart from a bad page
+         if (p2_off>0 && XrdOssCsiPages::fullread(fd, b, XrdSys::PageSize*p2, p2_off)>=0
+             && memcmp(&p[blen-p2_off], b, p2_off))
          {
             size_t badoff;
             for(badoff=0;badoff<p2_off;badoff++) { if (p[blen-p2_off+badoff] != b[badoff]) break; }
@@ -742,36 +764,24 @@ int XrdOssCsiPages::FetchRangeUnaligned_postblock(XrdOssDF *const fd, const void
             TRACE(Warn, ByteMismatchError(bavail, XrdSys::PageSize*p2+badoff, p[blen-p2_off+badoff], b[badoff]));
             return -EDOM;
          }
-      }
-      ub = b;
-   }
-   if ((opts & XrdOssDF::Verify))
-   {
-      const uint32_t crc32calc = XrdOucCRC::Calc32C(ub, bavail, 0U);
-      if (tbuf[tidx] != crc32calc)
-      {
          TRACE(Warn, CRCMismatchError(bavail, p2, crc32calc, tbuf[tidx]));
          return -EDOM;
       }
+      // verified; crc of the common part of page is that of the user's data
+      if (csvec && bremain>0)
+      {
+         csvec[tidx] = crcuser;
+      }
+      return 0;
    }
    // if we're returning csvec and user only request part of page
    // adjust the crc
    if (csvec && bremain>0)
    {
-      if ((opts & XrdOssDF::Verify))
-      {
-         // verified; calculate crc based on common part of page.
-         csvec[tidx] = XrdOucCRC::Calc32C(b, p2_off, 0u);
-      }
-      else
-      {
-         // recalculate crc based on recorded checksum and adjusting for part of data not returned.
-         // If either the returned data or the data not included in the user's request are
-         // corrupt the returned checksum and returned data will (probably) mismatch.
-
-         const uint32_t crc32c = XrdOucCRC::Calc32C(&b[p2_off], bremain, 0u);
-         csvec[tidx] = CrcUtils.crc32c_split1(csvec[tidx], crc32c, bremain);
-      }
+      // recalculate crc based on recorded checksum and adjusting for part of data not returned.
+      // If either the returned data or the data not included in the user's request are
+      // corrupt the returned checksum and returned data will (probably) mismatch.
+      csvec[tidx] = CrcUtils.crc32c_split1(csvec[tidx], crctail, bremain);
    }
 
    return 0;
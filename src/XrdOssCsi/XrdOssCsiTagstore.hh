@@ -48,6 +48,9 @@ public:
    virtual ssize_t WriteTags(const uint32_t *, off_t, size_t)=0;
    virtual ssize_t ReadTags(uint32_t *, off_t, size_t)=0;
 
+   // hint that the given tags are about to be read; may be ignored
+   virtual int PrefetchTags(off_t, size_t)=0;
+
    virtual off_t GetTrackedTagSize() const=0;
    virtual off_t GetTrackedDataSize() const=0;
    virtual bool IsVerified() const=0;
@@ -31,13 +31,45 @@
 
 #include "XrdOssCsiTrace.hh"
 #include "XrdOssCsiTagstoreFile.hh"
+#include "XrdSys/XrdSysMetrics.hh"
 
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <vector>
+
 extern XrdOucTrace  OssCsiTrace;
 
+namespace
+{
+// The tag cache counters of all files, exported with the server's metrics.
+// Reads less read_io and writes less write_io give the tag file I/O saved.
+struct CacheMetrics
+{
+   XrdSysMetrics::Counter rdReq{"xrootd_osscsi_tagcache_reads_total",
+                                "Tag reads through the tag cache."};
+   XrdSysMetrics::Counter rdHit{"xrootd_osscsi_tagcache_read_hits_total",
+                                "Tag reads served without reading the tag file."};
+   XrdSysMetrics::Counter rdIO {"xrootd_osscsi_tagcache_read_io_total",
+                                "Reads of tag files issued by the tag cache."};
+   XrdSysMetrics::Counter pfIO {"xrootd_osscsi_tagcache_prefetch_io_total",
+                                "Reads of tag files issued by tag prefetch."};
+   XrdSysMetrics::Counter wrReq{"xrootd_osscsi_tagcache_writes_total",
+                                "Tag writes through the tag cache."};
+   XrdSysMetrics::Counter wrIO {"xrootd_osscsi_tagcache_write_io_total",
+                                "Writes of tag files issued by the tag cache."};
+};
+
+// Metrics are never deleted, so these are only created once a cache is used
+CacheMetrics &Metrics()
+{
+   static CacheMetrics *metrics = new CacheMetrics;
+   return *metrics;
+}
+}
+
 int XrdOssCsiTagstoreFile::Open(const char *path, const off_t dsize, const int Oflag, XrdOucEnv &Env)
 {
    EPNAME("TagstoreFile::Open");
@@ -48,6 +80,9 @@ int XrdOssCsiTagstoreFile::Open(const char *path, const off_t dsize, const int O
       return ret;
    }
    isOpen = true;
+   cacheDrop();
+   cextent_ = 0;
+   memset(&cstats_, 0, sizeof(cstats_));
 
    struct guard_s
    {
@@ -134,6 +169,13 @@ int XrdOssCsiTagstoreFile::ResetSizes(const off_t size)
 {
    EPNAME("ResetSizes");
    if (!isOpen) return -EBADF;
+   if (cmaxblks_)
+   {
+      std::lock_guard<std::mutex> guard(cmtx_);
+      const int fret = cacheFlushAll();
+      cacheDrop();
+      if (fret<0) return fret;
+   }
    actualsize_ = size;
    struct stat sb;
    const int ssret = fd_->Fstat(&sb);
@@ -164,25 +206,276 @@ int XrdOssCsiTagstoreFile::ResetSizes(const off_t size)
 int XrdOssCsiTagstoreFile::Fsync()
 {
    if (!isOpen) return -EBADF;
+   if (cwriteback_)
+   {
+      std::lock_guard<std::mutex> guard(cmtx_);
+      const int fret = cacheFlushAll();
+      if (fret<0) return fret;
+   }
    return fd_->Fsync();
 }
 
 void XrdOssCsiTagstoreFile::Flush()
 {
+   EPNAME("TagstoreFile::Flush");
    if (!isOpen) return;
+   if (cwriteback_)
+   {
+      std::lock_guard<std::mutex> guard(cmtx_);
+      const int fret = cacheFlushAll();
+      if (fret<0)
+      {
+         TRACE(Warn, "error " << fret << " writing cached tags for " << fn_);
+      }
+   }
    fd_->Flush();
 }
 
 int XrdOssCsiTagstoreFile::Close()
 {
+   EPNAME("TagstoreFile::Close");
    if (!isOpen) return -EBADF;
+   int fret = 0;
+   if (cmaxblks_)
+   {
+      std::lock_guard<std::mutex> guard(cmtx_);
+      fret = cacheFlushAll();
+      cacheDrop();
+      TRACE(Info, "tag cache for " << fn_ <<
+         ": reads " << cstats_.rdReq << " (cached " << cstats_.rdHit <<
+         ", io " << cstats_.rdIO << ", prefetch io " << cstats_.pfIO <<
+         "), writes " << cstats_.wrReq << " (io " << cstats_.wrIO << ")");
+   }
    isOpen = false;
-   return fd_->Close();
+   const int cret = fd_->Close();
+   if (fret<0) return fret;
+   return cret;
 }
 
 ssize_t XrdOssCsiTagstoreFile::WriteTags(const uint32_t *const buf, const off_t off, const size_t n)
 {
    if (!isOpen) return -EBADF;
+   if (!cmaxblks_) return WriteTagsDirect(buf, off, n);
+
+   std::lock_guard<std::mutex> guard(cmtx_);
+   cstats_.wrReq++; Metrics().wrReq.Add();
+   if (!cwriteback_)
+   {
+      // write-through: the tag file is updated first, blocks already
+      // in the cache are updated afterwards but none are loaded
+      const ssize_t wret = WriteTagsDirect(buf, off, n);
+      cstats_.wrIO++; Metrics().wrIO.Add();
+      if (wret<0) return wret;
+   }
+
+   size_t ndone = 0;
+   while(ndone<n)
+   {
+      const off_t blk = (off+ndone) / cblksz_;
+      const size_t bidx = (off+ndone) % cblksz_;
+      const size_t bcnt = std::min(n-ndone, cblksz_-bidx);
+      TagBlock *b = NULL;
+      if (cwriteback_)
+      {
+         // a block which is to be entirely overwritten need not be read
+         int ret = 0;
+         b = cacheGet(blk, bcnt != cblksz_, ret);
+         if (!b) return ret;
+      }
+      else
+      {
+         const auto itr = cache_.find(blk);
+         if (itr != cache_.end()) b = itr->second.get();
+      }
+      if (b)
+      {
+         memcpy(&b->tags[bidx], &buf[ndone], 4*bcnt);
+         b->nvalid = std::max(b->nvalid, bidx+bcnt);
+         b->lastuse = ++cuse_;
+         if (cwriteback_)
+         {
+            if (b->dlo == b->dhi)
+            {
+               b->dlo = bidx;
+               b->dhi = bidx+bcnt;
+            }
+            else
+            {
+               b->dlo = std::min(b->dlo, bidx);
+               b->dhi = std::max(b->dhi, bidx+bcnt);
+            }
+         }
+      }
+      ndone += bcnt;
+   }
+   cextent_ = std::max(cextent_, (off_t)(off+n));
+   return n;
+}
+
+ssize_t XrdOssCsiTagstoreFile::ReadTags(uint32_t *const buf, const off_t off, const size_t n)
+{
+   if (!isOpen) return -EBADF;
+   if (!cmaxblks_) return ReadTagsDirect(buf, off, n);
+
+   std::lock_guard<std::mutex> guard(cmtx_);
+   cstats_.rdReq++; Metrics().rdReq.Add();
+   const uint64_t rdio = cstats_.rdIO;
+   size_t ndone = 0;
+   while(ndone<n)
+   {
+      const off_t blk = (off+ndone) / cblksz_;
+      const size_t bidx = (off+ndone) % cblksz_;
+      const size_t bcnt = std::min(n-ndone, cblksz_-bidx);
+      int ret = 0;
+      TagBlock *b = cacheGet(blk, true, ret);
+      if (!b) return ret;
+      // same as fullread: a short read is an error. Tags written after
+      // the block was loaded, wherever they were, extend the tag file
+      // with zeros up to cextent_.
+      size_t nvalid = b->nvalid;
+      if (cextent_ > blk*(off_t)cblksz_) nvalid = std::max(nvalid, std::min((size_t)(cextent_-blk*cblksz_), cblksz_));
+      if (bidx+bcnt > nvalid) return -EDOM;
+      memcpy(&buf[ndone], &b->tags[bidx], 4*bcnt);
+      ndone += bcnt;
+   }
+   if (rdio == cstats_.rdIO) { cstats_.rdHit++; Metrics().rdHit.Add(); }
+   return n;
+}
+
+int XrdOssCsiTagstoreFile::PrefetchTags(const off_t off, const size_t n)
+{
+   if (!isOpen) return -EBADF;
+   if (!cmaxblks_ || n == 0) return 0;
+
+   std::lock_guard<std::mutex> guard(cmtx_);
+   const off_t fblk = off / cblksz_;
+   off_t lblk = (off+n-1) / cblksz_;
+   // never try to hold more than the cache can keep
+   if (lblk-fblk+1 > (off_t)cmaxblks_) lblk = fblk + cmaxblks_ - 1;
+
+   // read each run of consecutive missing blocks with a single request
+   off_t blk = fblk;
+   while(blk <= lblk)
+   {
+      if (cache_.find(blk) != cache_.end()) { blk++; continue; }
+      off_t rend = blk+1;
+      while(rend <= lblk && cache_.find(rend) == cache_.end()) rend++;
+
+      const size_t nblks = rend - blk;
+      std::vector<uint32_t> rbuf(nblks*cblksz_);
+      const ssize_t rret = ReadTagsUpto(rbuf.data(), blk*cblksz_, rbuf.size());
+      cstats_.pfIO++; Metrics().pfIO.Add();
+      if (rret<0) return rret;
+
+      for(size_t i=0;i<nblks;i++)
+      {
+         const int mret = cacheMakeRoom();
+         if (mret<0) return mret;
+         std::unique_ptr<TagBlock> b(new TagBlock);
+         const size_t nread = (rret > (ssize_t)(i*cblksz_)) ? std::min((size_t)rret - i*cblksz_, cblksz_) : 0;
+         memcpy(b->tags, &rbuf[i*cblksz_], 4*cblksz_);
+         memset(&b->tags[nread], 0, 4*(cblksz_-nread));
+         b->nvalid = nread;
+         b->dlo = b->dhi = 0;
+         b->lastuse = ++cuse_;
+         cache_[blk+i] = std::move(b);
+      }
+      blk = rend;
+   }
+   return 0;
+}
+
+//
+// Locate a block in the cache, optionally loading it from the tag file.
+// Called with cmtx_ held.
+//
+XrdOssCsiTagstoreFile::TagBlock *XrdOssCsiTagstoreFile::cacheGet(const off_t blk, const bool load, int &ret)
+{
+   ret = 0;
+   const auto itr = cache_.find(blk);
+   if (itr != cache_.end())
+   {
+      itr->second->lastuse = ++cuse_;
+      return itr->second.get();
+   }
+
+   const int mret = cacheMakeRoom();
+   if (mret<0)
+   {
+      ret = mret;
+      return NULL;
+   }
+
+   std::unique_ptr<TagBlock> b(new TagBlock);
+   size_t nread = 0;
+   if (load)
+   {
+      const ssize_t rret = ReadTagsUpto(b->tags, blk*cblksz_, cblksz_);
+      cstats_.rdIO++; Metrics().rdIO.Add();
+      if (rret<0)
+      {
+         ret = rret;
+         return NULL;
+      }
+      nread = rret;
+   }
+   memset(&b->tags[nread], 0, 4*(cblksz_-nread));
+   b->nvalid = nread;
+   b->dlo = b->dhi = 0;
+   b->lastuse = ++cuse_;
+   TagBlock *const bp = b.get();
+   cache_[blk] = std::move(b);
+   return bp;
+}
+
+//
+// Evict the least recently used block if the cache is full.
+// Called with cmtx_ held.
+//
+int XrdOssCsiTagstoreFile::cacheMakeRoom()
+{
+   if (cache_.size() < cmaxblks_) return 0;
+   auto victim = cache_.begin();
+   for(auto itr=cache_.begin(); itr!=cache_.end(); ++itr)
+   {
+      if (itr->second->lastuse < victim->second->lastuse) victim = itr;
+   }
+   const int fret = cacheFlushBlock(victim->first, *victim->second);
+   if (fret<0) return fret;
+   cache_.erase(victim);
+   return 0;
+}
+
+int XrdOssCsiTagstoreFile::cacheFlushBlock(const off_t blk, TagBlock &b)
+{
+   if (b.dlo == b.dhi) return 0;
+   const ssize_t wret = WriteTagsDirect(&b.tags[b.dlo], blk*cblksz_+b.dlo, b.dhi-b.dlo);
+   cstats_.wrIO++; Metrics().wrIO.Add();
+   if (wret<0) return wret;
+   b.dlo = b.dhi = 0;
+   return 0;
+}
+
+int XrdOssCsiTagstoreFile::cacheFlushAll()
+{
+   // write in ascending block order, so the tag file is extended only once
+   int ret = 0;
+   for(auto itr=cache_.begin(); itr!=cache_.end(); ++itr)
+   {
+      const int fret = cacheFlushBlock(itr->first, *itr->second);
+      if (fret<0 && ret==0) ret = fret;
+   }
+   return ret;
+}
+
+void XrdOssCsiTagstoreFile::cacheDrop()
+{
+   cache_.clear();
+   cextent_ = 0;
+}
+
+ssize_t XrdOssCsiTagstoreFile::WriteTagsDirect(const uint32_t *const buf, const off_t off, const size_t n)
+{
    if (machineIsBige_ != fileIsBige_) return WriteTags_swap(buf, off, n);
 
    const ssize_t nwritten = XrdOssCsiTagstoreFile::fullwrite(*fd_, buf, 20LL+4*off, 4*n);
@@ -190,9 +483,8 @@ ssize_t XrdOssCsiTagstoreFile::WriteTags(const uint32_t *const buf, const off_t
    return nwritten/4;
 }
 
-ssize_t XrdOssCsiTagstoreFile::ReadTags(uint32_t *const buf, const off_t off, const size_t n)
+ssize_t XrdOssCsiTagstoreFile::ReadTagsDirect(uint32_t *const buf, const off_t off, const size_t n)
 {
-   if (!isOpen) return -EBADF;
    if (machineIsBige_ != fileIsBige_) return ReadTags_swap(buf, off, n);
 
    const ssize_t nread = XrdOssCsiTagstoreFile::fullread(*fd_, buf, 20LL+4*off, 4*n);
@@ -200,6 +492,25 @@ ssize_t XrdOssCsiTagstoreFile::ReadTags(uint32_t *const buf, const off_t off, co
    return nread/4;
 }
 
+//
+// Read up to n tags, returning the number available. Only used for filling
+// the cache, where the end of the tag file may fall inside a block.
+//
+ssize_t XrdOssCsiTagstoreFile::ReadTagsUpto(uint32_t *const buf, const off_t off, const size_t n)
+{
+   const ssize_t rret = XrdOssCsiTagstoreFile::maxread(*fd_, buf, 20LL+4*off, 4*n);
+   if (rret<0) return rret;
+   const size_t nread = rret/4;
+   if (machineIsBige_ != fileIsBige_)
+   {
+      for(size_t i=0;i<nread;i++)
+      {
+         buf[i] = bswap_32(buf[i]);
+      }
+   }
+   return nread;
+}
+
 int XrdOssCsiTagstoreFile::Truncate(const off_t size, bool datatoo)
 {
    if (!isOpen)
@@ -207,6 +518,16 @@ int XrdOssCsiTagstoreFile::Truncate(const off_t size, bool datatoo)
       return -EBADF;
    }
 
+   // write out anything pending and start with an empty cache: blocks
+   // beyond the new size are discarded by the truncate
+   if (cmaxblks_)
+   {
+      std::lock_guard<std::mutex> guard(cmtx_);
+      const int fret = cacheFlushAll();
+      cacheDrop();
+      if (fret<0) return fret;
+   }
+
    // set tag file to correct length for value of size
    const off_t expected_tagfile_size = 20LL + 4*((size+XrdSys::PageSize-1)/XrdSys::PageSize);
    const int tret = fd_->Ftruncate(expected_tagfile_size);
@@ -36,13 +36,16 @@
 #include "XrdOuc/XrdOucCRC.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 
+#include <map>
 #include <memory>
 #include <mutex>
 
 class XrdOssCsiTagstoreFile : public XrdOssCsiTagstore
 {
 public:
-   XrdOssCsiTagstoreFile(const std::string &fn, std::unique_ptr<XrdOssDF> fd, const char *tid) : fn_(fn), fd_(std::move(fd)), trackinglen_(0), isOpen(false), tident_(tid), tident(tident_.c_str()) { }
+   XrdOssCsiTagstoreFile(const std::string &fn, std::unique_ptr<XrdOssDF> fd, const char *tid, size_t cblks=0, bool wback=false) :
+      fn_(fn), fd_(std::move(fd)), trackinglen_(0), isOpen(false), tident_(tid), tident(tident_.c_str()),
+      cmaxblks_(cblks), cwriteback_(cblks ? wback : false), cuse_(0), cextent_(0) { }
    virtual ~XrdOssCsiTagstoreFile() { if (isOpen) { (void)Close(); } }
 
    virtual int Open(const char *, off_t, int, XrdOucEnv &) /* override */;
@@ -53,6 +56,7 @@ public:
 
    virtual ssize_t WriteTags(const uint32_t *, off_t, size_t) /* override */;
    virtual ssize_t ReadTags(uint32_t *, off_t, size_t) /* override */;
+   virtual int PrefetchTags(off_t, size_t) /* override */;
 
    virtual int Truncate(off_t, bool) /* override */;
 
@@ -119,6 +123,21 @@ public:
       return nread;
    }
 
+   static ssize_t maxread(XrdOssDF &fd, void *buff, const off_t off , const size_t sz)
+   {
+      size_t toread = sz, nread = 0;
+      uint8_t *p = (uint8_t*)buff;
+      while(toread>0)
+      {
+         const ssize_t rret = fd.Read(&p[nread], off+nread, toread);
+         if (rret<0) return rret;
+         if (rret==0) break;
+         toread -= rret;
+         nread += rret;
+      }
+      return nread;
+   }
+
    static ssize_t fullwrite(XrdOssDF &fd, const void *buff, const off_t off , const size_t sz)
    {
       size_t towrite = sz, nwritten = 0;
@@ -148,6 +167,54 @@ private:
 
    ssize_t WriteTags_swap(const uint32_t *, off_t, size_t);
    ssize_t ReadTags_swap(uint32_t *, off_t, size_t);
+   ssize_t WriteTagsDirect(const uint32_t *, off_t, size_t);
+   ssize_t ReadTagsDirect(uint32_t *, off_t, size_t);
+   ssize_t ReadTagsUpto(uint32_t *, off_t, size_t);
+
+   // Optional cache of tag blocks. Each block holds cblksz_ tags, i.e. one
+   // page of the tag file, which covers cblksz_ pages of the datafile.
+   // In write-through mode tags are always written to the tag file before
+   // WriteTags returns, preserving the tags-before-data ordering relied
+   // upon for recovery after a crash. In write-back mode dirty tags are
+   // kept until Flush, Fsync, Close, Truncate or eviction, so the data they
+   // cover may reach the datafile first: that ordering is NOT kept, and
+   // after a crash the tag file may not match the data until rewritten.
+   // Fsync writes and syncs the tags before the data is synced, so a file
+   // is consistent again once an Fsync has completed.
+   static constexpr size_t cblksz_ = 1024;
+
+   struct TagBlock
+   {
+      uint32_t tags[cblksz_];
+      size_t   nvalid;   // number of tags from the start of the block that exist
+      size_t   dlo;      // dirty range [dlo,dhi), empty if dlo==dhi
+      size_t   dhi;
+      uint64_t lastuse;
+   };
+
+   struct CacheStats
+   {
+      uint64_t rdReq;    // ReadTags calls
+      uint64_t rdHit;    // ReadTags calls satisfied without a tag file read
+      uint64_t rdIO;     // reads issued to the tag file
+      uint64_t wrReq;    // WriteTags calls
+      uint64_t wrIO;     // writes issued to the tag file
+      uint64_t pfIO;     // reads issued by prefetch
+   };
+
+   std::mutex cmtx_;
+   std::map<off_t, std::unique_ptr<TagBlock> > cache_;
+   const size_t cmaxblks_;
+   const bool cwriteback_;
+   uint64_t cuse_;
+   off_t cextent_;     // one past the highest tag ever written via the cache
+   CacheStats cstats_;
+
+   TagBlock *cacheGet(off_t, bool, int &);
+   int  cacheMakeRoom();
+   int  cacheFlushBlock(off_t, TagBlock &);
+   int  cacheFlushAll();
+   void cacheDrop();
 
    int WriteTrackedTagSize(const off_t size)
    {
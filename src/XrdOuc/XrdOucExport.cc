@@ -38,7 +38,9 @@
   
 /* Function: ParseDefs
 
-   Purpose:  Parse: defaults [[no]cache] [[no]check] [[no]dread]
+   Purpose:  Parse: defaults [[no]cache] [[no]check] [[no]directio]
+
+                             [[no]dread]
 
                              [[no]filter] [forcero]
 
@@ -50,6 +52,8 @@
 
                              [[no]stage] [stage+] [[no]rcreate]
 
+                             [[no]statcache]
+
                              [[not]writable] [[no]xattrs]
 
    Notes: See the oss configuration manual for the meaning of each option.
@@ -95,8 +99,12 @@ unsigned long long XrdOucExport::ParseDefs(XrdOucStream      &Config,
         {"stage+",        0,              XRDEXP_STAGEMM, XRDEXP_STAGE_X},
         {"dread",         XRDEXP_NODREAD, 0,              XRDEXP_DREAD_X},
         {"nodread",       0,              XRDEXP_NODREAD, XRDEXP_DREAD_X},
+        {"directio",      0,              XRDEXP_DIRECTIO,XRDEXP_DIRECTIO_X},
+        {"nodirectio",    XRDEXP_DIRECTIO,0,              XRDEXP_DIRECTIO_X},
         {"check",         XRDEXP_NOCHECK, 0,              XRDEXP_CHECK_X},
         {"nocheck",       0,              XRDEXP_NOCHECK, XRDEXP_CHECK_X},
+        {"statcache",     0,              XRDEXP_STATCACHE,XRDEXP_STATCACHE_X},
+        {"nostatcache",   XRDEXP_STATCACHE,0,             XRDEXP_STATCACHE_X},
         {"rcreate",       0,              XRDEXP_RCREATE, XRDEXP_RCREATE_X},
         {"norcreate",     XRDEXP_RCREATE, 0,              XRDEXP_RCREATE_X},
         {"local",         XRDEXP_GLBLRO,  XRDEXP_LOCAL,   XRDEXP_LOCAL_X},
@@ -144,6 +152,7 @@ unsigned long long XrdOucExport::ParseDefs(XrdOucStream      &Config,
              <options> a blank separated list of options:
                        [no]cache    - is [not] file caching
                        [no]check    - [don't] check if new file exists in MSS
+                       [no]directio - [don't] bypass the page cache for reads
                        [no]dread    - [don't] read actual directory contents
                            forcero  - force r/w opens to r/o opens
                            inplace  - do not use extended cache for creation
@@ -159,6 +168,7 @@ unsigned long long XrdOucExport::ParseDefs(XrdOucStream      &Config,
                            r/o      - do not allow modifications (read/only)
                            r/w      - path is writable/modifiable
                        [no]stage    - [don't] stage in files.
+                       [no]statcache - [don't] cache stat() results
 
    Output: XrdOucPList object upon success or 0 upon failure.
 */
@@ -75,8 +75,10 @@
 #define XRDEXP_GLBLRO_X   0x0018000000000000LL
 #define XRDEXP_STAGEMM    0x0000000000200020LL
 //                        0x0020000000000000LL
-//                        0x0040000000400000LL
-//                        0x0080000000800000LL
+#define XRDEXP_DIRECTIO   0x0000000000400000LL
+#define XRDEXP_DIRECTIO_X 0x0040000000000000LL
+#define XRDEXP_STATCACHE  0x0000000000800000LL
+#define XRDEXP_STATCACHE_X 0x0080000000000000LL
 #define XRDEXP_AVAILABLE  0xff000000ff000000LL
 #define XRDEXP_MASKSHIFT  32
 #define XRDEXP_SETTINGS   0x00000000ffffffffLL
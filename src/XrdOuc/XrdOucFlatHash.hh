@@ -0,0 +1,180 @@
+#ifndef __OUC_FLATHASH__
+#define __OUC_FLATHASH__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O u c F l a t H a s h . h h                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "XrdOuc/XrdOucHash.hh"
+
+/******************************************************************************/
+/*                  C l a s s   X r d O u c F l a t H a s h                   */
+/******************************************************************************/
+
+// XrdOucFlatHash has the same interface and options as XrdOucHash but keeps
+// its entries in the table itself using open addressing. The table is split
+// into groups of 16 slots, each with a byte of control information: whether
+// the slot is empty, deleted, or full and, if full, 7 bits of the key hash.
+// A lookup compares all the control bytes of a group at once (using SSE2 when
+// available) and only looks at the slots whose bits match. A slot is a cache
+// line holding the start of the key, so a lookup of a key shorter than 24
+// bytes normally reads two cache lines rather than following a chain of
+// separately allocated items.
+//
+// When the table must grow, a new one is allocated and entries are moved to
+// it a few at a time by each later Add() or Del(); Find() looks in both until
+// all are moved. Find() and Apply() do not move entries, so as with XrdOucHash
+// concurrent Find() calls are safe when no entries have a lifetime.
+//
+// The table size is a power of two. The constructor arguments are those of
+// XrdOucHash; the previous size is ignored and the load is at most 87%.
+
+template<class T>
+class XrdOucFlatHash
+{
+public:
+
+// Add() adds a new item to the hash, see XrdOucHash::Add().
+//
+T           *Add(const char *KeyVal, T *KeyData, const int LifeTime=0,
+                 XrdOucHash_Options opt=Hash_default);
+
+// Del() deletes the item from the hash, see XrdOucHash::Del().
+//
+int          Del(const char *KeyVal, XrdOucHash_Options opt=Hash_default);
+
+// Find() looks up an entry, optionally returning its expiration time.
+//
+T           *Find(const char *KeyVal, time_t *KeyTime=0);
+
+// Num() returns the number of items in the hash table
+//
+int          Num() {return hashnum;}
+
+// Purge() deletes all of the items in the table.
+//
+void         Purge();
+
+// Rep() is simply Add() that allows replacement.
+//
+T           *Rep(const char *KeyVal, T *KeyData, const int LifeTime=0,
+                 XrdOucHash_Options opt=Hash_default)
+                {return Add(KeyVal, KeyData, LifeTime,
+                            (XrdOucHash_Options)(opt | Hash_replace));}
+
+// Apply() applies the function to every item, see XrdOucHash::Apply().
+//
+T           *Apply(int (*func)(const char *, T *, void *), void *Arg);
+
+             XrdOucFlatHash(int psize = 89, int size=144, int load=80);
+            ~XrdOucFlatHash();
+
+             XrdOucFlatHash(const XrdOucFlatHash &) = delete;
+XrdOucFlatHash &operator=(const XrdOucFlatHash &) = delete;
+
+private:
+
+static const int         grpSize  = 16;
+static const signed char ctlEmpty = -128;
+static const signed char ctlDead  = -2;
+static const int         headLen  = 24;
+
+// A slot fills a cache line and holds the start of the key so that short keys
+// are compared without following the key pointer.
+//
+struct Slot
+      {const char        *key;
+       T                 *data;
+       unsigned long      hash;
+       time_t             time;
+       int                count;
+       int                opts;
+       char               head[headLen]; // Key start, all of it if head ends in 0
+      };
+
+struct Table
+      {signed char       *ctl;
+       Slot              *slot;
+       unsigned int       size;   // Number of slots, a power of 2
+       unsigned int       used;   // Slots full or deleted
+       unsigned int       max;    // Maximum used slots before growing
+      };
+
+static const unsigned int stepSize = 2*grpSize; // Slots moved per update
+
+// XrdOucHashVal() is a simple fold of the key, so spread its bits before
+// taking the group index and the 7 bits kept in the control byte.
+//
+static
+unsigned long long Mix(unsigned long khash)
+                      {unsigned long long h = khash;
+                       h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+                       h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+                       return h ^ (h >> 33);
+                      }
+
+static
+unsigned int Match(const signed char *grp, signed char val);
+static
+unsigned int MatchFree(const signed char *grp);
+
+void         Alloc(Table &tab, unsigned int size);
+static
+bool         Same(const Slot &slot, unsigned long khash, const char *kval)
+                 {return slot.hash == khash
+                     && !strncmp(slot.head, kval, headLen)
+                     && (!slot.head[headLen-1]
+                         || !strcmp(slot.key+headLen, kval+headLen));
+                 }
+void         Destroy(Slot &slot);
+void         Expand();
+int          Locate(Table &tab, unsigned long khash, unsigned long long mix,
+                    const char *kval);
+Slot        &Place(Table &tab, unsigned long long mix);
+void         Remove(Table &tab, int sent);
+int          Search(const char *kval, unsigned long khash, Table *&tab);
+void         Step(unsigned int nslots);
+
+Table        cur;
+Table        old;                 // Being drained when old.slot is not nil
+unsigned int oldPos;              // Next slot in old to move
+int          hashnum;
+int          hashload;
+};
+
+/******************************************************************************/
+/*                 A c t u a l   I m p l e m e n t a t i o n                  */
+/******************************************************************************/
+
+#include "XrdOuc/XrdOucFlatHash.icc"
+#endif
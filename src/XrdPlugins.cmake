@@ -27,6 +27,7 @@ add_library(
   XrdPss/XrdPss.cc           XrdPss/XrdPss.hh
   XrdPss/XrdPssCks.cc        XrdPss/XrdPssCks.hh
   XrdPss/XrdPssConfig.cc
+  XrdPss/XrdPssPool.cc       XrdPss/XrdPssPool.hh
                              XrdPss/XrdPssTrace.hh
   XrdPss/XrdPssUrlInfo.cc    XrdPss/XrdPssUrlInfo.hh
   XrdPss/XrdPssUtils.cc      XrdPss/XrdPssUtils.hh )
@@ -124,6 +125,7 @@ add_library(
   XrdThrottle/XrdThrottleFileSystem.cc
   XrdThrottle/XrdThrottleFileSystemConfig.cc
   XrdThrottle/XrdThrottleFile.cc
+  XrdThrottle/XrdThrottleLatency.cc    XrdThrottle/XrdThrottleLatency.hh
   XrdThrottle/XrdThrottleManager.cc    XrdThrottle/XrdThrottleManager.hh
 )
 
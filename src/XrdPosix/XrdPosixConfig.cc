@@ -54,6 +54,7 @@
 #include "XrdPosix/XrdPosixInfo.hh"
 #include "XrdPosix/XrdPosixMap.hh"
 #include "XrdPosix/XrdPosixPrepIO.hh"
+#include "XrdPosix/XrdPosixRdAhead.hh"
 #include "XrdPosix/XrdPosixStats.hh"
 #include "XrdPosix/XrdPosixTrace.hh"
 #include "XrdPosix/XrdPosixXrootd.hh"
@@ -502,6 +503,37 @@ void XrdPosixConfig::SetDebug(int val)
    XrdPosixMap::SetDebug(val > 0);
 }
   
+/******************************************************************************/
+/*                            S e t R d A h e a d                             */
+/******************************************************************************/
+
+// Parse the XRDPOSIX_RDAHEAD envar which enables read-ahead for files opened
+// read-only when no cache is in use. Its value is a list of the following
+// (any value other than "0" enables read-ahead with the defaults):
+//
+// max=n - maximum read-ahead window per file (default 8m).
+// mem=n - total memory all files may use for read-ahead (default 256m).
+// min=n - initial read-ahead window per file (default 128k).
+//
+
+void XrdPosixConfig::SetRdAhead(char *eData)
+{
+   XrdOucEnv theEnv(eData);
+   long long minW = 128*1024, maxW = 8*1024*1024, mem = 256*1024*1024, Val;
+
+// A value of zero keeps read-ahead disabled
+//
+   if (!eData || !strcmp(eData, "0")) return;
+
+// Get the sizes (errors force a default)
+//
+   initEnv(theEnv, "max", Val); if (Val >= 0) maxW = Val;
+   initEnv(theEnv, "mem", Val); if (Val >= 0) mem  = Val;
+   initEnv(theEnv, "min", Val); if (Val >= 0) minW = Val;
+
+   XrdPosixRdAhead::SetParms(minW, maxW, mem);
+}
+
 /******************************************************************************/
 /*                                S e t E n v                                 */
 /******************************************************************************/
@@ -557,8 +589,7 @@ int XrdPosixConfig::Stats(const char *theID, char *buff, int blen)
 {
    static const char stats1[] = "<stats id=\"%s\">"
           "<open>%lld<errs>%lld</errs></open>"
-          "<close>%lld<errs>%lld</errs></close>"
-          "</stats>";
+          "<close>%lld<errs>%lld</errs></close>";
 
    static const char stats2[] = "<stats id=\"cache\" type=\"%s\">"
           "<prerd><in>%lld</in><hits>%lld</hits><miss>%lld</miss></prerd>"
@@ -587,7 +618,8 @@ int XrdPosixConfig::Stats(const char *theID, char *buff, int blen)
        int len1, digitsLL = strlen("9223372036854775807");
        std::string fmt = stats1;
        n = std::count(fmt.begin(), fmt.end(), '%');
-       len1 = fmt.size() + (digitsLL*n) - (n*3) + strlen(theID);
+       len1 = fmt.size() + (digitsLL*n) - (n*3) + strlen(theID)
+            + XrdPosixRdAhead::Stats(0, 0) + 8;
        if (!XrdPosixGlobals::theCache) return len1;
        fmt = stats2;
        n = std::count(fmt.begin(), fmt.end(), '%');
@@ -599,10 +631,16 @@ int XrdPosixConfig::Stats(const char *theID, char *buff, int blen)
    XrdPosixStats Y;
    XrdPosixGlobals::Stats.Get(Y);
 
-// Format the line
+// Format the line. Each piece is clamped to what fits as snprintf() returns
+// the length it wanted, not the length it wrote.
 //
-   int k = snprintf(buff, blen, stats1, theID,
-                    Y.X.Opens, Y.X.OpenErrs, Y.X.Closes, Y.X.CloseErrs);
+   int m, k = snprintf(buff, blen, stats1, theID,
+                       Y.X.Opens, Y.X.OpenErrs, Y.X.Closes, Y.X.CloseErrs);
+   if (k >= blen) k = blen-1;
+   m = XrdPosixRdAhead::Stats(buff+k, blen-k);
+   k += (m >= blen-k ? blen-k-1 : m);
+   m = snprintf(buff+k, blen-k, "</stats>");
+   k += (m >= blen-k ? blen-k-1 : m);
 
 // If there is no cache then there nothing to return
 //
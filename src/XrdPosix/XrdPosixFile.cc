@@ -43,6 +43,7 @@
 #include "XrdPosix/XrdPosixFile.hh"
 #include "XrdPosix/XrdPosixFileRH.hh"
 #include "XrdPosix/XrdPosixPrepIO.hh"
+#include "XrdPosix/XrdPosixRdAhead.hh"
 #include "XrdPosix/XrdPosixStats.hh"
 #include "XrdPosix/XrdPosixTrace.hh"
 #include "XrdPosix/XrdPosixXrootdPath.hh"
@@ -121,7 +122,7 @@ XrdPosixFile::XrdPosixFile(bool &aOK, const char *path, XrdPosixCallBack *cbP,
                            int Opts)
              : XCio((XrdOucCacheIO *)this), PrepIO(0),
                mySize(0), myAtime(0), myCtime(0), myMtime(0), myRdev(0),
-               myInode(0), myMode(0), theCB(cbP), fLoc(0), cOpt(0),
+               myInode(0), myMode(0), theCB(cbP), fLoc(0), rdAhead(0), cOpt(0),
                isStream(Opts & isStrm ? 1 : 0)
 {
 // Handle path generation. This is trickt as we may have two namespaces. One
@@ -151,6 +152,10 @@ XrdPosixFile::XrdPosixFile(bool &aOK, const char *path, XrdPosixCallBack *cbP,
   
 XrdPosixFile::~XrdPosixFile()
 {
+// Stop any read-ahead before closing the remote connection
+//
+   if (rdAhead) rdAhead->Detach();
+
 // Close the remote connection
 //
    if (clFile.IsOpen())
@@ -312,6 +317,10 @@ bool XrdPosixFile::Close(XrdCl::XRootDStatus &Status)
 //
    if (PrepIO) PrepIO->Disable();
 
+// Discard any read-ahead as nothing will be reading it
+//
+   if (rdAhead) {rdAhead->Detach(); rdAhead = 0;}
+
 // If we don't need to close the file, then return success. Otherwise, do the
 // actual close and return the status. We should have already been removed
 // from the file table at this point and should be unlocked.
@@ -354,6 +363,13 @@ bool XrdPosixFile::Finalize(XrdCl::XRootDStatus *Status)
          (XrdPosixGlobals::theCache->Statistics.X.OpenDefers), 1LL);
       }
 
+// Without a cache, files opened read-only may be read ahead (this is a no-op
+// unless read-ahead was enabled).
+//
+   else if (ioP == (XrdOucCacheIO *)this && !(cOpt & XrdOucCache::optRW)
+        &&  !XrdPosixGlobals::autoPGRD)
+           rdAhead = XrdPosixRdAhead::Attach(clFile, mySize);
+
    return true;
 }
   
@@ -570,6 +586,7 @@ int XrdPosixFile::Read (char *Buff, long long Offs, int Len)
 {
    XrdCl::XRootDStatus Status;
    uint32_t bytes;
+   int done = 0;
 
 // Handle automatic pgread
 //
@@ -579,13 +596,23 @@ int XrdPosixFile::Read (char *Buff, long long Offs, int Len)
        return pgrCB.Wait4PGIO();
       }
 
-// Issue read and return appropriately.
+// Take what we can from read-ahead; it also schedules the next prefetch
 //
    Ref();
+   if (rdAhead)
+      {bool eof;
+       int got = rdAhead->Read(Buff, Offs, Len, eof);
+       if (got == Len || eof) {unRef(); return got;}
+       Buff += got; Offs += got; Len -= got; done = got;
+      }
+
+// Issue read and return appropriately.
+//
    Status = clFile.Read((uint64_t)Offs, (uint32_t)Len, Buff, bytes);
    unRef();
 
-   return (Status.IsOK() ? (int)bytes : XrdPosixMap::Result(Status,ecMsg,false));
+   if (Status.IsOK()) return done + (int)bytes;
+   return (done ? done : XrdPosixMap::Result(Status,ecMsg,false));
 }
   
 /******************************************************************************/
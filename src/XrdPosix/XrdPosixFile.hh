@@ -54,6 +54,7 @@
 
 class XrdPosixCallBack;
 class XrdPosixPrepIO;
+class XrdPosixRdAhead;
 
 class XrdPosixFile : public XrdPosixObject, 
                      public XrdOucCacheIO,
@@ -210,6 +211,7 @@ union {long long         currOffset;
 char       *fPath;
 char       *fOpen;
 char       *fLoc;
+XrdPosixRdAhead *rdAhead;
 union {int  cOpt; int numTries;};
 char        isStream;
 };
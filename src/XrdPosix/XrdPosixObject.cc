@@ -30,6 +30,7 @@
 
 #include <cerrno>
 #include <fcntl.h>
+#include <sched.h>
 #include <sys/resource.h>
 #include <sys/stat.h>
 
@@ -52,7 +53,7 @@ extern thread_local XrdOucECMsg ecMsg;
 /******************************************************************************/
 
 XrdSysMutex      XrdPosixObject::fdMutex;
-XrdPosixObject **XrdPosixObject::myFiles  =  0;
+std::atomic<XrdPosixObject *> *XrdPosixObject::myFiles = 0;
 int              XrdPosixObject::highFD   = -1;
 int              XrdPosixObject::lastFD   = -1;
 int              XrdPosixObject::baseFD   =  0;
@@ -60,6 +61,43 @@ int              XrdPosixObject::freeFD   =  0;
 int              XrdPosixObject::posxFD   =  0;
 int              XrdPosixObject::devNull  = -1;
 
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+// Threads looking up an object count themselves in one of two epochs, using
+// one of several cells per epoch so that they rarely share a cache line. The
+// epoch is checked again after counting in; had it flipped in between, the
+// count may have been missed by Quiesce() and the reader must try again.
+//
+namespace
+{
+static const int rdrCells = 16;
+
+struct alignas(64) rdrCell {std::atomic<int> num[2];};
+
+rdrCell          rdrCount[rdrCells];
+std::atomic<int> rdrEpoch{0};
+std::atomic<int> rdrNext{0};
+thread_local int rdrMine = -1;
+
+int rdrEnter()
+{
+   int cell, epoch;
+
+   if (rdrMine < 0) rdrMine = rdrNext++ % rdrCells;
+   cell = rdrMine;
+   do {epoch = rdrEpoch.load();
+       rdrCount[cell].num[epoch]++;
+       if (rdrEpoch.load() == epoch) break;
+       rdrCount[cell].num[epoch]--;
+      } while(true);
+   return (cell << 1) | epoch;
+}
+
+void rdrExit(int slot) {rdrCount[slot >> 1].num[slot & 1]--;}
+}
+
 /******************************************************************************/
 /*                              A s s i g n F D                               */
 /******************************************************************************/
@@ -74,23 +112,23 @@ bool XrdPosixObject::AssignFD(bool isStream)
 //
    if (baseFD)
       { if (isStream) return 0;
-        for (fd = freeFD; fd < posxFD && myFiles[fd]; fd++) {}
+        for (fd = freeFD; fd < posxFD && myFiles[fd].load(); fd++) {}
         if (fd >= posxFD) return 0;
         freeFD = fd+1;
       } else {
         do{if ((fd = dup(devNull)) < 0) return false;
            if (fd >= lastFD || (isStream && fd > 255))
               {close(fd); return 0;}
-           if (!myFiles[fd]) break;
+           if (!myFiles[fd].load()) break;
            DMSG("AssignFD", "FD " <<fd <<" closed outside of XrdPosix!");
           } while(1);
       }
 
 // Enter object in out vector of objects and assign it the FD
 //
-   myFiles[fd] = this;
-   if (fd > highFD) highFD = fd;
    fdNum  = fd + baseFD;
+   if (fd > highFD) highFD = fd;
+   myFiles[fd].store(this);
 
 // All done.
 //
@@ -105,46 +143,15 @@ XrdPosixDir *XrdPosixObject::Dir(int fd, bool glk)
 {
    XrdPosixDir    *dP;
    XrdPosixObject *oP;
-   int  waitCount = 0;
-   bool haveLock;
 
-// Validate the fildes
+// Find the object and make sure it is a directory
 //
-do{if (fd >= lastFD || fd < baseFD)
-      {errno = EBADF; return (XrdPosixDir *)0;}
+   if (!(oP = Lookup(fd, glk))) return (XrdPosixDir *)0;
+   if (oP->Who(&dP)) return dP;
 
-// Obtain the file object, if any
-//
-   fdMutex.Lock();
-   if (!(oP = myFiles[fd - baseFD]) || !(oP->Who(&dP)))
-      {fdMutex.UnLock(); errno = EBADF; return (XrdPosixDir *)0;}
-
-// Attempt to lock the object in the appropriate mode. If we fail, then we need
-// to retry this after dropping the global lock. We pause a bit to let the
-// current lock holder a chance to unlock the lock. We only do this a limited
-// amount of time (1 minute) so that we don't get stuck here forever.
-//
-   if (glk) haveLock = oP->objMutex.CondWriteLock();
-      else  haveLock = oP->objMutex.CondReadLock();
-   if (!haveLock)
-      {fdMutex.UnLock();
-       waitCount++;
-       if (waitCount > 120) break;
-       XrdSysTimer::Wait(500); // We wait 500 milliseconds
-       continue;
-      }
-
-// If the global lock is to be held, then release the object lock as this
-// is a call to destroy the object and there is no need for the local lock.
-//
-   if (glk) oP->UnLock();
-      else  fdMutex.UnLock();
-   return dP;
-  } while(1);
-
-// If we get here then we timedout waiting for the object lock
-//
-   errno = ETIMEDOUT;
+   oP->UnLock();
+   if (glk) fdMutex.UnLock();
+   errno = EBADF;
    return (XrdPosixDir *)0;
 }
   
@@ -156,46 +163,15 @@ XrdPosixFile *XrdPosixObject::File(int fd, bool glk)
 {
    XrdPosixFile   *fP;
    XrdPosixObject *oP;
-   int  waitCount = 0;
-   bool haveLock;
-
-// Validate the fildes
-//
-do{if (fd >= lastFD || fd < baseFD)
-      {errno = EBADF; return (XrdPosixFile *)0;}
-
-// Obtain the file object, if any
-//
-   fdMutex.Lock();
-   if (!(oP = myFiles[fd - baseFD]) || !(oP->Who(&fP)))
-      {fdMutex.UnLock(); errno = EBADF; return (XrdPosixFile *)0;}
-
-// Attempt to lock the object in the appropriate mode. If we fail, then we need
-// to retry this after dropping the global lock. We pause a bit to let the
-// current lock holder a chance to unlock the lock. We only do this a limited
-// amount of time (1 minute) so that we don't get stuck here forever.
-//
-   if (glk) haveLock = oP->objMutex.CondWriteLock();
-      else  haveLock = oP->objMutex.CondReadLock();
-   if (!haveLock)
-      {fdMutex.UnLock();
-       waitCount++;
-       if (waitCount > 120) break;
-       XrdSysTimer::Wait(500); // We wait 500 milliseconds
-       continue;
-      }
 
-// If the global lock is to be held, then release the object lock as this
-// is a call to destroy the object and there is no need for the local lock.
+// Find the object and make sure it is a file
 //
-   if (glk) oP->UnLock();
-      else  fdMutex.UnLock();
-   return fP;
-  } while(1);
+   if (!(oP = Lookup(fd, glk))) return (XrdPosixFile *)0;
+   if (oP->Who(&fP)) return fP;
 
-// If we get here then we timedout waiting for the object lock
-//
-   errno = ETIMEDOUT;
+   oP->UnLock();
+   if (glk) fdMutex.UnLock();
+   errno = EBADF;
    return (XrdPosixFile *)0;
 }
 
@@ -235,11 +211,11 @@ int XrdPosixObject::Init(int fdnum)
 //
    if (fdnum < 0) {posxFD = fdnum = -fdnum; baseFD = limfd;}
       else         fdnum = limfd;
-   isize = fdnum * sizeof(XrdPosixFile *);
+   isize = fdnum * sizeof(std::atomic<XrdPosixObject *>);
 
 // Allocate the table for fd-type pointers
 //
-   if (!(myFiles = (XrdPosixObject **)malloc(isize))) lastFD = -1;
+   if (!(myFiles = (std::atomic<XrdPosixObject *> *)malloc(isize))) lastFD = -1;
       else {memset((void *)myFiles, 0, isize); lastFD = fdnum+baseFD;}
 
 // All done
@@ -247,13 +223,90 @@ int XrdPosixObject::Init(int fdnum)
    return baseFD;
 }
 
+/******************************************************************************/
+/* Private:                       L o o k u p                                 */
+/******************************************************************************/
+
+XrdPosixObject *XrdPosixObject::Lookup(int fd, bool glk)
+{
+   XrdPosixObject *oP;
+   int  rdrSlot = 0, waitCount = 0;
+   bool haveLock;
+
+// Validate the fildes
+//
+do{if (fd >= lastFD || fd < baseFD)
+      {errno = EBADF; return (XrdPosixObject *)0;}
+
+// Obtain the object, if any. Ordinary lookups take no global lock; they only
+// announce themselves so that the object is not freed while they look at it.
+// A lookup to release the object holds the global lock until it is released.
+//
+   if (glk) fdMutex.Lock();
+      else  rdrSlot = rdrEnter();
+   if (!(oP = myFiles[fd - baseFD].load()))
+      {if (glk) fdMutex.UnLock();
+          else  rdrExit(rdrSlot);
+       errno = EBADF; return (XrdPosixObject *)0;
+      }
+
+// Attempt to lock the object in the appropriate mode. Once locked, an ordinary
+// lookup must verify the object was not removed from the table in the interim.
+// If we fail, we retry after a pause to give the current lock holder a chance
+// to unlock; unless the object is gone. We only do this a limited amount of
+// time (1 minute) so that we don't get stuck here forever.
+//
+   if (glk) haveLock = oP->objMutex.CondWriteLock();
+      else  haveLock = oP->objMutex.CondReadLock();
+   if (glk)
+      {if (haveLock) return oP;
+       fdMutex.UnLock();
+      } else {
+       bool isGone = (myFiles[fd - baseFD].load() != oP);
+       if (haveLock && isGone) oP->UnLock();
+       rdrExit(rdrSlot);
+       if (isGone) {errno = EBADF; return (XrdPosixObject *)0;}
+       if (haveLock) return oP;
+      }
+   waitCount++;
+   if (waitCount > 120) break;
+   XrdSysTimer::Wait(500); // We wait 500 milliseconds
+  } while(1);
+
+// If we get here then we timedout waiting for the object lock
+//
+   errno = ETIMEDOUT;
+   return (XrdPosixObject *)0;
+}
+
+/******************************************************************************/
+/* Private:                      Q u i e s c e                                */
+/******************************************************************************/
+
+void XrdPosixObject::Quiesce()
+{
+   static XrdSysMutex qMutex;
+   XrdSysMutexHelper qHelper(qMutex);
+   int epoch = rdrEpoch.load();
+
+// Start a new epoch and wait for all lookups in the old one to finish. A lookup
+// that counted itself in the old one after this point sees the flip and moves
+// to the new one; it then only finds what is still in the table. Lookups are
+// short and never block.
+//
+   rdrEpoch.store(epoch ^ 1);
+   for (int i = 0; i < rdrCells; i++)
+       while(rdrCount[i].num[epoch].load()) sched_yield();
+}
+
 /******************************************************************************/
 /*                               R e l e a s e                                */
 /******************************************************************************/
   
 void XrdPosixObject::Release(XrdPosixObject *oP, bool needlk)
 {
-// Get the lock if need be
+// Get the lock if need be. Otherwise, we were called with the object locked
+// by Dir() or File().
 //
    if (needlk) fdMutex.Lock();
 
@@ -262,16 +315,21 @@ void XrdPosixObject::Release(XrdPosixObject *oP, bool needlk)
    if (baseFD)
       {int myFD = oP->fdNum - baseFD;
        if (myFD < freeFD) freeFD = myFD;
-       myFiles[myFD] = 0;
+       myFiles[myFD].store(0);
       } else {
-       myFiles[oP->fdNum] = 0;
+       myFiles[oP->fdNum].store(0);
        close(oP->fdNum);
       }
 
-// Zorch the object fd and release the global lock
+// Zorch the object fd and release the locks
 //
    oP->fdNum = -1;
+   if (!needlk) oP->UnLock();
    fdMutex.UnLock();
+
+// Make sure no one is still looking at the object before the caller frees it
+//
+   Quiesce();
 }
 
 /******************************************************************************/
@@ -324,8 +382,8 @@ void XrdPosixObject::Shutdown()
    fdMutex.Lock();
    if (myFiles)
       {for (i = 0; i <= highFD; i++) 
-           if ((oP = myFiles[i]))
-              {myFiles[i] = 0;
+           if ((oP = myFiles[i].load()))
+              {myFiles[i].store(0);
                if (oP->fdNum >= 0) close(oP->fdNum);
                oP->fdNum = -1;
                delete oP;
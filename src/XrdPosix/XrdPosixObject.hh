@@ -30,6 +30,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucECMsg.hh"
@@ -62,15 +63,9 @@ static  int           Init(int numfd);
                               else objMutex.ReadLock();
                           }
 
-        void          Ref()    {AtomicBeg(updMutex);
-                                AtomicInc(refCnt);
-                                AtomicEnd(updMutex);
-                               }
-        int           Refs()   {AtomicRet(updMutex, refCnt);}
-        void          unRef()  {AtomicBeg(updMutex);
-                                AtomicDec(refCnt);
-                                AtomicEnd(updMutex);
-                               }
+        void          Ref()    {refCnt.fetch_add(1, std::memory_order_relaxed);}
+        int           Refs()   {return refCnt.load(std::memory_order_acquire);}
+        void          unRef()  {refCnt.fetch_sub(1, std::memory_order_acq_rel);}
 
 static  void          Release(XrdPosixObject *oP, bool needlk=true);
 
@@ -84,7 +79,7 @@ static  void          Shutdown();
 
 static  bool          Valid(int fd)
                            {return fd >= baseFD && fd <= (highFD+baseFD)
-                                   && myFiles && myFiles[fd-baseFD];}
+                                   && myFiles && myFiles[fd-baseFD].load();}
 
 virtual bool          Who(XrdPosixDir  **dirP)  {return false;}
 
@@ -99,12 +94,19 @@ protected:
        XrdSysRecMutex   updMutex;
        XrdSysRWLock     objMutex;
        int              fdNum;
-       int              refCnt;
+       std::atomic<int> refCnt;
 
 private:
 
+static XrdPosixObject *Lookup(int fd, bool glk);
+static void            Quiesce();
+
+// The fd table is read without a lock. An object removed from the table is
+// not released to the caller until every thread that may have fetched it
+// before the removal has finished looking at it (see Quiesce()).
+//
 static XrdSysMutex      fdMutex;
-static XrdPosixObject **myFiles;
+static std::atomic<XrdPosixObject *> *myFiles;
 static int              lastFD;
 static int              highFD;
 static int              baseFD;
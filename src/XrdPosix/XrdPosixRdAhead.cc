@@ -0,0 +1,309 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d P o s i x R d A h e a d . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "XrdCl/XrdClFile.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+
+#include "XrdPosix/XrdPosixRdAhead.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+class XrdPosixRdAhead::Block : public XrdCl::ResponseHandler
+{
+public:
+
+void HandleResponse(XrdCl::XRootDStatus *status,
+                    XrdCl::AnyObject    *response) override
+                   {XrdCl::ChunkInfo *cInfo = 0;
+                    if (status->IsOK() && response) response->Get(cInfo);
+                    result = (cInfo ? (int)cInfo->length : -1);
+                    delete status;
+                    if (response) delete response;
+                    raP->Done(this);
+                   }
+
+XrdPosixRdAhead *raP;
+Block           *next;
+char            *buff;
+long long        offs;
+int              blen;
+int              used;
+int              result;
+bool             done;
+bool             orphan;
+
+     Block(XrdPosixRdAhead *rp, char *bp, long long off, int len)
+          : raP(rp), next(0), buff(bp), offs(off), blen(len), used(0),
+            result(0), done(false), orphan(false) {}
+    ~Block() {if (buff) free(buff);}
+};
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+long long              XrdPosixRdAhead::minWin  = 128*1024;
+long long              XrdPosixRdAhead::maxWin  = 0;
+long long              XrdPosixRdAhead::memMax  = 256*1024*1024;
+std::atomic<long long> XrdPosixRdAhead::memUsed{0};
+std::atomic<long long> XrdPosixRdAhead::bytesFetched{0};
+std::atomic<long long> XrdPosixRdAhead::bytesHit{0};
+std::atomic<long long> XrdPosixRdAhead::bytesWasted{0};
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdPosixRdAhead::XrdPosixRdAhead(XrdCl::File &clf, long long fsz)
+                : raCond(0, "RdAhead"), clFile(clf), bFirst(0), bLast(0),
+                  fileSize(fsz), nextOffs(0), window(minWin), inFlight(0),
+                  detached(false)
+{}
+
+/******************************************************************************/
+/*                                A t t a c h                                 */
+/******************************************************************************/
+
+XrdPosixRdAhead *XrdPosixRdAhead::Attach(XrdCl::File &clFile, long long fSize)
+{
+// Files that fit in the initial window gain nothing from read-ahead
+//
+   if (!maxWin || fSize <= minWin) return 0;
+   return new XrdPosixRdAhead(clFile, fSize);
+}
+
+/******************************************************************************/
+/*                                D e t a c h                                 */
+/******************************************************************************/
+
+void XrdPosixRdAhead::Detach()
+{
+   bool doDel;
+
+// Discard all prefetched data. Blocks still in flight are freed as they
+// complete and the last one to complete deletes this object.
+//
+   raCond.Lock();
+   detached = true;
+   Reset();
+   doDel = (inFlight == 0);
+   raCond.UnLock();
+   if (doDel) delete this;
+}
+
+/******************************************************************************/
+/* Private:                         D o n e                                   */
+/******************************************************************************/
+
+void XrdPosixRdAhead::Done(Block *bP)
+{
+   bool doDel;
+
+// Mark the block complete and wake up anyone waiting for it. Blocks that were
+// discarded while in flight are simply freed.
+//
+   raCond.Lock();
+   bP->done = true;
+   inFlight--;
+   if (bP->orphan) Drop(bP);
+   doDel = (detached && inFlight == 0);
+   raCond.Broadcast();
+   raCond.UnLock();
+   if (doDel) delete this;
+}
+
+/******************************************************************************/
+/* Private:                         D r o p                                   */
+/******************************************************************************/
+
+void XrdPosixRdAhead::Drop(Block *bP)
+{
+   if (bP->result > bP->used) bytesWasted += bP->result - bP->used;
+   memUsed -= bP->blen;
+   delete bP;
+}
+
+/******************************************************************************/
+/* Private:                        F e t c h                                  */
+/******************************************************************************/
+
+void XrdPosixRdAhead::Fetch(long long offs)
+{
+   XrdCl::XRootDStatus Status;
+   Block *bP;
+   char  *buff;
+   long long endOffs = nextOffs + window;
+   int    bsz = BlkSize(), blen;
+
+// Continue from the last block already requested, if any, and never go past
+// the end of the file.
+//
+   if (bLast && bLast->offs + bLast->blen > offs)
+      offs = bLast->offs + bLast->blen;
+   if (endOffs > fileSize) endOffs = fileSize;
+
+// Issue reads for full blocks (the last one may be short at end of file) as
+// long as the memory budget allows.
+//
+   while(offs < endOffs)
+        {blen = (endOffs - offs < bsz ? endOffs - offs : bsz);
+         if (blen < bsz && endOffs != fileSize) break;
+         if (memUsed.fetch_add(blen) + blen > memMax)
+            {memUsed -= blen; break;}
+         if (!(buff = (char *)malloc(blen))) {memUsed -= blen; break;}
+         bP = new Block(this, buff, offs, blen);
+         Status = clFile.Read((uint64_t)offs, (uint32_t)blen, buff, bP);
+         if (!Status.IsOK()) {memUsed -= blen; delete bP; break;}
+         if (bLast) bLast->next = bP;
+            else bFirst = bP;
+         bLast = bP;
+         inFlight++;
+         bytesFetched += blen;
+         offs += blen;
+        }
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+int XrdPosixRdAhead::Read(char *buff, long long offs, int rlen, bool &eof)
+{
+   Block *bP;
+   int avail, n, got = 0;
+   bool isSeq, isShort;
+
+// A read that does not continue where the last one ended means the file is not
+// being read sequentially; collapse the window and discard what we fetched.
+//
+   eof = false;
+   raCond.Lock();
+   if (!(isSeq = (offs == nextOffs))) {Reset(); window = minWin;}
+   nextOffs = offs + rlen;
+
+// A read of at least a block is done by the caller in one request. Serving it
+// here would only add a copy and queue yet more prefetches behind it, so it
+// bypasses read-ahead and whatever was prefetched for it is discarded.
+//
+   if (rlen >= BlkSize()) {Reset(); raCond.UnLock(); return 0;}
+
+// Copy out whatever prefetched data covers the start of the request, waiting
+// for blocks that are still in flight. A failed prefetch is not an error; the
+// caller will simply read the data itself.
+//
+   while(rlen > 0 && (bP = bFirst) && bP->offs <= offs)
+        {if (bP->done || bP->offs + bP->blen <= offs)
+            {if (bP->done && bP->result < 0) {Reset(); break;}
+             avail = (bP->done ? bP->offs + bP->result - offs : 0);
+             if (avail > 0)
+                {n = (avail < rlen ? avail : rlen);
+                 memcpy(buff+got, bP->buff + (offs - bP->offs), n);
+                 bP->used += n; got += n; offs += n; rlen -= n;
+                 if (n < avail) break;
+                }
+             isShort = bP->done && bP->result < bP->blen;
+             if (isShort) eof = (bP->offs + bP->result >= fileSize);
+             if (!(bFirst = bP->next)) bLast = 0;
+             if (bP->done) Drop(bP);
+                else bP->orphan = true;
+             if (isShort) break;
+            } else raCond.Wait();
+        }
+
+// Open the window when prefetching paid off and keep it filled as long as the
+// file is being read sequentially.
+//
+   if (got)
+      {bytesHit += got;
+       if (window < maxWin) window = (window*2 < maxWin ? window*2 : maxWin);
+      }
+   if (isSeq && !eof) Fetch(offs + rlen);
+   raCond.UnLock();
+   return got;
+}
+
+/******************************************************************************/
+/* Private:                        R e s e t                                  */
+/******************************************************************************/
+
+void XrdPosixRdAhead::Reset()
+{
+   Block *bP;
+
+// Free completed blocks; those still in flight are freed when they complete
+//
+   while((bP = bFirst))
+        {bFirst = bP->next;
+         if (bP->done) Drop(bP);
+            else bP->orphan = true;
+        }
+   bLast = 0;
+}
+
+/******************************************************************************/
+/*                              S e t P a r m s                               */
+/******************************************************************************/
+
+void XrdPosixRdAhead::SetParms(long long minW, long long maxW, long long mem)
+{
+// Blocks are at most a quarter of the maximum window and must fit in an int
+//
+   if (minW < 4096) minW = 4096;
+   if (maxW > 1024LL*1024*1024) maxW = 1024LL*1024*1024;
+   if (maxW && maxW < minW) maxW = minW;
+
+   minWin = minW;
+   maxWin = maxW;
+   memMax = mem;
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdPosixRdAhead::Stats(char *buff, int blen)
+{
+   static const char statfmt[] = "<rdahead><fetched>%lld</fetched>"
+          "<hits>%lld</hits><waste>%lld</waste><mem>%lld</mem></rdahead>";
+
+// Return the maximum length if so wanted; nothing is reported when disabled
+//
+   if (!maxWin) return 0;
+   if (!blen) return sizeof(statfmt) + 4*16;
+
+   return snprintf(buff, blen, statfmt, bytesFetched.load(), bytesHit.load(),
+                   bytesWasted.load(), memUsed.load());
+}
@@ -0,0 +1,116 @@
+#ifndef __XRDPOSIXRDAHEAD_HH__
+#define __XRDPOSIXRDAHEAD_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d P o s i x R d A h e a d . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+namespace XrdCl {class File;}
+
+/******************************************************************************/
+/*                 C l a s s   X r d P o s i x R d A h e a d                  */
+/******************************************************************************/
+
+// XrdPosixRdAhead prefetches data for a file that is being read sequentially.
+// Each file has its own window which starts at the minimum size and doubles
+// each time a read is satisfied from prefetched data, up to the maximum. Any
+// read that does not start where the previous one ended collapses the window
+// and discards whatever was prefetched. Prefetches are issued as asynchronous
+// XrdCl reads of at most a quarter of the window each and all files share a
+// single memory budget; when it is exhausted no further prefetches are issued
+// until prefetched data has been consumed or discarded. Reads of at least a
+// block are left to the caller as they gain nothing from being prefetched.
+//
+// Read-ahead is off by default. It is enabled by SetParms() which is driven by
+// the XRDPOSIX_RDAHEAD envar (see XrdPosixConfig::SetRdAhead()).
+
+class XrdPosixRdAhead
+{
+public:
+
+// Return a read-ahead object for a file of fSize bytes or nil when read-ahead
+// is not enabled. The clFile object must remain valid until Detach().
+//
+static XrdPosixRdAhead *Attach(XrdCl::File &clFile, long long fSize);
+
+// Disassociate the object from its file. The object is deleted as soon as
+// all outstanding prefetches have completed; the caller must not use it again.
+//
+       void   Detach();
+
+// Copy as much of the requested range as possible from prefetched data and
+// schedule further prefetches. The return value is the number of bytes copied
+// from the start of the range (possibly zero); the caller must read the rest.
+// Nothing is copied nor prefetched for a read of at least a block.
+// Upon return, eof is true if the file ends at the returned length.
+//
+       int    Read(char *buff, long long offs, int rlen, bool &eof);
+
+// Set the read-ahead parameters; a zero maximum window disables read-ahead.
+//
+static void   SetParms(long long minW, long long maxW, long long mem);
+
+// Return read-ahead statistics in XML format.
+//
+static int    Stats(char *buff, int blen);
+
+private:
+class Block;
+
+            XrdPosixRdAhead(XrdCl::File &clf, long long fsz);
+           ~XrdPosixRdAhead() {}
+
+int         BlkSize() {return (int)(window/4 > minWin ? window/4 : minWin);}
+void        Done(Block *bP);
+void        Drop(Block *bP);
+void        Fetch(long long offs);
+void        Reset();
+
+XrdSysCondVar raCond;
+XrdCl::File  &clFile;
+Block        *bFirst;
+Block        *bLast;
+long long     fileSize;
+long long     nextOffs;
+long long     window;
+int           inFlight;
+bool          detached;
+
+static long long              minWin;
+static long long              maxWin;
+static long long              memMax;
+static std::atomic<long long> memUsed;
+static std::atomic<long long> bytesFetched;
+static std::atomic<long long> bytesHit;
+static std::atomic<long long> bytesWasted;
+};
+#endif
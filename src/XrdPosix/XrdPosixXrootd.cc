@@ -216,6 +216,11 @@ XrdPosixXrootd::XrdPosixXrootd(int fdnum, int dirnum, int thrnum)
           }
       }
 
+// Enable read-ahead if so wanted
+//
+   if ((cfn = getenv("XRDPOSIX_RDAHEAD")) && *cfn)
+      XrdPosixConfig::SetRdAhead(cfn);
+
 // Initialize file tracking
 //
    baseFD = XrdPosixObject::Init(fdnum);
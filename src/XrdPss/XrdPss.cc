@@ -51,9 +51,11 @@
 
 #include "XrdNet/XrdNetSecurity.hh"
 #include "XrdPss/XrdPss.hh"
+#include "XrdPss/XrdPssPool.hh"
 #include "XrdPss/XrdPssTrace.hh"
 #include "XrdPss/XrdPssUrlInfo.hh"
 #include "XrdPss/XrdPssUtils.hh"
+#include "XrdPosix/XrdPosixCallBack.hh"
 #include "XrdPosix/XrdPosixConfig.hh"
 #include "XrdPosix/XrdPosixExtra.hh"
 #include "XrdPosix/XrdPosixInfo.hh"
@@ -126,9 +128,39 @@ static const int     PBsz = 4096;
        bool          xrdProxy = false; // True means dest using xroot protocol
 
        XrdSysTrace SysTrace("Pss",0);
+
+// Large readv requests are split into segments that are sent to the origin
+// concurrently. A segment covers at least rvSegMin bytes; note that the
+// protocol layer already limits each request to its buffer size (2MB).
+//
+static const int     rvSegMax = 8;
+static const int     rvSegMin = 256*1024;
 }
 using namespace XrdProxy;
 
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+class rvSegCB : public XrdPosixCallBackIO
+{
+public:
+
+void    Complete(ssize_t result) override
+                {rvResult = (result < 0 ? -errno : result);
+                 rvSem->Post();
+                }
+
+ssize_t          rvResult;
+XrdSysSemaphore *rvSem;
+
+        rvSegCB() : rvResult(0), rvSem(0) {}
+       ~rvSegCB() {}
+};
+}
+
 /******************************************************************************/
 /*                XrdOssGetSS (a.k.a. XrdOssGetStorageSystem)                 */
 /******************************************************************************/
@@ -526,7 +558,17 @@ int XrdPssSys::Stat(const char *path, struct stat *buff, int Opts, XrdOucEnv *eP
 */
 int XrdPssSys::Stats(char *bp, int bl)
 {
-   return XrdPosixConfig::Stats("pss", bp, bl);
+   int n;
+
+// Return the maximum length if so wanted
+//
+   if (!bl) return XrdPosixConfig::Stats("pss", bp, 0)
+                 + XrdPssPool::Stats(bp, 0);
+
+// Add the connection pool statistics, if any, to the posix statistics
+//
+   if (!(n = XrdPosixConfig::Stats("pss", bp, bl)) || n >= bl) return n;
+   return n + XrdPssPool::Stats(bp+n, bl-n);
 }
 
 /******************************************************************************/
@@ -833,15 +875,20 @@ int XrdPssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
    if (!XrdProxy::outProxy && *path == '/' && !(XRDEXP_STAGE & popts))
       Cgi = osslclCGI;
 
-// Construct the url info
+// Construct the url info. When we have a connection pool the file is opened
+// through one of the pooled channels instead of the client's own.
 //
    XrdPssUrlInfo uInfo(&Env, path, Cgi, ucgiOK);
-   uInfo.setID();
+   if (XrdPssPool::Active())
+      {char poolID[12];
+       poolSlot = XrdPssPool::Acquire(poolID, sizeof(poolID));
+       uInfo.setPoolID(poolID);
+      } else uInfo.setID();
 
 // Convert path to URL
 //
    if ((rc = XrdPssSys::P2URL(pbuff, PBsz, uInfo, XrdPssSys::xLfn2Pfn)))
-      return rc;
+      return OpenFail(rc);
 
 // Do some tracing
 //
@@ -849,24 +896,39 @@ int XrdPssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
 
 // Try to open and if we failed, return an error
 //
+   long long begNS = XrdPssPool::Now();
    if (!XrdPssSys::dcaCheck || !ioCache)
-      {if ((fd = XrdPosixXrootd::Open(pbuff,Oflag,Mode)) < 0) return -errno;
+      {if ((fd = XrdPosixXrootd::Open(pbuff,Oflag,Mode)) < 0)
+          return OpenFail(-errno);
       } else {
        XrdPosixInfo Info;
        Info.ffReady = XrdPssSys::dcaWorld;
        if (XrdPosixConfig::OpenFC(pbuff,Oflag,Mode,Info))
           {Env.Put("FileURL", Info.cacheURL);
-           return -EDESTADDRREQ;
+           return OpenFail(-EDESTADDRREQ);
           }
        fd = Info.fileFD;
-       if (fd < 0) return -errno;
+       if (fd < 0) return OpenFail(-errno);
       }
+   XrdPssPool::Opened(XrdPssPool::Now() - begNS);
 
 // All done
 //
    return XrdOssOK;
 }
 
+/******************************************************************************/
+/* Private:                     O p e n F a i l                               */
+/******************************************************************************/
+
+int XrdPssFile::OpenFail(int rc)
+{
+// Give back the pool slot, if any, as the file will not be using it
+//
+   if (poolSlot >= 0) {XrdPssPool::Release(poolSlot); poolSlot = -1;}
+   return rc;
+}
+
 /******************************************************************************/
 /*                                 c l o s e                                  */
 /******************************************************************************/
@@ -898,6 +960,7 @@ int XrdPssFile::Close(long long *retsz)
 //
     rc = XrdPosixXrootd::Close(fd);
     fd = -1;
+    if (poolSlot >= 0) {XrdPssPool::Release(poolSlot); poolSlot = -1;}
     return (rc == 0 ? XrdOssOK : -errno);
 }
 
@@ -1081,11 +1144,49 @@ ssize_t XrdPssFile::ReadV(XrdOucIOVec     *readV,     // In
             an error.
 */
 {
-    ssize_t retval;
+    XrdSysSemaphore rvSem(0);
+    rvSegCB   segCB[rvSegMax];
+    ssize_t   retval;
+    long long rvBytes = 0, segBytes, n;
+    int       i, j, k, nSeg;
 
     if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
-    return (retval = XrdPosixXrootd::VRead(fd, readV, readCount)) < 0 ? (ssize_t)-errno : retval;;
+// Determine how many segments are worth sending concurrently. Small requests
+// are simply forwarded as a single readv and waited for.
+//
+    for (i = 0; i < readCount; i++) rvBytes += readV[i].size;
+    nSeg = static_cast<int>(rvBytes / rvSegMin);
+    if (nSeg > rvSegMax)  nSeg = rvSegMax;
+    if (nSeg > readCount) nSeg = readCount;
+    if (nSeg < 2)
+       return (retval = XrdPosixXrootd::VRead(fd, readV, readCount)) < 0
+              ? (ssize_t)-errno : retval;
+
+// Issue each segment asynchronously. The elements are forwarded in place so
+// data goes straight from the origin's response into the caller's buffers.
+// Each segment gets roughly the same number of bytes and at least one element.
+//
+    segBytes = rvBytes / nSeg;
+    for (i = 0, j = 0; i < nSeg; i++)
+        {k = j; n = 0;
+         if (i == nSeg-1) k = readCount;
+            else while(k < readCount - (nSeg-1-i) && (k == j || n < segBytes))
+                       n += readV[k++].size;
+         segCB[i].rvSem = &rvSem;
+         XrdPosixXrootd::VRead(fd, readV+j, k-j, &segCB[i]);
+         j = k;
+        }
+
+// Wait for all of the segments to complete before looking at the results as
+// the caller's buffers must not be released while any segment is in flight.
+//
+    for (i = 0; i < nSeg; i++) rvSem.Wait();
+    for (i = 0, retval = 0; i < nSeg; i++)
+        {if (segCB[i].rvResult < 0) return segCB[i].rvResult;
+         retval += segCB[i].rvResult;
+        }
+    return retval;
 }
 
 /******************************************************************************/
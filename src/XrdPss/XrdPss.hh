@@ -103,7 +103,7 @@ int     Write(XrdSfsAio *aiop);
          // Constructor and destructor
          XrdPssFile(const char *tid)
                    : XrdOssDF(tid, XrdOssDF::DF_isFile|XrdOssDF::DF_isProxy),
-                     rpInfo(0), tpcPath(0), entity(0) {}
+                     rpInfo(0), tpcPath(0), entity(0), poolSlot(-1) {}
 
 virtual ~XrdPssFile() {if (fd >= 0) Close();
                        if (rpInfo) delete(rpInfo);
@@ -112,6 +112,8 @@ virtual ~XrdPssFile() {if (fd >= 0) Close();
 
 private:
 
+int     OpenFail(int rc);
+
 struct tprInfo
       {char  *tprPath;
        char  *dstURL;
@@ -126,6 +128,7 @@ struct tprInfo
 
       char         *tpcPath;
 const XrdSecEntity *entity;
+      int           poolSlot;
 };
 
 /******************************************************************************/
@@ -228,6 +231,7 @@ int    xdca( XrdSysError *errp,   XrdOucStream &Config);
 int    xexp( XrdSysError *Eroute, XrdOucStream &Config);
 int    xperm(XrdSysError *errp,   XrdOucStream &Config);
 int    xpers(XrdSysError *errp,   XrdOucStream &Config);
+int    xpool(XrdSysError *Eroute, XrdOucStream &Config);
 int    xorig(XrdSysError *errp,   XrdOucStream &Config);
 };
 #endif
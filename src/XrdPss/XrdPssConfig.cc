@@ -45,6 +45,7 @@
 #include "XrdNet/XrdNetSecurity.hh"
 
 #include "XrdPss/XrdPss.hh"
+#include "XrdPss/XrdPssPool.hh"
 #include "XrdPss/XrdPssTrace.hh"
 #include "XrdPss/XrdPssUrlInfo.hh"
 #include "XrdPss/XrdPssUtils.hh"
@@ -343,6 +344,16 @@ int XrdPssSys::Configure(const char *cfn, XrdOucEnv *envP)
           }
       }
 
+// Start the connection pool. The pool ids hide the client's identity from the
+// origin so pooling is not possible when client personas are in use.
+//
+   if (XrdPssPool::Configured())
+      {if (sssMap == XrdSecsssID::idMapped || sssMap == XrdSecsssID::idMappedM)
+          eDest.Say("Config warning: ignoring 'pss.pool'; client personas are "
+                    "in effect!");
+          else XrdPssPool::Start(ManList && !outProxy ? hdrData : 0);
+      }
+
 // Check if we have any r/w exports as this will determine whether or not we
 // need to initialize any r/w cache. Currently, we don't support this so we
 // have no particular initialization to do.
@@ -500,6 +511,7 @@ int XrdPssSys::ConfigXeq(char *var, XrdOucStream &Config)
    TS_Xeq("origin",        xorig);
    TS_Xeq("permit",        xperm);
    TS_Xeq("persona",       xpers);
+   TS_Xeq("pool",          xpool);
    TS_PSX("setopt",        ParseSet);
    TS_PSX("trace",         ParseTrace);
 
@@ -951,3 +963,52 @@ int XrdPssSys::xpers(XrdSysError *Eroute, XrdOucStream &Config)
 //
     return 0;
 }
+  
+/******************************************************************************/
+/*                                 x p o o l                                  */
+/******************************************************************************/
+
+/* Function: xpool
+
+   Purpose:  To parse the directive: pool [channels <n>] [[no]warm]
+
+                    channels  the maximum number of channels to the origin
+                              that all users share; the default is 8.
+                    warm      log into the origin through each channel at
+                              start-up rather than on first use.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdPssSys::xpool(XrdSysError *Eroute, XrdOucStream &Config)
+{
+   char *val, *eP;
+   int   maxch = 8;
+   bool  warm  = false;
+
+// Process the options
+//
+   while ((val = Config.GetWord()))
+         {     if (!strcmp(val, "warm"  )) warm = true;
+          else if (!strcmp(val, "nowarm")) warm = false;
+          else if (!strcmp(val, "channels"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute->Emsg("Config", "pool channels not specified");
+                       return 1;
+                      }
+                   maxch = strtol(val, &eP, 10);
+                   if (*eP || maxch < 1 || maxch > 1024)
+                      {Eroute->Emsg("Config", "invalid pool channels -", val);
+                       return 1;
+                      }
+                  }
+          else {Eroute->Emsg("Config", "Invalid pool option - ", val);
+                return 1;
+               }
+         }
+
+// Record the information for future processing
+//
+   XrdPssPool::Config(maxch, warm);
+   return 0;
+}
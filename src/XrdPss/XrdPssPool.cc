@@ -0,0 +1,223 @@
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d P s s P o o l . c c                          */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdio>
+#include <ctime>
+#include <sys/stat.h>
+
+#include "XrdPosix/XrdPosixXrootd.hh"
+#include "XrdPss/XrdPssPool.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysMetrics.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+namespace XrdProxy
+{
+extern XrdSysError eDest;
+}
+using namespace XrdProxy;
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+std::atomic<int> *XrdPssPool::slotUse = 0;
+int               XrdPssPool::poolMax = 0;
+int               XrdPssPool::cfgMax  = 0;
+bool              XrdPssPool::cfgWarm = false;
+
+/******************************************************************************/
+/*                               M e t r i c s                                */
+/******************************************************************************/
+
+namespace
+{
+std::atomic<long long> poolFiles{0};
+
+long long getChans(void *) {return XrdPssPool::Channels();}
+long long getFiles(void *) {return poolFiles.load();}
+
+XrdSysMetrics::Histogram openTime("xrootd_pss_open_seconds",
+                                  "Time to open a file at the origin.");
+
+XrdSysMetrics::Probe    *chanProbe = 0;
+XrdSysMetrics::Probe    *fileProbe = 0;
+}
+
+/******************************************************************************/
+/*                               A c q u i r e                                */
+/******************************************************************************/
+
+int XrdPssPool::Acquire(char *idBuff, int idBlen)
+{
+   int slot = 0, minUse;
+
+// Find the least used slot. Races only make the choice slightly less than
+// optimal, which is harmless.
+//
+   if (!poolMax) return -1;
+   minUse = slotUse[0].load(std::memory_order_relaxed);
+   for (int i = 1; i < poolMax && minUse; i++)
+       {int n = slotUse[i].load(std::memory_order_relaxed);
+        if (n < minUse) {minUse = n; slot = i;}
+       }
+   slotUse[slot]++;
+   poolFiles++;
+
+// The id must differ from those generated by XrdPssUrlInfo::setID()
+//
+   snprintf(idBuff, idBlen, "c%d@", slot);
+   return slot;
+}
+
+/******************************************************************************/
+/*                              C h a n n e l s                               */
+/******************************************************************************/
+
+int XrdPssPool::Channels()
+{
+   int n = 0;
+
+   for (int i = 0; i < poolMax; i++)
+       if (slotUse[i].load(std::memory_order_relaxed)) n++;
+   return n;
+}
+
+/******************************************************************************/
+/*                                   N o w                                    */
+/******************************************************************************/
+
+long long XrdPssPool::Now()
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec*1000000000LL + ts.tv_nsec;
+}
+
+/******************************************************************************/
+/*                                O p e n e d                                 */
+/******************************************************************************/
+
+void XrdPssPool::Opened(long long nsec) {openTime.Record(nsec);}
+
+/******************************************************************************/
+/*                               R e l e a s e                                */
+/******************************************************************************/
+
+void XrdPssPool::Release(int slot)
+{
+   if (slot >= 0 && slot < poolMax) {slotUse[slot]--; poolFiles--;}
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+void XrdPssPool::Start(const char *urlFmt)
+{
+   pthread_t tid;
+   int rc;
+
+// Allocate the slots and register the occupancy metrics
+//
+   slotUse = new std::atomic<int>[cfgMax];
+   for (int i = 0; i < cfgMax; i++) slotUse[i].store(0);
+   chanProbe = new XrdSysMetrics::Probe("xrootd_pss_pool_channels",
+                        "Pooled origin channels with open files.",
+                        XrdSysMetrics::isGauge, getChans);
+   fileProbe = new XrdSysMetrics::Probe("xrootd_pss_pool_files",
+                        "Files open through pooled origin channels.",
+                        XrdSysMetrics::isGauge, getFiles);
+   poolMax = cfgMax;
+
+// Open the channels in the background if so wanted. This avoids a burst of
+// logins when a restarted proxy is hit by many clients at once.
+//
+   if (cfgWarm && urlFmt)
+      {if ((rc = XrdSysThread::Run(&tid, XrdPssPool::Warm, (void *)urlFmt,
+                                   0, "pss pool warmer")))
+          eDest.Emsg("Pool", rc, "start pool warmer thread");
+      }
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdPssPool::Stats(char *buff, int blen)
+{
+   static const char statfmt[] = "<stats id=\"psspool\"><max>%d</max>"
+          "<chans>%d</chans><files>%lld</files>"
+          "<opens>%lld</opens><avgus>%lld</avgus></stats>";
+   long long count, sum, bins[XrdSysMetrics::Histogram::numBins];
+
+// Return the maximum length if so wanted; nothing is reported without a pool
+//
+   if (!poolMax) return 0;
+   if (!blen) return sizeof(statfmt) + 5*16;
+
+// Format the statistics
+//
+   openTime.Read(count, sum, bins);
+   int n = snprintf(buff, blen, statfmt, poolMax, Channels(), poolFiles.load(),
+                    count, (count ? sum/count/1000 : 0LL));
+   return (n < blen ? n : 0);
+}
+
+/******************************************************************************/
+/* Private:                         W a r m                                   */
+/******************************************************************************/
+
+void *XrdPssPool::Warm(void *urlFmt)
+{
+   struct stat Stat;
+   char idBuff[16], url[2048];
+   int n, ok = 0;
+
+// Contact the origin through every pool id. The stat is only done to log in;
+// we count those that succeeded for the record.
+//
+   for (int i = 0; i < poolMax; i++)
+       {snprintf(idBuff, sizeof(idBuff), "c%d@", i);
+        n = snprintf(url, sizeof(url), (const char *)urlFmt, idBuff, "/");
+        if (n >= (int)sizeof(url)) break;
+        if (!XrdPosixXrootd::Stat(url, &Stat)) ok++;
+       }
+
+   char buff[32];
+   snprintf(buff, sizeof(buff), "%d of %d", ok, poolMax);
+   eDest.Say("Pool: ", buff, " origin channels pre-connected.");
+   return (void *)0;
+}
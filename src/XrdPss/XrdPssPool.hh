@@ -0,0 +1,108 @@
+#ifndef _XRDPSS_POOL_H
+#define _XRDPSS_POOL_H
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d P s s P o o l . h h                          */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+
+/******************************************************************************/
+/*                      C l a s s   X r d P s s P o o l                       */
+/******************************************************************************/
+
+// XrdPssPool bounds the number of channels the proxy opens to its origin.
+// Normally each client connection logs into the origin under its own id and
+// so gets its own TCP channel. With a pool, files are instead opened under one
+// of a fixed number of pool ids, each naming a single multiplexed channel, and
+// each open picks the least used one. This is only possible when the origin
+// sees the proxy's identity (i.e. the server persona); it is refused when
+// client personas are in effect.
+//
+// The pool is configured by the 'pss.pool' directive. Its occupancy and the
+// time taken to open origin files are exported as metrics and in the stats.
+
+class XrdPssPool
+{
+public:
+
+// Pick the least used pool slot and format its login id into idBuff. Returns
+// the slot, or -1 if pooling is not enabled.
+//
+static int   Acquire(char *idBuff, int idBlen);
+
+// Return true if pooling is enabled.
+//
+static bool  Active() {return poolMax > 0;}
+
+// Return the number of pool channels that have files open.
+//
+static int   Channels();
+
+// Set the pool size and whether channels are opened at start-up. The pool
+// is only used after a successful Start().
+//
+static void  Config(int maxch, bool warm) {cfgMax = maxch; cfgWarm = warm;}
+
+// Return true if the pool was configured.
+//
+static bool  Configured() {return cfgMax > 0;}
+
+// Return the monotonic time in nanoseconds and record the time, as measured
+// by it, that it took to open a file at the origin.
+//
+static
+long long    Now();
+
+static void  Opened(long long nsec);
+
+// Release a slot obtained via Acquire().
+//
+static void  Release(int slot);
+
+// Start the pool. When warm is in effect, urlFmt is used to generate a url
+// for each pool id which is then contacted in the background. The format has
+// two %s, the first replaced by the pool id (e.g. "c0@") and the second by the
+// path, which is "/".
+//
+static void  Start(const char *urlFmt);
+
+// Return pool statistics in XML format.
+//
+static int   Stats(char *buff, int blen);
+
+private:
+
+static void *Warm(void *urlFmt);
+
+static std::atomic<int> *slotUse;
+static int               poolMax;
+static int               cfgMax;
+static bool              cfgWarm;
+};
+#endif
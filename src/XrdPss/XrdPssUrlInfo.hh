@@ -54,6 +54,9 @@ const char *getID() {return theID;}
                   snprintf(theID, sizeof(theID), "p%d@", idVal.sidS);
                  }
 
+      void  setPoolID(const char *pid)
+                     {snprintf(theID, sizeof(theID), "%s", pid);}
+
 static void setMapID(bool onoff) {MapID = onoff;}
 
 const char *thePath() {return Path;}
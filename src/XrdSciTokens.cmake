@@ -13,6 +13,7 @@ add_library(
    ${LIB_XRD_SCITOKENS}
    MODULE
    XrdSciTokens/XrdSciTokensAccess.cc
+                                       XrdSciTokens/XrdSciTokensCache.hh
                                        XrdSciTokens/XrdSciTokensHelper.hh
    XrdSciTokens/XrdSciTokensMon.cc     XrdSciTokens/XrdSciTokensMon.hh )
 target_link_libraries(
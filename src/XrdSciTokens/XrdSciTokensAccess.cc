@@ -19,11 +19,13 @@
 #include <tuple>
 
 #include "fcntl.h"
+#include <sys/stat.h>
 
 #include "INIReader.h"
 #include "picojson.h"
 
 #include "scitokens/scitokens.h"
+#include "XrdSciTokens/XrdSciTokensCache.hh"
 #include "XrdSciTokens/XrdSciTokensHelper.hh"
 #include "XrdSciTokens/XrdSciTokensMon.hh"
 
@@ -522,17 +524,11 @@ public:
         std::shared_ptr<XrdAccRules> access_rules;
         uint64_t now = monotonic_time();
         Check(now);
-        {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            const auto iter = m_map.find(authz);
-            if (iter != m_map.end() && !iter->second->expired()) {
-                access_rules = iter->second;
-            }
-        }
+        access_rules = m_cache.Find(authz, now);
         if (!access_rules) {
             m_log.Log(LogMask::Debug, "Access", "Token not found in recent cache; parsing.");
+            uint64_t cache_expiry = 0;
             try {
-                uint64_t cache_expiry;
                 AccessRulesRaw rules;
                 std::string username;
                 std::string token_subject;
@@ -540,9 +536,14 @@ public:
                 std::vector<MapRule> map_rules;
                 std::vector<std::string> groups;
                 uint32_t authz_strategy;
+                struct timespec vbeg, vend;
+                clock_gettime(CLOCK_MONOTONIC, &vbeg);
                 if (GenerateAcls(authz, cache_expiry, rules, username, token_subject, issuer, map_rules, groups, authz_strategy)) {
                     access_rules.reset(new XrdAccRules(now + cache_expiry, username, token_subject, issuer, map_rules, groups, authz_strategy));
                     access_rules->parse(rules);
+                    clock_gettime(CLOCK_MONOTONIC, &vend);
+                    m_cache.Verified((vend.tv_sec - vbeg.tv_sec) * 1000000000LL
+                                     + (vend.tv_nsec - vbeg.tv_nsec));
                 } else {
                     m_log.Log(LogMask::Warning, "Access", "Failed to generate ACLs for token");
                     return OnMissing(Entity, path, oper, env);
@@ -554,8 +555,7 @@ public:
                 m_log.Log(LogMask::Warning, "Access", "Error generating ACLs for authorization", exc.what());
                 return OnMissing(Entity, path, oper, env);
             }
-            std::lock_guard<std::mutex> guard(m_mutex);
-            m_map[authz] = access_rules;
+            m_cache.Add(authz, access_rules, now + cache_expiry);
         } else if (m_log.getMsgMask() & LogMask::Debug) {
             m_log.Log(LogMask::Debug, "Access", "Cached token", access_rules->str().c_str());
         }
@@ -808,9 +808,11 @@ private:
             scitoken_destroy(token);
             return false;
         }
+        // The expiration is an absolute time; the rules may be cached until
+        // then (the cache is cleared should the configuration change).
         if (expiry > 0) {
-            expiry = std::max(static_cast<int64_t>(monotonic_time() - expiry),
-                static_cast<int64_t>(60));
+            expiry = std::max(static_cast<int64_t>(expiry - time(NULL)),
+                static_cast<int64_t>(0));
         } else {
             expiry = 60;
         }
@@ -1178,6 +1180,7 @@ private:
         }
         std::vector<std::string> audiences;
         std::unordered_map<std::string, IssuerConfig> issuers;
+        std::string cfg_sig = FileSig(m_cfg_file);
         for (const auto &section : reader.Sections()) {
             std::string section_lower;
             std::transform(section.begin(), section.end(), std::back_inserter(section_lower),
@@ -1243,6 +1246,7 @@ private:
             std::vector<MapRule> rules;
             auto name_mapfile = reader.Get(section, "name_mapfile", "");
             if (!name_mapfile.empty()) {
+                cfg_sig += FileSig(name_mapfile);
                 if (!ParseMapfile(name_mapfile, rules)) {
                     m_log.Log(LogMask::Error, "Reconfig", "Failed to parse mapfile; failing (re-)configuration", name_mapfile.c_str());
                     return false;
@@ -1333,21 +1337,34 @@ private:
             return false;
         }
         pthread_rwlock_unlock(&m_config_lock);
+
+        // Cached rules were generated under the old configuration; drop them
+        // if any of the files it came from have changed.
+        if (cfg_sig != m_cfg_sig) {
+            if (!m_cfg_sig.empty()) {
+                m_log.Log(LogMask::Info, "Reconfig", "Configuration changed; clearing the token cache");
+            }
+            m_cache.Clear();
+            m_cfg_sig = std::move(cfg_sig);
+        }
         return true;
     }
 
+    static std::string FileSig(const std::string &fname)
+    {
+        struct stat st;
+        if (stat(fname.c_str(), &st)) {return fname + ":none;";}
+        return fname + ":" + std::to_string(st.st_size) + ":" +
+               std::to_string(st.st_mtim.tv_sec) + "." +
+               std::to_string(st.st_mtim.tv_nsec) + ";";
+    }
+
     void Check(uint64_t now)
     {
         if (now <= m_next_clean) {return;}
         std::lock_guard<std::mutex> guard(m_mutex);
 
-        for (auto iter = m_map.begin(); iter != m_map.end(); ) {
-            if (iter->second->expired()) {
-                iter = m_map.erase(iter);
-            } else {
-                ++iter;
-            }
-        }
+        m_cache.Purge(now);
         Reconfig();
 
         m_next_clean = monotonic_time() + m_expiry_secs;
@@ -1358,7 +1375,8 @@ private:
     pthread_rwlock_t m_config_lock;
     std::vector<std::string> m_audiences;
     std::vector<const char *> m_audiences_array;
-    std::map<std::string, std::shared_ptr<XrdAccRules>> m_map;
+    XrdSciTokensCache<XrdAccRules> m_cache{"plugin=\"scitokens\""};
+    std::string m_cfg_sig;
     XrdAccAuthorize* m_chain;
     const std::string m_parms;
     std::vector<const char*> m_valid_issuers_array;
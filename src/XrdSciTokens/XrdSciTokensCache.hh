@@ -0,0 +1,213 @@
+#ifndef __XrdSciTokensCache_hh__
+#define __XrdSciTokensCache_hh__
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d S c i T o k e n s C a c h e . h h                   */
+/*                                                                            */
+/******************************************************************************/
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "XrdSys/XrdSysMetrics.hh"
+
+//-----------------------------------------------------------------------------
+//! This class caches the outcome of verifying a bearer token, keyed by a hash
+//! of the token, so that a client presenting the same token with every
+//! request only pays for signature checks and claim parsing once. What is
+//! cached is up to the plugin (e.g. the compiled access rules); it is shared
+//! with callers so it must not be changed once added.
+//!
+//! The cache is split into shards, each with its own lock and LRU list, and
+//! holds at most a fixed number of entries. An entry is dropped when it is
+//! found to have expired, when its shard is full and it is the least recently
+//! used, or when the cache is cleared (e.g. because the configuration
+//! changed). Times are in whatever units the caller uses, as long as they
+//! are used consistently.
+//!
+//! Hits, misses, evictions, the entry count and, as reported by the plugin,
+//! the time taken to verify tokens that were not found are exported as
+//! metrics labelled with the plugin name.
+//-----------------------------------------------------------------------------
+
+template<class T>
+class XrdSciTokensCache
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Add the verified outcome for a token.
+//!
+//! @param  token  - the token as presented.
+//! @param  item   - the outcome to cache.
+//! @param  expiry - the time after which the outcome may no longer be used.
+//-----------------------------------------------------------------------------
+
+void               Add(std::string_view token, const std::shared_ptr<T> &item,
+                       uint64_t expiry)
+                      {uint64_t hval = Hash(token);
+                       Shard &s = shard[hval % numShards];
+                       std::lock_guard<std::mutex> guard(s.mtx);
+                       auto it = s.map.find(hval);
+                       if (it != s.map.end()) Drop(s, it->second, false);
+                          else if (s.lru.size() >= maxPer)
+                                  Drop(s, std::prev(s.lru.end()), true);
+                       s.lru.push_front({std::string(token), item, hval, expiry});
+                       s.map[hval] = s.lru.begin();
+                       mEnts->Add();
+                      }
+
+//-----------------------------------------------------------------------------
+//! Drop all entries.
+//-----------------------------------------------------------------------------
+
+void               Clear()
+                        {for (auto &s : shard)
+                             {std::lock_guard<std::mutex> guard(s.mtx);
+                              mEnts->Sub(s.lru.size());
+                              s.map.clear();
+                              s.lru.clear();
+                             }
+                        }
+
+//-----------------------------------------------------------------------------
+//! Find the outcome for a token.
+//!
+//! @param  token  - the token as presented.
+//! @param  now    - the current time.
+//!
+//! @return The cached outcome or a null pointer if there is none or it has
+//!         expired, in which case the token must be verified and added.
+//-----------------------------------------------------------------------------
+
+std::shared_ptr<T> Find(std::string_view token, uint64_t now)
+                       {uint64_t hval = Hash(token);
+                        Shard &s = shard[hval % numShards];
+                        std::lock_guard<std::mutex> guard(s.mtx);
+                        auto it = s.map.find(hval);
+                        if (it == s.map.end() || it->second->token != token)
+                           {mMiss->Add(); return nullptr;}
+                        if (now > it->second->expiry)
+                           {Drop(s, it->second, false);
+                            mMiss->Add(); return nullptr;
+                           }
+                        s.lru.splice(s.lru.begin(), s.lru, it->second);
+                        mHits->Add();
+                        return it->second->item;
+                       }
+
+//-----------------------------------------------------------------------------
+//! Drop all entries that have expired.
+//!
+//! @param  now    - the current time.
+//-----------------------------------------------------------------------------
+
+void               Purge(uint64_t now)
+                        {for (auto &s : shard)
+                             {std::lock_guard<std::mutex> guard(s.mtx);
+                              for (auto it = s.lru.begin(); it != s.lru.end();)
+                                  {auto cur = it++;
+                                   if (now > cur->expiry) Drop(s, cur, false);
+                                  }
+                             }
+                        }
+
+//-----------------------------------------------------------------------------
+//! Record how long it took to verify a token that was not in the cache.
+//!
+//! @param  nsec   - the elapsed time in nanoseconds.
+//-----------------------------------------------------------------------------
+
+void               Verified(long long nsec) {mVerify->Record(nsec);}
+
+//-----------------------------------------------------------------------------
+//! Obtain the cache statistics.
+//-----------------------------------------------------------------------------
+
+struct Stats {long long hits, misses, evicts, entries, verifies, verifyNS;};
+
+Stats              GetStats() const
+                           {Stats st;
+                            long long bins[XrdSysMetrics::Histogram::numBins];
+                            st.hits    = mHits->Value();
+                            st.misses  = mMiss->Value();
+                            st.evicts  = mEvict->Value();
+                            st.entries = mEnts->Value();
+                            mVerify->Read(st.verifies, st.verifyNS, bins);
+                            return st;
+                           }
+
+//-----------------------------------------------------------------------------
+//! Constructor
+//!
+//! @param  labels - the labels for the metrics, which must stay valid
+//!                  for the life of the process (e.g. "plugin=\"name\"").
+//! @param  maxEnt - the maximum number of entries to hold.
+//-----------------------------------------------------------------------------
+
+static const int   numShards = 16;
+
+                   XrdSciTokensCache(const char *labels, size_t maxEnt=16384)
+                  : maxPer(maxEnt < numShards ? 1 : maxEnt / numShards)
+                  {typedef XrdSysMetrics::Counter Counter;
+                   mHits  = new Counter("xrootd_token_cache_hits_total",
+                                "Token lookups answered by the cache.", labels);
+                   mMiss  = new Counter("xrootd_token_cache_misses_total",
+                                "Token lookups that needed verification.",
+                                labels);
+                   mEvict = new Counter("xrootd_token_cache_evictions_total",
+                                "Live tokens dropped to make room.", labels);
+                   mEnts  = new Counter("xrootd_token_cache_entries",
+                                "Tokens in the cache.", labels, true);
+                   mVerify= new XrdSysMetrics::Histogram(
+                                "xrootd_token_verify_seconds",
+                                "Time taken to verify tokens not in the cache.",
+                                labels);
+                  }
+
+// Metrics are never deleted as they remain registered.
+//
+                  ~XrdSciTokensCache() {Clear();}
+
+private:
+
+struct Entry
+      {std::string         token;
+       std::shared_ptr<T>  item;
+       uint64_t            hval;
+       uint64_t            expiry;
+      };
+
+typedef typename std::list<Entry>::iterator entIter;
+
+struct Shard
+      {std::mutex                             mtx;
+       std::list<Entry>                       lru;
+       std::unordered_map<uint64_t, entIter>  map;
+      };
+
+static uint64_t    Hash(std::string_view token)
+                       {return std::hash<std::string_view>()(token);}
+
+void               Drop(Shard &s, entIter it, bool evict)
+                       {if (evict) mEvict->Add();
+                        mEnts->Sub();
+                        s.map.erase(it->hval);
+                        s.lru.erase(it);
+                       }
+
+Shard                     shard[numShards];
+size_t                    maxPer;
+XrdSysMetrics::Counter   *mHits;
+XrdSysMetrics::Counter   *mMiss;
+XrdSysMetrics::Counter   *mEvict;
+XrdSysMetrics::Counter   *mEnts;
+XrdSysMetrics::Histogram *mVerify;
+};
+#endif
@@ -18,6 +18,7 @@ add_library(
   XrdServer
   SHARED
   XrdXrootd/XrdXrootdAdmin.cc           XrdXrootd/XrdXrootdAdmin.hh
+  XrdXrootd/XrdXrootdAioArena.cc        XrdXrootd/XrdXrootdAioArena.hh
   XrdXrootd/XrdXrootdAioBuff.cc         XrdXrootd/XrdXrootdAioBuff.hh
   XrdXrootd/XrdXrootdAioFob.cc          XrdXrootd/XrdXrootdAioFob.hh
   XrdXrootd/XrdXrootdAioPgrw.cc         XrdXrootd/XrdXrootdAioPgrw.hh
@@ -31,9 +32,11 @@ add_library(
   XrdXrootd/XrdXrootdFileLock1.cc       XrdXrootd/XrdXrootdFileLock1.hh
                                         XrdXrootd/XrdXrootdFileStats.hh
   XrdXrootd/XrdXrootdJob.cc             XrdXrootd/XrdXrootdJob.hh
+  XrdXrootd/XrdXrootdLatency.cc         XrdXrootd/XrdXrootdLatency.hh
   XrdXrootd/XrdXrootdLoadLib.cc
                                         XrdXrootd/XrdXrootdMonData.hh
   XrdXrootd/XrdXrootdMonFile.cc         XrdXrootd/XrdXrootdMonFile.hh
+  XrdXrootd/XrdXrootdMonQueue.cc        XrdXrootd/XrdXrootdMonQueue.hh
   XrdXrootd/XrdXrootdMonFMap.cc         XrdXrootd/XrdXrootdMonFMap.hh
   XrdXrootd/XrdXrootdMonitor.cc         XrdXrootd/XrdXrootdMonitor.hh
 
@@ -129,6 +132,8 @@ add_library(
   XrdOss/XrdOssCopy.cc         XrdOss/XrdOssCopy.hh
   XrdOss/XrdOssCreate.cc
                                XrdOss/XrdOssOpaque.hh
+  XrdOss/XrdOssDio.cc          XrdOss/XrdOssDio.hh
+  XrdOss/XrdOssDirStat.cc      XrdOss/XrdOssDirStat.hh
   XrdOss/XrdOssMio.cc          XrdOss/XrdOssMio.hh
                                XrdOss/XrdOssMioFile.hh
   XrdOss/XrdOssMSS.cc
@@ -138,6 +143,7 @@ add_library(
   XrdOss/XrdOssSpace.cc        XrdOss/XrdOssSpace.hh
   XrdOss/XrdOssStage.cc        XrdOss/XrdOssStage.hh
   XrdOss/XrdOssStat.cc         XrdOss/XrdOssStatInfo.hh
+  XrdOss/XrdOssStatCache.cc    XrdOss/XrdOssStatCache.hh
                                XrdOss/XrdOssTrace.hh
   XrdOss/XrdOssUnlink.cc
                                XrdOss/XrdOssWrapper.hh
@@ -152,6 +158,7 @@ add_library(
                                  XrdAcc/XrdAccAuthorize.hh
   XrdAcc/XrdAccAuthFile.cc       XrdAcc/XrdAccAuthFile.hh
   XrdAcc/XrdAccCapability.cc     XrdAcc/XrdAccCapability.hh
+  XrdAcc/XrdAccCapTrie.cc        XrdAcc/XrdAccCapTrie.hh
   XrdAcc/XrdAccConfig.cc         XrdAcc/XrdAccConfig.hh
   XrdAcc/XrdAccEntity.cc         XrdAcc/XrdAccEntity.hh
   XrdAcc/XrdAccGroups.cc         XrdAcc/XrdAccGroups.hh
@@ -0,0 +1,321 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S y s M e t r i c s . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include "XrdSys/XrdSysMetrics.hh"
+
+/******************************************************************************/
+/*                      S t a t i c   A l l o c a t i o n                     */
+/******************************************************************************/
+
+std::atomic<XrdSysMetrics::Metric *> XrdSysMetrics::mList(0);
+
+thread_local int XrdSysMetrics::myShard = -1;
+
+namespace
+{
+std::atomic<unsigned int> shardNext(0);
+
+struct BinHead
+      {char     magic[4];
+       uint32_t version;
+       uint64_t generation;
+       int64_t  tod;
+       uint32_t count;
+       uint32_t size;
+      };
+
+struct BinRec
+      {uint16_t kind;
+       uint16_t nlen;
+       uint32_t nvals;
+      };
+
+// Append name{labels} to text, adding the extra label if any.
+//
+void PromName(std::string &text, const XrdSysMetrics::Metric *mP,
+              const char *sfx, const char *xlab=0)
+{
+   const char *labs = mP->Labels();
+   bool haveL = labs && *labs;
+
+   text += mP->Name();
+   if (sfx) text += sfx;
+   if (haveL || xlab)
+      {text += '{';
+       if (haveL) text += labs;
+       if (xlab) {if (haveL) text += ','; text += xlab;}
+       text += '}';
+      }
+   text += ' ';
+}
+}
+
+/******************************************************************************/
+/*                  M e t r i c   C o n s t r u c t o r                       */
+/******************************************************************************/
+
+XrdSysMetrics::Metric::Metric(const char *name, const char *help, Kind kind,
+                              const char *labels)
+                             : mName(name), mHelp(help), mLabels(labels),
+                               mKind(kind)
+{
+// Metrics are never removed, so a simple push onto the front suffices
+//
+   mNext = mList.load(std::memory_order_relaxed);
+   while(!mList.compare_exchange_weak(mNext, this, std::memory_order_release,
+                                                    std::memory_order_relaxed))
+        {}
+}
+
+/******************************************************************************/
+/*                         C o u n t e r : : V a l u e                        */
+/******************************************************************************/
+
+long long XrdSysMetrics::Counter::Value() const
+{
+   long long total = 0;
+
+   for (auto &cell : mShard) total += cell.val.load(std::memory_order_relaxed);
+   return total;
+}
+
+/******************************************************************************/
+/*                       H i s t o g r a m : : B i n O f                      */
+/******************************************************************************/
+
+int XrdSysMetrics::Histogram::BinOf(unsigned long long usec)
+{
+   const unsigned long long sub = 1ULL << subBits;
+   int exp, bin;
+
+   if (usec < sub) return static_cast<int>(usec);
+   exp = 63 - __builtin_clzll(usec);
+   bin = ((exp - subBits + 1) << subBits)
+       + static_cast<int>((usec >> (exp - subBits)) & (sub - 1));
+   return (bin < numBins ? bin : numBins-1);
+}
+
+/******************************************************************************/
+/*                    H i s t o g r a m : : B i n U p p e r                   */
+/******************************************************************************/
+
+double XrdSysMetrics::Histogram::BinUpper(int bin)
+{
+   const int sub = 1 << subBits;
+   int exp;
+
+   if (bin < sub) return bin + 1;
+   exp = (bin >> subBits) + subBits - 1;
+   return (sub + (bin & (sub - 1)) + 1) * std::ldexp(1.0, exp - subBits);
+}
+
+/******************************************************************************/
+/*                       H i s t o g r a m : : R e a d                        */
+/******************************************************************************/
+
+void XrdSysMetrics::Histogram::Read(long long &count, long long &sum,
+                                    long long *bins) const
+{
+   count = sum = 0;
+   for (int i = 0; i < numBins; i++) bins[i] = 0;
+
+   for (auto &cell : mShard)
+       {count += cell.count.load(std::memory_order_relaxed);
+        sum   += cell.sum.load(std::memory_order_relaxed);
+        for (int i = 0; i < numBins; i++)
+            bins[i] += cell.bins[i].load(std::memory_order_relaxed);
+       }
+}
+
+/******************************************************************************/
+/*                     H i s t o g r a m : : R e c o r d                      */
+/******************************************************************************/
+
+void XrdSysMetrics::Histogram::Record(long long nsec)
+{
+   Cell &cell = mShard[Shard() & 3];
+
+   if (nsec < 0) nsec = 0;
+   cell.bins[BinOf(static_cast<unsigned long long>(nsec) / 1000)]
+       .fetch_add(1, std::memory_order_relaxed);
+   cell.sum.fetch_add(nsec, std::memory_order_relaxed);
+   cell.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+/******************************************************************************/
+/*                                B i n a r y                                 */
+/******************************************************************************/
+
+int XrdSysMetrics::Binary(char *buff, int blen)
+{
+   long long hBins[Histogram::numBins], *vals;
+   BinHead  *hP = (BinHead *)buff;
+   BinRec   *rP;
+   Metric   *first = mList.load(std::memory_order_acquire), *mP;
+   char     *bP;
+   int       need = sizeof(BinHead), count = 0, nlen, nvals;
+
+// Compute the size of the snapshot
+//
+   for (mP = first; mP; mP = mP->mNext)
+       {nlen  = strlen(mP->mName) + 1;
+        if (mP->mLabels && *mP->mLabels) nlen += strlen(mP->mLabels) + 2;
+        nvals = (mP->mKind == isHistogram ? Histogram::numBins + 2 : 1);
+        need += sizeof(BinRec) + ((nlen + 7) & ~7) + nvals*sizeof(int64_t);
+        count++;
+       }
+   if (need > blen) return need;
+
+// Fill in the header, leaving the generation alone
+//
+   memcpy(hP->magic, "XRDM", 4);
+   hP->version = binVersion;
+   hP->tod     = static_cast<int64_t>(time(0));
+   hP->count   = count;
+   hP->size    = need;
+   bP = buff + sizeof(BinHead);
+
+// Now fill in each metric. Metrics registered after we sized the buffer are
+// in front of first and so are not seen here.
+//
+   for (mP = first; mP; mP = mP->mNext)
+       {rP = (BinRec *)bP;
+        bP += sizeof(BinRec);
+        if (mP->mLabels && *mP->mLabels)
+           nlen = sprintf(bP, "%s{%s}", mP->mName, mP->mLabels) + 1;
+           else {strcpy(bP, mP->mName); nlen = strlen(bP) + 1;}
+        nlen = (nlen + 7) & ~7;
+        memset(bP + strlen(bP), 0, nlen - strlen(bP));
+        rP->kind = static_cast<uint16_t>(mP->mKind);
+        rP->nlen = static_cast<uint16_t>(nlen);
+        bP += nlen;
+        vals = (long long *)bP;
+        switch(mP->mKind)
+              {case isHistogram:
+                    static_cast<Histogram *>(mP)->Read(vals[0], vals[1], hBins);
+                    memcpy(&vals[2], hBins, sizeof(hBins));
+                    nvals = Histogram::numBins + 2;
+                    break;
+               default:
+                    vals[0] = mP->Value();
+                    nvals = 1;
+                    break;
+              }
+        rP->nvals = nvals;
+        bP += nvals*sizeof(int64_t);
+       }
+   return need;
+}
+
+/******************************************************************************/
+/*                            P r o m e t h e u s                             */
+/******************************************************************************/
+
+void XrdSysMetrics::Prometheus(std::string &text)
+{
+   static const char *kName[] = {"counter", "gauge", "histogram"};
+   std::vector<Metric *> mVec;
+   long long hBins[Histogram::numBins], count, sum, cum;
+   const char *lastName = "";
+   char vBuff[64];
+
+// Prometheus requires all samples of a metric to be together, so order the
+// metrics by name (keeping registration order within a name).
+//
+   for (Metric *mP = mList.load(std::memory_order_acquire); mP; mP = mP->mNext)
+       mVec.push_back(mP);
+   std::reverse(mVec.begin(), mVec.end());
+   std::stable_sort(mVec.begin(), mVec.end(),
+                    [](const Metric *a, const Metric *b)
+                      {return strcmp(a->mName, b->mName) < 0;});
+
+   for (Metric *mP : mVec)
+       {if (strcmp(lastName, mP->mName))
+           {text += "# HELP "; text += mP->mName; text += ' ';
+            text += mP->mHelp; text += "\n# TYPE "; text += mP->mName;
+            text += ' '; text += kName[mP->mKind]; text += '\n';
+            lastName = mP->mName;
+           }
+
+        if (mP->mKind != isHistogram)
+           {PromName(text, mP, 0);
+            snprintf(vBuff, sizeof(vBuff), "%lld\n", mP->Value());
+            text += vBuff;
+            continue;
+           }
+
+     // Histograms are exported in seconds with a bucket per power of two
+     //
+        static_cast<Histogram *>(mP)->Read(count, sum, hBins);
+        cum = 0;
+        for (int i = 0; i < Histogram::numBins; i++)
+            {cum += hBins[i];
+             if ((i & ((1 << Histogram::subBits) - 1))
+             !=  (1 << Histogram::subBits) - 1) continue;
+             snprintf(vBuff, sizeof(vBuff), "le=\"%g\"",
+                      Histogram::BinUpper(i) / 1e6);
+             PromName(text, mP, "_bucket", vBuff);
+             snprintf(vBuff, sizeof(vBuff), "%lld\n", cum);
+             text += vBuff;
+            }
+        PromName(text, mP, "_bucket", "le=\"+Inf\"");
+        snprintf(vBuff, sizeof(vBuff), "%lld\n", count);
+        text += vBuff;
+        PromName(text, mP, "_sum");
+        snprintf(vBuff, sizeof(vBuff), "%.9f\n", sum / 1e9);
+        text += vBuff;
+        PromName(text, mP, "_count");
+        snprintf(vBuff, sizeof(vBuff), "%lld\n", count);
+        text += vBuff;
+       }
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                              N e w S h a r d                               */
+/******************************************************************************/
+
+// Threads are given shards round robin as they first update a metric.
+//
+int XrdSysMetrics::NewShard()
+{
+   myShard = static_cast<int>(shardNext.fetch_add(1, std::memory_order_relaxed)
+                              & 15);
+   return myShard;
+}
@@ -0,0 +1,235 @@
+#ifndef __XRDSYSMETRICS_HH__
+#define __XRDSYSMETRICS_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S y s M e t r i c s . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/******************************************************************************/
+/*                   C l a s s   X r d S y s M e t r i c s                    */
+/******************************************************************************/
+
+// XrdSysMetrics is a process-wide registry of named counters, gauges, and
+// latency histograms. Updating a metric never takes a lock: counters and
+// histograms are sharded so that threads rarely touch the same cache line.
+// Reading a metric sums the shards and so only gives a consistent value for
+// each metric, not across metrics, which is all that a scraper needs.
+//
+// Metrics register themselves when constructed and must live for the rest of
+// the process; they are normally static or allocated once at configuration.
+// Several metrics may share a name when they have distinct labels, given in
+// Prometheus form (e.g. "op=\"read\"").
+//
+// The registry can be exported as Prometheus text or as a compact binary
+// snapshot, laid out as follows (all fields in host byte order):
+//
+// Header:  char     magic[4]     "XRDM"
+//          uint32_t version      Currently 1
+//          uint64_t generation   Odd while the snapshot is being rewritten
+//          int64_t  tod          Unix time of the snapshot
+//          uint32_t count        Number of records that follow
+//          uint32_t size         Total snapshot size in bytes
+//
+// Record:  uint16_t kind         One of Kind below
+//          uint16_t nlen         Length of the name, including the null byte
+//                                and padding to a multiple of 8
+//          uint32_t nvals        Number of int64_t values after the name
+//          char     name[nlen]   name{labels}
+//          int64_t  vals[nvals]  Counters and gauges have a single value;
+//                                histograms have the sample count, the sum
+//                                in nanoseconds, and the count in each bin.
+//
+// Histogram bins are log-linear in microseconds: values below 4us have a
+// bin each, after that each power of two is split into four equal bins (see
+// Histogram::BinUpper()).
+
+class XrdSysMetrics
+{
+public:
+
+enum Kind {isCounter = 0, isGauge = 1, isHistogram = 2};
+
+class Metric
+{
+public:
+
+const char *Name()   const {return mName;}
+const char *Labels() const {return mLabels;}
+Kind        Type()   const {return mKind;}
+
+// Current value of a counter, gauge, or probe.
+//
+virtual
+long long   Value() const {return 0;}
+
+protected:
+
+            Metric(const char *name, const char *help, Kind kind,
+                   const char *labels);
+virtual    ~Metric() {}
+
+private:
+friend class XrdSysMetrics;
+
+Metric     *mNext;
+const char *mName;
+const char *mHelp;
+const char *mLabels;
+Kind        mKind;
+};
+
+/******************************************************************************/
+/*                               C o u n t e r                                */
+/******************************************************************************/
+
+// A monotonically increasing count (or, when constructed as a gauge, a value
+// that may also go down).
+
+class Counter : public Metric
+{
+public:
+
+inline void Add(long long val=1)
+               {mShard[Shard()].val.fetch_add(val, std::memory_order_relaxed);}
+
+inline void Sub(long long val=1) {Add(-val);}
+
+long long   Value() const override;
+
+            Counter(const char *name, const char *help,
+                    const char *labels=0, bool gauge=false)
+                   : Metric(name, help, (gauge ? isGauge : isCounter), labels)
+                   {}
+           ~Counter() {}
+
+private:
+
+struct alignas(64) Cell {std::atomic<long long> val{0};};
+Cell        mShard[16];
+};
+
+/******************************************************************************/
+/*                             H i s t o g r a m                              */
+/******************************************************************************/
+
+class Histogram : public Metric
+{
+public:
+
+static constexpr int subBits = 2;
+static constexpr int numBins = (32 << subBits);
+
+// Record a latency, in nanoseconds.
+//
+void        Record(long long nsec);
+
+// Obtain the number of samples, their sum in nanoseconds, and the count in
+// each of the numBins bins.
+//
+void        Read(long long &count, long long &sum, long long *bins) const;
+
+// Map a value in microseconds to its bin and obtain the upper edge of a bin
+// in microseconds.
+//
+static int  BinOf(unsigned long long usec);
+static double BinUpper(int bin);
+
+            Histogram(const char *name, const char *help,
+                      const char *labels=0)
+                     : Metric(name, help, isHistogram, labels) {}
+           ~Histogram() {}
+
+private:
+
+struct alignas(64) Cell
+      {std::atomic<long long> count{0};
+       std::atomic<long long> sum{0};
+       std::atomic<long long> bins[numBins];
+       Cell() {for (auto &b : bins) b.store(0, std::memory_order_relaxed);}
+      };
+Cell        mShard[4];
+};
+
+/******************************************************************************/
+/*                                 P r o b e                                  */
+/******************************************************************************/
+
+// A metric whose value is obtained by calling a function when it is exported.
+// This exposes counters a component already maintains without having it
+// update two copies. The function is called from the exporting thread and
+// must not block.
+
+class Probe : public Metric
+{
+public:
+
+long long   Value() const override {return mFunc(mArg);}
+
+            Probe(const char *name, const char *help, Kind kind,
+                  long long (*func)(void *), void *arg=0,
+                  const char *labels=0)
+                 : Metric(name, help, kind, labels),
+                   mFunc(func), mArg(arg) {}
+           ~Probe() {}
+
+private:
+
+long long (*mFunc)(void *);
+void       *mArg;
+};
+
+/******************************************************************************/
+/*                               E x p o r t s                                */
+/******************************************************************************/
+
+// Produce a binary snapshot of all metrics into buff. Returns the size of the
+// snapshot; if that is greater than blen, nothing was written and the call
+// should be repeated with a buffer of at least that size. The generation in
+// the header is left for the caller to maintain.
+//
+static int  Binary(char *buff, int blen);
+
+static const int  binVersion = 1;
+
+// Append all metrics to text in the Prometheus text exposition format.
+//
+static void Prometheus(std::string &text);
+
+private:
+
+static int  Shard() {return (myShard >= 0 ? myShard : NewShard());}
+static int  NewShard();
+
+static std::atomic<Metric *> mList;
+static thread_local int      myShard;
+};
+#endif
@@ -124,7 +124,7 @@ private:
 
    bool m_is_open{false};
    unique_sfs_ptr m_sfs;
-   int m_uid; // A unique identifier for this user; has no meaning except for the fairshare.
+   XrdThrottleManager::FileShare *m_share{nullptr}; // This file's place in the fairshare.
    std::string m_loadshed;
    std::string m_connection_id; // Identity for the connection; may or may authenticated
    std::string m_user;
@@ -290,6 +290,9 @@ private:
    int
    xmaxconn(XrdOucStream &Config);
 
+   int
+   xweight(XrdOucStream &Config);
+
    static FileSystem  *m_instance;
    XrdSysError         m_eroute;
    XrdOucTrace         m_trace;
@@ -19,8 +19,8 @@ using namespace XrdThrottle;
 
 #define DO_THROTTLE(amount) \
 DO_LOADSHED \
-m_throttle.Apply(amount, 1, m_uid); \
-XrdThrottleTimer xtimer = m_throttle.StartIOTimer();
+double xqueued = m_throttle.Apply(amount, 1, m_share); \
+XrdThrottleTimer xtimer = m_throttle.StartIOTimer(xqueued);
 
 File::File(const char                     *user,
                  unique_sfs_ptr            sfs,
@@ -32,7 +32,6 @@ File::File(const char                     *user,
 #else
      m_sfs(sfs),
 #endif
-     m_uid(0),
      m_connection_id(user ? user : ""),
      m_throttle(throttle),
      m_eroute(eroute)
@@ -43,6 +42,7 @@ File::~File()
    if (m_is_open) {
       m_throttle.CloseFile(m_user);
    }
+   m_throttle.CloseShare(m_share);
 }
 
 int
@@ -61,8 +61,15 @@ File::open(const char                *fileName,
        if (client->eaAPI->Get("request.name", user) && !user.empty()) m_user = user;
    }
    if (m_user.empty()) {m_user = client->name ? client->name : "nobody";}
-   m_uid = XrdThrottleManager::GetUid(m_user.c_str());
    m_throttle.PrepLoadShed(opaque, m_loadshed);
+   if (m_throttle.CheckOpenShed(m_loadshed)) {
+      unsigned port;
+      std::string host;
+      m_throttle.PerformLoadShed(m_loadshed, host, port);
+      m_eroute.Emsg("File", "Performing load-shed of open for client", m_connection_id.c_str());
+      error.setErrInfo(port, host.c_str());
+      return SFS_REDIRECT;
+   }
    std::string open_error_message;
    if (!m_throttle.OpenFile(m_user, open_error_message)) {
        error.setErrInfo(EMFILE, open_error_message.c_str());
@@ -71,6 +78,7 @@ File::open(const char                *fileName,
    auto retval = m_sfs->open(fileName, openMode, createMode, client, opaque);
    if (retval != SFS_ERROR) {
       m_is_open = true;
+      m_share = m_throttle.OpenShare(client->vorg ? client->vorg : "default", m_user);
    } else {
       m_throttle.CloseFile(m_user);
    }
@@ -82,6 +90,8 @@ File::close()
 {
    m_is_open = false;
    m_throttle.CloseFile(m_user);
+   m_throttle.CloseShare(m_share);
+   m_share = nullptr;
    return m_sfs->close();
 }
 
@@ -1,5 +1,7 @@
 
 #include <fcntl.h>
+#include <cstdlib>
+#include <cstring>
 
 #include "XrdSys/XrdSysPlugin.hh"
 #include "XrdOuc/XrdOuca2x.hh"
@@ -164,6 +166,7 @@ FileSystem::Configure(XrdSysError & log, XrdSfsFileSystem *native_fs, XrdOucEnv
       TS_Xeq("throttle.throttle", xthrottle);
       TS_Xeq("throttle.loadshed", xloadshed);
       TS_Xeq("throttle.trace", xtrace);
+      TS_Xeq("throttle.weight", xweight);
       if (NoGo)
       {
          log.Emsg("Config", "Throttle configuration failed.");
@@ -240,6 +243,44 @@ FileSystem::xmaxconn(XrdOucStream &Config)
 }
 
 
+/******************************************************************************/
+/*                              x w e i g h t                                 */
+/******************************************************************************/
+
+/* Function: xweight
+
+   Purpose:  Parse the directive: throttle.weight {vo | user} <name> <weight>
+
+             <name>    name of the VO or user the weight applies to.
+             <weight>  relative fairshare weight; the default for all is 1.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+int
+FileSystem::xweight(XrdOucStream &Config)
+{
+    auto val = Config.GetWord();
+    bool isvo;
+    if (val && !strcmp(val, "vo")) isvo = true;
+    else if (val && !strcmp(val, "user")) isvo = false;
+    else
+       {m_eroute.Emsg("Config", "Weight class not specified!  Example usage: throttle.weight vo cms 2"); return 1;}
+    std::string name;
+    if (!(val = Config.GetWord()) || val[0] == '\0')
+       {m_eroute.Emsg("Config", "Weight name not specified!  Example usage: throttle.weight vo cms 2"); return 1;}
+    name = val;
+    if (!(val = Config.GetWord()) || val[0] == '\0')
+       {m_eroute.Emsg("Config", "Weight value not specified!  Example usage: throttle.weight vo cms 2"); return 1;}
+    char *end;
+    float weight = strtof(val, &end);
+    if (*end || !(weight > 0))
+       {m_eroute.Emsg("Config", "Invalid weight value", val); return 1;}
+
+    m_throttle.SetWeight(isvo, name, weight);
+    return 0;
+}
+
+
 /******************************************************************************/
 /*                            x t h r o t t l e                               */
 /******************************************************************************/
@@ -304,17 +345,23 @@ FileSystem::xthrottle(XrdOucStream &Config)
 /* Function: xloadshed
 
    Purpose:  To parse the directive: loadshed host <hostname> [port <port>] [frequency <freq>]
+                                              [latency <ms>]
 
              <hostname> hostname of server to shed load to.  Required
              <port>     port of server to shed load to.  Defaults to 1094
              <freq>     A value from 1 to 100 specifying how often to shed load
                         (1 = 1% chance; 100 = 100% chance; defaults to 10).
+                        With a latency target, the most opens that may be shed.
+             <ms>       Target for the 99th percentile of IO latency, queueing
+                        plus service time, in milliseconds.  When given, new
+                        opens are shed as needed to meet it instead of shedding
+                        IO whenever a throttle limit is hit.
 
    Output: 0 upon success or !0 upon failure.
 */
 int FileSystem::xloadshed(XrdOucStream &Config)
 {
-    long long port = 0, freq = 0;
+    long long port = 0, freq = 0, latency = 0;
     char *val;
     std::string hostname;
 
@@ -338,6 +385,12 @@ int FileSystem::xloadshed(XrdOucStream &Config)
               {m_eroute.Emsg("Config", "Loadshed frequency not specified."); return 1;}
            if (XrdOuca2x::a2sz(m_eroute,"Loadshed frequency",val,&freq,1,100)) return 1;
        }
+       else if (strcmp("latency", val) == 0)
+       {
+           if (!(val = Config.GetWord()))
+              {m_eroute.Emsg("Config", "Loadshed latency target not specified."); return 1;}
+           if (XrdOuca2x::a2ll(m_eroute,"Loadshed latency target",val,&latency,1)) return 1;
+       }
        else
        {
            m_eroute.Emsg("Config", "Warning - unknown loadshed option specified", val, ".");
@@ -351,6 +404,7 @@ int FileSystem::xloadshed(XrdOucStream &Config)
     }
 
     m_throttle.SetLoadShed(hostname, port, freq);
+    if (latency) m_throttle.SetLoadShedLatency(latency / 1000.0);
     return 0;
 }
 
@@ -0,0 +1,101 @@
+#include "XrdThrottleLatency.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// The latency metric is only wanted when the controller is in use, and there
+// is one per process however many controllers there are.
+XrdSysMetrics::Histogram *IOHist()
+{
+   static XrdSysMetrics::Histogram *hist = new XrdSysMetrics::Histogram(
+          "xrootd_throttle_io_seconds",
+          "Time IO spent queued in the throttle plus being serviced.");
+   return hist;
+}
+}
+
+XrdThrottleLatency::XrdThrottleLatency()
+{
+   for (auto &bin : m_last) bin = 0;
+}
+
+/*
+ * Set the target, starting the first interval from the histogram's counts
+ * as they stand when the controller is first enabled.
+ */
+void
+XrdThrottleLatency::SetTarget(double target, double max_fraction)
+{
+   if (target > 0 && !m_hist)
+   {
+      long long count, sum;
+      m_hist = IOHist();
+      m_hist->Read(count, sum, m_last);
+   }
+   m_max_fraction = max_fraction;
+   m_target = target;
+}
+
+void
+XrdThrottleLatency::Record(double seconds)
+{
+   if (m_hist)
+      m_hist->Record(seconds > 0 ? static_cast<long long>(seconds * 1e9) : 0);
+}
+
+/*
+ * Called once per interval by a single thread.  The controller is an
+ * integrator on log2(p99 / target): each doubling above the target sheds
+ * a further m_gain of the opens per interval.  Running below the target
+ * releases them at no more than a quarter of that rate; since shed opens
+ * only take effect as admitted files close, releasing faster makes the
+ * loop oscillate around the target.  Intervals with too few samples to
+ * give a meaningful p99 count as being below the target.
+ */
+double
+XrdThrottleLatency::Update()
+{
+   // The histogram is cumulative; the interval's counts are the difference
+   // from the last reading.
+   long long bins[Hist::numBins], count, sum;
+   unsigned long long counts[Hist::numBins];
+   unsigned long long total = 0;
+   if (!m_hist) return 0;
+   m_hist->Read(count, sum, bins);
+   for (int i = 0; i < Hist::numBins; i++)
+   {
+      counts[i] = bins[i] - m_last[i];
+      m_last[i] = bins[i];
+      total += counts[i];
+   }
+   m_samples = total;
+
+   double p99 = 0, error;
+   if (total >= m_min_samples)
+   {
+      // Number of samples allowed above the percentile.
+      unsigned long long tail = total / 100;
+      unsigned long long seen = 0;
+      int bin = Hist::numBins - 1;
+      while (bin > 0 && seen + counts[bin] <= tail)
+         seen += counts[bin--];
+      p99 = Hist::BinUpper(bin) * 1e-6;
+      error = std::log2(p99 / m_target);
+      // Stay put while within a histogram bin of the target.
+      if (std::fabs(error) < 0.25) error = 0;
+   }
+   else
+   {
+      error = -0.25;
+   }
+
+   if (!Enabled()) return p99;
+
+   double fraction = m_fraction.load(std::memory_order_relaxed);
+   fraction += m_gain * std::max(-0.25, std::min(error, 4.0));
+   fraction = std::max(0.0, std::min(fraction, m_max_fraction));
+   m_fraction.store(fraction, std::memory_order_relaxed);
+   return p99;
+}
@@ -0,0 +1,79 @@
+
+/*
+ * XrdThrottleLatency
+ *
+ * Tracks the distribution of per-request IO latency - the time a request
+ * spends queued in the throttle plus the time the underlying filesystem
+ * takes to service it - and adjusts the fraction of new opens which should
+ * be shed to another server so that the 99th percentile stays below a
+ * configured target.
+ *
+ * Samples are recorded lock-free into a log-linear latency histogram,
+ * created once per process when a target is first set and exported with
+ * the server's other metrics; once per
+ * throttle interval the manager calls Update(), which computes the p99 of
+ * the interval and moves the shed fraction by an amount proportional to
+ * the log of the ratio between the p99 and the target.  The class has no
+ * dependencies on the rest of the throttle so that the controller can be
+ * driven by a simulation to tune it offline.
+ */
+
+#ifndef __XrdThrottleLatency_hh_
+#define __XrdThrottleLatency_hh_
+
+#include <atomic>
+
+#include "XrdSys/XrdSysMetrics.hh"
+
+class XrdThrottleLatency
+{
+
+public:
+
+// Configure the p99 latency target (seconds) and the largest fraction of
+// opens which may be shed.  A target <= 0 disables the controller.
+void        SetTarget(double target, double max_fraction=1.0);
+
+bool        Enabled() const {return m_target > 0;}
+
+double      Target() const {return m_target;}
+
+// Record the latency, in seconds, of a single request.
+void        Record(double seconds);
+
+// Close the current interval; returns the interval's p99 latency in seconds
+// (0 if there were too few samples) and updates the shed fraction.
+double      Update();
+
+// Fraction of new opens which should currently be shed, from 0 to 1.
+double      Fraction() const {return m_fraction.load(std::memory_order_relaxed);}
+
+// Number of samples seen in the last completed interval.
+unsigned long long Samples() const {return m_samples;}
+
+// Controller tuning: fraction moved per interval per doubling of p99 over
+// the target, and the minimum number of samples needed to act on a p99.
+void        SetGain(double gain) {m_gain = gain;}
+
+void        SetMinSamples(unsigned long long count) {m_min_samples = count;}
+
+            XrdThrottleLatency();
+
+           ~XrdThrottleLatency() {}
+
+private:
+
+typedef XrdSysMetrics::Histogram Hist;
+
+Hist       *m_hist{nullptr};       // Shared by all instances, see SetTarget()
+long long   m_last[Hist::numBins]; // Bin counts at the last Update()
+
+double      m_target{0};
+double      m_max_fraction{1.0};
+double      m_gain{0.05};
+unsigned long long m_min_samples{20};
+unsigned long long m_samples{0};
+std::atomic<double> m_fraction{0};
+};
+
+#endif
@@ -10,13 +10,16 @@
 #define XRD_TRACE m_trace->
 #include "XrdThrottle/XrdThrottleTrace.hh"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <thread>
 
 const char *
 XrdThrottleManager::TraceID = "ThrottleManager";
 
 const
-int XrdThrottleManager::m_max_users = 1024;
+int XrdThrottleManager::m_hist_bins;
 
 #if defined(__linux__) || defined(__APPLE__) || defined(__GNU__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))
 clockid_t XrdThrottleTimer::clock_id = CLOCK_MONOTONIC;
@@ -31,7 +34,6 @@ XrdThrottleManager::XrdThrottleManager(XrdSysError *lP, XrdOucTrace *tP) :
    m_bytes_per_second(-1),
    m_ops_per_second(-1),
    m_concurrency_limit(-1),
-   m_last_round_allocation(100*1024),
    m_io_active(0),
    m_loadshed_host(""),
    m_loadshed_port(0),
@@ -46,20 +48,6 @@ void
 XrdThrottleManager::Init()
 {
    TRACE(DEBUG, "Initializing the throttle manager.");
-   // Initialize all our shares to zero.
-   m_primary_bytes_shares.resize(m_max_users);
-   m_secondary_bytes_shares.resize(m_max_users);
-   m_primary_ops_shares.resize(m_max_users);
-   m_secondary_ops_shares.resize(m_max_users);
-   // Allocate each user 100KB and 10 ops to bootstrap;
-   for (int i=0; i<m_max_users; i++)
-   {
-      m_primary_bytes_shares[i] = m_last_round_allocation;
-      m_secondary_bytes_shares[i] = 0;
-      m_primary_ops_shares[i] = 10;
-      m_secondary_ops_shares[i] = 0;
-   }
-
    m_io_wait.tv_sec = 0;
    m_io_wait.tv_nsec = 0;
 
@@ -70,40 +58,124 @@ XrdThrottleManager::Init()
 
 }
 
+double
+XrdThrottleManager::Now()
+{
+   return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 /*
- * Take as many shares as possible to fulfill the request; update
- * request with current remaining value, or zero if satisfied.
+ * Mark a node as having recent activity, adding its weight to those of
+ * its parent's active children.  The caller holds the lock guarding the
+ * parent's children.
  */
-inline void
-XrdThrottleManager::GetShares(int &shares, int &request)
+void
+XrdThrottleManager::Activate(ShareNode &node, ShareNode &parent, double now)
+{
+   node.m_last_active = now;
+   if (!node.m_active)
+   {
+      node.m_active = true;
+      parent.m_active_weight = parent.m_active_weight + node.m_weight;
+   }
+}
+
+void
+XrdThrottleManager::Deactivate(ShareNode &node, ShareNode &parent)
 {
-   int remaining;
-   AtomicFSub(remaining, shares, request);
-   if (remaining > 0)
+   if (node.m_active)
    {
-      request -= (remaining < request) ? remaining : request;
+      node.m_active = false;
+      double weight = parent.m_active_weight - node.m_weight;
+      parent.m_active_weight = weight < 0 ? 0 : weight;
    }
 }
 
 /*
- * Iterate through all of the secondary shares, attempting 
- * to steal enough to fulfill the request.
+ * A node's weighted part of its parent's share.  The node may be expired
+ * between being marked active and this being read without the parent's
+ * lock, so the part is never taken to be more than the whole.
  */
-void
-XrdThrottleManager::StealShares(int uid, int &reqsize, int &reqops)
+double
+XrdThrottleManager::Part(const ShareNode &node, const ShareNode &parent)
 {
-   if (!reqsize && !reqops) return;
-   TRACE(BANDWIDTH, "Stealing shares to fill request of " << reqsize << " bytes");
-   TRACE(IOPS, "Stealing shares to fill request of " << reqops << " ops.");
+   return node.m_weight / std::max<double>(parent.m_active_weight, node.m_weight);
+}
 
-   for (int i=uid+1; i % m_max_users == uid; i++)
+/*
+ * Charge a request against a server-wide bucket.  These are paced like the
+ * per-file ones but shared by every request, so are updated without a lock.
+ * Returns the time at which the bucket, which holds at most one interval's
+ * worth, had room for the request; this is now if it had capacity to spare.
+ */
+double
+XrdThrottleManager::Charge(std::atomic<double> &tat, double cost, double rate, double now)
+{
+   double old_tat = tat.load(std::memory_order_relaxed), new_tat;
+   do {new_tat = std::max(old_tat, now) + cost / rate;}
+      while (!tat.compare_exchange_weak(old_tat, new_tat, std::memory_order_relaxed));
+   return std::max(now, new_tat - m_interval_length_seconds);
+}
+
+/*
+ * Charge a request of the given cost against a bucket paced at the given
+ * rate and return the earliest time it may start.  Up to one interval of
+ * burst is allowed.  When borrowing, the request starts now and the bucket
+ * is left no further behind than an empty bucket, so that borrowed capacity
+ * is not paid back later.
+ */
+double
+XrdThrottleManager::Pace(Bucket &bucket, double cost, double rate, double now, bool borrow)
+{
+   double tau = m_interval_length_seconds;
+   double start = std::max(now, bucket.m_tat - tau);
+   bucket.m_tat = std::max(bucket.m_tat, now) + cost / rate;
+   if (borrow && bucket.m_tat > now + tau) bucket.m_tat = now + tau;
+   return start;
+}
+
+/*
+ * Register a newly opened file under its VO and user.
+ */
+XrdThrottleManager::FileShare *
+XrdThrottleManager::OpenShare(const std::string &vo, const std::string &user)
+{
+   const std::lock_guard<std::mutex> lock(m_share_mutex);
+   auto &vo_node = m_vos[vo];
+   if (!vo_node)
    {
-      if (reqsize) GetShares(m_secondary_bytes_shares[i % m_max_users], reqsize);
-      if (reqops)  GetShares(m_secondary_ops_shares[  i % m_max_users], reqops);
+      vo_node.reset(new VONode());
+      auto iter = m_vo_weights.find(vo);
+      if (iter != m_vo_weights.end()) vo_node->m_weight = iter->second;
    }
+   auto &user_node = vo_node->m_users[user];
+   if (!user_node)
+   {
+      user_node.reset(new UserNode());
+      user_node->m_vo = vo_node.get();
+      auto iter = m_user_weights.find(user);
+      if (iter != m_user_weights.end()) user_node->m_weight = iter->second;
+   }
+   // A new file starts with an empty bucket; any burst is borrowed from the
+   // server, so that reopening files gains a user nothing.
+   FileShare *share = new FileShare();
+   share->m_user = user_node.get();
+   share->m_bytes.m_tat = share->m_ops.m_tat = Now() + m_interval_length_seconds;
+   user_node->m_files.insert(share);
+   return share;
+}
 
-   TRACE(BANDWIDTH, "After stealing shares, " << reqsize << " of request bytes remain.");
-   TRACE(IOPS, "After stealing shares, " << reqops << " of request ops remain.");
+void
+XrdThrottleManager::CloseShare(FileShare *share)
+{
+   if (!share) return;
+   const std::lock_guard<std::mutex> lock(m_share_mutex);
+   {
+      const std::lock_guard<std::mutex> user_lock(share->m_user->m_mutex);
+      Deactivate(*share, *share->m_user);
+   }
+   share->m_user->m_files.erase(share);
+   delete share;
 }
 
 /*
@@ -253,48 +325,87 @@ XrdThrottleManager::CloseFile(const std::string &entity)
 /*
  * Apply the throttle.  If there are no limits set, returns immediately.  Otherwise,
  * this applies the limits as best possible, stalling the thread if necessary.
+ *
+ * The request is charged against its file's bucket, paced at the file's part
+ * of its user's part of its VO's share of the rate.  If that would delay the
+ * request but the server as a whole has capacity to spare, the request borrows
+ * it and starts immediately.  Otherwise the thread sleeps until the start time computed.
+ *
+ * Only the file's user is locked; the server buckets and per-VO statistics
+ * are updated atomically, and the hierarchy lock is taken only when the
+ * file's VO or user was idle.
+ *
+ * Returns the time, in seconds, for which the request was delayed.
  */
-void
-XrdThrottleManager::Apply(int reqsize, int reqops, int uid)
+double
+XrdThrottleManager::Apply(int reqsize, int reqops, FileShare *share)
 {
    if (m_bytes_per_second < 0)
       reqsize = 0;
    if (m_ops_per_second < 0)
       reqops = 0;
-   while (reqsize || reqops)
+   if (!reqsize && !reqops) return 0;
+
+   // Charge the server bucket immediately, even if the request must wait,
+   // so that capacity promised to waiting requests cannot be borrowed.
+   double now = Now(), start = now;
+   if (reqsize) start = std::max(start, Charge(m_root_bytes, reqsize, m_bytes_per_second, now));
+   if (reqops)  start = std::max(start, Charge(m_root_ops, reqops, m_ops_per_second, now));
+
+   // Without a share to charge, the request simply waits for the server
+   // bucket; otherwise it is paced by its file and may borrow from the server.
+   if (share)
    {
-      // Subtract the requested out of the shares
-      AtomicBeg(m_compute_var);
-      GetShares(m_primary_bytes_shares[uid], reqsize);
-      if (reqsize)
-      {
-         TRACE(BANDWIDTH, "Using secondary shares; request has " << reqsize << " bytes left.");
-         GetShares(m_secondary_bytes_shares[uid], reqsize);
-         TRACE(BANDWIDTH, "Finished with secondary shares; request has " << reqsize << " bytes left.");
-      }
-      else
-      {
-         TRACE(BANDWIDTH, "Filled byte shares out of primary; " << m_primary_bytes_shares[uid] << " left.");
-      }
-      GetShares(m_primary_ops_shares[uid], reqops);
-      if (reqops)
+      bool borrow = start <= now;
+      UserNode *user = share->m_user;
+      VONode *vo = user->m_vo;
+      if (!vo->m_active || !user->m_active)
       {
-         GetShares(m_secondary_ops_shares[uid], reqops);
+         const std::lock_guard<std::mutex> lock(m_share_mutex);
+         Activate(*vo, m_root, now);
+         Activate(*user, *vo, now);
       }
-      StealShares(uid, reqsize, reqops);
-      AtomicEnd(m_compute_var);
 
-      if (reqsize || reqops)
-      {
-         if (reqsize) TRACE(BANDWIDTH, "Sleeping to wait for throttle fairshare.");
-         if (reqops) TRACE(IOPS, "Sleeping to wait for throttle fairshare.");
-         m_compute_var.Wait();
-         AtomicBeg(m_compute_var);
-         AtomicInc(m_loadshed_limit_hit);
-         AtomicEnd(m_compute_var);
-      }
+      const std::lock_guard<std::mutex> lock(user->m_mutex);
+      Activate(*share, *user, now);
+
+      // Each level's rate is its weighted part of its parent's rate,
+      // amongst the siblings with recent activity; the file's rate is
+      // then its part of the server's.  Pacing each file at that rate
+      // keeps every class within its share.
+      double frac = Part(*vo, m_root) * Part(*user, *vo) * Part(*share, *user);
+
+      double tau = m_interval_length_seconds;
+      bool within = (!reqsize || share->m_bytes.m_tat - tau <= now) &&
+                    (!reqops  || share->m_ops.m_tat - tau <= now);
+      borrow = borrow && !within;
+      start = now;
+      if (reqsize) start = std::max(start, Pace(share->m_bytes, reqsize, m_bytes_per_second * frac, now, borrow));
+      if (reqops)  start = std::max(start, Pace(share->m_ops, reqops, m_ops_per_second * frac, now, borrow));
+      if (borrow) start = now;
+
+      // A request waiting to start keeps its classes active until then.
+      vo->m_last_active = user->m_last_active = share->m_last_active = start;
+
+      double wait_us = (start - now) * 1e6;
+      int bin = 0;
+      while (wait_us >= 1 && bin < m_hist_bins-1) {wait_us /= 2; bin++;}
+      vo->m_wait_hist[bin].fetch_add(1, std::memory_order_relaxed);
+      vo->m_req_bytes.fetch_add(reqsize, std::memory_order_relaxed);
+      vo->m_req_ops.fetch_add(reqops, std::memory_order_relaxed);
    }
 
+   if (start > now)
+   {
+      if (reqsize) TRACE(BANDWIDTH, "Sleeping " << (start - now) << "s to wait for throttle fairshare.");
+      if (reqops) TRACE(IOPS, "Sleeping " << (start - now) << "s to wait for throttle fairshare.");
+      AtomicBeg(m_compute_var);
+      AtomicInc(m_loadshed_limit_hit);
+      AtomicEnd(m_compute_var);
+      std::this_thread::sleep_for(std::chrono::duration<double>(start - now));
+      return start - now;
+   }
+   return 0;
 }
 
 void *
@@ -359,74 +470,34 @@ XrdThrottleManager::Recompute()
 }
 
 /*
- * The heart of the manager approach.
- *
- * This routine periodically recomputes the shares of each current user.
- * Each user has a "primary" and a "secondary" share.  At the end of the
- * each time interval, the remaining primary share is moved to secondary.
- * A user can utilize both shares; if both are gone, they must block until
- * the next recompute interval.
- *
- * The secondary share can be "stolen" by any other user; so, if a user
- * is idle or under-utilizing, their share can be used by someone else.
- * However, they can never be completely starved, as no one can steal
- * primary share.
- *
- * In this way, we violate the throttle for an interval, but never starve.
- *
+ * Fairshares are computed on the fly in Apply; at the end of each interval
+ * we only need to forget classes which have gone idle and report the
+ * per-class statistics.
  */
 void
 XrdThrottleManager::RecomputeInternal()
 {
-   // Compute total shares for this interval; 
    float intervals_per_second = 1.0/m_interval_length_seconds;
-   float total_bytes_shares = m_bytes_per_second / intervals_per_second;
-   float total_ops_shares   = m_ops_per_second / intervals_per_second;
-
-   // Compute the number of active users; a user is active if they used
-   // any primary share during the last interval;
-   AtomicBeg(m_compute_var);
-   float active_users = 0;
-   long bytes_used = 0;
-   for (int i=0; i<m_max_users; i++)
-   {
-      int primary = AtomicFAZ(m_primary_bytes_shares[i]);
-      if (primary != m_last_round_allocation)
-      {
-         active_users++;
-         if (primary >= 0)
-            m_secondary_bytes_shares[i] = primary;
-         primary = AtomicFAZ(m_primary_ops_shares[i]);
-         if (primary >= 0)
-             m_secondary_ops_shares[i] = primary;
-         bytes_used += (primary < 0) ? m_last_round_allocation : (m_last_round_allocation-primary);
-      }
-   }
-
-   if (active_users == 0)
-   {
-      active_users++;
-   }
 
-   // Note we allocate the same number of shares to *all* users, not
-   // just the active ones.  If a new user becomes active in the next
-   // interval, we'll go over our bandwidth budget just a bit.
-   m_last_round_allocation = static_cast<int>(total_bytes_shares / active_users);
-   int ops_shares = static_cast<int>(total_ops_shares / active_users);
-   TRACE(BANDWIDTH, "Round byte allocation " << m_last_round_allocation << " ; last round used " << bytes_used << ".");
-   TRACE(IOPS, "Round ops allocation " << ops_shares);
-   for (int i=0; i<m_max_users; i++)
-   {
-      m_primary_bytes_shares[i] = m_last_round_allocation;
-      m_primary_ops_shares[i] = ops_shares;
-   }
+   ExpireShares(Now());
+   ReportShares();
 
+   AtomicBeg(m_compute_var);
    // Reset the loadshed limit counter.
    int limit_hit = AtomicFAZ(m_loadshed_limit_hit);
    TRACE(DEBUG, "Throttle limit hit " << limit_hit << " times during last interval.");
 
    AtomicEnd(m_compute_var);
 
+   // Let the latency controller decide how much of the load to shed.
+   double p99 = 0;
+   if (m_latency.Enabled())
+   {
+      p99 = m_latency.Update();
+      TRACE(IOLOAD, "IO latency p99 is " << p99*1000 << "ms over " << m_latency.Samples()
+                    << " requests; shedding " << m_latency.Fraction()*100 << "% of opens.");
+   }
+
    // Update the IO counters
    m_compute_var.Lock();
    m_stable_io_active = AtomicGet(m_io_active);
@@ -451,11 +522,17 @@ XrdThrottleManager::RecomputeInternal()
    TRACE(IOLOAD, "Current IO counter is " << io_active << "; total IO wait time is " << io_wait_ms << "ms.");
    if (m_gstream)
    {
-        char buf[128];
-        auto len = snprintf(buf, 128,
-                            R"({"event":"throttle_update","io_wait":%.4f,"io_active":%d,"io_total":%d})",
-                            static_cast<double>(io_wait_ms) / 1000.0, io_active, io_total);
-        auto suc = (len < 128) ? m_gstream->Insert(buf, len + 1) : false;
+        char buf[192];
+        int len;
+        if (m_latency.Enabled())
+            len = snprintf(buf, 192,
+                           R"({"event":"throttle_update","io_wait":%.4f,"io_active":%d,"io_total":%d,"p99":%.4f,"shed":%.3f})",
+                           static_cast<double>(io_wait_ms) / 1000.0, io_active, io_total, p99, m_latency.Fraction());
+        else
+            len = snprintf(buf, 192,
+                           R"({"event":"throttle_update","io_wait":%.4f,"io_active":%d,"io_total":%d})",
+                           static_cast<double>(io_wait_ms) / 1000.0, io_active, io_total);
+        auto suc = (len < 192) ? m_gstream->Insert(buf, len + 1) : false;
         if (!suc)
         {
             TRACE(IOLOAD, "Failed g-stream insertion of throttle_update record (len=" << len << "): " << buf);
@@ -465,52 +542,120 @@ XrdThrottleManager::RecomputeInternal()
 }
 
 /*
- * Do a simple hash across the username.
+ * Deactivate all classes which saw no requests during the last interval,
+ * so that their share is redistributed amongst the active ones.  Users with
+ * no open files are removed entirely.
  */
-int
-XrdThrottleManager::GetUid(const char *username)
+void
+XrdThrottleManager::ExpireShares(double now)
 {
-   const char *cur = username;
-   int hval = 0;
-   while (cur && *cur && *cur != '@' && *cur != '.')
+   double idle = now - m_interval_length_seconds;
+   const std::lock_guard<std::mutex> lock(m_share_mutex);
+   for (auto &vo_entry : m_vos)
    {
-      hval += *cur;
-      hval %= m_max_users;
-      cur++;
+      VONode &vo = *vo_entry.second;
+      for (auto iter = vo.m_users.begin(); iter != vo.m_users.end();)
+      {
+         UserNode &user = *iter->second;
+         {
+            const std::lock_guard<std::mutex> user_lock(user.m_mutex);
+            for (auto share : user.m_files)
+            {
+               if (share->m_last_active < idle) Deactivate(*share, user);
+            }
+         }
+         if (user.m_last_active < idle) Deactivate(user, vo);
+         if (user.m_files.empty())
+         {
+            Deactivate(user, vo);
+            iter = vo.m_users.erase(iter);
+         }
+         else
+         {
+            iter++;
+         }
+      }
+      if (vo.m_last_active < idle) Deactivate(vo, m_root);
+   }
+}
+
+/*
+ * Publish the per-VO usage and throttle wait histogram for the last interval;
+ * bin i of the histogram counts requests delayed by [2^(i-1), 2^i) microseconds,
+ * with bin 0 counting those not delayed at all.
+ */
+void
+XrdThrottleManager::ReportShares()
+{
+   const std::lock_guard<std::mutex> lock(m_share_mutex);
+   for (auto iter = m_vos.begin(); iter != m_vos.end();)
+   {
+      VONode &vo = *iter->second;
+      unsigned long long bytes = vo.m_req_bytes.exchange(0);
+      unsigned long long ops = vo.m_req_ops.exchange(0);
+      unsigned long long hist[m_hist_bins];
+      for (int i = 0; i < m_hist_bins; i++) hist[i] = vo.m_wait_hist[i].exchange(0);
+      if (m_gstream && (bytes || ops))
+      {
+         std::stringstream ss;
+         ss << R"({"event":"throttle_class","vo":")";
+         for (auto c : iter->first) if (c != '"' && c != '\\' && c >= ' ') ss << c;
+         ss << R"(","bytes":)" << bytes << R"(,"ops":)" << ops << R"(,"wait_us":[)";
+         for (int i = 0; i < m_hist_bins; i++)
+            ss << (i ? "," : "") << hist[i];
+         ss << "]}";
+         auto record = ss.str();
+         if (!m_gstream->Insert(record.c_str(), record.size() + 1))
+         {
+            TRACE(IOLOAD, "Failed g-stream insertion of throttle_class record: " << record);
+         }
+      }
+      if (vo.m_users.empty())
+      {
+         Deactivate(vo, m_root);
+         iter = m_vos.erase(iter);
+      }
+      else
+      {
+         iter++;
+      }
    }
-   //std::cerr << "Calculated UID " << hval << " for " << username << std::endl;
-   return hval;
 }
 
 /*
  * Create an IO timer object; increment the number of outstanding IOs.
  */
 XrdThrottleTimer
-XrdThrottleManager::StartIOTimer()
+XrdThrottleManager::StartIOTimer(double queued)
 {
    AtomicBeg(m_compute_var);
    int cur_counter = AtomicInc(m_io_active);
    AtomicInc(m_io_total);
    AtomicEnd(m_compute_var);
-   while (m_concurrency_limit >= 0 && cur_counter > m_concurrency_limit)
+   if (m_concurrency_limit >= 0 && cur_counter > m_concurrency_limit)
    {
-      AtomicBeg(m_compute_var);
-      AtomicInc(m_loadshed_limit_hit);
-      AtomicDec(m_io_active);
-      AtomicEnd(m_compute_var);
-      m_compute_var.Wait();
-      AtomicBeg(m_compute_var);
-      cur_counter = AtomicInc(m_io_active);
-      AtomicEnd(m_compute_var);
+      double wait_start = Now();
+      while (m_concurrency_limit >= 0 && cur_counter > m_concurrency_limit)
+      {
+         AtomicBeg(m_compute_var);
+         AtomicInc(m_loadshed_limit_hit);
+         AtomicDec(m_io_active);
+         AtomicEnd(m_compute_var);
+         m_compute_var.Wait();
+         AtomicBeg(m_compute_var);
+         cur_counter = AtomicInc(m_io_active);
+         AtomicEnd(m_compute_var);
+      }
+      queued += Now() - wait_start;
    }
-   return XrdThrottleTimer(*this);
+   return XrdThrottleTimer(*this, queued);
 }
 
 /*
  * Finish recording an IO timer.
  */
 void
-XrdThrottleManager::StopIOTimer(struct timespec timer)
+XrdThrottleManager::StopIOTimer(struct timespec timer, double queued)
 {
    AtomicBeg(m_compute_var);
    AtomicDec(m_io_active);
@@ -518,6 +663,11 @@ XrdThrottleManager::StopIOTimer(struct timespec timer)
    // Note this may result in tv_nsec > 1e9
    AtomicAdd(m_io_wait.tv_nsec, timer.tv_nsec);
    AtomicEnd(m_compute_var);
+   // Wake up a thread waiting for a free IO slot rather than leaving it
+   // until the end of the interval.
+   if (m_concurrency_limit >= 0) m_compute_var.Signal();
+   if (m_latency.Enabled())
+      m_latency.Record(queued + timer.tv_sec + timer.tv_nsec * 1e-9);
 }
 
 /*
@@ -530,7 +680,7 @@ XrdThrottleManager::StopIOTimer(struct timespec timer)
 bool
 XrdThrottleManager::CheckLoadShed(const std::string &opaque)
 {
-   if (m_loadshed_port == 0)
+   if (m_loadshed_port == 0 || m_latency.Enabled())
    {
       return false;
    }
@@ -549,6 +699,26 @@ XrdThrottleManager::CheckLoadShed(const std::string &opaque)
    return true;
 }
 
+/*
+ * When a latency target is configured, shed the fraction of new opens given
+ * by the latency controller instead of shedding IO on hitting a limit; a
+ * client is more cheaply sent elsewhere before it has started reading.
+ */
+bool
+XrdThrottleManager::CheckOpenShed(const std::string &opaque)
+{
+   if (m_loadshed_port == 0 || !m_latency.Enabled() || opaque.empty())
+   {
+      return false;
+   }
+   double fraction = m_latency.Fraction();
+   if (fraction <= 0)
+   {
+      return false;
+   }
+   return static_cast<double>(rand()) / RAND_MAX < fraction;
+}
+
 void
 XrdThrottleManager::PrepLoadShed(const char * opaque, std::string &lsOpaque)
 {
@@ -9,12 +9,16 @@
  *
  * The XrdThrottleManager is user-aware and provides fairshare.
  *
- * This works by having a separate thread periodically refilling
- * each user's shares.
+ * Shares are hierarchical: the server rate is divided between the VOs
+ * with recent activity according to their weights, a VO's share between
+ * its active users, and a user's share between their active files.  Each
+ * file is paced at its resulting part of the server rate; a request sleeps
+ * until the time at which its file's bucket allows it, rather than until
+ * the next recompute interval.  When the server as a whole has unused capacity
+ * a request may borrow it and proceed ahead of its share.
  *
- * Note that we do not actually keep close track of users, but rather
- * put them into a hash.  This way, we can pretend there's a constant
- * number of users and use a lock-free algorithm.
+ * A separate thread periodically expires idle VOs, users and files and
+ * publishes per-VO throttle delay histograms.
  */
 
 #ifndef __XrdThrottleManager_hh_
@@ -28,14 +32,17 @@
 #define unlikely(x)     x
 #endif
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <ctime>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 
 #include "XrdSys/XrdSysPthread.hh"
+#include "XrdThrottle/XrdThrottleLatency.hh"
 
 class XrdSysError;
 class XrdOucTrace;
@@ -49,12 +56,17 @@ friend class XrdThrottleTimer;
 
 public:
 
+struct      FileShare;
+
 void        Init();
 
 bool        OpenFile(const std::string &entity, std::string &open_error_message);
 bool        CloseFile(const std::string &entity);
 
-void        Apply(int reqsize, int reqops, int uid);
+FileShare  *OpenShare(const std::string &vo, const std::string &user);
+void        CloseShare(FileShare *share);
+
+double      Apply(int reqsize, int reqops, FileShare *share);
 
 bool        IsThrottling() {return (m_ops_per_second > 0) || (m_bytes_per_second > 0);}
 
@@ -65,6 +77,12 @@ void        SetThrottles(float reqbyterate, float reqoprate, int concurrency, fl
 void        SetLoadShed(std::string &hostname, unsigned port, unsigned frequency)
             {m_loadshed_host = hostname; m_loadshed_port = port; m_loadshed_frequency = frequency;}
 
+void        SetLoadShedLatency(double target)
+            {m_latency.SetTarget(target, m_loadshed_frequency ? m_loadshed_frequency / 100.0 : 1.0);}
+
+void        SetWeight(bool isvo, const std::string &name, float weight)
+            {if (isvo) m_vo_weights[name] = weight; else m_user_weights[name] = weight;}
+
 void        SetMaxOpen(unsigned long max_open) {m_max_open = max_open;}
 
 void        SetMaxConns(unsigned long max_conns) {m_max_conns = max_conns;}
@@ -73,15 +91,14 @@ void        SetMonitor(XrdXrootdGStream *gstream) {m_gstream = gstream;}
 
 //int         Stats(char *buff, int blen, int do_sync=0) {return m_pool.Stats(buff, blen, do_sync);}
 
-static
-int         GetUid(const char *username);
-
-XrdThrottleTimer StartIOTimer();
+XrdThrottleTimer StartIOTimer(double queued=0);
 
 void        PrepLoadShed(const char *opaque, std::string &lsOpaque);
 
 bool        CheckLoadShed(const std::string &opaque);
 
+bool        CheckOpenShed(const std::string &opaque);
+
 void        PerformLoadShed(const std::string &opaque, std::string &host, unsigned &port);
 
             XrdThrottleManager(XrdSysError *lP, XrdOucTrace *tP);
@@ -90,7 +107,7 @@ void        PerformLoadShed(const std::string &opaque, std::string &host, unsign
 
 protected:
 
-void        StopIOTimer(struct timespec);
+void        StopIOTimer(struct timespec, double queued);
 
 private:
 
@@ -101,11 +118,74 @@ void        RecomputeInternal();
 static
 void *      RecomputeBootstrap(void *pp);
 
-int         WaitForShares();
+// Generic cell rate algorithm pacing: m_tat is the theoretical arrival
+// time, in seconds, at which the bucket would again be full.
+struct Bucket
+{
+   double   m_tat{0};
+};
 
-void        GetShares(int &shares, int &request);
+static const
+int         m_hist_bins = 24;
 
-void        StealShares(int uid, int &reqsize, int &reqops);
+// A class's activity is changed under the lock guarding its parent's
+// children (see below) but read without it.
+struct ShareNode
+{
+   float    m_weight{1.0};
+   std::atomic<bool>   m_active{false};
+   std::atomic<double> m_last_active{0};
+   std::atomic<double> m_active_weight{0};  // sum of the weights of active children
+};
+
+struct VONode;
+
+struct UserNode : public ShareNode
+{
+   VONode  *m_vo{nullptr};
+   std::unordered_set<FileShare *> m_files;
+   std::mutex m_mutex;  // protects the pacing and activity of the files
+};
+
+public:
+
+// An open file's place in the share hierarchy; opaque outside the manager.
+struct FileShare : public ShareNode
+{
+   UserNode *m_user{nullptr};
+   Bucket    m_bytes;
+   Bucket    m_ops;
+};
+
+private:
+
+struct VONode : public ShareNode
+{
+   std::unordered_map<std::string, std::unique_ptr<UserNode>> m_users;
+   // Throttle delays seen by this VO's requests since the last report;
+   // bin 0 counts undelayed requests, bin k delays of [2^(k-1),2^k) us.
+   std::atomic<unsigned long long> m_wait_hist[m_hist_bins]{};
+   std::atomic<unsigned long long> m_req_bytes{0};
+   std::atomic<unsigned long long> m_req_ops{0};
+};
+
+static
+double      Now();
+
+void        Activate(ShareNode &node, ShareNode &parent, double now);
+
+void        Deactivate(ShareNode &node, ShareNode &parent);
+
+double      Charge(std::atomic<double> &tat, double cost, double rate, double now);
+
+static
+double      Part(const ShareNode &node, const ShareNode &parent);
+
+double      Pace(Bucket &bucket, double cost, double rate, double now, bool borrow);
+
+void        ExpireShares(double now);
+
+void        ReportShares();
 
 XrdOucTrace * m_trace;
 XrdSysError * m_log;
@@ -118,14 +198,17 @@ float       m_bytes_per_second;
 float       m_ops_per_second;
 int         m_concurrency_limit;
 
-// Maintain the shares
-static const
-int         m_max_users;
-std::vector<int> m_primary_bytes_shares;
-std::vector<int> m_secondary_bytes_shares;
-std::vector<int> m_primary_ops_shares;
-std::vector<int> m_secondary_ops_shares;
-int         m_last_round_allocation;
+// The share hierarchy.  m_share_mutex protects the maps and the activity
+// of VOs and users; each user's mutex that of its files.  Requests take
+// only the latter, and the former when their VO or user becomes active.
+std::mutex  m_share_mutex;
+ShareNode   m_root;
+// Theoretical arrival times for the server as a whole, charged lock-free.
+std::atomic<double> m_root_bytes{0};
+std::atomic<double> m_root_ops{0};
+std::unordered_map<std::string, std::unique_ptr<VONode>> m_vos;
+std::unordered_map<std::string, float> m_vo_weights;
+std::unordered_map<std::string, float> m_user_weights;
 
 // Active IO counter
 int         m_io_active;
@@ -141,6 +224,7 @@ std::string m_loadshed_host;
 unsigned m_loadshed_port;
 unsigned m_loadshed_frequency;
 int m_loadshed_limit_hit;
+XrdThrottleLatency m_latency;  // Queue plus service time of each IO
 
 // Maximum number of open files
 unsigned long m_max_open{0};
@@ -184,7 +268,7 @@ void StopTimer()
    }
    if (m_timer.tv_nsec != -1)
    {
-      m_manager.StopIOTimer(end_timer);
+      m_manager.StopIOTimer(end_timer, m_queued);
    }
    m_timer.tv_sec = 0;
    m_timer.tv_nsec = -1;
@@ -200,8 +284,9 @@ void StopTimer()
 
 protected:
 
-XrdThrottleTimer(XrdThrottleManager & manager) :
-   m_manager(manager)
+XrdThrottleTimer(XrdThrottleManager & manager, double queued) :
+   m_manager(manager),
+   m_queued(queued)
 {
 #if defined(__linux__) || defined(__APPLE__) || defined(__GNU__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))
    int retval = clock_gettime(clock_id, &m_timer);
@@ -218,6 +303,7 @@ XrdThrottleTimer(XrdThrottleManager & manager) :
 private:
 XrdThrottleManager &m_manager;
 struct timespec m_timer;
+double m_queued; // Seconds the IO waited in the throttle before starting
 
 static clockid_t clock_id;
 };
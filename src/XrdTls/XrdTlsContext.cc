@@ -20,13 +20,25 @@
 #include <openssl/bio.h>
 #include <openssl/crypto.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/opensslv.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#else
+#include <openssl/hmac.h>
+#endif
 #include <sys/stat.h>
+#include <chrono>
+#include <cstring>
+#include <list>
+#include <unordered_map>
 
 #include "XrdOuc/XrdOucUtils.hh"
 #include "XrdSys/XrdSysRAtomic.hh"
 #include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysMetrics.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdSys/XrdSysTimer.hh"
 
@@ -235,8 +247,11 @@ do{tStart = time(0);
 //
    if (TRACING(XrdTls::dbgCTX))
       {char mBuff[512];
-       snprintf(mBuff, sizeof(mBuff), "sess=%d hits=%d miss=%d timeouts=%d",
-               sesn, hits, miss, tmos);
+       XrdTlsContext::HSCounts hs;
+       XrdTlsContext::HandShakes(hs);
+       snprintf(mBuff, sizeof(mBuff), "sess=%d hits=%d miss=%d timeouts=%d "
+               "handshakes full=%lld resumed=%lld", sesn, hits, miss, tmos,
+               hs.srvFull, hs.srvResumed);
        DBG_CTX("Cache flushed; " <<mBuff);
       }
   } while(true);
@@ -287,9 +302,255 @@ bool Setup_Flusher(XrdTlsContextImpl *pImpl, int flushT)
 // Finish up
 //
    pImpl->flsRunning = true;
-   SSL_CTX_set_session_cache_mode(pImpl->ctx, SSL_SESS_CACHE_NO_AUTO_CLEAR);
+   SSL_CTX_set_session_cache_mode(pImpl->ctx, SSL_SESS_CACHE_NO_AUTO_CLEAR
+                                 | SSL_CTX_get_session_cache_mode(pImpl->ctx));
+   return true;
+}
+}
+  
+/******************************************************************************/
+/*              S e s s i o n   R e s u m p t i o n   S u p p o r t           */
+/******************************************************************************/
+
+namespace XrdTlsResume
+{
+// Handshake counters indexed by [server][resumed] and the SSL ex_data slots
+// used to count each handshake once and to hold a client's peer name.
+//
+XrdSysMetrics::Counter *hsCount[2][2] = {{0, 0}, {0, 0}};
+int                     hsIdx   = -1;
+int                     peerIdx = -1;
+
+// Session ticket keys shared by all server contexts. New tickets use the
+// current key; tickets made with the previous key are still accepted.
+//
+struct TicketKey
+      {unsigned char name[16];
+       unsigned char hmac[32];
+       unsigned char aes[32];
+       std::chrono::steady_clock::time_point born;
+      };
+
+XrdSysMutex  tkMutex;
+TicketKey    tkCur, tkOld;
+bool         tkHaveCur = false;
+bool         tkHaveOld = false;
+int          tkLife    = 3600;
+
+// Client sessions by peer, shared by all client contexts and bounded in size.
+//
+typedef std::list<std::pair<std::string, SSL_SESSION *>> sessList;
+
+XrdSysMutex                                              ssMutex;
+sessList                                                 ssLRU;
+std::unordered_map<std::string, sessList::iterator>      ssMap;
+const size_t                                             ssMax = 1024;
+
+/******************************************************************************/
+/*                                I n f o C B                                 */
+/******************************************************************************/
+
+// TLS 1.3 may report the end of a handshake again after post-handshake
+// messages (e.g. tickets), so each SSL is marked once it has been counted.
+//
+void InfoCB(const SSL *ssl, int where, int ret)
+{
+   if (!(where & SSL_CB_HANDSHAKE_DONE)) return;
+
+   SSL *sslP = const_cast<SSL *>(ssl);
+   if (SSL_get_ex_data(sslP, hsIdx)) return;
+   SSL_set_ex_data(sslP, hsIdx, (void *)1);
+   int srv = (SSL_is_server(sslP) ? 1 : 0);
+   hsCount[srv][SSL_session_reused(sslP) ? 1 : 0]->Add();
+}
+
+/******************************************************************************/
+/*                               P e e r F r e e                              */
+/******************************************************************************/
+
+void PeerFree(void *parent, void *ptr, CRYPTO_EX_DATA *ad, int idx,
+              long argl, void *argp)
+{
+   if (ptr) free(ptr);
+}
+
+/******************************************************************************/
+/*                                N e w K e y                                 */
+/******************************************************************************/
+
+bool NewKey(TicketKey &key, std::chrono::steady_clock::time_point now)
+{
+   if (RAND_bytes(key.name, sizeof(key.name)) != 1
+   ||  RAND_bytes(key.hmac, sizeof(key.hmac)) != 1
+   ||  RAND_bytes(key.aes,  sizeof(key.aes))  != 1) return false;
+   key.born = now;
    return true;
 }
+
+/******************************************************************************/
+/*                                G e t K e y                                 */
+/******************************************************************************/
+
+// Obtain the key for a new ticket (name is nil) or the key that made a ticket.
+// Keys are rotated here, as tickets are made, so no thread is needed.
+//
+bool GetKey(TicketKey &key, const unsigned char *name)
+{
+   XrdSysMutexHelper tkHelper(tkMutex);
+   auto now  = std::chrono::steady_clock::now();
+   auto life = std::chrono::seconds(tkLife);
+
+   if (tkHaveCur && now - tkCur.born >= life)
+      {if (now - tkCur.born < 2*life) {tkOld = tkCur; tkHaveOld = true;}
+          else tkHaveOld = false;
+       tkHaveCur = false;
+      }
+   if (tkHaveOld && now - tkOld.born >= 2*life) tkHaveOld = false;
+
+   if (!tkHaveCur)
+      {if (!NewKey(tkCur, now)) return false;
+       tkHaveCur = true;
+      }
+
+   if (!name || !memcmp(name, tkCur.name, sizeof(tkCur.name)))
+      {key = tkCur; return true;}
+   if (tkHaveOld && !memcmp(name, tkOld.name, sizeof(tkOld.name)))
+      {key = tkOld; return true;}
+   return false;
+}
+
+/******************************************************************************/
+/*                              T i c k e t C B                               */
+/******************************************************************************/
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int TicketCB(SSL *ssl, unsigned char *name, unsigned char *iv,
+             EVP_CIPHER_CTX *cctx, EVP_MAC_CTX *hctx, int enc)
+#else
+int TicketCB(SSL *ssl, unsigned char *name, unsigned char *iv,
+             EVP_CIPHER_CTX *cctx, HMAC_CTX *hctx, int enc)
+#endif
+{
+   TicketKey key;
+   int rc;
+
+// Find the key to use, making a new iv when encrypting a new ticket. A ticket
+// that decrypts is always renewed: TLS 1.3 clients use a ticket only once and
+// would otherwise make a full handshake on every other connection.
+//
+   if (enc)
+      {if (!GetKey(key, 0)) return -1;
+       if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1)
+          return -1;
+       memcpy(name, key.name, sizeof(key.name));
+       rc = 1;
+      } else {if (!GetKey(key, name)) return 0;
+              rc = 2;
+             }
+
+// Set up the cipher and the mac
+//
+   if ((enc ? EVP_EncryptInit_ex(cctx, EVP_aes_256_cbc(), 0, key.aes, iv)
+            : EVP_DecryptInit_ex(cctx, EVP_aes_256_cbc(), 0, key.aes, iv)) != 1)
+      rc = -1;
+      else {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+            OSSL_PARAM parms[] =
+               {OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY,
+                                                  key.hmac, sizeof(key.hmac)),
+                OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                                 (char *)"SHA256", 0),
+                OSSL_PARAM_construct_end()};
+            if (EVP_MAC_CTX_set_params(hctx, parms) != 1) rc = -1;
+#else
+            if (HMAC_Init_ex(hctx, key.hmac, sizeof(key.hmac),
+                             EVP_sha256(), 0) != 1) rc = -1;
+#endif
+           }
+
+   OPENSSL_cleanse(&key, sizeof(key));
+   return rc;
+}
+
+/******************************************************************************/
+/*                             N e w S e s s C B                              */
+/******************************************************************************/
+
+// Remember a client session under the peer it was made with. Returning 1 tells
+// OpenSSL that we have kept its reference to the session.
+//
+int NewSessCB(SSL *ssl, SSL_SESSION *sess)
+{
+   const char *peer = static_cast<const char *>(SSL_get_ex_data(ssl, peerIdx));
+
+   if (!peer) return 0;
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+   if (!SSL_SESSION_is_resumable(sess)) return 0;
+#endif
+
+   XrdSysMutexHelper ssHelper(ssMutex);
+   auto it = ssMap.find(peer);
+   if (it != ssMap.end())
+      {SSL_SESSION_free(it->second->second);
+       it->second->second = sess;
+       ssLRU.splice(ssLRU.begin(), ssLRU, it->second);
+       return 1;
+      }
+
+   if (ssLRU.size() >= ssMax)
+      {SSL_SESSION_free(ssLRU.back().second);
+       ssMap.erase(ssLRU.back().first);
+       ssLRU.pop_back();
+      }
+   ssLRU.emplace_front(peer, sess);
+   ssMap[peer] = ssLRU.begin();
+   return 1;
+}
+
+/******************************************************************************/
+/*                                E n a b l e                                 */
+/******************************************************************************/
+
+// Share ticket keys among server contexts and remember sessions by peer for
+// client contexts, as the session cache options call for.
+//
+void Enable(SSL_CTX *ctx, int opts)
+{
+   if (opts & XrdTlsContext::scSrvr)
+      {SSL_CTX_clear_options(ctx, SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+       SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, TicketCB);
+#else
+       SSL_CTX_set_tlsext_ticket_key_cb(ctx, TicketCB);
+#endif
+      }
+
+   if (opts & XrdTlsContext::scClnt) SSL_CTX_sess_set_new_cb(ctx, NewSessCB);
+}
+
+/******************************************************************************/
+/*                                 S e t u p                                  */
+/******************************************************************************/
+
+// Called once when the library is initialized.
+//
+void Setup()
+{
+   static const char *hsLabels[2][2] =
+         {{"role=\"client\",type=\"full\"",
+           "role=\"client\",type=\"resumed\""},
+          {"role=\"server\",type=\"full\"",
+           "role=\"server\",type=\"resumed\""}};
+
+   for (int i = 0; i < 2; i++)
+       for (int j = 0; j < 2; j++)
+           hsCount[i][j] = new XrdSysMetrics::Counter(
+                               "xrd_tls_handshakes_total",
+                               "Completed TLS handshakes.", hsLabels[i][j]);
+
+   hsIdx   = SSL_get_ex_new_index(0, 0, 0, 0, 0);
+   peerIdx = SSL_get_ex_new_index(0, 0, 0, 0, PeerFree);
+}
 }
   
 /******************************************************************************/
@@ -425,6 +686,10 @@ void InitTLS() // This is strictly a one-time call!
 #endif
    ERR_load_crypto_strings();
 
+// Set up session resumption support
+//
+   XrdTlsResume::Setup();
+
 // Set callbacks if we need to do this
 //
 #ifdef XRDTLS_SET_CALLBACKS
@@ -698,6 +963,10 @@ XrdTlsContext::XrdTlsContext(const char *cert,  const char *key,
 //
    SSL_CTX_set_session_cache_mode(pImpl->ctx, SSL_SESS_CACHE_OFF);
 
+// Count handshakes, full and resumed, as they complete
+//
+   SSL_CTX_set_info_callback(pImpl->ctx, XrdTlsResume::InfoCB);
+
 // Establish the CA cert locations, if specified. Then set the verification
 // depth and turn on peer cert validation. For now, we don't set a callback.
 // In the future we may to grab debugging information.
@@ -851,6 +1120,21 @@ const XrdTlsContext::CTX_Params *XrdTlsContext::GetParams()
   return &pImpl->Parm;
 }
 
+/******************************************************************************/
+/*                            H a n d S h a k e s                             */
+/******************************************************************************/
+
+void XrdTlsContext::HandShakes(XrdTlsContext::HSCounts &counts)
+{
+   using XrdTlsResume::hsCount;
+
+   if (!hsCount[0][0]) {counts = HSCounts(); return;}
+   counts.srvFull    = hsCount[1][0]->Value();
+   counts.srvResumed = hsCount[1][1]->Value();
+   counts.clnFull    = hsCount[0][0]->Value();
+   counts.clnResumed = hsCount[0][1]->Value();
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -879,6 +1163,63 @@ bool XrdTlsContext::isOK()
    return pImpl->ctx != 0;
 }
   
+/******************************************************************************/
+/*                                R e s u m e                                 */
+/******************************************************************************/
+
+bool XrdTlsContext::Resume(void *ssl, const char *peer)
+{
+   using namespace XrdTlsResume;
+   SSL *sslP = static_cast<SSL *>(ssl);
+   SSL_SESSION *sess = 0;
+
+// This only applies to client sessions that have not started their handshake
+//
+   if (!peer || !sslP || peerIdx < 0 || SSL_is_server(sslP)
+   ||  !SSL_in_before(sslP)
+   ||  !(SSL_CTX_get_session_cache_mode(SSL_get_SSL_CTX(sslP))
+         & SSL_SESS_CACHE_CLIENT)) return false;
+
+// Record the peer so that the new session, if any, is remembered under it
+//
+   char *oldPeer = static_cast<char *>(SSL_get_ex_data(sslP, peerIdx));
+   if (!oldPeer || strcmp(oldPeer, peer))
+      {if (oldPeer) free(oldPeer);
+       SSL_set_ex_data(sslP, peerIdx, strdup(peer));
+      }
+
+// Find the last session established with this peer. A TLS 1.3 session is
+// meant to be used only once (RFC 8446 C.4) and OpenSSL will not offer it
+// again, so it is taken out of the store; the server renews the ticket and
+// the new session replaces it. Earlier versions may be offered repeatedly.
+//
+   {XrdSysMutexHelper ssHelper(ssMutex);
+    auto it = ssMap.find(peer);
+    if (it != ssMap.end())
+       {sess = it->second->second;
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+        bool once = SSL_SESSION_get_protocol_version(sess) >= TLS1_3_VERSION;
+        bool isOK = SSL_SESSION_is_resumable(sess);
+        if (once || !isOK)
+           {ssLRU.erase(it->second);
+            ssMap.erase(it);
+            if (!isOK) {SSL_SESSION_free(sess); return false;}
+           } else
+#endif
+           {SSL_SESSION_up_ref(sess);
+            ssLRU.splice(ssLRU.begin(), ssLRU, it->second);
+           }
+       }
+   }
+
+// Offer it in the handshake
+//
+   if (!sess) return false;
+   bool aOK = SSL_set_session(sslP, sess) == 1;
+   SSL_SESSION_free(sess);
+   return aOK;
+}
+  
 /******************************************************************************/
 /*                               S e s s i o n                                */
 /******************************************************************************/
@@ -982,7 +1323,7 @@ int XrdTlsContext::SessionCache(int opts, const char *id, int idlen)
    int flushT = opts & scFMax;
 
    pImpl->sessionCacheOpts = opts;
-   pImpl->sessionCacheId = id;
+   if (id && idlen > 0) pImpl->sessionCacheId.assign(id, idlen);
 
 // If initialization failed there is nothing to do
 //
@@ -1000,8 +1341,10 @@ int XrdTlsContext::SessionCache(int opts, const char *id, int idlen)
 // Check if we should set any cache options or simply get them
 //
    if (!(opts & doSet)) sslopt = SSL_CTX_get_session_cache_mode(pImpl->ctx);
-      else {sslopt = SSL_CTX_set_session_cache_mode(pImpl->ctx, sslopt);
+      else {if (opts & scClnt) sslopt |= SSL_SESS_CACHE_NO_INTERNAL_STORE;
+            sslopt = SSL_CTX_set_session_cache_mode(pImpl->ctx, sslopt);
             if (opts & scOff) SSL_CTX_set_options(pImpl->ctx, SSL_OP_NO_TICKET);
+               else XrdTlsResume::Enable(pImpl->ctx, opts);
            }
 
 // Compute what he previous cache options were
@@ -1111,6 +1454,16 @@ bool XrdTlsContext::SetCrlRefresh(int refsec)
 #endif
 }
   
+/******************************************************************************/
+/*                      S e t T i c k e t K e y L i f e                       */
+/******************************************************************************/
+
+void XrdTlsContext::SetTicketKeyLife(int secs)
+{
+   XrdSysMutexHelper tkHelper(XrdTlsResume::tkMutex);
+   XrdTlsResume::tkLife = (secs > 0 ? secs : 1);
+}
+
 /******************************************************************************/
 /*                            x 5 0 9 V e r i f y                             */
 /******************************************************************************/
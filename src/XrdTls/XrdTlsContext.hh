@@ -127,6 +127,13 @@ void           *Session();
 //!         If the context has been pprroperly initialized, zero is returned.
 //!         By default, the session cache is disabled as it is impossible to
 //!         verify a peer certificate chain when a cached session is reused.
+//!
+//! @note   a) In server mode, session tickets are encrypted with keys that are
+//!            shared by all server contexts in the process and rotated (see
+//!            SetTicketKeyLife()), so tickets remain valid when a context is
+//!            replaced (e.g. on CRL refresh).
+//!         b) In client mode, sessions are remembered by peer for all client
+//!            contexts in the process and offered again by Resume().
 //------------------------------------------------------------------------
 
 static const int scNone = 0x00000000; //!< Do not change any option settings
@@ -140,6 +147,38 @@ static const int scFMax = 0x00007fff; //!< Maximum flush interval in seconds
 
       int       SessionCache(int opts=scNone, const char *id=0, int idlen=0);
 
+//------------------------------------------------------------------------
+//! Obtain the number of completed handshakes over all contexts.
+//------------------------------------------------------------------------
+
+struct HSCounts
+      {long long srvFull;     //!< Server-side full handshakes
+       long long srvResumed;  //!< Server-side resumed sessions
+       long long clnFull;     //!< Client-side full handshakes
+       long long clnResumed;  //!< Client-side resumed sessions
+      };
+
+static
+void            HandShakes(HSCounts &counts);
+
+//------------------------------------------------------------------------
+//! Offer a session previously established with a peer when connecting.
+//!
+//! @param  ssl      The SSL session, as returned by Session(), that has not
+//!                  yet started its handshake.
+//! @param  peer     Identifies the peer (e.g. "host:port"). Any new session
+//!                  established by the handshake is remembered under it.
+//!
+//! @return True if a session was found and will be offered; false otherwise.
+//!
+//! @note The context must have its session cache in client mode; see
+//!       SessionCache(). Whether the session is actually resumed is up to
+//!       the peer, the handshake falls back to a full one otherwise.
+//------------------------------------------------------------------------
+
+static
+bool            Resume(void *ssl, const char *peer);
+
 //------------------------------------------------------------------------
 //! Set allowed ciphers for this context.
 //!
@@ -173,6 +212,16 @@ void            SetDefaultCiphers(const char *ciphers);
 
       bool      SetCrlRefresh(int refsec=-1);
 
+//------------------------------------------------------------------------
+//! Set how long a session ticket key is used to encrypt new tickets. Tickets
+//! are accepted for up to twice as long, after which the key is discarded.
+//!
+//! @param  secs     The key lifetime in seconds. The default is one hour.
+//------------------------------------------------------------------------
+
+static
+void            SetTicketKeyLife(int secs);
+
 //------------------------------------------------------------------------
 //! Check if certificates are being verified.
 //!
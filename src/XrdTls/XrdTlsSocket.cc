@@ -698,6 +698,16 @@ XrdTls::RC XrdTlsSocket::Read( char *buffer, size_t size, int &bytesRead )
     return XrdTls::TLS_SYS_Error;
   }
 
+/******************************************************************************/
+/*                                R e s u m e                                 */
+/******************************************************************************/
+
+bool XrdTlsSocket::Resume(const char *peer)
+{
+   if (!pImpl->ssl || !pImpl->isClient) return false;
+   return XrdTlsContext::Resume(pImpl->ssl, peer);
+}
+
 /******************************************************************************/
 /*                            S e t T r a c e I D                             */
 /******************************************************************************/
@@ -205,6 +205,18 @@ XrdTlsPeerCerts *getCerts(bool ver=true);
 
   XrdTls::RC Read( char *buffer, size_t size, int &bytesRead );
 
+//------------------------------------------------------------------------
+//! Offer the session last established with a peer when connecting. This
+//! must be called before Connect() and only has an effect when the context's
+//! session cache is in client mode (see XrdTlsContext::SessionCache()).
+//!
+//! @param  peer       - Identifies the peer (e.g. "host:port").
+//!
+//! @return True if a previous session will be offered; false otherwise.
+//------------------------------------------------------------------------
+
+  bool       Resume(const char *peer);
+
 //------------------------------------------------------------------------
 //! Set the trace identifier (used when it's updated).
 //!
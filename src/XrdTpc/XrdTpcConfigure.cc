@@ -1,5 +1,6 @@
 
 #include "XrdTpcTPC.hh"
+#include "XrdTpcStream.hh"
 
 #include <dlfcn.h>
 #include <fcntl.h>
@@ -15,6 +16,50 @@
 using namespace TPC;
 
 
+/*
+ * tpc.engine [threads <n>] [buffers <size>]
+ *
+ * threads: number of threads running the curl transfers of all TPC
+ *          requests; 0, the default, runs each transfer on its own request
+ *          thread. The engine threads also write to storage, so a slow
+ *          write delays every transfer sharing that thread.
+ * buffers: memory kept around for reuse by the multi-stream reordering
+ *          buffers when they are not in use.
+ */
+bool TPCHandler::ConfigureEngine(XrdOucStream &Config)
+{
+    const char *val = Config.GetWord();
+    if (!val) {
+        m_log.Emsg("Config", "tpc.engine requires at least one option");
+        return false;
+    }
+    while (val) {
+        if (!strcmp("threads", val)) {
+            int threads;
+            if (!(val = Config.GetWord())) {
+                m_log.Emsg("Config", "tpc.engine threads value not specified");
+                return false;
+            }
+            if (XrdOuca2x::a2i(m_log, "engine thread count", val, &threads, 0, 1024)) return false;
+            m_engine_threads = threads;
+        } else if (!strcmp("buffers", val)) {
+            long long bytes;
+            if (!(val = Config.GetWord())) {
+                m_log.Emsg("Config", "tpc.engine buffers value not specified");
+                return false;
+            }
+            if (XrdOuca2x::a2sz(m_log, "idle buffer size", val, &bytes, 0)) return false;
+            BufferPool::SetMaxIdle(bytes);
+        } else {
+            m_log.Emsg("Config", "tpc.engine option is invalid", val);
+            return false;
+        }
+        val = Config.GetWord();
+    }
+    return true;
+}
+
+
 bool TPCHandler::Configure(const char *configfn, XrdOucEnv *myEnv)
 {
     XrdOucEnv cfgEnv;
@@ -96,6 +141,11 @@ bool TPCHandler::Configure(const char *configfn, XrdOucEnv *myEnv)
             } else {
                 m_first_timeout = 2*m_timeout;
             }
+        } else if (!strcmp("tpc.engine", val)) {
+            if (!ConfigureEngine(Config)) {
+                Config.Close();
+                return false;
+            }
         }
     }
     Config.Close();
@@ -0,0 +1,394 @@
+
+#include "XrdTpcEngine.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysFD.hh"
+
+using namespace TPC;
+
+namespace {
+
+// How often the progress of running jobs is refreshed.
+const std::chrono::milliseconds g_progress_period(1000);
+
+}
+
+/**
+ * A single engine thread.  Everything except the submission queues is only
+ * touched by the thread itself.
+ */
+struct CurlEngine::Worker {
+    struct Socket {
+        CurlJob *job;
+        short events;
+    };
+
+    Worker(CurlEngine &engine) : m_engine(engine) {}
+
+    void Run();
+    void Wake();
+    void Start(CurlJob *job);
+    void Finish(CurlJob *job);
+    void Refresh(CurlJob *job);
+    void Action(CurlJob *job, curl_socket_t fd, int ev_bitmask);
+
+    CurlEngine &m_engine;
+    std::thread m_thread;
+    int m_wake[2]{-1, -1};
+    std::atomic<int> m_load{0};
+
+    // Submission queues, protected by m_mutex.
+    std::mutex m_mutex;
+    std::vector<CurlJob *> m_incoming;
+    std::vector<CurlJob *> m_cancels;
+    bool m_stop{false};
+
+    std::vector<CurlJob *> m_jobs;
+    std::unordered_map<curl_socket_t, Socket> m_sockets;
+    bool m_sockets_changed{true};
+};
+
+
+bool CurlJob::Wait(time_t deadline)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!deadline) {
+        m_cv.wait(lock, [&]{return m_done;});
+        return true;
+    }
+    return m_cv.wait_until(lock, std::chrono::system_clock::from_time_t(deadline),
+        [&]{return m_done;});
+}
+
+
+void CurlJob::Cancel()
+{
+    if (m_engine) {m_engine->Cancel(*this);}
+}
+
+
+off_t CurlJob::BytesTransferred() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+}
+
+
+std::string CurlJob::Connections() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_connections;
+}
+
+
+CurlEngine::CurlEngine(XrdSysError &log, unsigned threads)
+    : m_log(log)
+{
+    for (unsigned idx = 0; idx < threads; idx++) {
+        std::unique_ptr<Worker> worker(new Worker(*this));
+        if (XrdSysFD_Pipe(worker->m_wake) < 0) {
+            m_log.Emsg("CurlEngine", errno, "create engine wakeup pipe");
+            break;
+        }
+        fcntl(worker->m_wake[0], F_SETFL, O_NONBLOCK);
+        fcntl(worker->m_wake[1], F_SETFL, O_NONBLOCK);
+        worker->m_thread = std::thread(&Worker::Run, worker.get());
+        m_workers.emplace_back(std::move(worker));
+    }
+    if (m_workers.empty()) {
+        throw std::runtime_error("Unable to start any TPC engine threads");
+    }
+}
+
+
+CurlEngine::~CurlEngine()
+{
+    for (auto &worker : m_workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->m_mutex);
+            worker->m_stop = true;
+        }
+        worker->Wake();
+        worker->m_thread.join();
+        close(worker->m_wake[0]);
+        close(worker->m_wake[1]);
+    }
+}
+
+
+void CurlEngine::Submit(CurlJob &job)
+{
+    size_t best = 0;
+    for (size_t idx = 1; idx < m_workers.size(); idx++) {
+        if (m_workers[idx]->m_load < m_workers[best]->m_load) {best = idx;}
+    }
+    Worker &worker = *m_workers[best];
+    worker.m_load++;
+    job.m_engine = this;
+    job.m_worker = best;
+    {
+        std::lock_guard<std::mutex> lock(worker.m_mutex);
+        worker.m_incoming.push_back(&job);
+    }
+    worker.Wake();
+}
+
+
+// A cancellation may race with the job completing on its own; the worker
+// only honours it for jobs it is still running, identified by address.  As
+// cancels and new jobs are drained together, cancels first, a stale cancel
+// can never hit a later job allocated at the same address.
+void CurlEngine::Cancel(CurlJob &job)
+{
+    Worker &worker = *m_workers[job.m_worker];
+    {
+        std::lock_guard<std::mutex> lock(worker.m_mutex);
+        worker.m_cancels.push_back(&job);
+    }
+    worker.Wake();
+}
+
+
+int CurlEngine::SocketCB(CURL *, curl_socket_t fd, int what, void *userp, void *)
+{
+    auto job = static_cast<CurlJob *>(userp);
+    Worker &worker = *job->m_engine->m_workers[job->m_worker];
+    if (what == CURL_POLL_REMOVE) {
+        worker.m_sockets.erase(fd);
+    } else {
+        short events = 0;
+        if (what & CURL_POLL_IN) {events |= POLLIN;}
+        if (what & CURL_POLL_OUT) {events |= POLLOUT;}
+        worker.m_sockets[fd] = Worker::Socket{job, events};
+    }
+    worker.m_sockets_changed = true;
+    return 0;
+}
+
+
+int CurlEngine::TimerCB(CURLM *, long timeout_ms, void *userp)
+{
+    auto job = static_cast<CurlJob *>(userp);
+    if (timeout_ms < 0) {
+        job->m_has_timer = false;
+    } else {
+        job->m_has_timer = true;
+        job->m_timer = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    }
+    return 0;
+}
+
+
+void CurlEngine::Worker::Wake()
+{
+    char byte = 0;
+    while (write(m_wake[1], &byte, 1) < 0 && errno == EINTR) {}
+}
+
+
+void CurlEngine::Worker::Start(CurlJob *job)
+{
+    CURLM *multi = job->Multi();
+    curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, CurlEngine::SocketCB);
+    curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, job);
+    curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, CurlEngine::TimerCB);
+    curl_multi_setopt(multi, CURLMOPT_TIMERDATA, job);
+    m_jobs.push_back(job);
+    bool running = false;
+    try {
+        running = job->Begin();
+    } catch (std::exception &exc) {
+        job->m_error = exc.what();
+    }
+    if (!running) {
+        Finish(job);
+        return;
+    }
+    // Handles may have been added before the timer callback was installed;
+    // kick off the transfers rather than wait for a timeout we never saw.
+    Action(job, CURL_SOCKET_TIMEOUT, 0);
+}
+
+
+void CurlEngine::Worker::Refresh(CurlJob *job)
+{
+    off_t bytes = 0;
+    std::string connections;
+    try {
+        job->Progress(bytes, connections);
+    } catch (std::exception &) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(job->m_mutex);
+    job->m_bytes = bytes;
+    job->m_connections = connections;
+}
+
+
+void CurlEngine::Worker::Finish(CurlJob *job)
+{
+    auto iter = std::find(m_jobs.begin(), m_jobs.end(), job);
+    if (iter == m_jobs.end()) {return;}
+    m_jobs.erase(iter);
+
+    Refresh(job);
+    try {
+        job->End();
+    } catch (std::exception &exc) {
+        if (job->m_error.empty()) {job->m_error = exc.what();}
+    }
+    // The creator cleans up the multi-handle once the job is done; make
+    // sure whatever libcurl does with it then does not call back into us.
+    CURLM *multi = job->Multi();
+    curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, nullptr);
+    curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, nullptr);
+    curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, nullptr);
+    curl_multi_setopt(multi, CURLMOPT_TIMERDATA, nullptr);
+    for (auto sock = m_sockets.begin(); sock != m_sockets.end();) {
+        if (sock->second.job == job) {sock = m_sockets.erase(sock);}
+        else {++sock;}
+    }
+    m_sockets_changed = true;
+    m_load--;
+
+    // Last time the job is touched; the creator may destroy it as soon as
+    // the lock is released.
+    std::lock_guard<std::mutex> lock(job->m_mutex);
+    job->m_done = true;
+    job->m_cv.notify_all();
+}
+
+
+// Let libcurl act on a socket (or the timeout) of the job, then harvest
+// any transfers which completed as a result.
+void CurlEngine::Worker::Action(CurlJob *job, curl_socket_t fd, int ev_bitmask)
+{
+    int running_handles;
+    CURLMcode mres = curl_multi_socket_action(job->Multi(), fd, ev_bitmask, &running_handles);
+    if (mres != CURLM_OK) {
+        job->m_mres = mres;
+        Finish(job);
+        return;
+    }
+    bool finished = false;
+    try {
+        job->Activity();
+        CURLMsg *msg;
+        int msgq = 0;
+        while (!finished && (msg = curl_multi_info_read(job->Multi(), &msgq))) {
+            if (msg->msg == CURLMSG_DONE) {
+                finished = job->Done(msg->easy_handle, msg->data.result);
+            }
+        }
+    } catch (std::exception &exc) {
+        job->m_error = exc.what();
+        finished = true;
+    }
+    if (finished) {Finish(job);}
+}
+
+
+void CurlEngine::Worker::Run()
+{
+    std::vector<struct pollfd> fds;
+    std::vector<CurlJob *> ready;
+    auto last_refresh = std::chrono::steady_clock::now();
+
+    while (true) {
+        std::vector<CurlJob *> incoming, cancels;
+        bool stop;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            incoming.swap(m_incoming);
+            cancels.swap(m_cancels);
+            stop = m_stop;
+        }
+        for (auto job : cancels) {Finish(job);}
+        for (auto job : incoming) {Start(job);}
+        if (stop) {
+            while (!m_jobs.empty()) {Finish(m_jobs.back());}
+            return;
+        }
+
+        if (m_sockets_changed) {
+            fds.resize(1 + m_sockets.size());
+            fds[0].fd = m_wake[0];
+            fds[0].events = POLLIN;
+            size_t idx = 1;
+            for (const auto &sock : m_sockets) {
+                fds[idx].fd = sock.first;
+                fds[idx].events = sock.second.events;
+                idx++;
+            }
+            m_sockets_changed = false;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        auto wake_at = last_refresh + g_progress_period;
+        for (auto job : m_jobs) {
+            if (job->m_has_timer && job->m_timer < wake_at) {wake_at = job->m_timer;}
+        }
+        int timeout_ms = 0;
+        if (wake_at > now) {
+            timeout_ms = std::chrono::duration_cast<std::chrono::milliseconds>(wake_at - now).count() + 1;
+        }
+        for (auto &pfd : fds) {pfd.revents = 0;}
+        int rval = poll(fds.data(), fds.size(), timeout_ms);
+        if (rval < 0 && errno != EINTR) {
+            m_engine.m_log.Emsg("CurlEngine", errno, "poll TPC transfer sockets");
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        if (rval > 0) {
+            if (fds[0].revents) {
+                char buf[64];
+                while (read(m_wake[0], buf, sizeof(buf)) == sizeof(buf)) {}
+            }
+            // Handling one socket may add or remove others; work from a copy
+            // of the ready set and skip sockets libcurl has since dropped.
+            std::vector<std::pair<curl_socket_t, int>> events;
+            for (size_t idx = 1; idx < fds.size(); idx++) {
+                if (!fds[idx].revents) {continue;}
+                int ev_bitmask = 0;
+                if (fds[idx].revents & (POLLIN|POLLHUP)) {ev_bitmask |= CURL_CSELECT_IN;}
+                if (fds[idx].revents & POLLOUT) {ev_bitmask |= CURL_CSELECT_OUT;}
+                if (fds[idx].revents & (POLLERR|POLLNVAL)) {ev_bitmask |= CURL_CSELECT_ERR;}
+                events.emplace_back(fds[idx].fd, ev_bitmask);
+            }
+            for (const auto &event : events) {
+                auto sock = m_sockets.find(event.first);
+                if (sock == m_sockets.end()) {continue;}
+                Action(sock->second.job, event.first, event.second);
+            }
+        }
+
+        now = std::chrono::steady_clock::now();
+        ready.clear();
+        for (auto job : m_jobs) {
+            if (job->m_has_timer && job->m_timer <= now) {ready.push_back(job);}
+        }
+        for (auto job : ready) {
+            if (std::find(m_jobs.begin(), m_jobs.end(), job) == m_jobs.end()) {continue;}
+            job->m_has_timer = false;
+            Action(job, CURL_SOCKET_TIMEOUT, 0);
+        }
+
+        if (now - last_refresh >= g_progress_period) {
+            for (auto job : m_jobs) {Refresh(job);}
+            last_refresh = now;
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * engine.hh:
+ *
+ * A shared event loop for running the libcurl transfers of all TPC requests.
+ *
+ * Without the engine, each HTTP request thread drives its own curl multi-handle,
+ * polling its sockets until the transfer completes; hundreds of concurrent
+ * transfers mean hundreds of threads each in their own poll loop.  The engine
+ * instead runs the multi-handles of all transfers on a small, fixed pool of
+ * worker threads through libcurl's socket interface; each worker waits on the
+ * sockets of all of its transfers at once.  The request thread only waits for
+ * its job to complete, waking every marker period to send the progress computed
+ * by the worker back to the client as a performance marker.
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <curl/curl.h>
+
+class XrdSysError;
+
+namespace TPC {
+
+class CurlEngine;
+
+/**
+ * A transfer run by the engine.  The job borrows a multi-handle from its
+ * creator, which must keep it - and anything the job's callbacks touch - alive
+ * until Wait() has returned true; the engine never calls curl_multi_cleanup.
+ *
+ * The protected callbacks are invoked on the engine thread only; between
+ * Submit() and the completion of the job, the creator must not touch the
+ * multi-handle or its easy handles.
+ */
+class CurlJob {
+    friend class CurlEngine;
+
+public:
+    CurlJob(CURLM *multi) : m_multi(multi) {}
+    virtual ~CurlJob() {}
+
+    // Block until the job completes or the wall-clock deadline passes; a
+    // deadline of zero waits indefinitely.  Returns true if the job completed.
+    bool Wait(time_t deadline);
+
+    // Ask the engine to abort the job.  The caller must still Wait() for it.
+    void Cancel();
+
+    // Progress as last computed by the engine.
+    off_t BytesTransferred() const;
+    std::string Connections() const;
+
+    // Failure of the multi-handle itself, or the message of an exception
+    // thrown by a callback; valid once the job has completed.
+    CURLMcode MultiError() const {return m_mres;}
+    const std::string &Error() const {return m_error;}
+
+protected:
+    // Add the initial transfers to the multi-handle.  Returns false if there
+    // is nothing to run, completing the job.
+    virtual bool Begin() = 0;
+
+    // One of the job's easy handles finished with the given result; the
+    // callback must remove it from the multi-handle.  Returns true once
+    // the job has nothing left to run.
+    virtual bool Done(CURL *curl, CURLcode res) = 0;
+
+    // libcurl has made progress on the job's sockets.
+    virtual void Activity() {}
+
+    // Compute the bytes transferred so far and the remote connections used.
+    virtual void Progress(off_t &bytes, std::string &connections) = 0;
+
+    // Remove any easy handles still attached to the multi-handle; called
+    // once as the job completes, however it completes.
+    virtual void End() = 0;
+
+    CURLM *Multi() const {return m_multi;}
+
+private:
+    CURLM *m_multi;
+    CurlEngine *m_engine{nullptr};
+    size_t m_worker{0};
+    bool m_has_timer{false};
+    std::chrono::steady_clock::time_point m_timer;
+    CURLMcode m_mres{CURLM_OK};
+    std::string m_error;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_done{false};
+    off_t m_bytes{0};
+    std::string m_connections;
+};
+
+class CurlEngine {
+public:
+    CurlEngine(XrdSysError &log, unsigned threads);
+    ~CurlEngine();
+
+    CurlEngine(const CurlEngine &) = delete;
+
+    // Hand a job over to the least loaded worker.
+    void Submit(CurlJob &job);
+
+    unsigned Threads() const {return m_workers.size();}
+
+private:
+    friend class CurlJob;
+    struct Worker;
+
+    void Cancel(CurlJob &job);
+
+    static int SocketCB(CURL *curl, curl_socket_t fd, int what, void *userp, void *socketp);
+    static int TimerCB(CURLM *multi, long timeout_ms, void *userp);
+
+    XrdSysError &m_log;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+};
+
+}
@@ -7,6 +7,7 @@
 #include "XrdTpcTPC.hh"
 #include "XrdTpcState.hh"
 #include "XrdTpcCurlMulti.hh"
+#include "XrdTpcEngine.hh"
 
 #include "XrdSys/XrdSysError.hh"
 
@@ -66,6 +67,30 @@ public:
 
     CURLM *Get() const {return m_handle;}
 
+    size_t ActiveHandles() const {return m_active_handles.size();}
+
+    // Remove all in-flight transfers from the multi-handle, abandoning them.
+    void RemoveActive() {
+        for (std::vector<CURL *>::const_iterator it = m_active_handles.begin();
+             it != m_active_handles.end();
+             it++) {
+            curl_multi_remove_handle(m_handle, *it);
+            m_avail_handles.push_back(*it);
+        }
+        m_active_handles.clear();
+    }
+
+    // Total bytes received, including those of in-flight transfers.
+    off_t BytesInFlight() const {
+        off_t bytes = m_bytes_transferred;
+        for (std::vector<State*>::const_iterator state_iter = m_states.begin();
+             state_iter != m_states.end();
+             state_iter++) {
+            bytes += (*state_iter)->BytesTransferred();
+        }
+        return bytes;
+    }
+
     void FinishCurlXfer(CURL *curl) {
         CURLMcode mres = curl_multi_remove_handle(m_handle, curl);
         if (mres) {
@@ -253,6 +278,84 @@ private:
     int                  m_status_code;
     std::string          m_error_message;
 };
+
+
+/**
+ * Runs a multi-stream transfer on the shared engine: keeps up to the
+ * concurrency limit of block requests in flight until the whole file
+ * has been requested, cutting off the transfer if any request fails.
+ */
+class MultiStreamJob : public CurlJob {
+public:
+    MultiStreamJob(MultiCurlHandler &mch, std::vector<State*> &states,
+                   XrdTpc::PMarkManager &pmark, off_t &current_offset,
+                   off_t content_size, size_t block_size, CURLcode &res) :
+        CurlJob(mch.Get()),
+        m_mch(mch),
+        m_states(states),
+        m_pmark(pmark),
+        m_current_offset(current_offset),
+        m_content_size(content_size),
+        m_block_size(block_size),
+        m_res(res)
+    {}
+
+protected:
+    bool Begin() override {
+        m_pmark.startTransfer();
+        StartTransfers();
+        return m_mch.ActiveHandles() > 0;
+    }
+
+    bool Done(CURL *curl, CURLcode res) override {
+        m_res = res;
+        m_mch.FinishCurlXfer(curl);
+        // If any requests fail, cut off the entire transfer.
+        if (res != CURLE_OK) {return true;}
+        StartTransfers();
+        return m_mch.ActiveHandles() == 0;
+    }
+
+    // Buffers free up as data is written out, not only as requests
+    // complete; retry starting transfers whenever there is progress.
+    void Activity() override {
+        m_pmark.beginPMarks();
+        StartTransfers();
+    }
+
+    void Progress(off_t &bytes, std::string &connections) override {
+        bytes = m_mch.BytesInFlight();
+        bool first = true;
+        for (std::vector<State*>::const_iterator iter = m_states.begin();
+             iter != m_states.end(); iter++) {
+            std::string desc = (*iter)->GetConnectionDescription();
+            if (!desc.empty()) {
+                connections += (first ? "" : ",") + desc;
+                first = false;
+            }
+        }
+    }
+
+    void End() override {
+        m_mch.RemoveActive();
+    }
+
+private:
+    void StartTransfers() {
+        if (m_current_offset == m_content_size) {return;}
+        int running_handles = m_mch.ActiveHandles();
+        m_current_offset = m_mch.StartTransfers(m_current_offset, m_content_size,
+                                                m_block_size, running_handles);
+    }
+
+    MultiCurlHandler &m_mch;
+    std::vector<State*> &m_states;
+    XrdTpc::PMarkManager &m_pmark;
+    off_t &m_current_offset;
+    off_t m_content_size;
+    size_t m_block_size;
+    CURLcode &m_res;
+};
 }
 
 
@@ -304,119 +407,145 @@ int TPCHandler::RunCurlWithStreamsImpl(XrdHttpExtReq &req, State &state,
             "Initial transfer response sent to the TPC client");
     }
 
-    // Start assigning transfers
-    int running_handles = 0;
-    current_offset = mch.StartTransfers(current_offset, content_size, m_block_size, running_handles);
-
-    // Transfer loop: use curl to actually run the transfer, but periodically
-    // interrupt things to send back performance updates to the client.
-    time_t last_marker = 0;
-    // Track the time since the transfer last made progress
-    off_t last_advance_bytes = 0;
-    time_t last_advance_time = time(NULL);
-    time_t transfer_start = last_advance_time;
     CURLcode res = static_cast<CURLcode>(-1);
     CURLMcode mres = CURLM_OK;
-    do {
-        time_t now = time(NULL);
-        time_t next_marker = last_marker + m_marker_period;
-        if (now >= next_marker) {
-            if (current_offset > last_advance_bytes) {
-                last_advance_bytes = current_offset;
-                last_advance_time = now;
-            }
-            if (SendPerfMarker(req, rec, handles, current_offset)) {
-                logTransferEvent(LogMask::Error, rec, "PERFMARKER_FAIL",
-                    "Failed to send a perf marker to the TPC client");
-                return -1;
-            }
-            int timeout = (transfer_start == last_advance_time) ? m_first_timeout : m_timeout;
-            if (now > last_advance_time + timeout) {
-                const char *log_prefix = rec.log_prefix.c_str();
-                bool tpc_pull = strncmp("Pull", log_prefix, 4) == 0;
 
-                mch.SetErrorCode(10);
-                std::stringstream ss;
-                ss << "Transfer failed because no bytes have been "
-                   << (tpc_pull ? "received from the source (pull mode) in "
-                                : "transmitted to the destination (push mode) in ") << timeout << " seconds.";
-                mch.SetErrorMessage(ss.str());
-                break;
-            }
-            last_marker = now;
+    if (m_engine) {
+        MultiStreamJob job(mch, handles, rec.pmarkManager, current_offset,
+                           content_size, m_block_size, res);
+        std::string stall_message;
+        if (RunTransferJob(req, rec, job, stall_message)) {
+            return -1;
         }
-
-        mres = curl_multi_perform(multi_handle, &running_handles);
-        if (mres == CURLM_CALL_MULTI_PERFORM) {
-            // curl_multi_perform should be called again immediately.  On newer
-            // versions of curl, this is no longer used.
-            continue;
-        } else if (mres != CURLM_OK) {
-            break;
+        if (!stall_message.empty()) {
+            mch.SetErrorCode(10);
+            mch.SetErrorMessage(stall_message);
         }
-
-        rec.pmarkManager.beginPMarks();
-
-
-        // Harvest any messages, looking for CURLMSG_DONE.
-        CURLMsg *msg;
-        do {
-            int msgq = 0;
-            msg = curl_multi_info_read(multi_handle, &msgq);
-            if (msg && (msg->msg == CURLMSG_DONE)) {
-                CURL *easy_handle = msg->easy_handle;
-                res = msg->data.result;
-                mch.FinishCurlXfer(easy_handle);
-                // If any requests fail, cut off the entire transfer.
-                if (res != CURLE_OK) {
-                    break;
-                }
-            }
-        } while (msg);
+        if (!job.Error().empty()) {
+            logTransferEvent(LogMask::Error, rec, "MULTISTREAM_ERROR", job.Error());
+            throw std::runtime_error(job.Error());
+        }
+        mres = job.MultiError();
         if (res != static_cast<CURLcode>(-1) && res != CURLE_OK) {
             std::stringstream ss;
-            ss << "Breaking loop due to failed curl transfer: " << curl_easy_strerror(res);
+            ss << "Stopped transfer due to failed curl transfer: " << curl_easy_strerror(res);
             logTransferEvent(LogMask::Debug, rec, "MULTISTREAM_CURL_FAILURE",
                 ss.str());
-            break;
         }
+    } else {
+        // Start assigning transfers
+        int running_handles = 0;
+        current_offset = mch.StartTransfers(current_offset, content_size, m_block_size, running_handles);
+
+        // Transfer loop: use curl to actually run the transfer, but periodically
+        // interrupt things to send back performance updates to the client.
+        time_t last_marker = 0;
+        // Track the time since the transfer last made progress
+        off_t last_advance_bytes = 0;
+        time_t last_advance_time = time(NULL);
+        time_t transfer_start = last_advance_time;
+        do {
+            time_t now = time(NULL);
+            time_t next_marker = last_marker + m_marker_period;
+            if (now >= next_marker) {
+                if (current_offset > last_advance_bytes) {
+                    last_advance_bytes = current_offset;
+                    last_advance_time = now;
+                }
+                if (SendPerfMarker(req, rec, handles, current_offset)) {
+                    logTransferEvent(LogMask::Error, rec, "PERFMARKER_FAIL",
+                        "Failed to send a perf marker to the TPC client");
+                    return -1;
+                }
+                int timeout = (transfer_start == last_advance_time) ? m_first_timeout : m_timeout;
+                if (now > last_advance_time + timeout) {
+                    const char *log_prefix = rec.log_prefix.c_str();
+                    bool tpc_pull = strncmp("Pull", log_prefix, 4) == 0;
 
-        if (running_handles < static_cast<int>(concurrency)) {
-            // Issue new transfers if there is still pending work to do.
-            // Otherwise, continue running until there are no handles left.
-            if (current_offset != content_size) {
-                current_offset = mch.StartTransfers(current_offset, content_size,
-                                                    m_block_size, running_handles);
-                if (!running_handles) {
+                    mch.SetErrorCode(10);
                     std::stringstream ss;
-                    ss << "No handles are able to run.  Streams=" << streams << ", concurrency="
-                       << concurrency;
-                    
-                    logTransferEvent(LogMask::Debug, rec, "MULTISTREAM_IDLE", ss.str());
+                    ss << "Transfer failed because no bytes have been "
+                       << (tpc_pull ? "received from the source (pull mode) in "
+                                    : "transmitted to the destination (push mode) in ") << timeout << " seconds.";
+                    mch.SetErrorMessage(ss.str());
+                    break;
                 }
-            } else if (running_handles == 0) {
-                logTransferEvent(LogMask::Debug, rec, "MULTISTREAM_IDLE",
-                    "Unable to start new transfers; breaking loop.");
+                last_marker = now;
+            }
+
+            mres = curl_multi_perform(multi_handle, &running_handles);
+            if (mres == CURLM_CALL_MULTI_PERFORM) {
+                // curl_multi_perform should be called again immediately.  On newer
+                // versions of curl, this is no longer used.
+                continue;
+            } else if (mres != CURLM_OK) {
                 break;
             }
-        }
 
-        int64_t max_sleep_time = next_marker - time(NULL);
-        if (max_sleep_time <= 0) {
-            continue;
-        }
-        int fd_count;
+            rec.pmarkManager.beginPMarks();
+
+
+            // Harvest any messages, looking for CURLMSG_DONE.
+            CURLMsg *msg;
+            do {
+                int msgq = 0;
+                msg = curl_multi_info_read(multi_handle, &msgq);
+                if (msg && (msg->msg == CURLMSG_DONE)) {
+                    CURL *easy_handle = msg->easy_handle;
+                    res = msg->data.result;
+                    mch.FinishCurlXfer(easy_handle);
+                    // If any requests fail, cut off the entire transfer.
+                    if (res != CURLE_OK) {
+                        break;
+                    }
+                }
+            } while (msg);
+            if (res != static_cast<CURLcode>(-1) && res != CURLE_OK) {
+                std::stringstream ss;
+                ss << "Breaking loop due to failed curl transfer: " << curl_easy_strerror(res);
+                logTransferEvent(LogMask::Debug, rec, "MULTISTREAM_CURL_FAILURE",
+                    ss.str());
+                break;
+            }
+
+            if (running_handles < static_cast<int>(concurrency)) {
+                // Issue new transfers if there is still pending work to do.
+                // Otherwise, continue running until there are no handles left.
+                if (current_offset != content_size) {
+                    current_offset = mch.StartTransfers(current_offset, content_size,
+                                                        m_block_size, running_handles);
+                    if (!running_handles) {
+                        std::stringstream ss;
+                        ss << "No handles are able to run.  Streams=" << streams << ", concurrency="
+                           << concurrency;
+                    
+                        logTransferEvent(LogMask::Debug, rec, "MULTISTREAM_IDLE", ss.str());
+                    }
+                } else if (running_handles == 0) {
+                    logTransferEvent(LogMask::Debug, rec, "MULTISTREAM_IDLE",
+                        "Unable to start new transfers; breaking loop.");
+                    break;
+                }
+            }
+
+            int64_t max_sleep_time = next_marker - time(NULL);
+            if (max_sleep_time <= 0) {
+                continue;
+            }
+            int fd_count;
 #ifdef HAVE_CURL_MULTI_WAIT
-        mres = curl_multi_wait(multi_handle, NULL, 0, max_sleep_time*1000,
-                               &fd_count);
+            mres = curl_multi_wait(multi_handle, NULL, 0, max_sleep_time*1000,
+                                   &fd_count);
 #else
-        mres = curl_multi_wait_impl(multi_handle, max_sleep_time*1000,
-                                    &fd_count);
+            mres = curl_multi_wait_impl(multi_handle, max_sleep_time*1000,
+                                        &fd_count);
 #endif
-        if (mres != CURLM_OK) {
-            break;
-        }
-    } while (running_handles);
+            if (mres != CURLM_OK) {
+                break;
+            }
+        } while (running_handles);
+
+    }
 
     if (mres != CURLM_OK) {
         std::stringstream ss;
@@ -1,5 +1,7 @@
 
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 #include "XrdTpcStream.hh"
 
@@ -8,6 +10,62 @@
 
 using namespace TPC;
 
+namespace {
+
+std::mutex g_pool_mutex;
+std::unordered_map<size_t, std::vector<char *>> g_pool;
+size_t g_pool_idle = 0;
+size_t g_pool_max_idle = 256*1024*1024;
+
+}
+
+
+char *
+BufferPool::Get(size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_pool_mutex);
+        auto iter = g_pool.find(size);
+        if (iter != g_pool.end() && !iter->second.empty()) {
+            char *buffer = iter->second.back();
+            iter->second.pop_back();
+            g_pool_idle -= size;
+            return buffer;
+        }
+    }
+    return new char[size];
+}
+
+
+void
+BufferPool::Put(char *buffer, size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_pool_mutex);
+        if (g_pool_idle + size <= g_pool_max_idle) {
+            g_pool[size].push_back(buffer);
+            g_pool_idle += size;
+            return;
+        }
+    }
+    delete [] buffer;
+}
+
+
+void
+BufferPool::SetMaxIdle(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(g_pool_mutex);
+    g_pool_max_idle = bytes;
+    for (auto &entry : g_pool) {
+        while (g_pool_idle > g_pool_max_idle && !entry.second.empty()) {
+            delete [] entry.second.back();
+            entry.second.pop_back();
+            g_pool_idle -= entry.first;
+        }
+    }
+}
+
 Stream::~Stream()
 {
     for (std::vector<Entry*>::iterator buffer_iter = m_buffers.begin();
@@ -150,15 +208,6 @@ Stream::Write(off_t offset, const char *buf, size_t size, bool force)
         m_avail_count --;
     }
 
-    // If we have low buffer occupancy, then release memory.
-    if ((m_buffers.size() > 2) && (m_avail_count * 2 > m_buffers.size())) {
-        for (std::vector<Entry*>::iterator entry_iter = m_buffers.begin();
-             entry_iter != m_buffers.end();
-             entry_iter++) {
-            (*entry_iter)->ShrinkIfUnused();
-        }
-    }
-
     return retval;
 }
 
@@ -8,6 +8,7 @@
  */
 
 #include <memory>
+#include <utility>
 #include <vector>
 #include <string>
 
@@ -19,6 +20,25 @@ class XrdSfsFile;
 class XrdSysError;
 
 namespace TPC {
+
+/**
+ * Process-wide pool of reordering buffers.
+ *
+ * A stream only holds a buffer while it has out-of-order data to keep; with
+ * block sizes in the megabytes, allocating (and zero-filling) a fresh buffer
+ * each time costs more than the copy into it.  Buffers are recycled between
+ * all streams instead, keeping up to SetMaxIdle() bytes around when unused.
+ */
+class BufferPool {
+public:
+    // Returns an uninitialized buffer of the given size.
+    static char *Get(size_t size);
+
+    static void Put(char *buffer, size_t size);
+
+    static void SetMaxIdle(size_t bytes);
+};
+
 class Stream {
 public:
     Stream(std::unique_ptr<XrdSfsFile> fh, size_t max_blocks, size_t buffer_size, XrdSysError &log)
@@ -75,9 +95,14 @@ private:
         Entry(size_t capacity) :
             m_offset(-1),
             m_capacity(capacity),
-            m_size(0)
+            m_size(0),
+            m_buffer(nullptr)
         {}
 
+        ~Entry() {
+            if (m_buffer) {BufferPool::Put(m_buffer, m_capacity);}
+        }
+
         bool Available() const {return m_offset == -1;}
 
         int Write(Stream &stream, bool force) {
@@ -90,7 +115,7 @@ private:
             if (!force && (m_size != m_capacity)) {
                 return 0;
             }
-            ssize_t retval = stream.WriteImpl(m_offset, &m_buffer[0], m_size);
+            ssize_t retval = stream.WriteImpl(m_offset, m_buffer, m_size);
             // Currently the only valid negative value is SFS_ERROR (-1); checking for
             // all negative values to future-proof the code.
             if ((retval < 0) || (static_cast<size_t>(retval) != m_size)) {
@@ -98,7 +123,8 @@ private:
             }
             m_offset = -1;
             m_size = 0;
-            m_buffer.clear();
+            BufferPool::Put(m_buffer, m_capacity);
+            m_buffer = nullptr;
             return retval;
         }
 
@@ -113,14 +139,13 @@ private:
                 size = to_accept;
             }
 
-            // Inflate the underlying buffer if needed.
-            ssize_t new_bytes_needed = (m_size + size) - m_buffer.size();
-            if (new_bytes_needed > 0) {
-                m_buffer.resize(m_capacity);
+            // Take a buffer from the pool if needed.
+            if (!m_buffer) {
+                m_buffer = BufferPool::Get(m_capacity);
             }
 
             // Finally, do the copy.
-            memcpy(&m_buffer[0] + m_size, buf, size);
+            memcpy(m_buffer + m_size, buf, size);
             m_size += size;
             if (m_offset == -1) {
                 m_offset = offset;
@@ -128,15 +153,8 @@ private:
             return size;
         }
 
-        void ShrinkIfUnused() {
-           if (!Available()) {return;}
-#if __cplusplus > 199711L
-           m_buffer.shrink_to_fit();
-#endif
-        }
-
         void Move(Entry &other) {
-            m_buffer.swap(other.m_buffer);
+            std::swap(m_buffer, other.m_buffer);
             m_offset = other.m_offset;
             m_size = other.m_size;
         }
@@ -156,7 +174,7 @@ private:
         off_t m_offset;  // Offset within file that m_buffer[0] represents.
         size_t m_capacity;
         size_t m_size;  // Number of bytes held in buffer.
-        std::vector<char> m_buffer;
+        char *m_buffer;  // Taken from the pool while the entry holds data.
     };
 
     ssize_t WriteImpl(off_t offset, const char *buffer, size_t size);
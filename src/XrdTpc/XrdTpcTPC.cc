@@ -28,6 +28,7 @@
 #include "XrdTpcStream.hh"
 #include "XrdTpcTPC.hh"
 #include "XrdTpcCurlMulti.hh"
+#include "XrdTpcEngine.hh"
 #include <fstream>
 
 using namespace TPC;
@@ -42,6 +43,59 @@ XrdSysMutex TPCHandler::m_monid_mutex;
 
 XrdVERSIONINFO(XrdHttpGetExtHandler, HttpTPC);
 
+#ifdef XRD_CHUNK_RESP
+namespace {
+/**
+ * Runs a single-stream transfer on the shared engine.
+ */
+class SingleCurlJob : public CurlJob {
+public:
+    SingleCurlJob(CURLM *multi, CURL *curl, State &state,
+                  XrdTpc::PMarkManager &pmark, CURLcode &res) :
+        CurlJob(multi),
+        m_curl(curl),
+        m_state(state),
+        m_pmark(pmark),
+        m_res(res)
+    {}
+
+protected:
+    // The handle was added to the multi-handle by the caller.
+    bool Begin() override {
+        // The transfer will start after this point, notify the packet marking manager
+        m_pmark.startTransfer();
+        return true;
+    }
+
+    bool Done(CURL *curl, CURLcode res) override {
+        m_res = res;
+        curl_multi_remove_handle(Multi(), curl);
+        m_attached = false;
+        return true;
+    }
+
+    void Activity() override {m_pmark.beginPMarks();}
+
+    void Progress(off_t &bytes, std::string &connections) override {
+        bytes = m_state.BytesTransferred();
+        connections = m_state.GetConnectionDescription();
+    }
+
+    void End() override {
+        if (m_attached) {curl_multi_remove_handle(Multi(), m_curl);}
+        m_attached = false;
+    }
+
+private:
+    CURL *m_curl;
+    State &m_state;
+    XrdTpc::PMarkManager &m_pmark;
+    CURLcode &m_res;
+    bool m_attached{true};
+};
+}
+#endif
+
 /******************************************************************************/
 /*   T P C H a n d l e r : : T P C L o g R e c o r d   D e s t r u c t o r    */
 /******************************************************************************/
@@ -307,11 +361,15 @@ TPCHandler::TPCHandler(XrdSysError *log, const char *config, XrdOucEnv *myEnv) :
         m_timeout(60),
         m_first_timeout(120),
         m_log(log->logger(), "TPC_"),
-        m_sfs(NULL)
+        m_sfs(NULL),
+        m_engine_threads(0)
 {
     if (!Configure(config, myEnv)) {
         throw std::runtime_error("Failed to configure the HTTP third-party-copy handler.");
     }
+    if (m_engine_threads) {
+        m_engine.reset(new CurlEngine(m_log, m_engine_threads));
+    }
 
 // Extract out the TPC monitoring object (we share it with xrootd).
 //
@@ -537,13 +595,6 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vecto
     //    RemoteConnections: tcp:129.93.3.4:1234,tcp:[2600:900:6:1301:268a:7ff:fef6:a590]:2345\n
     //    End\n
     //
-    std::stringstream ss;
-    const std::string crlf = "\n";
-    ss << "Perf Marker" << crlf;
-    ss << "Timestamp: " << time(NULL) << crlf;
-    ss << "Stripe Index: 0" << crlf;
-    ss << "Stripe Bytes Transferred: " << bytes_transferred << crlf;
-    ss << "Total Stripe Count: 1" << crlf;
     // Build a list of TCP connections associated with this transfer; used by
     // the TPC client for monitoring purposes.
     bool first = true;
@@ -557,8 +608,26 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vecto
             first = false;
         }
     }
-    if (!first)
-        ss << "RemoteConnections: " << ss2.str() << crlf;
+    return SendPerfMarker(req, rec, bytes_transferred, ss2.str());
+}
+
+/******************************************************************************/
+/* XRD_CHUNK_RESP:                                                            */
+/*            T P C H a n d l e r : : S e n d P e r f M a r k e r             */
+/******************************************************************************/
+  
+int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, off_t bytes_transferred,
+    const std::string &connections)
+{
+    std::stringstream ss;
+    const std::string crlf = "\n";
+    ss << "Perf Marker" << crlf;
+    ss << "Timestamp: " << time(NULL) << crlf;
+    ss << "Stripe Index: 0" << crlf;
+    ss << "Stripe Bytes Transferred: " << bytes_transferred << crlf;
+    ss << "Total Stripe Count: 1" << crlf;
+    if (!connections.empty())
+        ss << "RemoteConnections: " << connections << crlf;
     ss << "End" << crlf;
     rec.bytes_transferred = bytes_transferred;
     logTransferEvent(LogMask::Debug, rec, "PERF_MARKER");
@@ -566,6 +635,60 @@ int TPCHandler::SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vecto
     return req.ChunkResp(ss.str().c_str(), 0);
 }
 
+/******************************************************************************/
+/* XRD_CHUNK_RESP:                                                            */
+/*            T P C H a n d l e r : : R u n T r a n s f e r J o b             */
+/******************************************************************************/
+  
+int TPCHandler::RunTransferJob(XrdHttpExtReq &req, TPCLogRecord &rec, CurlJob &job,
+    std::string &stall_message)
+{
+    m_engine->Submit(job);
+
+    time_t last_marker = 0;
+    // Track how long it's been since the last time we recorded more bytes being transferred.
+    off_t last_advance_bytes = 0;
+    time_t last_advance_time = time(NULL);
+    time_t transfer_start = last_advance_time;
+    while (true) {
+        time_t now = time(NULL);
+        time_t next_marker = last_marker + m_marker_period;
+        if (now >= next_marker) {
+            off_t bytes_xfer = job.BytesTransferred();
+            if (bytes_xfer > last_advance_bytes) {
+                last_advance_bytes = bytes_xfer;
+                last_advance_time = now;
+            }
+            if (SendPerfMarker(req, rec, bytes_xfer, job.Connections())) {
+                job.Cancel();
+                job.Wait(0);
+                logTransferEvent(LogMask::Error, rec, "PERFMARKER_FAIL",
+                    "Failed to send a perf marker to the TPC client");
+                return -1;
+            }
+            int timeout = (transfer_start == last_advance_time) ? m_first_timeout : m_timeout;
+            if (now > last_advance_time + timeout) {
+                const char *log_prefix = rec.log_prefix.c_str();
+                bool tpc_pull = strncmp("Pull", log_prefix, 4) == 0;
+
+                job.Cancel();
+                job.Wait(0);
+                std::stringstream ss;
+                ss << "Transfer failed because no bytes have been "
+                   << (tpc_pull ? "received from the source (pull mode) in "
+                                : "transmitted to the destination (push mode) in ") << timeout << " seconds.";
+                stall_message = ss.str();
+                return 0;
+            }
+            last_marker = now;
+            next_marker = now + m_marker_period;
+        }
+        if (job.Wait(next_marker)) {
+            return 0;
+        }
+    }
+}
+
 /******************************************************************************/
 /* XRD_CHUNK_RESP:                                                            */
 /*        T P C H a n d l e r : : R u n C u r l W i t h U p d a t e s         */
@@ -610,90 +733,106 @@ int TPCHandler::RunCurlWithUpdates(CURL *curl, XrdHttpExtReq &req, State &state,
             "Initial transfer response sent to the TPC client");
     }
 
-    // Transfer loop: use curl to actually run the transfer, but periodically
-    // interrupt things to send back performance updates to the client.
-    int running_handles = 1;
-    time_t last_marker = 0;
-    // Track how long it's been since the last time we recorded more bytes being transferred.
-    off_t last_advance_bytes = 0;
-    time_t last_advance_time = time(NULL);
-    time_t transfer_start = last_advance_time;
     CURLcode res = static_cast<CURLcode>(-1);
-    do {
-        time_t now = time(NULL);
-        time_t next_marker = last_marker + m_marker_period;
-        if (now >= next_marker) {
-            off_t bytes_xfer = state.BytesTransferred();
-            if (bytes_xfer > last_advance_bytes) {
-                last_advance_bytes = bytes_xfer;
-                last_advance_time = now;
-            }
-            if (SendPerfMarker(req, rec, state)) {
-                curl_multi_remove_handle(multi_handle, curl);
-                curl_multi_cleanup(multi_handle);
-                logTransferEvent(LogMask::Error, rec, "PERFMARKER_FAIL",
-                    "Failed to send a perf marker to the TPC client");
-                return -1;
-            }
-            int timeout = (transfer_start == last_advance_time) ? m_first_timeout : m_timeout;
-            if (now > last_advance_time + timeout) {
-                const char *log_prefix = rec.log_prefix.c_str();
-                bool tpc_pull = strncmp("Pull", log_prefix, 4) == 0;
 
-                state.SetErrorCode(10);
-                std::stringstream ss;
-                ss << "Transfer failed because no bytes have been "
-                   << (tpc_pull ? "received from the source (pull mode) in "
-                                : "transmitted to the destination (push mode) in ") << timeout << " seconds.";
-                state.SetErrorMessage(ss.str());
-                curl_multi_remove_handle(multi_handle, curl);
-                curl_multi_cleanup(multi_handle);
-                break;
-            }
-            last_marker = now;
+    if (m_engine) {
+        SingleCurlJob job(multi_handle, curl, state, rec.pmarkManager, res);
+        std::string stall_message;
+        if (RunTransferJob(req, rec, job, stall_message)) {
+            curl_multi_cleanup(multi_handle);
+            return -1;
         }
-        // The transfer will start after this point, notify the packet marking manager
-        rec.pmarkManager.startTransfer();
-        mres = curl_multi_perform(multi_handle, &running_handles);
-        if (mres == CURLM_CALL_MULTI_PERFORM) {
-            // curl_multi_perform should be called again immediately.  On newer
-            // versions of curl, this is no longer used.
-            continue;
-        } else if (mres != CURLM_OK) {
-            break;
-        } else if (running_handles == 0) {
-            break;
+        if (!stall_message.empty()) {
+            state.SetErrorCode(10);
+            state.SetErrorMessage(stall_message);
         }
-
-        rec.pmarkManager.beginPMarks();
-        //printf("There are %d running handles\n", running_handles);
-
-        // Harvest any messages, looking for CURLMSG_DONE.
-        CURLMsg *msg;
+        mres = job.MultiError();
+    } else {
+        // Transfer loop: use curl to actually run the transfer, but periodically
+        // interrupt things to send back performance updates to the client.
+        int running_handles = 1;
+        time_t last_marker = 0;
+        // Track how long it's been since the last time we recorded more bytes being transferred.
+        off_t last_advance_bytes = 0;
+        time_t last_advance_time = time(NULL);
+        time_t transfer_start = last_advance_time;
         do {
-            int msgq = 0;
-            msg = curl_multi_info_read(multi_handle, &msgq);
-            if (msg && (msg->msg == CURLMSG_DONE)) {
-                CURL *easy_handle = msg->easy_handle;
-                res = msg->data.result;
-                curl_multi_remove_handle(multi_handle, easy_handle);
+            time_t now = time(NULL);
+            time_t next_marker = last_marker + m_marker_period;
+            if (now >= next_marker) {
+                off_t bytes_xfer = state.BytesTransferred();
+                if (bytes_xfer > last_advance_bytes) {
+                    last_advance_bytes = bytes_xfer;
+                    last_advance_time = now;
+                }
+                if (SendPerfMarker(req, rec, state)) {
+                    curl_multi_remove_handle(multi_handle, curl);
+                    curl_multi_cleanup(multi_handle);
+                    logTransferEvent(LogMask::Error, rec, "PERFMARKER_FAIL",
+                        "Failed to send a perf marker to the TPC client");
+                    return -1;
+                }
+                int timeout = (transfer_start == last_advance_time) ? m_first_timeout : m_timeout;
+                if (now > last_advance_time + timeout) {
+                    const char *log_prefix = rec.log_prefix.c_str();
+                    bool tpc_pull = strncmp("Pull", log_prefix, 4) == 0;
+
+                    state.SetErrorCode(10);
+                    std::stringstream ss;
+                    ss << "Transfer failed because no bytes have been "
+                       << (tpc_pull ? "received from the source (pull mode) in "
+                                    : "transmitted to the destination (push mode) in ") << timeout << " seconds.";
+                    state.SetErrorMessage(ss.str());
+                    curl_multi_remove_handle(multi_handle, curl);
+                    curl_multi_cleanup(multi_handle);
+                    break;
+                }
+                last_marker = now;
+            }
+            // The transfer will start after this point, notify the packet marking manager
+            rec.pmarkManager.startTransfer();
+            mres = curl_multi_perform(multi_handle, &running_handles);
+            if (mres == CURLM_CALL_MULTI_PERFORM) {
+                // curl_multi_perform should be called again immediately.  On newer
+                // versions of curl, this is no longer used.
+                continue;
+            } else if (mres != CURLM_OK) {
+                break;
+            } else if (running_handles == 0) {
+                break;
             }
-        } while (msg);
 
-        int64_t max_sleep_time = next_marker - time(NULL);
-        if (max_sleep_time <= 0) {
-            continue;
-        }
-        int fd_count;
+            rec.pmarkManager.beginPMarks();
+            //printf("There are %d running handles\n", running_handles);
+
+            // Harvest any messages, looking for CURLMSG_DONE.
+            CURLMsg *msg;
+            do {
+                int msgq = 0;
+                msg = curl_multi_info_read(multi_handle, &msgq);
+                if (msg && (msg->msg == CURLMSG_DONE)) {
+                    CURL *easy_handle = msg->easy_handle;
+                    res = msg->data.result;
+                    curl_multi_remove_handle(multi_handle, easy_handle);
+                }
+            } while (msg);
+
+            int64_t max_sleep_time = next_marker - time(NULL);
+            if (max_sleep_time <= 0) {
+                continue;
+            }
+            int fd_count;
 #ifdef HAVE_CURL_MULTI_WAIT
-        mres = curl_multi_wait(multi_handle, NULL, 0, max_sleep_time*1000, &fd_count);
+            mres = curl_multi_wait(multi_handle, NULL, 0, max_sleep_time*1000, &fd_count);
 #else
-        mres = curl_multi_wait_impl(multi_handle, max_sleep_time*1000, &fd_count);
+            mres = curl_multi_wait_impl(multi_handle, max_sleep_time*1000, &fd_count);
 #endif
-        if (mres != CURLM_OK) {
-            break;
-        }
-    } while (running_handles);
+            if (mres != CURLM_OK) {
+                break;
+            }
+        } while (running_handles);
+
+    }
 
     if (mres != CURLM_OK) {
         std::stringstream ss;
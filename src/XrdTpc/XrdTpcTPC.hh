@@ -22,6 +22,8 @@ class XrdXrootdTpcMon;
 typedef void CURL;
 
 namespace TPC {
+class CurlEngine;
+class CurlJob;
 class State;
 
 enum LogMask {
@@ -113,6 +115,15 @@ private:
     int SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, TPC::State &state);
     int SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, std::vector<State*> &state,
         off_t bytes_transferred);
+    int SendPerfMarker(XrdHttpExtReq &req, TPCLogRecord &rec, off_t bytes_transferred,
+        const std::string &connections);
+
+    // Run a transfer on the shared curl engine, sending perf markers from the
+    // progress it reports until the job completes.  If the transfer stalls,
+    // it is cancelled and stall_message describes why; returns -1 if a perf
+    // marker could not be sent.
+    int RunTransferJob(XrdHttpExtReq &req, TPCLogRecord &rec, CurlJob &job,
+                       std::string &stall_message);
 
     // Perform the libcurl transfer, periodically sending back chunked updates.
     int RunCurlWithUpdates(CURL *curl, XrdHttpExtReq &req, TPC::State &state,
@@ -137,6 +148,7 @@ private:
                         std::string &path2, bool &path2_alt);
     bool Configure(const char *configfn, XrdOucEnv *myEnv);
     bool ConfigureLogger(XrdOucStream &Config);
+    bool ConfigureEngine(XrdOucStream &Config);
 
     // Generate a consistently-formatted log message.
     void logTransferEvent(LogMask lvl, const TPCLogRecord &record,
@@ -163,6 +175,8 @@ private:
     XrdSysError m_log;
     XrdSfsFileSystem *m_sfs;
     std::shared_ptr<XrdTlsTempCA> m_ca_file;
+    unsigned m_engine_threads; // Threads running the curl transfers; 0 runs each on its request thread.
+    std::unique_ptr<CurlEngine> m_engine;
 
     // 16 blocks in flight at 16 MB each, meaning that there will be up to 256MB
     // in flight; this is equal to the bandwidth delay product of a 200ms transcontinental
@@ -43,6 +43,7 @@ set ( XrdSysSources
                                 XrdSys/XrdSysLogPI.hh
   XrdSys/XrdSysLogger.cc        XrdSys/XrdSysLogger.hh
   XrdSys/XrdSysLogging.cc       XrdSys/XrdSysLogging.hh
+  XrdSys/XrdSysMetrics.cc       XrdSys/XrdSysMetrics.hh
                                 XrdSys/XrdSysPageSize.hh
   XrdSys/XrdSysPlatform.cc      XrdSys/XrdSysPlatform.hh
   XrdSys/XrdSysPlugin.cc        XrdSys/XrdSysPlugin.hh
@@ -111,6 +112,8 @@ set ( XrdOucSources
                                 XrdOuc/XrdOucErrInfo.hh
   XrdOuc/XrdOucExport.cc        XrdOuc/XrdOucExport.hh
   XrdOuc/XrdOucFileInfo.cc      XrdOuc/XrdOucFileInfo.hh
+                                XrdOuc/XrdOucFlatHash.hh
+                                XrdOuc/XrdOucFlatHash.icc
   XrdOuc/XrdOucGatherConf.cc    XrdOuc/XrdOucGatherConf.hh
   XrdOuc/XrdOucGMap.cc          XrdOuc/XrdOucGMap.hh
                                 XrdOuc/XrdOucHash.hh
@@ -217,6 +220,7 @@ set ( XrdSources
   Xrd/XrdLinkMatch.cc           Xrd/XrdLinkMatch.hh
   Xrd/XrdGlobals.cc
   Xrd/XrdObject.icc             Xrd/XrdObject.hh
+  Xrd/XrdNuma.cc                Xrd/XrdNuma.hh
   Xrd/XrdPoll.cc                Xrd/XrdPoll.hh
                                 Xrd/XrdPollE.hh
                                 Xrd/XrdPollE.icc
@@ -0,0 +1,183 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d X r o o t d A i o A r e n a . c c                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+
+#include "Xrd/XrdBuffer.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysMetrics.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdXrootd/XrdXrootdAioArena.hh"
+
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+
+namespace
+{
+XrdSysMutex  arMutex;
+XrdBuffer  **slotVec = 0;    // Buffer object for each slot, never deleted
+int         *freeVec = 0;    // Stack of free slot numbers
+int          freeNum = 0;
+int          slotNum = 0;
+int          slotSz  = 0;
+char        *arBase  = 0;
+char        *arEnd   = 0;
+
+static const size_t hpSize = 2*1024*1024;
+
+XrdSysMetrics::Counter *arMiss = 0;
+
+long long getSlots(void *) {return slotNum;}
+long long getUsed (void *) {return slotNum - freeNum;}
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+bool XrdXrootdAioArena::Init(long long asz, int bsz, int slotsz,
+                             XrdSysError &eDest)
+{
+   const char *how = "normal pages";
+   void  *mem = MAP_FAILED;
+   size_t len;
+   bool   locked;
+
+// Size the arena in whole huge pages with at least one slot
+//
+   if (asz < slotsz) asz = slotsz;
+   len = (asz + hpSize - 1) / hpSize * hpSize;
+
+// Prefer explicitly reserved huge pages and fall back to transparent ones
+//
+#ifdef MAP_HUGETLB
+   mem = mmap(0, len, PROT_READ|PROT_WRITE,
+              MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+   if (mem != MAP_FAILED) how = "huge pages";
+#endif
+   if (mem == MAP_FAILED)
+      {mem = mmap(0, len, PROT_READ|PROT_WRITE,
+                  MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+       if (mem == MAP_FAILED)
+          {eDest.Emsg("Config", errno, "allocate aio arena"); return false;}
+#ifdef MADV_HUGEPAGE
+       if (!madvise(mem, len, MADV_HUGEPAGE)) how = "transparent huge pages";
+#endif
+      }
+
+// Lock the arena in memory so that it is never paged out or faulted in. If we
+// cannot, touch every page so that at least it is all present now.
+//
+   if (!(locked = !mlock(mem, len))) memset(mem, 0, len);
+
+// Carve up the arena into slots
+//
+   slotNum = len / slotsz;
+   slotSz  = slotsz;
+   arBase  = (char *)mem;
+   arEnd   = arBase + (size_t)slotNum * slotsz;
+   slotVec = new XrdBuffer*[slotNum];
+   freeVec = new int[slotNum];
+   for (int i = 0; i < slotNum; i++)
+       {slotVec[i] = new XrdBuffer(arBase + (size_t)i * slotsz, bsz, 0);
+        freeVec[i] = slotNum - 1 - i;
+       }
+   freeNum = slotNum;
+
+// Register our metrics
+//
+   new XrdSysMetrics::Probe("xrootd_aio_arena_slots",
+                            "Buffer slots in the aio arena.",
+                            XrdSysMetrics::isGauge, getSlots);
+   new XrdSysMetrics::Probe("xrootd_aio_arena_slots_used",
+                            "Aio arena slots currently in use.",
+                            XrdSysMetrics::isGauge, getUsed);
+   arMiss = new XrdSysMetrics::Counter("xrootd_aio_arena_misses_total",
+                            "Aio buffers obtained elsewhere as the arena was full.");
+
+// Tell everyone what we have
+//
+   char buff[128];
+   snprintf(buff, sizeof(buff), "%d %dK slots (%lldM) in ", slotNum,
+            slotsz>>10, (long long)(len>>20));
+   eDest.Say("Config aio arena has ", buff, how,
+             (locked ? "." : "; memory not locked."));
+   return true;
+}
+
+/******************************************************************************/
+/*                                O b t a i n                                 */
+/******************************************************************************/
+
+XrdBuffer *XrdXrootdAioArena::Obtain()
+{
+   XrdBuffer *bP = 0;
+
+   if (!slotNum) return 0;
+
+   arMutex.Lock();
+   if (freeNum) bP = slotVec[freeVec[--freeNum]];
+   arMutex.UnLock();
+
+   if (!bP) arMiss->Add();
+   return bP;
+}
+
+/******************************************************************************/
+/*                                  O w n s                                   */
+/******************************************************************************/
+
+bool XrdXrootdAioArena::Owns(XrdBuffer *bP)
+{
+   return bP->buff >= arBase && bP->buff < arEnd;
+}
+
+/******************************************************************************/
+/*                               R e l e a s e                                */
+/******************************************************************************/
+
+bool XrdXrootdAioArena::Release(XrdBuffer *bP)
+{
+// Make sure this is one of ours
+//
+   if (!Owns(bP)) return false;
+
+// Put the slot back on the free stack
+//
+   arMutex.Lock();
+   freeVec[freeNum++] = (bP->buff - arBase) / slotSz;
+   arMutex.UnLock();
+   return true;
+}
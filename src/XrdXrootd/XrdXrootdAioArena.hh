@@ -0,0 +1,65 @@
+#ifndef __XRDXROOTDAIOARENA_HH_
+#define __XRDXROOTDAIOARENA_HH_
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d X r o o t d A i o A r e n a . h h                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+class XrdBuffer;
+class XrdSysError;
+
+// The aio arena is a preallocated region of fixed size buffers for async I/O.
+// It is backed by huge pages when the system has them and is locked into
+// memory when allowed, so that buffers never fault and span few TLB entries.
+// Each slot is page aligned and so may also be used for direct I/O. When the
+// arena is exhausted callers fall back to the general buffer pool.
+
+class XrdXrootdAioArena
+{
+public:
+
+// Create the arena with at least asz bytes of slots, each usable for bsz
+// bytes and spaced by slotsz bytes. Returns true upon success.
+//
+static bool       Init(long long asz, int bsz, int slotsz, XrdSysError &eDest);
+
+// Obtain a free slot. Returns 0 if there is no arena or all slots are in use.
+//
+static XrdBuffer *Obtain();
+
+// Indicate whether or not a buffer belongs to the arena.
+//
+static bool       Owns(XrdBuffer *bP);
+
+// Give back a buffer if it belongs to the arena. Returns false if it does not,
+// in which case it must be released elsewhere.
+//
+static bool       Release(XrdBuffer *bP);
+};
+#endif
@@ -29,6 +29,7 @@
 /******************************************************************************/
 
 #include "Xrd/XrdBuffer.hh"
+#include "XrdXrootd/XrdXrootdAioArena.hh"
 #include "XrdXrootd/XrdXrootdAioBuff.hh"
 #include "XrdXrootd/XrdXrootdAioTask.hh"
 #include "XrdXrootd/XrdXrootdProtocol.hh"
@@ -74,9 +75,11 @@ XrdXrootdAioBuff *XrdXrootdAioBuff::Alloc(XrdXrootdAioTask* arp)
    XrdXrootdAioBuff *aiobuff;
    XrdBuffer *bP;
 
-// Obtain a buffer as we never hold on to them (unlike pgaio)
+// Obtain a buffer as we never hold on to them (unlike pgaio). We prefer one
+// from the aio arena, if any, and otherwise use the general pool.
 //
-   if (!(bP = BPool->Obtain(XrdXrootdProtocol::as_segsize))) return 0;
+   if (!(bP = XrdXrootdAioArena::Obtain())
+   &&  !(bP = BPool->Obtain(XrdXrootdProtocol::as_segsize))) return 0;
 
 // Obtain a preallocated aio object
 //
@@ -146,7 +149,10 @@ void XrdXrootdAioBuff::Recycle()
 
 // Recycle the buffer as we don't want to hold on to it
 //
-   if (buffP) {BPool->Release(buffP); buffP = 0;}
+   if (buffP)
+      {if (!XrdXrootdAioArena::Release(buffP)) BPool->Release(buffP);
+       buffP = 0;
+      }
 
 // Place the object on the free queue if possible
 //
@@ -36,6 +36,7 @@
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
+#include "XrdXrootd/XrdXrootdAioArena.hh"
 #include "XrdXrootd/XrdXrootdAioPgrw.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
 #include "XrdXrootd/XrdXrootdTrace.hh"
@@ -80,7 +81,6 @@ static const int  maxKeep = 64; // 4MB in the pocket
 XrdXrootdAioPgrw::XrdXrootdAioPgrw(XrdXrootdAioTask* tP, XrdBuffer *bP)
                  : XrdXrootdAioBuff(this, tP, bP)
 {
-   char *buff = bP->buff;
    uint32_t *csV = csVec;
 
 // Fill out the iovec
@@ -88,11 +88,10 @@ XrdXrootdAioPgrw::XrdXrootdAioPgrw(XrdXrootdAioTask* tP, XrdBuffer *bP)
    for (int i = 1; i <= acsSZ<<1; i+= 2)
        {ioVec[i  ].iov_base = csV;
         ioVec[i  ].iov_len  = csLen;
-        ioVec[i+1].iov_base = buff;
         ioVec[i+1].iov_len  = XrdProto::kXR_pgPageSZ;
         csV++;
-        buff += XrdProto::kXR_pgPageSZ;
        }
+   SetBuff(bP);
 
 // Complete initialization
 //
@@ -110,7 +109,7 @@ XrdXrootdAioPgrw::~XrdXrootdAioPgrw()
 {
 // Recycle the buffer if we have one
 //
-   if (buffP) BPool->Release(buffP);
+   if (buffP && !XrdXrootdAioArena::Release(buffP)) BPool->Release(buffP);
 }
   
 /******************************************************************************/
@@ -120,6 +119,7 @@ XrdXrootdAioPgrw::~XrdXrootdAioPgrw()
 XrdXrootdAioPgrw *XrdXrootdAioPgrw::Alloc(XrdXrootdAioTask* arp)
 {
    XrdXrootdAioBuff *aiobuff;
+   XrdBuffer *bP = 0;
 
 // Obtain a preallocated aio object
 //
@@ -130,18 +130,24 @@ XrdXrootdAioPgrw *XrdXrootdAioPgrw::Alloc(XrdXrootdAioTask* arp)
       }
    fqMutex.UnLock();
 
-// If we have no object, create a new one. Otherwise initialize n old one
+// Obtain a buffer unless the object still has one, preferring an arena slot.
+// Objects give back their slot when recycled so that idle ones do not hold it.
 //
-   if (!aiobuff)
-      {XrdBuffer *bP = BPool->Obtain(aioSZ);
-       if (!bP) return 0;
-       aiobuff = new XrdXrootdAioPgrw(arp, bP);
-      } else {
-       aiobuff->Result = 0;
-       aiobuff->cksVec = aiobuff->pgrwP->csVec;
-       aiobuff->pgrwP->reqP = arp;
+   if ((!aiobuff || !aiobuff->pgrwP->buffP)
+   &&  !(bP = XrdXrootdAioArena::Obtain()) && !(bP = BPool->Obtain(aioSZ)))
+      {delete aiobuff;
+       return 0;
       }
 
+// If we have no object, create a new one. Otherwise initialize an old one
+//
+   if (!aiobuff) aiobuff = new XrdXrootdAioPgrw(arp, bP);
+      else {if (bP) aiobuff->pgrwP->SetBuff(bP);
+            aiobuff->Result = 0;
+            aiobuff->cksVec = aiobuff->pgrwP->csVec;
+            aiobuff->pgrwP->reqP = arp;
+           }
+
 // Update aio counters
 //
    arp->urProtocol()->aioUpdate(1);
@@ -221,10 +227,12 @@ void XrdXrootdAioPgrw::Recycle()
 //
    reqP->urProtocol()->aioUpdate(-1);
 
-// Place the object on the free queue if possible
+// Place the object on the free queue if possible, less any arena slot which
+// would otherwise be kept from others while the object is idle.
 //
+   if (XrdXrootdAioArena::Release(buffP)) buffP = 0;
    fqMutex.Lock();
-   if (numFree >= maxKeep) 
+   if (numFree >= maxKeep)
       {fqMutex.UnLock();
        delete this;
       } else {
@@ -235,6 +243,23 @@ void XrdXrootdAioPgrw::Recycle()
       }
 }
   
+/******************************************************************************/
+/*                               S e t B u f f                                */
+/******************************************************************************/
+
+void XrdXrootdAioPgrw::SetBuff(XrdBuffer *bP)
+{
+   char *buff = bP->buff;
+
+// Point the data elements of the iovec at the buffer
+//
+   buffP = bP;
+   for (int i = 2; i <= acsSZ<<1; i+= 2)
+       {ioVec[i].iov_base = buff;
+        buff += XrdProto::kXR_pgPageSZ;
+       }
+}
+
 /******************************************************************************/
 /*                            S e t u p 2 R e c v                             */
 /******************************************************************************/
@@ -79,6 +79,8 @@ private:
 
 static const char*  TraceID;
 
+void                SetBuff(XrdBuffer *bP);
+
 int                 csNum;
 int                 iovReset;
 uint32_t            csVec[acsSZ];
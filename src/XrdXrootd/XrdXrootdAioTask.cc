@@ -43,6 +43,7 @@
 #include "XrdXrootd/XrdXrootdAioFob.hh"
 #include "XrdXrootd/XrdXrootdAioTask.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
+#include "XrdXrootd/XrdXrootdLatency.hh"
 #include "XrdXrootd/XrdXrootdTrace.hh"
 
 #define TRACELINK dataLink
@@ -289,6 +290,23 @@ void XrdXrootdAioTask::Init(XrdXrootdProtocol *protP,
    inFlight   = 0;
    isDone     = false;
    Status     = Running;
+   latBeg     = XrdXrootdLatency::Defer(latReq);
+   latSend    = 0;
+}
+
+/******************************************************************************/
+/* Protected:                    L a t D o n e                                */
+/******************************************************************************/
+
+// Record the latency of the request we took over, once, as it completes.
+//
+void XrdXrootdAioTask::LatDone()
+{
+   if (latBeg)
+      {XrdXrootdLatency::Record(latReq, XrdXrootdLatency::Now() - latBeg,
+                                latSend);
+       latBeg = 0;
+      }
 }
   
 /******************************************************************************/
@@ -77,6 +77,7 @@ virtual bool               CopyL2F(XrdXrootdAioBuff *aioP) = 0;
         int                gdDone() override;
         void               gdFail() override;
         XrdXrootdAioBuff*  getBuff(bool wait);
+        void               LatDone();
         void               SendError(int rc, const char *eText);
         void               SendFSError(int rc);
         bool               Validate(XrdXrootdAioBuff* aioP);
@@ -110,6 +111,10 @@ union  {XrdXrootdAioBuff  *finalRead;  // -> A short read indicating EOF
 
         XrdXrootdResponse  Response;
 
+        long long          latBeg;    // Dispatch time of the request (ns)
+        RAtomic_llong      latSend;   // Time spent sending responses (ns)
+        int                latReq;    // Request opcode
+
 // These values may be present in aioState
 //
 static const int aioDead = 0x01;      // This aio encountered a fatal link error
@@ -28,6 +28,7 @@
 /******************************************************************************/
  
 #include <unistd.h>
+#include <algorithm>
 #include <cctype>
 #include <fcntl.h>
 #include <string>
@@ -66,11 +67,13 @@
 #include "XrdTls/XrdTlsContext.hh"
 
 #include "XrdXrootd/XrdXrootdAdmin.hh"
+#include "XrdXrootd/XrdXrootdAioArena.hh"
 #include "XrdXrootd/XrdXrootdCallBack.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
 #include "XrdXrootd/XrdXrootdFileLock.hh"
 #include "XrdXrootd/XrdXrootdFileLock1.hh"
 #include "XrdXrootd/XrdXrootdJob.hh"
+#include "XrdXrootd/XrdXrootdPgrwAio.hh"
 #include "XrdXrootd/XrdXrootdPrepare.hh"
 #include "XrdXrootd/XrdXrootdProtocol.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
@@ -362,6 +365,16 @@ int XrdXrootdProtocol::Configure(char *parms, XrdProtocol_Config *pi)
 //
    if (as_segsize > 65536) as_okstutter = as_segsize/65536;
 
+// Create the aio buffer arena if one was wanted. Slots must also be able to
+// hold a pgio buffer and are page aligned for direct I/O.
+//
+   if (as_arena && as_aioOK)
+      {int slotsz = std::max(as_segsize, (int)XrdXrootdPgrwAio::aioSZ);
+       slotsz = (slotsz + 4095) & ~4095;
+       if (!XrdXrootdAioArena::Init(as_arena, as_segsize, slotsz, eDest))
+          return 0;
+      }
+
 // Establish final sendfile processing mode. This may be turned off by the
 // link or by the SFS plugin usually because it's a proxy.
 //
@@ -797,7 +810,7 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
    Purpose:  To parse directive: async [limit <aiopl>] [maxsegs <msegs>]
                                        [maxtot <mtot>] [segsize <segsize>]
                                        [minsize <iosz>] [maxstalls <cnt>]
-                                       [timeout <tos>]
+                                       [timeout <tos>] [arena <asz>]
                                        [Debug] [force] [syncw] [off]
                                        [nocache] [nosf]
 
@@ -814,6 +827,8 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
              <tos>    second timeout for async I/O.
              <cnt>    Maximum number of client stalls before synchronous i/o is
                       used. Async mode is tried after <cnt> requests.
+             <asz>    size of a preallocated, huge page backed, arena of aio
+                      buffers. The default is to have no arena.
              Debug    Turns on async I/O for everything. This an internal
                       undocumented option used for testing purposes.
              force    Uses async i/o for all requests, even when not explicitly
@@ -857,7 +872,18 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
        {eDest.Emsg("Config", "async option not specified"); return 1;}
 
     while (val)
-         {for (i = 0; i < numopts; i++)
+         {if (!strcmp(val, "arena"))
+             {if (!(val = Config.GetWord()))
+                 {eDest.Emsg("Config", "async arena value not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2sz(eDest, "async arena", val, &llp,
+                                  2*1024*1024)) return 1;
+              as_arena = llp;
+              val = Config.GetWord();
+              continue;
+             }
+          for (i = 0; i < numopts; i++)
               if (!strcmp(val, asopts[i].opname))
                  {if (asopts[i].minv >=  0 && !(val = Config.GetWord()))
                      {eDest.Emsg("Config","async",(char *)asopts[i].opname,
@@ -1972,6 +1998,7 @@ int XrdXrootdProtocol::xtlsr(XrdOucStream &Config)
                 else if (num > XrdTlsContext::scFMax)
                          num = XrdTlsContext::scFMax;
              tlsCache |= num;
+             return 0;
             }
       }
 
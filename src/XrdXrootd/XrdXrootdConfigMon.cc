@@ -65,13 +65,15 @@ struct MonParms
        int   monFSint;
        int   monFSopt;
        int   monFSion;
+       int   monSendQ;
 
        void  Exported() {monDest[0] = monDest[1] = 0;}
 
              MonParms() : monDest{0,0}, monMode{0,0},  monFlash(0), monFlush(0),
                           monGBval(0),  monMBval(0),   monRBval(0), monWWval(0),
                           monFbsz(0),   monIdent(3600),monRnums(0),
-                          monFSint(0),  monFSopt(0),   monFSion(0) {}
+                          monFSint(0),  monFSopt(0),   monFSion(0),
+                          monSendQ(-1) {}
             ~MonParms() {if (monDest[0]) free(monDest[0]);
                          if (monDest[1]) free(monDest[1]);
                         }
@@ -149,7 +151,8 @@ bool XrdXrootdProtocol::ConfigMon(XrdProtocol_Config *pi, XrdOucEnv &xrootdEnv)
    XrdXrootdMonitor::Defaults(MP->monMBval, MP->monRBval, MP->monWWval,
                               MP->monFlush, MP->monFlash, MP->monIdent,
                               MP->monRnums, MP->monFbsz,
-                              MP->monFSint, MP->monFSopt, MP->monFSion);
+                              MP->monFSint, MP->monFSopt, MP->monFSion,
+                              MP->monSendQ);
 
 // Complete destination dependent setup
 //
@@ -189,8 +192,8 @@ bool XrdXrootdProtocol::ConfigMon(XrdProtocol_Config *pi, XrdOucEnv &xrootdEnv)
                                       [fstat <sec> [lfn] [ops] [ssq] [xfr <n>]
                                       [{fbuff | fbsz} <sz>] [gbuff <sz>]
                                       [ident {<sec>|off}] [mbuff <sz>]
-                                      [rbuff <sz>] [rnums <cnt>] [window <sec>]
-                                      [dest [Events] <host:port>]
+                                      [rbuff <sz>] [rnums <cnt>] [sendq <n>]
+                                      [window <sec>] [dest [Events] <host:port>]
 
    Events: [ccm] [files] [fstat] [info] [io] [iov] [pfc] [redir] [tcpmon] [throttle] [user]
 
@@ -212,6 +215,10 @@ bool XrdXrootdProtocol::ConfigMon(XrdProtocol_Config *pi, XrdOucEnv &xrootdEnv)
          mbuff  <sz>        size of message buffer for event trace monitoring.
          rbuff  <sz>        size of message buffer for redirection monitoring.
          rnums  <cnt>       bumber of redirections monitoring streams.
+         sendq  <n>         records each thread may queue for the monitor
+                            sender thread before further ones are dropped.
+                            A value of 0, the default, sends records
+                            synchronously.
          window <sec>       time (seconds, M, H) between timing marks.
          dest               specified routing information. Up to two dests
                             may be specified.
@@ -330,6 +337,14 @@ int XrdXrootdProtocol::xmon(XrdOucStream &Config)
                  if (XrdOuca2x::a2i(eDest,"monitor rnums",val, &MP->monRnums,1,
                                     XrdXrootdMonitor::rdrMax)) return 1;
                 }
+          else if (!strcmp("sendq", val))
+                {if (!(val = Config.GetWord()))
+                    {eDest.Emsg("Config", "monitor sendq value not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2i(eDest,"monitor sendq",val, &MP->monSendQ,0,
+                                    65536)) return 1;
+                }
           else if (!strcmp("window", val))
                 {if (!(val = Config.GetWord()))
                     {eDest.Emsg("Config", "monitor window value not specified");
@@ -29,7 +29,7 @@
 
 #include <cstdlib>
 
-#include "XrdOuc/XrdOucHash.hh"
+#include "XrdOuc/XrdOucFlatHash.hh"
 
 #include "XrdXrootd/XrdXrootdFileLock1.hh"
  
@@ -67,7 +67,7 @@ XrdSysMutex *mp;
 /*                               G l o b a l s                                */
 /******************************************************************************/
   
-XrdOucHash<XrdXrootdFileLockInfo> XrdXrootdLockTable;
+XrdOucFlatHash<XrdXrootdFileLockInfo> XrdXrootdLockTable;
 
 XrdSysMutex  XrdXrootdFileLock1::LTMutex;
 
@@ -0,0 +1,203 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d L a t e n c y . c c                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#include "XProtocol/XProtocol.hh"
+#include "XrdSys/XrdSysMetrics.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdXrootd/XrdXrootdLatency.hh"
+
+/******************************************************************************/
+/*                           L o c a l   D a t a                              */
+/******************************************************************************/
+
+namespace
+{
+// The request being dispatched by this thread, if any, and the time this
+// thread has spent sending responses.
+//
+struct ReqState
+      {long long begNS;
+       long long sendNS;
+       int       reqID;
+       bool      active;
+      };
+
+thread_local ReqState myReq = {0, 0, 0, false};
+
+const int numOps = kXR_REQFENCE - kXR_auth;
+
+// Histograms are only created for opcodes actually seen. Creation is rare and
+// serialized; lookups are lock-free.
+//
+typedef XrdSysMetrics::Histogram Hist;
+
+std::atomic<Hist *> totHist[numOps];
+std::atomic<Hist *> sndHist[numOps];
+XrdSysMutex         histMutex;
+
+void getHist(int opx, Hist *&totP, Hist *&sndP)
+{
+   if ((totP = totHist[opx].load(std::memory_order_acquire)))
+      {sndP = sndHist[opx].load(std::memory_order_relaxed);
+       return;
+      }
+
+   XrdSysMutexHelper mHelp(histMutex);
+   if (!(totP = totHist[opx].load(std::memory_order_relaxed)))
+      {char buff[64];
+       snprintf(buff, sizeof(buff), "op=\"%s\"",
+                XProtocol::reqName(static_cast<kXR_unt16>(opx + kXR_auth)));
+       const char *label = strdup(buff);
+       sndP = new Hist("xrootd_request_send_seconds",
+                       "Time spent sending request responses.", label);
+       totP = new Hist("xrootd_request_seconds",
+                       "Time from request dispatch to final response.", label);
+       sndHist[opx].store(sndP, std::memory_order_relaxed);
+       totHist[opx].store(totP, std::memory_order_release);
+      } else sndP = sndHist[opx].load(std::memory_order_relaxed);
+}
+
+// Return the upper edge, in microseconds, of the bin holding the q quantile.
+//
+long long Quantile(const long long *bins, long long count, double q)
+{
+   long long want = static_cast<long long>(q * count + 0.5), seen = 0;
+   int i;
+
+   if (want < 1) want = 1;
+   for (i = 0; i < Hist::numBins-1; i++)
+       if ((seen += bins[i]) >= want) break;
+   return static_cast<long long>(Hist::BinUpper(i));
+}
+}
+
+/******************************************************************************/
+/*                               A d d S e n d                                */
+/******************************************************************************/
+
+void XrdXrootdLatency::AddSend(long long nsec) {myReq.sendNS += nsec;}
+
+/******************************************************************************/
+/*                                 D e f e r                                  */
+/******************************************************************************/
+
+long long XrdXrootdLatency::Defer(int &reqID)
+{
+   if (!myReq.active) return 0;
+   myReq.active = false;
+   reqID = myReq.reqID;
+   return myReq.begNS;
+}
+
+/******************************************************************************/
+/*                                R e c o r d                                 */
+/******************************************************************************/
+
+void XrdXrootdLatency::Record(int reqID, long long totNS, long long sendNS)
+{
+   Hist *totP, *sndP;
+   int opx = reqID - kXR_auth;
+
+   if (opx < 0 || opx >= numOps) return;
+   getHist(opx, totP, sndP);
+   totP->Record(totNS);
+   sndP->Record(sendNS);
+}
+
+/******************************************************************************/
+/*                              S e n d T i m e                               */
+/******************************************************************************/
+
+long long XrdXrootdLatency::SendTime() {return myReq.sendNS;}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdXrootdLatency::Stats(char *buff, int blen)
+{
+   static const char hdr[] = "<stats id=\"lat\">";
+   static const char trl[] = "</stats>";
+   static const char opfmt[] = "<op id=\"%s\"><n>%lld</n><avg>%lld</avg>"
+                               "<p50>%lld</p50><p99>%lld</p99>"
+                               "<snd>%lld</snd></op>";
+   long long bins[Hist::numBins], tCnt, tSum, sCnt, sSum;
+   Hist *totP, *sndP;
+   int n, len;
+
+// If no buffer, caller wants the maximum size we will generate. Times are
+// in microseconds and averages are over the life of the server.
+//
+   if (!buff) return sizeof(hdr) + sizeof(trl) + numOps*(sizeof(opfmt)+16*5);
+   if (blen <= static_cast<int>(sizeof(hdr) + sizeof(trl))) return 0;
+
+   len = strlcpy(buff, hdr, blen);
+   for (int i = 0; i < numOps; i++)
+       {if (!(totP = totHist[i].load(std::memory_order_acquire))) continue;
+        sndP = sndHist[i].load(std::memory_order_relaxed);
+        sndP->Read(sCnt, sSum, bins);
+        totP->Read(tCnt, tSum, bins);
+        if (!tCnt) continue;
+        n = snprintf(buff+len, blen-len, opfmt,
+                     XProtocol::reqName(static_cast<kXR_unt16>(i + kXR_auth)),
+                     tCnt, tSum/tCnt/1000, Quantile(bins, tCnt, 0.50),
+                     Quantile(bins, tCnt, 0.99),
+                     (sCnt ? sSum/sCnt/1000 : 0));
+        if (n >= blen - len - static_cast<int>(sizeof(trl))) break;
+        len += n;
+       }
+   len += strlcpy(buff+len, trl, blen-len);
+   return len;
+}
+
+/******************************************************************************/
+/*                                 T i m e r                                  */
+/******************************************************************************/
+
+XrdXrootdLatency::Timer::Timer(int reqID)
+{
+   myReq.begNS  = Now();
+   myReq.sendNS = 0;
+   myReq.reqID  = reqID;
+   myReq.active = true;
+}
+
+XrdXrootdLatency::Timer::~Timer()
+{
+   if (myReq.active)
+      {myReq.active = false;
+       Record(myReq.reqID, Now() - myReq.begNS, myReq.sendNS);
+      }
+}
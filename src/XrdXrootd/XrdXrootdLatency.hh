@@ -0,0 +1,93 @@
+#ifndef __XRDXROOTDLATENCY__
+#define __XRDXROOTDLATENCY__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d L a t e n c y . h h                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <ctime>
+
+/******************************************************************************/
+/*                C l a s s   X r d X r o o t d L a t e n c y                 */
+/******************************************************************************/
+
+// Per-opcode request latency. The time from dispatching a request to its final
+// response is recorded in one histogram per opcode, and the part of it spent
+// sending the response over the network in another, so that filesystem time
+// and network time can be told apart. Requests completed by an aio task are
+// recorded when the task finishes rather than when dispatch returns.
+//
+// The histograms are registered with XrdSysMetrics and summarized in the
+// stats report (and hence the summary monitoring stream).
+
+class XrdXrootdLatency
+{
+public:
+
+// Current time in nanoseconds on the monotonic clock.
+//
+static inline long long Now()
+                  {struct timespec ts;
+                   clock_gettime(CLOCK_MONOTONIC, &ts);
+                   return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+                  }
+
+// Time the calling thread has spent sending responses, in nanoseconds.
+//
+static long long SendTime();
+
+// Add to the calling thread's send time.
+//
+static void      AddSend(long long nsec);
+
+// Called by an aio task as it takes over the request being dispatched. It
+// returns the time the request was dispatched (0 if none is being timed) and
+// the request's opcode; the request is then no longer recorded at dispatch.
+//
+static long long Defer(int &reqID);
+
+// Record the latency of a request.
+//
+static void      Record(int reqID, long long totNS, long long sendNS);
+
+// Format the latency summary for the stats report. When buff is nil, the
+// maximum length is returned.
+//
+static int       Stats(char *buff, int blen);
+
+// Times the dispatch of a request. The request is recorded when the timer
+// goes out of scope unless an aio task took it over.
+//
+class Timer
+{
+public:
+        Timer(int reqID);
+       ~Timer();
+};
+};
+#endif
@@ -0,0 +1,362 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d X r o o t d M o n Q u e u e . c c                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "XrdNet/XrdNetMsg.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysMetrics.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdXrootd/XrdXrootdMonData.hh"
+#include "XrdXrootd/XrdXrootdMonQueue.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+struct MonRec
+      {char *data;
+       int   blen;
+       int   mode;
+       bool  setseq;
+      };
+
+// A single-producer single-consumer ring. Only the owning thread advances
+// tail and only the sender advances head. Rings are pushed onto the front of
+// ringList by their owners and only ever unlinked by the sender, which never
+// unlinks the front element; so the list itself needs no lock either.
+//
+struct MonRing
+      {std::atomic<unsigned int> head;
+       std::atomic<unsigned int> tail;
+       std::atomic<bool>         orphan;
+       unsigned int              mask;
+       MonRec                   *slot;
+       MonRing                  *next;
+
+       MonRing(unsigned int n) : head(0), tail(0), orphan(false),
+                                 mask(n-1), slot(new MonRec[n]), next(0) {}
+      ~MonRing() {unsigned int h = head, t = tail;
+                  while(h != t) free(slot[(h++) & mask].data);
+                  delete [] slot;
+                 }
+      };
+
+// Marks the calling thread's ring for reclamation when the thread exits.
+//
+struct MonRingRef
+      {MonRing *ring;
+       MonRingRef() : ring(0) {}
+      ~MonRingRef() {if (ring) ring->orphan.store(true, std::memory_order_release);}
+      };
+
+thread_local MonRingRef    myRing;
+
+std::atomic<MonRing *>     ringList(0);
+std::atomic<long long>     numDropped(0);
+std::atomic<long long>     numSent(0);
+
+XrdSysError               *eDest   = 0;
+unsigned int               ringSize= 256;
+XrdNetMsg                 *Dest[2] = {0, 0};
+int                        Mode[2] = {0, 0};
+
+// When every ring is empty the sender sets sndIdle and sleeps on sndWake
+// until a producer, seeing the flag after publishing a record, wakes it up.
+//
+XrdSysCondVar              sndWake(0);
+std::atomic<bool>          sndIdle(false);
+
+// Maximum number of records gathered per batch and the number of seconds
+// between reports of dropped records.
+//
+const int                  batchMax  = 64;
+const int                  rptIntvl  = 60;
+
+long long getDropped(void *) {return numDropped.load(std::memory_order_relaxed);}
+
+long long getSent(void *)    {return numSent.load(std::memory_order_relaxed);}
+}
+
+/******************************************************************************/
+/*                     S t a t i c   A l l o c a t i o n                      */
+/******************************************************************************/
+
+bool XrdXrootdMonQueue::isActive = false;
+
+/******************************************************************************/
+/*                               D r o p p e d                                */
+/******************************************************************************/
+
+long long XrdXrootdMonQueue::Dropped()
+{
+   return numDropped.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************/
+/*                                  P o s t                                   */
+/******************************************************************************/
+  
+bool XrdXrootdMonQueue::Post(int monMode, const void *buff, int blen,
+                             bool setseq)
+{
+   MonRing *rP = myRing.ring;
+   unsigned int tail;
+
+// Allocate a ring for this thread the first time it posts anything
+//
+   if (!rP)
+      {rP = new MonRing(ringSize);
+       rP->next = ringList.load(std::memory_order_relaxed);
+       while(!ringList.compare_exchange_weak(rP->next, rP,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {}
+       myRing.ring = rP;
+      }
+
+// Drop the record if the ring is full (or we cannot copy it)
+//
+   tail = rP->tail.load(std::memory_order_relaxed);
+   if (tail - rP->head.load(std::memory_order_acquire) > rP->mask
+   ||  !(rP->slot[tail & rP->mask].data = (char *)malloc(blen)))
+      {numDropped.fetch_add(1, std::memory_order_relaxed);
+       return false;
+      }
+
+// Fill the slot and publish it
+//
+   MonRec &rec = rP->slot[tail & rP->mask];
+   memcpy(rec.data, buff, blen);
+   rec.blen   = blen;
+   rec.mode   = monMode;
+   rec.setseq = setseq;
+   rP->tail.store(tail+1, std::memory_order_release);
+
+// Wake up the sender if it went to sleep. The fence orders the store above
+// with the load of the flag, pairing with the one in Sender(); so either the
+// sender sees the record or we see that it is idle.
+//
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (sndIdle.load(std::memory_order_relaxed)
+   &&  sndIdle.exchange(false, std::memory_order_relaxed))
+      {sndWake.Lock(); sndWake.Signal(); sndWake.UnLock();}
+   return true;
+}
+
+/******************************************************************************/
+/*                                  S e n t                                   */
+/******************************************************************************/
+
+long long XrdXrootdMonQueue::Sent()
+{
+   return numSent.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+  
+bool XrdXrootdMonQueue::Start(XrdSysError *eP, int qDepth,
+                              XrdNetMsg *dest1, int mode1,
+                              XrdNetMsg *dest2, int mode2)
+{
+   pthread_t tid;
+
+// Set the parameters
+//
+   eDest   = eP;
+   ringSize= 2;
+   while(ringSize < static_cast<unsigned int>(qDepth)) ringSize <<= 1;
+   Dest[0] = dest1; Mode[0] = mode1;
+   Dest[1] = dest2; Mode[1] = mode2;
+
+// Start the sender
+//
+   if (XrdSysThread::Run(&tid, XrdXrootdMonQueue::Sender, 0, 0,
+                         "Monitor sender"))
+      {eDest->Emsg("MonQueue", errno, "start monitor sender");
+       return false;
+      }
+   isActive = true;
+
+// Make the counters available to metrics scrapers
+//
+   new XrdSysMetrics::Probe("xrootd_monitor_records_sent_total",
+                            "Monitor records sent to a collector.",
+                            XrdSysMetrics::isCounter, getSent);
+   new XrdSysMetrics::Probe("xrootd_monitor_records_dropped_total",
+                            "Monitor records dropped as a queue was full "
+                            "or a send failed.",
+                            XrdSysMetrics::isCounter, getDropped);
+   return true;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                S e n d e r                                 */
+/******************************************************************************/
+  
+namespace
+{
+void Transmit(MonRec *recs, int n)
+{
+   static unsigned char seq[2] = {0, 0};
+   XrdXrootdMonHeader hdrs[batchMax];
+   struct iovec       iov[batchMax][2];
+   struct msghdr      msgs[batchMax];
+   int m, k;
+
+// Each destination has its own sequence numbers, so each gets its own copy
+// of the header; the body of the record is shared.
+//
+   for (int d = 0; d < 2; d++)
+       {if (!Dest[d]) continue;
+        for (int i = m = 0; i < n; i++)
+            {if (!(recs[i].mode & Mode[d])) continue;
+             memset(&msgs[m], 0, sizeof(struct msghdr));
+             msgs[m].msg_iov = iov[m];
+             if (recs[i].setseq)
+                {memcpy(&hdrs[m], recs[i].data, sizeof(XrdXrootdMonHeader));
+                 hdrs[m].pseq = seq[d]++;
+                 iov[m][0].iov_base = &hdrs[m];
+                 iov[m][0].iov_len  = sizeof(XrdXrootdMonHeader);
+                 iov[m][1].iov_base = recs[i].data + sizeof(XrdXrootdMonHeader);
+                 iov[m][1].iov_len  = recs[i].blen - sizeof(XrdXrootdMonHeader);
+                 msgs[m].msg_iovlen = 2;
+                } else {
+                 iov[m][0].iov_base = recs[i].data;
+                 iov[m][0].iov_len  = recs[i].blen;
+                 msgs[m].msg_iovlen = 1;
+                }
+             m++;
+            }
+        if (!m) continue;
+        if ((k = Dest[d]->Send(msgs, m)) < 0) k = 0;
+        if (k) numSent.fetch_add(k, std::memory_order_relaxed);
+        if (k < m) numDropped.fetch_add(m - k, std::memory_order_relaxed);
+       }
+
+// Release the records
+//
+   for (int i = 0; i < n; i++) free(recs[i].data);
+}
+
+// Returns true if any ring holds a record.
+//
+bool Pending()
+{
+   MonRing *rP = ringList.load(std::memory_order_acquire);
+
+   while(rP)
+        {if (rP->head.load(std::memory_order_relaxed)
+         !=  rP->tail.load(std::memory_order_acquire)) return true;
+         rP = rP->next;
+        }
+   return false;
+}
+}
+
+/******************************************************************************/
+
+void *XrdXrootdMonQueue::Sender(void *)
+{
+   MonRec    recs[batchMax];
+   MonRing  *rP, *prev;
+   time_t    nextRpt = time(0) + rptIntvl;
+   long long lastDrops = 0, drops;
+   unsigned int h, t;
+   bool orphan;
+   int n, total;
+
+   while(1)
+        {total = n = 0;
+         prev  = 0;
+         rP    = ringList.load(std::memory_order_acquire);
+         while(rP)
+              {orphan = rP->orphan.load(std::memory_order_acquire);
+               h = rP->head.load(std::memory_order_relaxed);
+               t = rP->tail.load(std::memory_order_acquire);
+               while(h != t)
+                    {recs[n++] = rP->slot[(h++) & rP->mask];
+                     if (n == batchMax)
+                        {rP->head.store(h, std::memory_order_release);
+                         Transmit(recs, n); total += n; n = 0;
+                        }
+                    }
+               rP->head.store(h, std::memory_order_release);
+
+            // Reclaim rings of threads that have exited once drained
+            //
+               if (orphan && prev)
+                  {prev->next = rP->next;
+                   delete rP;
+                   rP = prev->next;
+                  } else {prev = rP; rP = rP->next;}
+              }
+         if (n) {Transmit(recs, n); total += n;}
+
+      // Periodically report dropped records
+      //
+         if (time(0) >= nextRpt)
+            {drops = numDropped.load(std::memory_order_relaxed);
+             if (drops != lastDrops)
+                {char buff[80];
+                 snprintf(buff, sizeof(buff), "%lld monitor records dropped;",
+                          drops - lastDrops);
+                 eDest->Emsg("MonQueue", buff, "consider increasing sendq.");
+                 lastDrops = drops;
+                }
+             nextRpt = time(0) + rptIntvl;
+            }
+
+      // Sleep until a record is posted, checking the rings once more after
+      // announcing it so that a record published meanwhile is not missed.
+      // Waking up at the report interval keeps the drop reports going.
+      //
+         if (!total)
+            {sndWake.Lock();
+             sndIdle.store(true, std::memory_order_relaxed);
+             std::atomic_thread_fence(std::memory_order_seq_cst);
+             if (!Pending()) sndWake.Wait(rptIntvl);
+             sndIdle.store(false, std::memory_order_relaxed);
+             sndWake.UnLock();
+            }
+        }
+   return 0;
+}
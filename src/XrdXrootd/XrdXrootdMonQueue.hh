@@ -0,0 +1,83 @@
+#ifndef __XRDXROOTDMONQUEUE__
+#define __XRDXROOTDMONQUEUE__
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d X r o o t d M o n Q u e u e . h h                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+class XrdNetMsg;
+class XrdSysError;
+
+/******************************************************************************/
+/*               C l a s s   X r d X r o o t d M o n Q u e u e                */
+/******************************************************************************/
+
+// Monitoring records are normally sent by whatever thread fills a buffer,
+// adding the UDP send to the latency of the client request that did so. When
+// the queue is started, each thread instead copies its records into its own
+// lock-free ring and a dedicated sender thread drains all of the rings,
+// batching the records to each collector into as few system calls as possible.
+// When a thread's ring is full the record is dropped and counted; the request
+// is never made to wait on the network.
+  
+class XrdXrootdMonQueue
+{
+public:
+
+// Returns true if records are being queued for the sender thread.
+//
+static bool      Active() {return isActive;}
+
+// Queue a copy of a record (which must start with a XrdXrootdMonHeader) for
+// the destinations enabled for monMode. When setseq is true, the sender
+// fills in the per-destination sequence number. Returns false if the record
+// was dropped because the calling thread's ring was full.
+//
+static bool      Post(int monMode, const void *buff, int blen, bool setseq);
+
+// Number of records dropped, because a ring was full or the send failed, and
+// the number actually sent. A record going to both collectors counts twice.
+//
+static long long Dropped();
+
+static long long Sent();
+
+// Start the sender thread. Each thread may have up to qDepth records queued
+// (rounded up to a power of two). Returns false if it could not be started.
+//
+static bool      Start(XrdSysError *eP, int qDepth,
+                       XrdNetMsg *dest1, int mode1,
+                       XrdNetMsg *dest2, int mode2);
+
+private:
+
+static void     *Sender(void *);
+
+static bool      isActive;
+};
+#endif
@@ -46,6 +46,7 @@
 #include "Xrd/XrdScheduler.hh"
 #include "XrdXrootd/XrdXrootdMonitor.hh"
 #include "XrdXrootd/XrdXrootdMonFile.hh"
+#include "XrdXrootd/XrdXrootdMonQueue.hh"
 #include "XrdXrootd/XrdXrootdTrace.hh"
 
 /******************************************************************************/
@@ -77,6 +78,7 @@ int                XrdXrootdMonitor::autoFlash  = 0;
 int                XrdXrootdMonitor::autoFlush  = 600;
 int                XrdXrootdMonitor::FlushTime  = 0;
 int                XrdXrootdMonitor::monIdent   = 3600;
+int                XrdXrootdMonitor::monSendQ   = 0;
 kXR_int32          XrdXrootdMonitor::currWindow = 0;
 int                XrdXrootdMonitor::rdrTOD     = 0;
 int                XrdXrootdMonitor::rdrWin     = 0;
@@ -529,7 +531,8 @@ void XrdXrootdMonitor::Defaults(char *dest1, int mode1, char *dest2, int mode2)
 
 void XrdXrootdMonitor::Defaults(int msz,   int rsz,   int wsz,
                                 int flush, int flash, int idt, int rnm,
-                                int fbsz, int fsint, int fsopt, int fsion)
+                                int fbsz, int fsint, int fsopt, int fsion,
+                                int sndq)
 {
 
 // Set default window size and flush time
@@ -541,6 +544,7 @@ void XrdXrootdMonitor::Defaults(int msz,   int rsz,   int wsz,
    rdrNum     = (rnm   <= 0 || rnm > rdrMax ? 3 : rnm);
    rdrWin     = (sizeWindow > 16777215 ? 16777215 : sizeWindow);
    rdrWin     = htonl(rdrWin);
+   monSendQ   = (sndq  < 0 ?   0 : sndq);
 
 // Set the fstat defaults
 //
@@ -755,6 +759,14 @@ int XrdXrootdMonitor::Init()
           }
       }
 
+// Unless records are to be sent synchronously, start the sender thread. We
+// must do this before anything is sent so that sequence numbers are in order.
+//
+   if (monSendQ > 0 && (InetDest1 || InetDest2)
+   &&  !XrdXrootdMonQueue::Start(eDest, monSendQ, InetDest1, monMode1,
+                                                  InetDest2, monMode2))
+      eDest->Emsg("Monitor", "Monitor records will be sent synchronously.");
+
 // Now schedule the first identification record
 //
    if (Sched && monIdent >= 0) Sched->Schedule((XrdJob *)&MonIdent);
@@ -1205,6 +1217,12 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
     XrdXrootdMonHeader *mHdr=0;
     int rc1, rc2;
 
+// If records are queued for the sender thread, hand over a copy. If this
+// thread's queue is full, the record is dropped rather than have us wait.
+//
+   if (XrdXrootdMonQueue::Active())
+      return (XrdXrootdMonQueue::Post(monMode, buff, blen, setseq) ? 0 : 1);
+
 // If we are to set sequence numbers, recast the buffer. We are assured that
 // the buffer always starts with the standard monitor header.
 //
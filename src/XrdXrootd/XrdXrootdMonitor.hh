@@ -118,7 +118,8 @@ inline void              Add_wr(kXR_unt32 dictid,
 static void              Defaults(char *dest1, int m1, char *dest2, int m2);
 static void              Defaults(int msz,     int rsz,     int wsz,
                                   int flush,   int flash,   int iDent, int rnm,
-                                  int fbsz, int fsint=0, int fsopt=0, int fsion=0);
+                                  int fbsz, int fsint=0, int fsopt=0, int fsion=0,
+                                  int sndq=-1);
 
 static int               Flushing() {return autoFlush;}
 
@@ -297,6 +298,7 @@ static kXR_int32          sizeWindow;
 static int                isEnabled;
 static int                numMonitor;
 static int                monIdent;
+static int                monSendQ;
 static int                monRlen;
 static char               monIO;
 static char               monINFO;
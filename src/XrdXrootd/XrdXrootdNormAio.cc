@@ -40,6 +40,7 @@
 #include "XrdXrootd/XrdXrootdAioBuff.hh"
 #include "XrdXrootd/XrdXrootdAioFob.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
+#include "XrdXrootd/XrdXrootdLatency.hh"
 #include "XrdXrootd/XrdXrootdNormAio.hh"
 #include "XrdXrootd/XrdXrootdTrace.hh"
 
@@ -415,7 +416,8 @@ void XrdXrootdNormAio::Recycle(bool release)
 // Update request count, file and link reference count
 //
    if (!(aioState & aioHeld))
-      {Protocol->aioUpdReq(-1);
+      {LatDone();
+       Protocol->aioUpdReq(-1);
        if (aioState & aioRead)
           {dataFile->Ref(-1);
            dataLink->setRef(-1);
@@ -453,6 +455,7 @@ void XrdXrootdNormAio::Recycle(bool release)
 bool XrdXrootdNormAio::Send(XrdXrootdAioBuff *aioP, bool final)
 {
    XResponseType code = (final ? kXR_ok : kXR_oksofar);
+   long long sndBeg = XrdXrootdLatency::SendTime();
    int rc;
 
 // Send the data (note that no data means it's a finalresponse)
@@ -461,6 +464,7 @@ bool XrdXrootdNormAio::Send(XrdXrootdAioBuff *aioP, bool final)
       {rc = Response.Send(code,(void*)aioP->sfsAio.aio_buf,aioP->Result);
        sendOffset = aioP->sfsAio.aio_offset + aioP->Result;
       } else rc = Response.Send();
+   latSend += XrdXrootdLatency::SendTime() - sndBeg;
 
 // Diagnose any errors
 //
@@ -42,6 +42,7 @@
 #include "XrdXrootd/XrdXrootdAioFob.hh"
 #include "XrdXrootd/XrdXrootdAioPgrw.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
+#include "XrdXrootd/XrdXrootdLatency.hh"
 #include "XrdXrootd/XrdXrootdPgrwAio.hh"
 #include "XrdXrootd/XrdXrootdPgwBadCS.hh"
 #include "XrdXrootd/XrdXrootdTrace.hh"
@@ -392,7 +393,8 @@ void XrdXrootdPgrwAio::Recycle(bool release)
 // Update request count, file and link reference count
 //
    if (!(aioState & aioHeld))
-       {Protocol->aioUpdReq(-1);
+       {LatDone();
+        Protocol->aioUpdReq(-1);
         if (aioState & aioRead)
            {dataLink->setRef(-1);
             dataFile->Ref(-1);
@@ -433,6 +435,7 @@ bool XrdXrootdPgrwAio::SendData(XrdXrootdAioBuff *bP, bool final)
          {ServerResponseStatus rsp;
           kXR_int64            ofs;
          } pgrResp;
+   long long sndBeg = XrdXrootdLatency::SendTime();
    int rc;
 
 // Preinitialize the header
@@ -458,6 +461,7 @@ bool XrdXrootdPgrwAio::SendData(XrdXrootdAioBuff *bP, bool final)
        pgrResp.ofs          = htonll(dataOffset);
        rc = Response.Send(pgrResp.rsp, infoLen);
       }
+   latSend += XrdXrootdLatency::SendTime() - sndBeg;
 
 // Diagnose any errors
 //
@@ -479,6 +483,7 @@ int XrdXrootdPgrwAio::SendDone()
    struct {ServerResponseStatus       rsp;
            ServerResponseBody_pgWrite info;  // info.offset
           } pgwResp;
+   long long sndBeg = XrdXrootdLatency::SendTime();
    char *buff;
    int n, rc;
 
@@ -496,6 +501,7 @@ int XrdXrootdPgrwAio::SendDone()
 // Send the final response
 //
    if ((rc = Response.Send(pgwResp.rsp, infoLen, buff, n))) dataLen = 0;
+   latSend += XrdXrootdLatency::SendTime() - sndBeg;
    isDone = true;
    if (rc) aioState |= aioDead;
    return rc;
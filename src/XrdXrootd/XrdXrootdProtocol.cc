@@ -50,6 +50,7 @@
 #include "XrdXrootd/XrdXrootdFile.hh"
 #include "XrdXrootd/XrdXrootdFileLock.hh"
 #include "XrdXrootd/XrdXrootdFileLock1.hh"
+#include "XrdXrootd/XrdXrootdLatency.hh"
 #include "XrdXrootd/XrdXrootdMonFile.hh"
 #include "XrdXrootd/XrdXrootdMonitor.hh"
 #include "XrdXrootd/XrdXrootdPio.hh"
@@ -115,6 +116,7 @@ int                   XrdXrootdProtocol::maxBuffsz;
 int                   XrdXrootdProtocol::maxTransz    = 262144; // 256KB
 int                   XrdXrootdProtocol::maxReadv_ior =
                       XrdXrootdProtocol::maxTransz-(int)sizeof(readahead_list);
+long long             XrdXrootdProtocol::as_arena     = 0;   // No aio arena
 int                   XrdXrootdProtocol::as_maxperlnk = 8;   // Max ops per link
 int                   XrdXrootdProtocol::as_maxperreq = 8;   // Max ops per request
 int                   XrdXrootdProtocol::as_maxpersrv = 4096;// Max ops per server
@@ -436,6 +438,10 @@ int XrdXrootdProtocol::Process(XrdLink *lp) // We ignore the argument here
   
 int XrdXrootdProtocol::Process2()
 {
+// Time the request until we return (or until an aio task takes it over)
+//
+   XrdXrootdLatency::Timer latTimer(Request.header.requestid);
+
 // If we are verifying requests, see if this request needs to be verified
 //
    if (sigNeed)
@@ -215,6 +215,7 @@ static const int     maxStreams = 16;
 
 // async configuration values (referenced outside this class)
 //
+static long long     as_arena;     // Size of the aio buffer arena
 static int           as_maxperlnk; // Max async requests per link
 static int           as_maxperreq; // Max async ops per request
 static int           as_maxpersrv; // Max async ops per server
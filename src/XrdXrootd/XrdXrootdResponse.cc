@@ -35,6 +35,7 @@
 
 #include "Xrd/XrdLinkCtl.hh"
 #include "XrdOuc/XrdOucCRC.hh"
+#include "XrdXrootd/XrdXrootdLatency.hh"
 #include "XrdXrootd/XrdXrootdResponse.hh"
 #define TRACELINK Link
 #include "XrdXrootd/XrdXrootdTrace.hh"
@@ -56,6 +57,18 @@ const char *XrdXrootdResponse::TraceID = "Response";
 namespace
 {
 const char *sName[] = {"final ", "partial ", "progress "};
+
+// Send over the link, charging the time taken to the thread's send time so
+// that request latency can be split between filesystem and network.
+//
+template<typename... Args>
+inline int timedSend(XrdLink *lP, Args... args)
+{
+   long long tBeg = XrdXrootdLatency::Now();
+   int rc = lP->Send(args...);
+   XrdXrootdLatency::AddSend(XrdXrootdLatency::Now() - tBeg);
+   return rc;
+}
 }
 
 /******************************************************************************/
@@ -76,7 +89,7 @@ int XrdXrootdResponse::Send()
     Resp.status = isOK;
     Resp.dlen   = 0;
 
-    if (Link->Send((char *)&Resp, sizeof(Resp)) < 0)
+    if (timedSend(Link, (char *)&Resp, sizeof(Resp)) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -100,7 +113,7 @@ int XrdXrootdResponse::Send(const char *msg)
     Resp.status        = isOK;
     Resp.dlen          = static_cast<kXR_int32>(htonl(RespIO[1].iov_len));
 
-    if (Link->Send(RespIO, 2, sizeof(Resp) + RespIO[1].iov_len) < 0)
+    if (timedSend(Link, RespIO, 2, sizeof(Resp) + RespIO[1].iov_len) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -123,7 +136,7 @@ int XrdXrootdResponse::Send(XResponseType rcode, void *data, int dlen)
     Resp.status        = static_cast<kXR_unt16>(htons(rcode));
     Resp.dlen          = static_cast<kXR_int32>(htonl(dlen));
 
-    if (Link->Send(RespIO, 2, sizeof(Resp) + dlen) < 0)
+    if (timedSend(Link, RespIO, 2, sizeof(Resp) + dlen) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -149,7 +162,7 @@ int XrdXrootdResponse::Send(XResponseType rcode,
     Resp.status        = static_cast<kXR_unt16>(htons(rcode));
     Resp.dlen          = static_cast<kXR_int32>(htonl(dlen));
 
-    if (Link->Send(IOResp, iornum, sizeof(Resp) + dlen) < 0)
+    if (timedSend(Link, IOResp, iornum, sizeof(Resp) + dlen) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -177,7 +190,7 @@ int XrdXrootdResponse::Send(XResponseType rcode, int info,
     Resp.status        = static_cast<kXR_unt16>(htons(rcode));
     Resp.dlen          = static_cast<kXR_int32>(htonl((dlen+sizeof(xbuf))));
 
-    if (Link->Send(RespIO, 3, sizeof(Resp) + dlen + sizeof(xbuf)) < 0)
+    if (timedSend(Link, RespIO, 3, sizeof(Resp) + dlen + sizeof(xbuf)) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -201,7 +214,7 @@ int XrdXrootdResponse::Send(void *data, int dlen)
     Resp.status        = isOK;
     Resp.dlen          = static_cast<kXR_int32>(htonl(dlen));
 
-    if (Link->Send(RespIO, 2, sizeof(Resp) + dlen) < 0)
+    if (timedSend(Link, RespIO, 2, sizeof(Resp) + dlen) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -228,7 +241,7 @@ int XrdXrootdResponse::Send(struct iovec *IOResp, int iornum, int iolen)
     Resp.status        = isOK;
     Resp.dlen          = static_cast<kXR_int32>(htonl(dlen));
 
-    if (Link->Send(IOResp, iornum, sizeof(Resp) + dlen) < 0)
+    if (timedSend(Link, IOResp, iornum, sizeof(Resp) + dlen) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -256,7 +269,7 @@ int XrdXrootdResponse::Send(XErrorCode ecode, const char *msg)
     Resp.status        = static_cast<kXR_unt16>(htons(kXR_error));
     Resp.dlen          = static_cast<kXR_int32>(htonl(dlen));
 
-    if (Link->Send(RespIO, 3, sizeof(Resp) + dlen) < 0)
+    if (timedSend(Link, RespIO, 3, sizeof(Resp) + dlen) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -291,7 +304,7 @@ int XrdXrootdResponse::Send(int fdnum, long long offset, int dlen)
 
 // Send off the request
 //
-    if (Link->Send(myVec, 2) < 0)
+    if (timedSend(Link, myVec, 2) < 0)
        return Link->setEtext("sendfile failure");
     return 0;
 }
@@ -319,7 +332,7 @@ int XrdXrootdResponse::Send(XrdOucSFVec *sfvec, int sfvnum, int dlen)
 
 // Send off the request
 //
-    if (Link->Send(sfvec, sfvnum) < 0)
+    if (timedSend(Link, sfvec, sfvnum) < 0)
        return Link->setEtext("sendfile failure");
     return 0;
 }
@@ -331,7 +344,7 @@ int XrdXrootdResponse::Send(ServerResponseStatus &srs, int iLen)
 
 // Fill out the status structure and send this off
 //
-    if (Link->Send((char *)&srs, srsComplete(srs, iLen)) < 0)
+    if (timedSend(Link, (char *)&srs, srsComplete(srs, iLen)) < 0)
        return Link->setEtext("send failure");
     return 0;
 }
@@ -345,13 +358,13 @@ int XrdXrootdResponse::Send(ServerResponseStatus &srs, int iLen,
 
 // Send off the appropriate response
 //
-    if (!dlen) rc = Link->Send((char *)&srs, srsComplete(srs, iLen));
+    if (!dlen) rc = timedSend(Link, (char *)&srs, srsComplete(srs, iLen));
        else {struct iovec srsIOV[2];
              srsIOV[0].iov_base = &srs;
              srsIOV[0].iov_len  = srsComplete(srs, iLen, dlen);
              srsIOV[1].iov_base = (caddr_t)data;
              srsIOV[1].iov_len  = dlen;
-             rc = Link->Send(srsIOV, 2, srsIOV[0].iov_len + dlen);
+             rc = timedSend(Link, srsIOV, 2, srsIOV[0].iov_len + dlen);
             }
 
 // Finish up
@@ -383,7 +396,7 @@ int XrdXrootdResponse::Send(ServerResponseStatus &srs, int iLen,
 
 // Send the data off
 //
-   if (Link->Send(IOResp, iornum, rspLen + dlen) < 0)
+   if (timedSend(Link, IOResp, iornum, rspLen + dlen) < 0)
       return Link->setEtext("send failure");
    return 0;
 }
@@ -453,7 +466,7 @@ int XrdXrootdResponse::Send(XrdXrootdReqID &ReqID,
                                           &IOResp[1], iornum-1, ioxlen);
              else {asynResp.theHdr.streamid[0] = theSID[0];
                    asynResp.theHdr.streamid[1] = theSID[1];
-                   rc = Link->Send(IOResp, iornum, iolen);
+                   rc = timedSend(Link, IOResp, iornum, iolen);
                   }
           } else rc = -1;
        Link->setRef(-1);
@@ -31,6 +31,7 @@
   
 #include "Xrd/XrdStats.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdXrootd/XrdXrootdLatency.hh"
 #include "XrdXrootd/XrdXrootdResponse.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
  
@@ -105,7 +106,8 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                       INMax, INMax, INMax,
                       LLMax, INMax, LLMax, INMax, LLMax, INMax,
                       INMax, INMax, INMax, INMax);
-       return len + (fsP ? fsP->getStats(0,0) : 0);
+       return len + XrdXrootdLatency::Stats(0, 0)
+                  + (fsP ? fsP->getStats(0,0) : 0);
       }
 
 // Format our statistics
@@ -121,8 +123,9 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                   LoginAT, AuthBad, LoginAU, LoginUA);
    statsMutex.UnLock();
 
-// Now include filesystem statistics and return
+// Now include request latency and filesystem statistics and return
 //
+   len += XrdXrootdLatency::Stats(buff+len, blen-len);
    if (fsP) len += fsP->getStats(buff+len, blen-len);
    return len;
 }
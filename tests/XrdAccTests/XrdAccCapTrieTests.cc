@@ -0,0 +1,184 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "XrdAcc/XrdAccCapability.hh"
+
+using namespace testing;
+
+namespace
+{
+// Build a capability list from paths and privileges, in order. A path of
+// "=" inserts the template instead.
+//
+XrdAccCapability *MakeList(const std::vector<std::string> &paths,
+                           XrdAccCapability *tmpl=0)
+{
+   XrdAccCapability *head = 0, *last = 0, *cp;
+   XrdAccPrivCaps caps;
+   int n = 0;
+
+   for (auto &p : paths)
+       {if (p == "=") cp = new XrdAccCapability(tmpl);
+           else {caps.pprivs = (XrdAccPrivs)(1 << (n % 8));
+                 caps.nprivs = (XrdAccPrivs)(n % 5 ? 0 : 1 << ((n+3) % 8));
+                 cp = new XrdAccCapability((char *)p.c_str(), caps);
+                }
+        if (last) last->Add(cp);
+           else head = cp;
+        last = cp; n++;
+       }
+   return head;
+}
+
+// Check that the compiled list gives what the plain one does for path.
+//
+void Same(XrdAccCapability *plain, XrdAccCapability *comp, const std::string &p)
+{
+   XrdAccPrivCaps pc, cc;
+   int prc = plain->Privs(pc, p.c_str(), (int)p.size());
+   int crc = comp ->Privs(cc, p.c_str(), (int)p.size());
+
+   EXPECT_EQ(prc, crc) << "path '" << p << "'";
+   EXPECT_EQ(pc.pprivs, cc.pprivs) << "path '" << p << "'";
+   EXPECT_EQ(pc.nprivs, cc.nprivs) << "path '" << p << "'";
+}
+
+std::vector<std::string> BigList(int n, unsigned int seed)
+{
+   static const char *top[] = {"/store/", "/store/user/", "/data/", "/tmp",
+                               "/atlas/", "/cms/store/", "/"};
+   std::vector<std::string> paths;
+
+   srand(seed);
+   for (int i = 0; i < n; i++)
+       {std::string p = top[rand() % 7];
+        int depth = rand() % 4;
+        for (int d = 0; d < depth; d++)
+            {p += "d" + std::to_string(rand() % 50);
+             if (d+1 < depth || rand() % 2) p += "/";
+            }
+        paths.push_back(p);
+       }
+   return paths;
+}
+}
+
+TEST(XrdAccCapTrie, Basic)
+{
+  std::vector<std::string> paths = {"/a/b/", "/a/", "/a/b/c", "/a/", "/x",
+                                    "/xyz/", "/xy", "/"};
+  XrdAccCapability *plain = MakeList(paths), *comp = MakeList(paths);
+
+  EXPECT_EQ(8, comp->Compile());
+
+  for (auto p : {"", "/", "/a", "/a/", "/a/b", "/a/b/", "/a/b/c", "/a/b/cd",
+                 "/a/bb", "/x", "/xy", "/xyz", "/xyz/", "/xyz/q", "/y", "a"})
+      Same(plain, comp, p);
+
+  delete plain; delete comp;
+}
+
+TEST(XrdAccCapTrie, NoMatch)
+{
+  std::vector<std::string> paths = {"/store/", "/data/a"};
+  XrdAccCapability *comp = MakeList(paths);
+  XrdAccPrivCaps caps;
+
+  comp->Compile();
+  EXPECT_EQ(0, comp->Privs(caps, "/stor", 5));
+  EXPECT_EQ(0, comp->Privs(caps, "/data/", 6));
+  EXPECT_EQ(0, comp->Privs(caps, "", 0));
+  EXPECT_EQ(XrdAccPriv_None, caps.pprivs);
+  EXPECT_EQ(1, comp->Privs(caps, "/data/ab", 8));
+
+  delete comp;
+}
+
+TEST(XrdAccCapTrie, Templates)
+{
+  std::vector<std::string> tpaths = {"/t/one/", "/store/user/", "/t/"};
+  std::vector<std::string> paths  = {"/store/user/me/", "=", "/t/one/x", "/",
+                                     "="};
+  XrdAccCapability *tmpl  = MakeList(tpaths);
+  XrdAccCapability *plain = MakeList(paths, tmpl);
+  XrdAccCapability *comp  = MakeList(paths, tmpl);
+
+  EXPECT_EQ(9, comp->Compile());
+
+  for (auto p : {"/store/user/me/f", "/store/user/you", "/t/one/x", "/t/two",
+                 "/t", "/other", ""})
+      Same(plain, comp, p);
+
+  delete plain; delete comp; delete tmpl;
+}
+
+TEST(XrdAccCapTrie, Random)
+{
+  std::vector<std::string> paths = BigList(10000, 17);
+  std::vector<std::string> tpaths = BigList(200, 18);
+  XrdAccCapability *tmpl = MakeList(tpaths);
+  paths[100] = paths[5000] = "=";
+  XrdAccCapability *plain = MakeList(paths, tmpl), *comp = MakeList(paths, tmpl);
+
+  comp->Compile();
+
+  srand(19);
+  for (int i = 0; i < 20000; i++)
+      {std::string p = paths[rand() % paths.size()];
+       switch(rand() % 4)
+             {case 0: break;
+              case 1: p += "f" + std::to_string(rand() % 10); break;
+              case 2: p.resize(rand() % (p.size()+1)); break;
+              case 3: if (!p.empty()) p[rand() % p.size()] = 'q'; break;
+             }
+       Same(plain, comp, p);
+      }
+
+  delete plain; delete comp; delete tmpl;
+}
+
+TEST(XrdAccCapTrie, Benchmark)
+{
+  for (int n : {10, 1000, 10000})
+      {std::vector<std::string> paths, query;
+       for (int i = 0; i < n; i++)
+           paths.push_back((i & 1 ? "/store/user/u" : "/store/group/g")
+                           + std::to_string(i) + "/");
+       XrdAccCapability *plain = MakeList(paths), *comp = MakeList(paths);
+       comp->Compile();
+
+       srand(29);
+       for (int i = 0; i < 1000; i++)
+           query.push_back(paths[rand() % n] + "file" + std::to_string(i));
+       query.push_back("/store/nowhere/file");
+
+       double ns[2];
+       int hits[2];
+       XrdAccCapability *list[2] = {plain, comp};
+       for (int k = 0; k < 2; k++)
+           {int rounds = (k || n < 1000 ? 100 : 10);
+            hits[k] = 0;
+            auto t0 = std::chrono::steady_clock::now();
+            for (int r = 0; r < rounds; r++)
+                for (auto &q : query)
+                    {XrdAccPrivCaps caps;
+                     hits[k] += list[k]->Privs(caps,q.c_str(),(int)q.size());
+                    }
+            auto t1 = std::chrono::steady_clock::now();
+            ns[k] = std::chrono::duration<double, std::nano>(t1 - t0).count()
+                  / (rounds * query.size());
+            hits[k] /= rounds;
+           }
+       EXPECT_EQ(hits[0], hits[1]);
+       printf("%6d entries: linear %9.1f ns/lookup, trie %6.1f ns/lookup\n",
+              n, ns[0], ns[1]);
+
+       delete plain; delete comp;
+      }
+}
@@ -0,0 +1,126 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "XrdOfs/XrdOfsHandle.hh"
+#include "XrdOfs/XrdOfsStats.hh"
+
+using namespace testing;
+
+extern XrdOfsStats OfsStats;
+
+namespace
+{
+// Open a handle the way XrdOfsFile::open() does, leaving it unlocked.
+//
+XrdOfsHandle *Open(const std::string &path, int opts = 0)
+{
+  XrdOfsHandle *hP = nullptr;
+  EXPECT_EQ(0, XrdOfsHandle::Alloc(path.c_str(), opts, &hP));
+  if (hP) hP->UnLock();
+  return hP;
+}
+
+// Close a handle the way XrdOfsFile::close() does, returning the links left.
+//
+int Close(XrdOfsHandle *hP)
+{
+  int retc;
+  hP->Lock();
+  return hP->Retire(retc);
+}
+
+// Open and close files from several threads and return opens per second.
+// When hot is true every thread opens the same file, otherwise each thread
+// opens its own set of files.
+//
+double OpenRate(int nThreads, int nOpens, bool hot)
+{
+  std::atomic<bool> go(false);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; t++)
+      threads.emplace_back([&, t]()
+         {std::vector<std::string> paths;
+          for (int i = 0; i < 64; i++)
+              paths.push_back(hot ? std::string("/bench/hot")
+                                  : "/bench/t" + std::to_string(t)
+                                  + "/f" + std::to_string(i));
+          while(!go) std::this_thread::yield();
+          for (int i = 0; i < nOpens; i++)
+              {XrdOfsHandle *hP = Open(paths[i % 64]);
+               if (hP) Close(hP);
+              }
+         });
+  auto beg = std::chrono::steady_clock::now();
+  go = true;
+  for (auto &t : threads) t.join();
+  std::chrono::duration<double> secs = std::chrono::steady_clock::now() - beg;
+  return nThreads * (double)nOpens / secs.count();
+}
+}
+
+TEST(XrdOfsHandleTests, Sharing)
+{
+  int base = OfsStats.Data.numHandles;
+  XrdOfsHandle *r1 = Open("/share/a");
+  XrdOfsHandle *r2 = Open("/share/a");
+  XrdOfsHandle *w1 = Open("/share/a", XrdOfsHandle::opRW);
+  XrdOfsHandle *r3 = Open("/share/b");
+
+  ASSERT_NE(nullptr, r1);
+  EXPECT_EQ(r1, r2);
+  EXPECT_NE(r1, w1);
+  EXPECT_NE(r1, r3);
+  EXPECT_EQ(2, r1->Usage());
+  EXPECT_STREQ("/share/a", w1->Name());
+  EXPECT_EQ(base + 3, OfsStats.Data.numHandles);
+
+  EXPECT_EQ(1, Close(r2));
+  EXPECT_EQ(0, Close(r1));
+  EXPECT_EQ(0, Close(w1));
+  EXPECT_EQ(0, Close(r3));
+  EXPECT_EQ(base, OfsStats.Data.numHandles);
+}
+
+TEST(XrdOfsHandleTests, Hide)
+{
+  XrdOfsHandle *h1 = Open("/hide/a");
+  XrdOfsHandle::Hide("/hide/a");
+  XrdOfsHandle *h2 = Open("/hide/a");
+
+  EXPECT_NE(h1, h2);
+  EXPECT_EQ(0, Close(h1));
+  EXPECT_EQ(0, Close(h2));
+}
+
+// Many threads opening and closing the same file must leave no handle behind.
+//
+TEST(XrdOfsHandleTests, Concurrency)
+{
+  int base = OfsStats.Data.numHandles;
+  OpenRate(8, 20000, true);
+  OpenRate(8, 20000, false);
+  EXPECT_EQ(base, OfsStats.Data.numHandles);
+
+  XrdOfsHandle *hP = Open("/bench/hot");
+  EXPECT_EQ(1, hP->Usage());
+  EXPECT_EQ(0, Close(hP));
+}
+
+TEST(XrdOfsHandleTests, OpenCloseRate)
+{
+  static constexpr int nOpens = 200000;
+  unsigned int nCPU = std::max(2u, std::thread::hardware_concurrency());
+
+  for (unsigned int n : {1u, nCPU, nCPU*4})
+      {printf("%3u threads: %10.0f opens/s distinct files, "
+              "%10.0f opens/s same file\n", n,
+              OpenRate(n, nOpens/n, false), OpenRate(n, nOpens/n, true));
+      }
+}
@@ -0,0 +1,158 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "XrdOssCsi/XrdOssCsiCrcUtils.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+
+using namespace testing;
+
+namespace
+{
+static constexpr uint32_t CrcPoly = 0x82F63B78;
+
+// Bytewise crc32c, independent of both XrdOucCRC and the helpers under test.
+//
+uint32_t RefCrc(const uint8_t *data, size_t len)
+{
+  uint32_t crc = 0xffffffff;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ ((crc & 1) ? CrcPoly : 0);
+  }
+  return ~crc;
+}
+
+// The helpers as they were before they used the x^(2^k) tables, to compare
+// both the results and the speed.
+//
+const uint8_t g_bz[XrdSys::PageSize] = {0};
+
+uint32_t OldCombine(uint32_t crc1, uint32_t crc2, size_t len2)
+{
+  if (len2 == 0) return crc1;
+  return ~XrdOucCRC::Calc32C(g_bz, len2, ~crc1) ^ crc2;
+}
+
+uint32_t OldSplit1(uint32_t crctot, uint32_t crc2, size_t len2)
+{
+  if (len2 == 0) return crctot;
+  uint32_t crc = crctot ^ crc2;
+  for (size_t i = 0; i < 8*len2; i++)
+    crc = (crc << 1) ^ ((crc & 0x80000000) ? (CrcPoly << 1 | 0x1) : 0);
+  return crc;
+}
+
+class XrdOssCsiCrcUtilsTests : public Test
+{
+protected:
+
+void SetUp() override
+{
+  data.resize(2*XrdSys::PageSize);
+  for (auto &c : data) c = rng();
+}
+
+size_t Rand(size_t lo, size_t hi) // inclusive
+  {return std::uniform_int_distribution<size_t>(lo, hi)(rng);}
+
+const uint8_t *At(size_t off) {return data.data() + off;}
+
+XrdOssCsiCrcUtils    utils;
+std::mt19937         rng{20260918};
+std::vector<uint8_t> data;
+};
+}
+
+TEST_F(XrdOssCsiCrcUtilsTests, Reference)
+{
+  static const char check[] = "123456789";
+  EXPECT_EQ(0xE3069283u, RefCrc((const uint8_t *)check, 9));
+  for (int i = 0; i < 1000; i++) {
+    size_t off = Rand(0, XrdSys::PageSize), len = Rand(0, XrdSys::PageSize);
+    ASSERT_EQ(RefCrc(At(off), len), XrdOucCRC::Calc32C(At(off), len, 0U));
+  }
+}
+
+// Check each helper on adjacent random pieces of data at random offsets,
+// including the edge lengths of 0, 1 and a whole page.
+//
+TEST_F(XrdOssCsiCrcUtilsTests, CombineAndSplit)
+{
+  const size_t edge[] = {0, 1, XrdSys::PageSize-1, XrdSys::PageSize};
+
+  for (int i = 0; i < 5000; i++) {
+    size_t len1 = (i < 16 ? edge[i/4] : Rand(0, XrdSys::PageSize));
+    size_t len2 = (i < 16 ? edge[i%4] : Rand(0, XrdSys::PageSize));
+    size_t off  = Rand(0, data.size() - len1 - len2);
+    uint32_t crc1 = RefCrc(At(off), len1);
+    uint32_t crc2 = RefCrc(At(off + len1), len2);
+    uint32_t crct = RefCrc(At(off), len1 + len2);
+
+    ASSERT_EQ(crct, utils.crc32c_combine(crc1, crc2, len2))
+              << off << ' ' << len1 << ' ' << len2;
+    ASSERT_EQ(crc1, utils.crc32c_split1(crct, crc2, len2))
+              << off << ' ' << len1 << ' ' << len2;
+    if (len2)
+       ASSERT_EQ(crc2, utils.crc32c_split2(crct, crc1, len2))
+                 << off << ' ' << len1 << ' ' << len2;
+      else ASSERT_EQ(0u, utils.crc32c_split2(crct, crc1, len2));
+  }
+}
+
+TEST_F(XrdOssCsiCrcUtilsTests, ExtendWithZero)
+{
+  std::vector<uint8_t> buff(2*XrdSys::PageSize);
+
+  for (int i = 0; i < 2000; i++) {
+    size_t len = Rand(0, XrdSys::PageSize), nz = Rand(0, XrdSys::PageSize);
+    size_t off = Rand(0, data.size() - len);
+    std::copy(At(off), At(off + len), buff.begin());
+    std::fill(buff.begin() + len, buff.begin() + len + nz, 0);
+    uint32_t crc = RefCrc(buff.data(), len);
+    ASSERT_EQ(RefCrc(buff.data(), len + nz),
+              utils.crc32c_extendwith_zero(crc, nz)) << len << ' ' << nz;
+  }
+}
+
+// Time the helpers against the way they used to be computed, which must give
+// the same results, on the lengths seen when adjusting partial pages.
+//
+TEST_F(XrdOssCsiCrcUtilsTests, Benchmark)
+{
+  const int iters = 20000;
+  std::vector<uint32_t> crc(iters), len(iters);
+  uint32_t sumOld = 0, sumNew = 0;
+
+  for (int i = 0; i < iters; i++) {crc[i] = rng(); len[i] = Rand(1, 4096);}
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; i++) sumOld += OldCombine(crc[i], i, len[i]);
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; i++)
+      sumNew += utils.crc32c_combine(crc[i], i, len[i]);
+  auto t2 = std::chrono::steady_clock::now();
+  EXPECT_EQ(sumOld, sumNew);
+  double oc = std::chrono::duration<double, std::nano>(t1 - t0).count()/iters;
+  double nc = std::chrono::duration<double, std::nano>(t2 - t1).count()/iters;
+
+  sumOld = sumNew = 0;
+  t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; i++) sumOld += OldSplit1(crc[i], i, len[i]);
+  t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; i++)
+      sumNew += utils.crc32c_split1(crc[i], i, len[i]);
+  t2 = std::chrono::steady_clock::now();
+  EXPECT_EQ(sumOld, sumNew);
+  double os = std::chrono::duration<double, std::nano>(t1 - t0).count()/iters;
+  double ns = std::chrono::duration<double, std::nano>(t2 - t1).count()/iters;
+
+  printf("combine: old %.0f ns, new %.0f ns; split1: old %.0f ns, new %.0f ns\n",
+         oc, nc, os, ns);
+}
@@ -0,0 +1,323 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "XrdOss/XrdOss.hh"
+#include "XrdOssCsi/XrdOssCsiTagstoreFile.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSys/XrdSysMetrics.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+
+XrdOucTrace OssCsiTrace(0);
+
+using namespace testing;
+
+namespace
+{
+// The tag file lives in memory and counts the I/O done on it, so the tests
+// can tell what the cache has written out and when.
+//
+struct MemStore
+{
+  std::vector<uint8_t> data;
+  int reads  = 0;
+  int writes = 0;
+  int syncs  = 0;
+};
+
+class MemDF : public XrdOssDF
+{
+public:
+
+int     Open(const char *, int, mode_t, XrdOucEnv &) override {return 0;}
+
+int     Close(long long *retsz=0) override {return 0;}
+
+int     Fstat(struct stat *buf) override
+                 {memset(buf, 0, sizeof(struct stat));
+                  buf->st_size = sP->data.size();
+                  return 0;
+                 }
+
+int     Fsync() override {sP->syncs++; return 0;}
+
+int     Ftruncate(unsigned long long flen) override
+                 {sP->data.resize(flen); return 0;}
+
+ssize_t Read(void *buff, off_t offset, size_t size) override
+                 {sP->reads++;
+                  if (offset >= (off_t)sP->data.size()) return 0;
+                  size = std::min(size, sP->data.size() - offset);
+                  memcpy(buff, sP->data.data() + offset, size);
+                  return size;
+                 }
+
+ssize_t Write(const void *buff, off_t offset, size_t size) override
+                 {sP->writes++;
+                  if (offset + size > sP->data.size())
+                     sP->data.resize(offset + size);
+                  memcpy(sP->data.data() + offset, buff, size);
+                  return size;
+                 }
+
+        MemDF(std::shared_ptr<MemStore> store) : sP(store) {}
+
+private:
+std::shared_ptr<MemStore> sP;
+};
+
+static constexpr size_t blkTags = 1024;  // tags per cached block
+
+class XrdOssCsiTagstoreTests : public Test
+{
+protected:
+
+// Open a tagstore keeping at most cblks blocks of tags in memory
+//
+std::unique_ptr<XrdOssCsiTagstoreFile> Open(size_t cblks, bool wback,
+                                            off_t dsize=0)
+{
+  std::unique_ptr<XrdOssCsiTagstoreFile> ts(new XrdOssCsiTagstoreFile("test",
+                     std::unique_ptr<XrdOssDF>(new MemDF(store)), "tid",
+                     cblks, wback));
+  EXPECT_EQ(0, ts->Open("test.xrdt", dsize, O_RDWR, env));
+  return ts;
+}
+
+// Number of tags held by the tag file
+//
+size_t Stored() {return (store->data.size() - 20) / 4;}
+
+// Tag n as held by the tag file
+//
+uint32_t Stored(size_t n)
+{
+  uint32_t v;
+  memcpy(&v, store->data.data() + 20 + 4*n, 4);
+  return v;
+}
+
+// Write count tags starting at tag off, with values derived from the index
+//
+void Write(XrdOssCsiTagstoreFile &ts, off_t off, size_t count, uint32_t seed)
+{
+  std::vector<uint32_t> tags(count);
+  for (size_t i = 0; i < count; i++) tags[i] = seed + off + i;
+  ASSERT_EQ((ssize_t)count, ts.WriteTags(tags.data(), off, count));
+}
+
+void Check(XrdOssCsiTagstoreFile &ts, off_t off, size_t count, uint32_t seed)
+{
+  std::vector<uint32_t> tags(count);
+  ASSERT_EQ((ssize_t)count, ts.ReadTags(tags.data(), off, count));
+  for (size_t i = 0; i < count; i++)
+      ASSERT_EQ(seed + off + i, tags[i]) << "tag " << off + i;
+}
+
+// Value of an exported tag cache counter, e.g. Counted("reads")
+//
+long long Counted(const char *what)
+{
+  std::string text, name = std::string("\nxrootd_osscsi_tagcache_") + what
+                         + "_total ";
+  XrdSysMetrics::Prometheus(text);
+  size_t pos = text.find(name);
+  return (pos == std::string::npos ? 0 : atoll(text.c_str()+pos+name.size()));
+}
+
+std::shared_ptr<MemStore> store = std::make_shared<MemStore>();
+XrdOucEnv                 env;
+};
+}
+
+// With write-through every write reaches the tag file before WriteTags
+// returns, and cached blocks are kept up to date.
+//
+TEST_F(XrdOssCsiTagstoreTests, WriteThrough)
+{
+  auto ts = Open(2, false);
+
+  Write(*ts, 0, 100, 7);
+  ASSERT_EQ(100u, Stored());
+  Check(*ts, 0, 100, 7);
+  int reads = store->reads;
+  Write(*ts, 50, 10, 9);
+  EXPECT_EQ(9u + 50, Stored(50));
+  Check(*ts, 50, 10, 9);
+  EXPECT_EQ(reads, store->reads);
+  ASSERT_EQ(0, ts->Close());
+}
+
+// Evicting a block with dirty tags writes them out; blocks read back later
+// come from the tag file with what was written.
+//
+TEST_F(XrdOssCsiTagstoreTests, EvictDirty)
+{
+  auto ts = Open(2, true);
+
+  Write(*ts, 0, blkTags, 1);
+  Write(*ts, blkTags + 10, 20, 1);
+  EXPECT_EQ(0u, Stored());
+  int writes = store->writes;
+
+// A third block evicts the least recently used one, the first
+//
+  Write(*ts, 2*blkTags, 5, 1);
+  EXPECT_EQ(writes + 1, store->writes);
+  ASSERT_EQ(blkTags, Stored());
+  EXPECT_EQ(1u, Stored(0));
+  EXPECT_EQ(blkTags, Stored(blkTags - 1));
+
+// Reading the first block back evicts the second, whose dirty range alone is
+// written, and the tags from the file are the ones written before
+//
+  Check(*ts, 0, blkTags, 1);
+  ASSERT_EQ(blkTags + 30, Stored());
+  EXPECT_EQ(1u + blkTags + 10, Stored(blkTags + 10));
+  EXPECT_EQ(0u, Stored(blkTags));
+  Check(*ts, blkTags + 10, 20, 1);
+  Check(*ts, 2*blkTags, 5, 1);
+
+  ASSERT_EQ(0, ts->Close());
+  ASSERT_EQ(2*blkTags + 5, Stored());
+  EXPECT_EQ(1u + 2*blkTags + 4, Stored(2*blkTags + 4));
+}
+
+// Dirty tags reach the tag file on flush, fsync and close, and not before.
+//
+TEST_F(XrdOssCsiTagstoreTests, FlushFsyncClose)
+{
+  auto ts = Open(4, true);
+
+  Write(*ts, 0, 10, 3);
+  EXPECT_EQ(0u, Stored());
+  ts->Flush();
+  ASSERT_EQ(10u, Stored());
+  EXPECT_EQ(12u, Stored(9));
+
+  Write(*ts, 10, 10, 3);
+  EXPECT_EQ(10u, Stored());
+  int syncs = store->syncs;
+  ASSERT_EQ(0, ts->Fsync());
+  EXPECT_EQ(syncs + 1, store->syncs);
+  ASSERT_EQ(20u, Stored());
+  EXPECT_EQ(22u, Stored(19));
+
+// Nothing dirty, nothing written
+//
+  int writes = store->writes;
+  ASSERT_EQ(0, ts->Fsync());
+  EXPECT_EQ(writes, store->writes);
+
+  Write(*ts, 3*blkTags, 2, 3);
+  ASSERT_EQ(0, ts->SetTrackedSize((3*blkTags + 2)*XrdSys::PageSize));
+  ASSERT_EQ(0, ts->Close());
+  ASSERT_EQ(3*blkTags + 2, Stored());
+  EXPECT_EQ(3u + 3*blkTags + 1, Stored(3*blkTags + 1));
+
+// Tags skipped over read back as zeros once reopened
+//
+  ts = Open(4, true, (3*blkTags + 2)*XrdSys::PageSize);
+  std::vector<uint32_t> tags(blkTags);
+  ASSERT_EQ((ssize_t)blkTags, ts->ReadTags(tags.data(), blkTags, blkTags));
+  for (auto t : tags) ASSERT_EQ(0u, t);
+  Check(*ts, 0, 20, 3);
+}
+
+// Truncating while blocks are cached writes out what is pending, discards
+// the tags beyond the new size, and lets the file grow again afterwards.
+//
+TEST_F(XrdOssCsiTagstoreTests, TruncateWhileCached)
+{
+  auto ts = Open(4, true);
+
+  Write(*ts, 0, 3*blkTags, 5);
+  Check(*ts, 0, 3*blkTags, 5);
+  ASSERT_EQ(0, ts->Truncate(1500*(off_t)XrdSys::PageSize, true));
+  ASSERT_EQ(1500u, Stored());
+  EXPECT_EQ(1500*(off_t)XrdSys::PageSize, ts->GetTrackedTagSize());
+  EXPECT_EQ(5u + 1499, Stored(1499));
+  Check(*ts, 0, 1500, 5);
+
+  uint32_t tag;
+  EXPECT_EQ(-EDOM, ts->ReadTags(&tag, 1500, 1));
+
+// Extending after the truncate leaves zeros in between
+//
+  Write(*ts, 2*blkTags, 4, 11);
+  std::vector<uint32_t> tags(2*blkTags - 1500);
+  ASSERT_EQ((ssize_t)tags.size(), ts->ReadTags(tags.data(), 1500, tags.size()));
+  for (auto t : tags) ASSERT_EQ(0u, t);
+  Check(*ts, 2*blkTags, 4, 11);
+  Check(*ts, 1000, 100, 5);
+
+  ASSERT_EQ(0, ts->Close());
+  ASSERT_EQ(2*blkTags + 4, Stored());
+  EXPECT_EQ(0u, Stored(1500));
+  EXPECT_EQ(11u + 2*blkTags, Stored(2*blkTags));
+}
+
+// Resetting the sizes writes out and drops the cache, and shortens the tag
+// file to the tracked size.
+//
+TEST_F(XrdOssCsiTagstoreTests, ResizeWhileCached)
+{
+  auto ts = Open(4, true);
+
+  Write(*ts, 0, 2*blkTags, 13);
+  ASSERT_EQ(0, ts->SetTrackedSize(blkTags*(off_t)XrdSys::PageSize));
+  int reads = store->reads;
+  ASSERT_EQ(0, ts->ResetSizes(blkTags*(off_t)XrdSys::PageSize));
+  ASSERT_EQ(blkTags, Stored());
+  EXPECT_EQ(13u + blkTags - 1, Stored(blkTags - 1));
+
+  Check(*ts, 0, blkTags, 13);
+  EXPECT_GT(store->reads, reads);
+  uint32_t tag;
+  EXPECT_EQ(-EDOM, ts->ReadTags(&tag, blkTags, 1));
+  ASSERT_EQ(0, ts->Close());
+}
+
+// A prefetch loads a run of blocks in one read, after which reads are hits.
+//
+TEST_F(XrdOssCsiTagstoreTests, Prefetch)
+{
+  auto ts = Open(0, false);
+  Write(*ts, 0, 3*blkTags, 17);
+  ASSERT_EQ(0, ts->SetTrackedSize(3*blkTags*XrdSys::PageSize));
+  ASSERT_EQ(0, ts->Close());
+
+  ts = Open(4, false, 3*blkTags*XrdSys::PageSize);
+  int reads = store->reads;
+  ASSERT_EQ(0, ts->PrefetchTags(0, 3*blkTags));
+  EXPECT_EQ(reads + 1, store->reads);
+  Check(*ts, 0, 3*blkTags, 17);
+  EXPECT_EQ(reads + 1, store->reads);
+  ASSERT_EQ(0, ts->Close());
+}
+
+// The counts of all files are exported as metrics as the cache is used.
+//
+TEST_F(XrdOssCsiTagstoreTests, Metrics)
+{
+  auto ts = Open(4, true);
+  long long reads = Counted("reads"), hits = Counted("read_hits");
+  long long writes = Counted("writes"), wrio = Counted("write_io");
+
+  Write(*ts, 0, 100, 3);
+  Check(*ts, 0, 100, 3);
+  EXPECT_EQ(writes + 1, Counted("writes"));
+  EXPECT_EQ(reads + 1, Counted("reads"));
+  EXPECT_EQ(hits + 1, Counted("read_hits"));
+  EXPECT_EQ(wrio, Counted("write_io"));
+  ASSERT_EQ(0, ts->Close());
+  EXPECT_LT(wrio, Counted("write_io"));
+}
@@ -0,0 +1,322 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "XrdOss/XrdOssCache.hh"
+
+using namespace testing;
+
+namespace
+{
+// The cache is process-wide and filesystems can only be added, so a single
+// group of partitions is set up once for all tests. All of them live in /tmp
+// and so share one filesystem and its free space.
+//
+class XrdOssCacheTests : public Test
+{
+protected:
+
+static void SetUpTestSuite()
+{
+  char tmpl[] = "/tmp/xrdosscacheXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(tmpl));
+  base = tmpl;
+  for (int i = 0; i < 4; i++)
+      {std::string part = base + "/p" + std::to_string(i);
+       ASSERT_EQ(0, mkdir(part.c_str(), 0755));
+       int retc = 0;
+       new XrdOssCache_FS(retc, "test", part.c_str(), XrdOssCache_FS::None);
+       ASSERT_EQ(0, retc);
+      }
+  XrdOssCache::Init(0, 0, 0);
+  fsdP = XrdOssCache::fsfirst->fsdata;
+}
+
+static void TearDownTestSuite()
+{
+  for (int i = 0; i < 4; i++) rmdir((base + "/p" + std::to_string(i)).c_str());
+  rmdir(base.c_str());
+}
+
+// Reserve size bytes in the test group without creating a file
+//
+static int Alloc(long long size, int blen=1024)
+{
+  char buff[1024];
+  XrdOssCache::allocInfo aInfo("/file", buff, blen);
+  aInfo.cgName = "test";
+  aInfo.cgSize = size;
+  return XrdOssCache::Alloc(aInfo);
+}
+
+static std::string         base;
+static XrdOssCache_FSData *fsdP;
+};
+
+std::string         XrdOssCacheTests::base;
+XrdOssCache_FSData *XrdOssCacheTests::fsdP = 0;
+}
+
+TEST_F(XrdOssCacheTests, Reserve)
+{
+  long long before = fsdP->frsz;
+  ASSERT_GT(before, 1024*1024);
+
+  EXPECT_EQ(0, Alloc(4096));
+  EXPECT_EQ(before - 4096, fsdP->frsz);
+  EXPECT_TRUE(fsdP->stat & XrdOssFSData_REFRESH);
+
+// A failed allocation gives back what it reserved
+//
+  EXPECT_EQ(-ENAMETOOLONG, Alloc(4096, 8));
+  EXPECT_EQ(before - 4096, fsdP->frsz);
+
+// More than is free cannot be allocated, and unknown groups do not exist
+//
+  EXPECT_EQ(-ENOSPC, Alloc(before));
+  char buff[64];
+  XrdOssCache::allocInfo aInfo("/file", buff, sizeof(buff));
+  aInfo.cgName = "nogroup";
+  EXPECT_EQ(-ENOENT, XrdOssCache::Alloc(aInfo));
+
+// Closing files adjusts the free space, which never goes negative
+//
+  XrdOssCache::Adjust(fsdP->fsid, -4096);
+  EXPECT_EQ(before, fsdP->frsz);
+  XrdOssCache::Adjust(fsdP->fsid, before*2);
+  EXPECT_EQ(0, fsdP->frsz);
+  fsdP->frsz = before;
+}
+
+// Allocations and adjustments from several threads must all be accounted for
+//
+TEST_F(XrdOssCacheTests, Concurrency)
+{
+  const int nThreads = 4, nOps = 20000;
+  long long before = fsdP->frsz;
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < nThreads; i++)
+      {threads.emplace_back([i]()
+          {for (int j = 0; j < nOps; j++)
+               {if (i & 1) XrdOssCache::Adjust(fsdP->fsid, -3);
+                   else    ASSERT_EQ(0, Alloc(5));
+               }
+          });
+      }
+  for (auto &t : threads) t.join();
+
+  EXPECT_EQ(before - nOps*(nThreads/2)*5 + nOps*(nThreads/2)*3, fsdP->frsz);
+  fsdP->frsz = before;
+}
+
+// Measure the allocation rate while other threads account for closed files
+//
+TEST_F(XrdOssCacheTests, AllocRate)
+{
+  const int nAlloc = 200000;
+  long long before = fsdP->frsz;
+  std::atomic<bool> done(false);
+  std::vector<std::thread> closers;
+
+  for (int i = 0; i < 2; i++)
+      closers.emplace_back([&done]()
+         {while(!done) XrdOssCache::Adjust(fsdP->fsid, 0);});
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < nAlloc; i++) ASSERT_EQ(0, Alloc(1));
+  auto t1 = std::chrono::steady_clock::now();
+  done = true;
+  for (auto &t : closers) t.join();
+
+  printf("alloc %.0f/s with concurrent adjust\n",
+         nAlloc/std::chrono::duration<double>(t1 - t0).count());
+  fsdP->frsz = before;
+}
+
+namespace
+{
+// Uploads arriving at random are simulated against four filesystems in the
+// "sim" group. Each gets its own space data, the first two with ten times the free space of the
+// others and the last one twice as fast as the rest. A device's bandwidth is
+// shared equally among the files being written to it.
+//
+class XrdOssCacheLoadTests : public Test
+{
+protected:
+
+static const int       nFS = 4;
+
+static void SetUpTestSuite()
+{
+  char tmpl[] = "/tmp/xrdosscachesimXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(tmpl));
+  base = tmpl;
+  for (int i = 0; i < nFS; i++)
+      {std::string part = base + "/s" + std::to_string(i);
+       ASSERT_EQ(0, mkdir(part.c_str(), 0755));
+       int retc = 0;
+       fsP[i] = new XrdOssCache_FS(retc,"sim",part.c_str(),XrdOssCache_FS::None);
+       ASSERT_EQ(0, retc);
+       STATFS_t fsbuff;
+       ASSERT_EQ(0, FS_Stat(part.c_str(), &fsbuff));
+       fsP[i]->fsdata = new XrdOssCache_FSData(part.c_str(), fsbuff,
+                                               static_cast<dev_t>(0x7fff00+i));
+      }
+}
+
+static void TearDownTestSuite()
+{
+  XrdOssCache::Init(0, 0, 0, false);
+  for (int i = 0; i < nFS; i++) rmdir((base + "/s" + std::to_string(i)).c_str());
+  rmdir(base.c_str());
+}
+
+static void Reset()
+{
+  for (int i = 0; i < nFS; i++)
+      {XrdOssCache_FSData *fsdP = fsP[i]->fsdata;
+       fsdP->frsz     = (i < 2 ? 10000LL : 1000LL) << 30;
+       fsdP->wrActive = 0;
+       fsdP->alSecond = 0;
+       fsdP->alCount  = 0;
+       fsdP->wrCost   = 0;
+      }
+}
+
+// Return the index of the filesystem the next file of size bytes goes to
+//
+static int Place(long long size)
+{
+  char buff[1024];
+  XrdOssCache::allocInfo aInfo("/file", buff, sizeof(buff));
+  aInfo.cgName = "sim";
+  aInfo.cgSize = size;
+  if (XrdOssCache::Alloc(aInfo) < 0) return -1;
+  for (int i = 0; i < nFS; i++) if (aInfo.cgFSp == fsP[i]) return i;
+  return -1;
+}
+
+// Run the simulation and return the mean upload time in seconds
+//
+static double Simulate(bool load, int *used)
+{
+  const long long mb = 1024*1024, fSize = 100*mb;
+  const double    bw[nFS] = {150.0, 150.0, 150.0, 300.0}; // MB/s
+  const long long dtNs = 10000000;                        // 10 ms step
+  const int       nFiles = 400;
+  std::mt19937    rng(1);
+  std::exponential_distribution<double> apart(1.0/40); // Mean steps apart
+  struct Upload {int fs; long long left; int start;};
+  std::vector<Upload> active;
+  double total = 0.0;
+  int done = 0, placed = 0, next = 0, n[nFS];
+
+  Reset();
+  XrdOssCache::Init(0, 0, 0, load);
+  for (int i = 0; i < nFS; i++) used[i] = 0;
+
+  for (int step = 0; done < nFiles; step++)
+      {if (step == next && placed++ < nFiles)
+          {next = step + 1 + static_cast<int>(apart(rng));
+           int fs = Place(fSize);
+           if (fs < 0) return -1.0;
+           used[fs]++;
+// Allocations are all made in the same wall clock second here, so the file
+// is counted as open right away rather than as recently allocated.
+           fsP[fs]->fsdata->alSecond = 0;
+           fsP[fs]->fsdata->wrActive++;
+           active.push_back({fs, fSize, step});
+          }
+       for (int i = 0; i < nFS; i++) n[i] = 0;
+       for (auto &u : active) n[u.fs]++;
+       for (auto it = active.begin(); it != active.end();)
+           {long long bytes = static_cast<long long>
+                              (bw[it->fs]*mb*dtNs/1e9/n[it->fs]);
+            fsP[it->fs]->fsdata->NoteWrite(bytes, dtNs);
+            if ((it->left -= bytes) > 0) {++it; continue;}
+            fsP[it->fs]->fsdata->wrActive--;
+            total += (step - it->start + 1) * dtNs / 1e9;
+            done++;
+            it = active.erase(it);
+           }
+      }
+  return total / nFiles;
+}
+
+static std::string     base;
+static XrdOssCache_FS *fsP[nFS];
+};
+
+std::string     XrdOssCacheLoadTests::base;
+XrdOssCache_FS *XrdOssCacheLoadTests::fsP[XrdOssCacheLoadTests::nFS];
+}
+
+// Measured costs decide placement; unmeasured filesystems count as fastest
+//
+TEST_F(XrdOssCacheLoadTests, Select)
+{
+  int now = static_cast<int>(time(0));
+
+// With nothing measured the most free space wins
+//
+  Reset();
+  XrdOssCache::Init(0, 0, 0, true);
+  fsP[0]->fsdata->frsz += 1LL<<30;
+  fsP[2]->fsdata->frsz += 1LL<<30;
+  EXPECT_EQ(0, Place(0));
+
+// Allocations in the current second count as writers
+//
+  EXPECT_EQ(1, fsP[0]->fsdata->Recent(now));
+  EXPECT_EQ(1, Place(0));
+  fsP[0]->fsdata->alSecond = 0;
+  fsP[1]->fsdata->alSecond = 0;
+
+// Then the cost of writing counts
+//
+  fsP[0]->fsdata->NoteWrite(1024*1024, 4000000);
+  for (int i = 1; i < nFS; i++) fsP[i]->fsdata->NoteWrite(1024*1024, 8000000);
+  EXPECT_EQ(4000000, fsP[0]->fsdata->wrCost);
+  fsP[0]->fsdata->NoteWrite(1024, 1); // Too small to count
+  EXPECT_EQ(4000000, fsP[0]->fsdata->wrCost);
+  EXPECT_EQ(0, Place(0));
+  fsP[0]->fsdata->alSecond = 0;
+
+// Two writers on the fast device make it slower than an idle slow one and
+// equal loads go to the most free space.
+//
+  fsP[0]->fsdata->wrActive = 2;
+  EXPECT_EQ(1, Place(0));
+  fsP[1]->fsdata->alSecond = 0;
+  fsP[1]->fsdata->wrActive = 1;
+  EXPECT_EQ(2, Place(0));
+  Reset();
+}
+
+TEST_F(XrdOssCacheLoadTests, Simulation)
+{
+  int usedFree[nFS], usedLoad[nFS];
+  double tFree = Simulate(false, usedFree);
+  double tLoad = Simulate(true,  usedLoad);
+
+  printf("free space: mean upload %.2fs files %d %d %d %d\n", tFree,
+         usedFree[0], usedFree[1], usedFree[2], usedFree[3]);
+  printf("write load: mean upload %.2fs files %d %d %d %d\n", tLoad,
+         usedLoad[0], usedLoad[1], usedLoad[2], usedLoad[3]);
+  ASSERT_GT(tFree, 0.0);
+  ASSERT_GT(tLoad, 0.0);
+  EXPECT_LT(tLoad, tFree);
+  EXPECT_GT(usedLoad[3], usedLoad[2]);
+}
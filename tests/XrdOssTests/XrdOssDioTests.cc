@@ -0,0 +1,161 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+#include "XrdOss/XrdOssDio.hh"
+
+using namespace testing;
+
+namespace
+{
+// The test file is a little over 3MB so that it ends in the middle of a page
+// and reads through the bounce buffer need more than one chunk.
+//
+static constexpr size_t fileSize = 3*1024*1024 + 1000;
+
+class XrdOssDioTests : public Test
+{
+protected:
+
+void SetUp() override
+{
+  char tmpl[] = "/tmp/xrdossdioXXXXXX";
+  int wfd = mkstemp(tmpl);
+  ASSERT_GE(wfd, 0);
+  path = tmpl;
+  data.resize(fileSize);
+  for (size_t i = 0; i < fileSize; i++) data[i] = (char)((i * 131) ^ (i >> 12));
+  ASSERT_EQ((ssize_t)fileSize, write(wfd, data.data(), fileSize));
+  fsync(wfd);
+  close(wfd);
+  if ((dfd = XrdOssDio::Open(path.c_str())) < 0)
+     GTEST_SKIP() << "direct I/O is not supported on /tmp";
+}
+
+void TearDown() override
+{
+  if (dfd >= 0) close(dfd);
+  unlink(path.c_str());
+}
+
+// Read len bytes at offs into a buffer misaligned by skew and check them
+//
+void Check(size_t skew, off_t offs, size_t len)
+{
+  char *mem = nullptr;
+  ASSERT_EQ(0, posix_memalign((void **)&mem, XrdOssDio::Align,
+                              len + XrdOssDio::Align));
+  size_t want = (offs >= (off_t)fileSize ? 0
+              :  std::min(len, fileSize - (size_t)offs));
+  ssize_t rc = XrdOssDio::Read(dfd, mem + skew, offs, len);
+  EXPECT_EQ((ssize_t)want, rc) << skew << ' ' << offs << ' ' << len;
+  if (rc == (ssize_t)want)
+     {EXPECT_EQ(0, memcmp(mem + skew, data.data() + offs, want))
+                << skew << ' ' << offs << ' ' << len;
+     }
+  free(mem);
+}
+
+std::string       path;
+std::vector<char> data;
+int               dfd = -1;
+};
+}
+
+TEST_F(XrdOssDioTests, Aligned)
+{
+  Check(0, 0, 65536);
+  Check(0, 8192, 1024*1024);
+  Check(0, fileSize & ~(size_t)4095, 4096);
+}
+
+TEST_F(XrdOssDioTests, Congruent)
+{
+  Check(100, 100, 65536);
+  Check(4095, 4095, 2*4096);
+  Check(7, 4096*5 + 7, 3*4096 + 11);
+  Check(0, 0, 4096*3 + 5);
+  Check(512, 512, fileSize);
+}
+
+TEST_F(XrdOssDioTests, Unaligned)
+{
+  Check(1, 0, 100);
+  Check(0, 1, 4096);
+  Check(3, 4090, 12);
+  Check(17, 12345, 2*1024*1024 + 777);
+  Check(1, 4096, 65536);
+}
+
+TEST_F(XrdOssDioTests, EndOfFile)
+{
+  Check(0, fileSize - 10, 4096);
+  Check(5, fileSize - 4000, 65536);
+  Check(0, fileSize - 3*4096 - 1, 4*4096);
+  Check(0, fileSize, 4096);
+  Check(9, fileSize + 4096, 100);
+}
+
+// Compare buffered and direct reads of the whole file in 256KB requests, the
+// size used by the xroot protocol's aio buffers. Reports throughput and how
+// much of the file is left in the page cache.
+//
+TEST_F(XrdOssDioTests, Footprint)
+{
+  static constexpr size_t blkSize = 256*1024;
+  const long pgSz = sysconf(_SC_PAGESIZE);
+  const size_t pages = (fileSize + pgSz - 1) / pgSz;
+  char *buff = nullptr;
+  ASSERT_EQ(0, posix_memalign((void **)&buff, XrdOssDio::Align, blkSize));
+
+  auto resident = [&]()
+     {int fd = open(path.c_str(), O_RDONLY);
+      void *mP = mmap(0, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+      std::vector<unsigned char> vec(pages);
+      size_t n = 0;
+      if (mP != MAP_FAILED && !mincore(mP, fileSize, vec.data()))
+         for (auto v : vec) n += (v & 1);
+      if (mP != MAP_FAILED) munmap(mP, fileSize);
+      close(fd);
+      return n;
+     };
+  auto evict = [&]()
+     {int fd = open(path.c_str(), O_RDONLY);
+      posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      close(fd);
+     };
+  auto timed = [&](int fd, bool direct)
+     {auto beg = std::chrono::steady_clock::now();
+      for (off_t offs = 0; offs < (off_t)fileSize; offs += blkSize)
+          {ssize_t rc = (direct ? XrdOssDio::Read(fd, buff, offs, blkSize)
+                                : pread(fd, buff, blkSize, offs));
+           EXPECT_GT(rc, 0);
+          }
+      std::chrono::duration<double> secs = std::chrono::steady_clock::now()-beg;
+      return fileSize / secs.count() / (1024*1024);
+     };
+
+  evict();
+  int bfd = open(path.c_str(), O_RDONLY);
+  double bRate = timed(bfd, false);
+  close(bfd);
+  size_t bRes = resident();
+
+  evict();
+  double dRate = timed(dfd, true);
+  size_t dRes = resident();
+
+  printf("buffered: %8.1f MB/s, %zu of %zu pages cached\n", bRate, bRes, pages);
+  printf("direct:   %8.1f MB/s, %zu of %zu pages cached\n", dRate, dRes, pages);
+  EXPECT_LT(dRes, bRes);
+  free(buff);
+}
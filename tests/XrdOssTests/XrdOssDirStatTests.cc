@@ -0,0 +1,185 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "XrdOss/XrdOssDirStat.hh"
+
+using namespace testing;
+
+namespace
+{
+class XrdOssDirStatTests : public Test
+{
+protected:
+
+void SetUp() override
+{
+  char tmpl[] = "/tmp/xrdossdsXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(tmpl));
+  dir = tmpl;
+  XrdOssDirStat::Start(4, 64);
+}
+
+void TearDown() override
+{
+  for (auto &it : made) unlink((dir + "/" + it.first).c_str());
+  rmdir(dir.c_str());
+}
+
+void Make(int n)
+{
+  for (int i = 0; i < n; i++)
+      {std::string name = "f" + std::to_string(i);
+       int fd = open((dir + "/" + name).c_str(), O_WRONLY | O_CREAT, 0644);
+       ASSERT_GE(fd, 0);
+       ASSERT_EQ(0, ftruncate(fd, i));
+       close(fd);
+       made[name] = i;
+      }
+}
+
+// List the directory through XrdOssDirStat, checking each entry
+//
+int List()
+{
+  DIR *dP = opendir(dir.c_str());
+  XrdOssDirStat ds(dP);
+  struct stat sb;
+  char buff[512];
+  int n = 0;
+
+  while(true)
+       {EXPECT_EQ(0, ds.Next(buff, sizeof(buff), &sb));
+        if (!*buff) break;
+        if (!strcmp(buff, ".") || !strcmp(buff, "..")) continue;
+        auto it = made.find(buff);
+        EXPECT_NE(made.end(), it) << buff;
+        if (it != made.end()) {EXPECT_EQ(it->second, sb.st_size) << buff;}
+        n++;
+       }
+  closedir(dP);
+  return n;
+}
+
+std::string dir;
+std::map<std::string, int> made;
+};
+}
+
+TEST_F(XrdOssDirStatTests, Empty)
+{
+  EXPECT_EQ(0, List());
+}
+
+TEST_F(XrdOssDirStatTests, Small)
+{
+  Make(5);
+  EXPECT_EQ(5, List());
+}
+
+TEST_F(XrdOssDirStatTests, Batches)
+{
+  Make(1000);
+  EXPECT_EQ(1000, List());
+}
+
+TEST_F(XrdOssDirStatTests, Vanished)
+{
+  Make(100);
+  DIR *dP = opendir(dir.c_str());
+  XrdOssDirStat ds(dP);
+  struct stat sb;
+  char buff[512];
+  int n = 0;
+
+// The first batch is read and stat'ed by the first call, remove everything
+// so that later batches find nothing.
+//
+  ASSERT_EQ(0, ds.Next(buff, sizeof(buff), &sb));
+  for (auto &it : made) unlink((dir + "/" + it.first).c_str());
+  while(true)
+       {ASSERT_EQ(0, ds.Next(buff, sizeof(buff), &sb));
+        if (!*buff) break;
+        if (strcmp(buff, ".") && strcmp(buff, "..")) n++;
+       }
+  closedir(dP);
+  EXPECT_LT(n, 64);
+  made.clear();
+}
+
+TEST_F(XrdOssDirStatTests, StatAt)
+{
+  struct stat sb1, sb2;
+  Make(3);
+  int dfd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+  ASSERT_GE(dfd, 0);
+
+// Have StatAt() use statx(), where available, as nosync is in effect
+//
+  XrdOssDirStat::Start(0, 64, true);
+  for (const char *name : {"f2", ".", ".."})
+      {ASSERT_EQ(0, fstatat(dfd, name, &sb1, 0));
+       ASSERT_EQ(0, XrdOssDirStat::StatAt(dfd, name, &sb2));
+       EXPECT_EQ(sb1.st_dev,   sb2.st_dev)   << name;
+       EXPECT_EQ(sb1.st_ino,   sb2.st_ino)   << name;
+       EXPECT_EQ(sb1.st_mode,  sb2.st_mode)  << name;
+       EXPECT_EQ(sb1.st_nlink, sb2.st_nlink) << name;
+       EXPECT_EQ(sb1.st_uid,   sb2.st_uid)   << name;
+       EXPECT_EQ(sb1.st_gid,   sb2.st_gid)   << name;
+       EXPECT_EQ(sb1.st_rdev,  sb2.st_rdev)  << name;
+       EXPECT_EQ(sb1.st_size,  sb2.st_size)  << name;
+       EXPECT_EQ(sb1.st_blocks,sb2.st_blocks)<< name;
+       EXPECT_EQ(sb1.st_mtim.tv_sec,  sb2.st_mtim.tv_sec)  << name;
+       EXPECT_EQ(sb1.st_mtim.tv_nsec, sb2.st_mtim.tv_nsec) << name;
+       EXPECT_EQ(sb1.st_ctime, sb2.st_ctime) << name;
+       EXPECT_EQ(sb1.st_atime, sb2.st_atime) << name;
+      }
+  EXPECT_EQ(ENOENT, XrdOssDirStat::StatAt(dfd, "nope", &sb2));
+  close(dfd);
+}
+
+// Compare listing with stat one entry at a time against batched listing
+//
+TEST_F(XrdOssDirStatTests, Rate)
+{
+  const int nFiles = 20000;
+  struct stat sb;
+  struct dirent *rp;
+  Make(nFiles);
+
+  DIR *dP = opendir(dir.c_str());
+  while((rp = readdir(dP))) ASSERT_EQ(0, fstatat(dirfd(dP), rp->d_name, &sb, 0));
+  closedir(dP);
+
+  auto tA = std::chrono::steady_clock::now();
+  dP = opendir(dir.c_str());
+  while((rp = readdir(dP)))
+       ASSERT_EQ(0, XrdOssDirStat::StatAt(dirfd(dP), rp->d_name, &sb));
+  closedir(dP);
+  auto t0 = std::chrono::steady_clock::now();
+  dP = opendir(dir.c_str());
+  while((rp = readdir(dP))) ASSERT_EQ(0, fstatat(dirfd(dP), rp->d_name, &sb, 0));
+  closedir(dP);
+  auto t1 = std::chrono::steady_clock::now();
+  dP = opendir(dir.c_str());
+  {XrdOssDirStat ds(dP);
+   char buff[512];
+   do {ASSERT_EQ(0, ds.Next(buff, sizeof(buff), &sb));} while(*buff);
+  }
+  closedir(dP);
+  auto t2 = std::chrono::steady_clock::now();
+
+  printf("serial StatAt %.0f/s fstatat %.0f/s batched %.0f/s\n",
+         nFiles/std::chrono::duration<double>(t0 - tA).count(),
+         nFiles/std::chrono::duration<double>(t1 - t0).count(),
+         nFiles/std::chrono::duration<double>(t2 - t1).count());
+}
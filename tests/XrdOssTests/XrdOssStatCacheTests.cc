@@ -0,0 +1,276 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "XrdOss/XrdOss.hh"
+#include "XrdOss/XrdOssDefaultSS.hh"
+#include "XrdOss/XrdOssStatCache.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdVersion.hh"
+
+using namespace testing;
+
+namespace
+{
+class XrdOssStatCacheTests : public Test
+{
+protected:
+
+void SetUp() override
+{
+  char tmpl[] = "/tmp/xrdossscXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(tmpl));
+  dir  = tmpl;
+  file = dir + "/file";
+  Make(file, 10);
+}
+
+void TearDown() override
+{
+  unlink(file.c_str());
+  rmdir(dir.c_str());
+}
+
+static void Make(const std::string &path, int len)
+{
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(0, ftruncate(fd, len));
+  close(fd);
+}
+
+// Metrics must outlive the process, so caches are never deleted.
+//
+static XrdOssStatCache *NewCache(int maxEnt=1024, int ttl=60000, int nttl=60000)
+  {return new XrdOssStatCache(maxEnt, ttl, nttl);}
+
+std::string dir;
+std::string file;
+};
+}
+
+TEST_F(XrdOssStatCacheTests, Hit)
+{
+  XrdOssStatCache *scP = NewCache();
+  struct stat sb;
+
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(10, sb.st_size);
+
+// Change the file behind the cache's back; the cached size is returned.
+//
+  Make(file, 20);
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(10, sb.st_size);
+
+// Trailing slashes name the same entry.
+//
+  ASSERT_EQ(0, scP->Stat(dir.c_str(), &sb));
+  scP->Invalidate((dir + "//").c_str());
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(10, sb.st_size);
+  scP->Invalidate(file.c_str());
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(20, sb.st_size);
+}
+
+TEST_F(XrdOssStatCacheTests, Negative)
+{
+  XrdOssStatCache *scP = NewCache();
+  std::string nofile = dir + "/nofile";
+  struct stat sb;
+
+  errno = 0;
+  EXPECT_EQ(-1, scP->Stat(nofile.c_str(), &sb));
+  EXPECT_EQ(ENOENT, errno);
+
+// The file now exists but the negative entry still hides it.
+//
+  Make(nofile, 1);
+  errno = 0;
+  EXPECT_EQ(-1, scP->Stat(nofile.c_str(), &sb));
+  EXPECT_EQ(ENOENT, errno);
+
+  scP->Invalidate(nofile.c_str());
+  EXPECT_EQ(0, scP->Stat(nofile.c_str(), &sb));
+  unlink(nofile.c_str());
+}
+
+TEST_F(XrdOssStatCacheTests, Expiry)
+{
+  XrdOssStatCache *scP = NewCache(1024, 50, 50);
+  struct stat sb;
+
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  Make(file, 30);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(30, sb.st_size);
+}
+
+TEST_F(XrdOssStatCacheTests, Parents)
+{
+  XrdOssStatCache *scP = NewCache();
+  struct stat sb;
+  time_t mtime;
+
+  ASSERT_EQ(0, scP->Stat(dir.c_str(), &sb));
+  mtime = sb.st_mtime;
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+
+// Dropping the file alone leaves its directory cached; with parents both go.
+//
+  scP->Invalidate(file.c_str());
+  ASSERT_EQ(0, chmod(dir.c_str(), 0750));
+  ASSERT_EQ(0, scP->Stat(dir.c_str(), &sb));
+  EXPECT_EQ(0700u, sb.st_mode & 0777);
+  EXPECT_EQ(mtime, sb.st_mtime);
+  scP->Invalidate(file.c_str(), true);
+  ASSERT_EQ(0, scP->Stat(dir.c_str(), &sb));
+  EXPECT_EQ(0750u, sb.st_mode & 0777);
+}
+
+TEST_F(XrdOssStatCacheTests, Pinned)
+{
+  XrdOssStatCache *scP = NewCache();
+  struct stat sb;
+
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(10, sb.st_size);
+
+// While pinned, and pins nest, every stat goes to the filesystem.
+//
+  scP->Pin(file.c_str());
+  scP->Pin(file.c_str());
+  Make(file, 20);
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(20, sb.st_size);
+  scP->UnPin(file.c_str());
+  Make(file, 30);
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(30, sb.st_size);
+
+// Once the last pin is gone the path is cached again.
+//
+  scP->UnPin(file.c_str());
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  Make(file, 40);
+  ASSERT_EQ(0, scP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(30, sb.st_size);
+}
+
+// Write through the oss while stat'ing the file through it; the size must
+// always be current, whatever way the data was written.
+//
+TEST_F(XrdOssStatCacheTests, OssWrite)
+{
+  XrdVERSIONINFODEF(myVer, ossstatcachetest, XrdVNUMBER, XrdVERSION);
+  static XrdSysLogger logger(open("/dev/null", O_WRONLY), 0);
+  std::string cfn = dir + "/oss.cf";
+  XrdOucEnv env;
+  struct stat sb;
+  char buff[4096];
+
+  FILE *cfp = fopen(cfn.c_str(), "w");
+  ASSERT_NE(nullptr, cfp);
+  fprintf(cfp, "all.export / statcache\noss.statcache ttl 60000\n");
+  fclose(cfp);
+  setenv("XRDINSTANCE", "xrootd anon@localhost", 0);
+  XrdOss *ossP = XrdOssDefaultSS(&logger, cfn.c_str(), myVer);
+  unlink(cfn.c_str());
+  ASSERT_NE(nullptr, ossP);
+
+  ASSERT_EQ(0, ossP->Stat(file.c_str(), &sb));
+  Make(file, 15);
+  ASSERT_EQ(0, ossP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(10, sb.st_size);
+
+  XrdOssDF *fP = ossP->newFile("test");
+  ASSERT_EQ(0, fP->Open(file.c_str(), O_RDWR, 0, env));
+  memset(buff, 'x', sizeof(buff));
+  ASSERT_EQ(100, fP->Write(buff, 0, 100));
+  ASSERT_EQ(0, ossP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(100, sb.st_size);
+  ASSERT_EQ(200, fP->Write(buff, 100, 200));
+  ASSERT_EQ(0, ossP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(300, sb.st_size);
+
+  uint32_t csvec[1] = {0};
+  ASSERT_EQ(4096, fP->pgWrite(buff, 4096, 4096, csvec, 0));
+  ASSERT_EQ(0, ossP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(8192, sb.st_size);
+
+  ASSERT_EQ(0, fP->Ftruncate(50));
+  ASSERT_EQ(0, ossP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(50, sb.st_size);
+  ASSERT_EQ(0, fP->Close());
+  delete fP;
+
+// After the close the file is cached again.
+//
+  ASSERT_EQ(0, ossP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(50, sb.st_size);
+  Make(file, 60);
+  ASSERT_EQ(0, ossP->Stat(file.c_str(), &sb));
+  EXPECT_EQ(50, sb.st_size);
+}
+
+TEST_F(XrdOssStatCacheTests, Bounded)
+{
+  XrdOssStatCache *scP = NewCache(64);
+  struct stat sb;
+  char buff[1024];
+
+// With one entry per shard, many distinct paths must evict.
+//
+  for (int i = 0; i < 1000; i++)
+      {std::string path = dir + "/none" + std::to_string(i);
+       scP->Stat(path.c_str(), &sb);
+      }
+  ASSERT_GT(scP->Stats(buff, sizeof(buff)), 0);
+  long long ent = -1, evct = -1;
+  sscanf(strstr(buff, "<ent>"), "<ent>%lld", &ent);
+  sscanf(strstr(buff, "<evct>"), "<evct>%lld", &evct);
+  EXPECT_LE(ent, 64);
+  EXPECT_EQ(1000 - ent, evct);
+  EXPECT_GE(scP->Stats(nullptr, 0), (int)strlen(buff));
+}
+
+// Compare the stat rate through the cache with that of plain stat(2) on a
+// path several directories deep.
+//
+TEST_F(XrdOssStatCacheTests, Rate)
+{
+  XrdOssStatCache *scP = NewCache();
+  std::string deep = dir;
+  struct stat sb;
+  const int iters = 200000;
+
+  for (int i = 0; i < 6; i++) {deep += "/d"; mkdir(deep.c_str(), 0755);}
+  std::string leaf = deep + "/leaf";
+  Make(leaf, 1);
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; i++) ASSERT_EQ(0, stat(leaf.c_str(), &sb));
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; i++) ASSERT_EQ(0, scP->Stat(leaf.c_str(), &sb));
+  auto t2 = std::chrono::steady_clock::now();
+
+  double tsys = std::chrono::duration<double>(t1 - t0).count();
+  double tsc  = std::chrono::duration<double>(t2 - t1).count();
+  printf("stat(2) %.0f/s cached %.0f/s\n", iters/tsys, iters/tsc);
+
+  unlink(leaf.c_str());
+  while(deep != dir) {rmdir(deep.c_str()); deep.erase(deep.rfind('/'));}
+}
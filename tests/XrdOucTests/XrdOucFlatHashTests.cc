@@ -0,0 +1,178 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "XrdOuc/XrdOucFlatHash.hh"
+#include "XrdOuc/XrdOucHash.hh"
+
+using namespace testing;
+
+namespace
+{
+struct Counted
+{
+static int alive;
+int        val;
+           Counted(int v) : val(v) {alive++;}
+          ~Counted() {alive--;}
+};
+int Counted::alive = 0;
+
+int Sum(const char *, Counted *data, void *arg)
+{
+   *static_cast<long long *>(arg) += data->val;
+   return 0;
+}
+
+int DropOdd(const char *, Counted *data, void *)
+{
+   return (data->val & 1 ? -1 : 0);
+}
+
+std::string Key(int i) {return "/store/user/file" + std::to_string(i);}
+}
+
+TEST(XrdOucFlatHash, AddFindDel)
+{
+  XrdOucFlatHash<Counted> hash;
+
+  EXPECT_EQ(nullptr, hash.Add("a", new Counted(1)));
+  Counted *dup = new Counted(2);
+  EXPECT_EQ(1, hash.Add("a", dup)->val);
+  delete dup;
+  EXPECT_EQ(1, hash.Find("a")->val);
+  EXPECT_EQ(nullptr, hash.Find("b"));
+  EXPECT_EQ(1, hash.Num());
+
+  EXPECT_EQ(nullptr, hash.Rep("a", new Counted(3)));
+  EXPECT_EQ(3, hash.Find("a")->val);
+  EXPECT_EQ(1, Counted::alive);
+
+  EXPECT_EQ(0, hash.Del("a"));
+  EXPECT_EQ(-ENOENT, hash.Del("a"));
+  EXPECT_EQ(0, Counted::alive);
+  EXPECT_EQ(0, hash.Num());
+}
+
+TEST(XrdOucFlatHash, Options)
+{
+  XrdOucFlatHash<char> names;
+  static char key[] = "kept";
+
+  names.Add("dup", 0, 0, Hash_data_is_key);
+  EXPECT_STREQ("dup", names.Find("dup"));
+
+  names.Add(key, 0, 0, (XrdOucHash_Options)(Hash_keep|Hash_data_is_key));
+  EXPECT_EQ(key, names.Find("kept"));
+  EXPECT_EQ(0, names.Del("kept"));
+  EXPECT_STREQ("kept", key);
+
+// Counted entries need as many deletions as additions
+//
+  names.Add("cnt", 0, 0, (XrdOucHash_Options)(Hash_count|Hash_data_is_key));
+  names.Add("cnt", 0, 0, (XrdOucHash_Options)(Hash_count|Hash_data_is_key));
+  EXPECT_EQ(0, names.Del("cnt"));
+  EXPECT_NE(nullptr, names.Find("cnt"));
+  EXPECT_EQ(0, names.Del("cnt"));
+  EXPECT_EQ(nullptr, names.Find("cnt"));
+
+// Data released with free() and expired entries
+//
+  names.Add("freed", strdup("data"), 0, Hash_dofree);
+  EXPECT_STREQ("data", names.Find("freed"));
+  names.Add("old", 0, -1, Hash_data_is_key);
+  time_t when = 1;
+  EXPECT_EQ(nullptr, names.Find("old", &when));
+  EXPECT_EQ(0, when);
+  EXPECT_EQ(2, names.Num());
+}
+
+// Grow well past the initial size with deletions along the way so that
+// lookups span tables being drained and tombstones get reclaimed.
+//
+TEST(XrdOucFlatHash, Growth)
+{
+  const int n = 50000;
+  XrdOucFlatHash<Counted> hash(8, 16);
+  long long sum = 0, want = 0;
+
+  for (int i = 0; i < n; i++)
+      {ASSERT_EQ(nullptr, hash.Add(Key(i).c_str(), new Counted(i)));
+       if (i % 3 == 0) {ASSERT_EQ(0, hash.Del(Key(i/2).c_str()));}
+       if (i % 1000 == 0)
+          for (int j = 0; j <= i; j += 97)
+              {Counted *cp = hash.Find(Key(j).c_str());
+               if (cp) {ASSERT_EQ(j, cp->val);}
+              }
+      }
+  EXPECT_EQ(Counted::alive, hash.Num());
+
+  for (int i = 0; i < n; i++) if (hash.Find(Key(i).c_str())) want += i;
+  hash.Apply(Sum, &sum);
+  EXPECT_EQ(want, sum);
+
+  hash.Apply(DropOdd, 0);
+  for (int i = 1; i < n; i += 2) ASSERT_EQ(nullptr, hash.Find(Key(i).c_str()));
+  EXPECT_EQ(Counted::alive, hash.Num());
+
+  for (int i = 0; i < 4*n; i++)
+      {hash.Rep("churn", new Counted(i));
+       hash.Rep(Key(n + i%64).c_str(), new Counted(i));
+       hash.Del(Key(n + (i+32)%64).c_str());
+      }
+  EXPECT_EQ(Counted::alive, hash.Num());
+
+  hash.Purge();
+  EXPECT_EQ(0, hash.Num());
+  EXPECT_EQ(0, Counted::alive);
+}
+
+/******************************************************************************/
+/*                           B e n c h m a r k s                              */
+/******************************************************************************/
+
+namespace
+{
+template<class H>
+void Bench(const char *name, int n)
+{
+  std::vector<std::string> keys, miss;
+  for (int i = 0; i < n; i++)
+      {keys.push_back(Key(i)); miss.push_back(Key(i) + ".x");}
+
+  H *hash = new H;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; i++) hash->Add(keys[i].c_str(), 0, 0, Hash_data_is_key);
+  auto t1 = std::chrono::steady_clock::now();
+  for (int r = 0; r < 4; r++)
+      for (int i = 0; i < n; i++)
+          if (!hash->Find(keys[(i*7919) % n].c_str())) abort();
+  auto t2 = std::chrono::steady_clock::now();
+  for (int r = 0; r < 4; r++)
+      for (int i = 0; i < n; i++)
+          if (hash->Find(miss[i].c_str())) abort();
+  auto t3 = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; i++) hash->Del(keys[i].c_str());
+  auto t4 = std::chrono::steady_clock::now();
+  delete hash;
+
+  auto ns = [](std::chrono::steady_clock::duration d, int ops)
+              {return std::chrono::duration<double, std::nano>(d).count()/ops;};
+  printf("%-14s %7d keys: add %6.1f hit %6.1f miss %6.1f del %6.1f ns\n",
+         name, n, ns(t1-t0, n), ns(t2-t1, 4*n), ns(t3-t2, 4*n), ns(t4-t3, n));
+}
+}
+
+TEST(XrdOucFlatHash, Benchmark)
+{
+  for (int n : {100, 10000, 100000})
+      {Bench<XrdOucHash<char>>    ("XrdOucHash",     n);
+       Bench<XrdOucFlatHash<char>>("XrdOucFlatHash", n);
+      }
+}
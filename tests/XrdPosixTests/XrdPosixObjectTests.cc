@@ -0,0 +1,190 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "XrdPosix/XrdPosixFile.hh"
+#include "XrdPosix/XrdPosixObject.hh"
+
+using namespace testing;
+
+namespace
+{
+static constexpr int numFD = 64;
+
+// Use virtual file descriptors so that the tests do not consume real ones
+//
+int baseFD()
+{
+  static int base = XrdPosixObject::Init(-4096);
+  return base;
+}
+
+XrdPosixFile *newFile()
+{
+  bool aOK;
+  if (baseFD() <= 0) return 0;
+  XrdPosixFile *fP = new XrdPosixFile(aOK, "root://localhost//dummy");
+  if (!fP->AssignFD()) {delete fP; return 0;}
+  return fP;
+}
+
+void delFile(XrdPosixFile *fP)
+{
+  ASSERT_EQ(fP, XrdPosixObject::ReleaseFile(fP->FDNum()));
+  delete fP;
+}
+}
+
+TEST(XrdPosixObjectTests, LookupAndRelease) {
+  ASSERT_GT(baseFD(), 0);
+
+  XrdPosixFile *fP = newFile();
+  ASSERT_NE(nullptr, fP);
+  int fd = fP->FDNum();
+  ASSERT_TRUE(XrdPosixObject::Valid(fd));
+
+  XrdPosixFile *gP = XrdPosixObject::File(fd);
+  ASSERT_EQ(fP, gP);
+  gP->UnLock();
+  ASSERT_EQ(nullptr, XrdPosixObject::Dir(fd));
+  ASSERT_EQ(EBADF, errno);
+
+  delFile(fP);
+  ASSERT_FALSE(XrdPosixObject::Valid(fd));
+  ASSERT_EQ(nullptr, XrdPosixObject::File(fd));
+  ASSERT_EQ(EBADF, errno);
+  ASSERT_EQ(nullptr, XrdPosixObject::File(baseFD() - 1));
+}
+
+TEST(XrdPosixObjectTests, ConcurrentLookupAndClose) {
+  std::vector<XrdPosixFile *> files;
+  for (int i = 0; i < numFD; i++) files.push_back(newFile());
+  const int fd0 = files[0]->FDNum();
+
+  // Readers look up random descriptors while another thread keeps closing
+  // and reopening them. A lookup must either fail or return a live object
+  // that still owns the descriptor.
+  std::atomic<bool> stop{false};
+  std::atomic<long long> bad{0}, hits{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++)
+    readers.emplace_back([&, t]{
+      unsigned int r = t;
+      while (!stop.load()) {
+        r = r * 1103515245 + 12345;
+        int fd = fd0 + (r >> 8) % numFD;
+        XrdPosixFile *fP = XrdPosixObject::File(fd);
+        if (fP) {
+          if (fP->FDNum() != fd) bad++;
+          hits++;
+          fP->UnLock();
+        }
+      }
+    });
+
+  auto endT = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+  int n = 0;
+  while (std::chrono::steady_clock::now() < endT) {
+    int i = n++ % numFD;
+    delFile(files[i]);
+    files[i] = newFile();
+    ASSERT_NE(nullptr, files[i]);
+  }
+  stop = true;
+  for (auto &t : readers) t.join();
+  for (auto fP : files) delFile(fP);
+
+  ASSERT_EQ(0, bad.load());
+  ASSERT_GT(hits.load(), 0);
+}
+
+TEST(XrdPosixObjectTests, ConcurrentLookupAndRelease) {
+  static constexpr int numHot = 4;
+  std::vector<XrdPosixFile *> files;
+  for (int i = 0; i < numHot; i++) files.push_back(newFile());
+  const int fd0 = files[0]->FDNum();
+
+  // Many readers crowd a few descriptors whose objects are released and
+  // deleted as fast as possible, so that lookups keep straddling the epoch
+  // flips in Release(). A lookup must never touch an object after Release()
+  // returned; run under a sanitizer this shows up as a use after free.
+  std::atomic<bool> stop{false};
+  std::atomic<long long> bad{0}, hits{0}, released{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 8; t++)
+    readers.emplace_back([&, t]{
+      unsigned int r = t;
+      while (!stop.load()) {
+        r = r * 1103515245 + 12345;
+        int fd = fd0 + (r >> 8) % (numHot*2);
+        XrdPosixFile *fP = XrdPosixObject::File(fd);
+        if (fP) {
+          if (fP->FDNum() != fd) bad++;
+          hits++;
+          fP->UnLock();
+        }
+      }
+    });
+
+  std::thread releaser([&]{
+    auto endT = std::chrono::steady_clock::now()
+              + std::chrono::milliseconds(500);
+    int n = 0;
+    while (std::chrono::steady_clock::now() < endT) {
+      int i = n++ % numHot;
+      XrdPosixFile *oldP = files[i], *newP = newFile();
+      if (!newP) {bad++; break;}
+      files[i] = newP;
+      delFile(oldP);
+      released++;
+    }
+  });
+
+  releaser.join();
+  stop = true;
+  for (auto &t : readers) t.join();
+  for (auto fP : files) delFile(fP);
+
+  ASSERT_EQ(0, bad.load());
+  ASSERT_GT(hits.load(), 0);
+  ASSERT_GT(released.load(), 0);
+}
+
+TEST(XrdPosixObjectTests, LookupScaling) {
+  std::vector<XrdPosixFile *> files;
+  for (int i = 0; i < numFD; i++) files.push_back(newFile());
+  const int fd0 = files[0]->FDNum();
+
+  // Report the lookup rate as the number of threads grows; with a lock-free
+  // table it should scale rather than collapse.
+  for (int nThreads : {1, 2, 4, 8}) {
+    std::atomic<bool> stop{false};
+    std::atomic<long long> total{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; t++)
+      threads.emplace_back([&, t]{
+        long long n = 0;
+        int fd = fd0 + t*8;
+        while (!stop.load(std::memory_order_relaxed)) {
+          XrdPosixFile *fP = XrdPosixObject::File(fd + (n & 7));
+          if (fP) fP->UnLock();
+          n++;
+        }
+        total += n;
+      });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    stop = true;
+    for (auto &t : threads) t.join();
+    std::cout << nThreads << " thread(s): " << total.load() * 5
+              << " lookups/s" << std::endl;
+    ASSERT_GT(total.load(), 0);
+  }
+
+  for (auto fP : files) delFile(fP);
+}
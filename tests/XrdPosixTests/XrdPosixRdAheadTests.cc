@@ -0,0 +1,376 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClFile.hh"
+#include "XrdCl/XrdClPlugInInterface.hh"
+#include "XrdCl/XrdClPlugInManager.hh"
+#include "XrdPosix/XrdPosixRdAhead.hh"
+
+using namespace testing;
+
+namespace
+{
+static constexpr long long fileSize = 256LL*1024*1024;
+static constexpr int       maxRead  = 16*1024*1024;
+static constexpr int       kb       = 1024;
+
+// Every file holds the same data, byte o being o % 251
+//
+const char *Pattern()
+{
+  static std::vector<char> pat = []
+         {std::vector<char> v(maxRead + 251);
+          for (size_t i = 0; i < v.size(); i++) v[i] = i % 251;
+          return v;
+         }();
+  return pat.data();
+}
+
+// Reads are answered from memory by a single thread, in the order issued and
+// after an optional delay standing in for the network. Reads may be held so
+// the tests can look at what is in flight.
+//
+class Server
+{
+public:
+
+void Queue(uint64_t offs, uint32_t len, void *buff, XrdCl::ResponseHandler *hP)
+{
+  std::lock_guard<std::mutex> lck(mtx);
+  reqs.push_back({offs, len, buff, hP});
+  issued++; lastLen = len;
+  if (len > maxLen) maxLen = len;
+  cv.notify_all();
+}
+
+void Hold(bool onoff)
+{
+  std::lock_guard<std::mutex> lck(mtx);
+  hold = onoff;
+  cv.notify_all();
+}
+
+// Wait until every read issued has been answered
+//
+void Drain()
+{
+  std::unique_lock<std::mutex> lck(mtx);
+  cv.wait(lck, [this]{return reqs.empty() && !busy;});
+}
+
+void Reset(int usec)
+{
+  std::lock_guard<std::mutex> lck(mtx);
+  hold = false; latency = usec; issued = 0; lastLen = maxLen = 0;
+}
+
+int      latency = 0;
+int      issued  = 0;
+uint32_t lastLen = 0;
+uint32_t maxLen  = 0;
+
+Server() {std::thread(&Server::Run, this).detach();}
+
+private:
+
+struct Req {uint64_t offs; uint32_t len; void *buff; XrdCl::ResponseHandler *hP;};
+
+void Run()
+{
+  std::unique_lock<std::mutex> lck(mtx);
+  while(true)
+       {cv.wait(lck, [this]{return !hold && !reqs.empty();});
+        Req req = reqs.front();
+        reqs.pop_front();
+        busy = true;
+        int usec = latency;
+        lck.unlock();
+        if (usec) std::this_thread::sleep_for(std::chrono::microseconds(usec));
+        uint32_t len = 0;
+        if ((long long)req.offs < fileSize)
+           {len = std::min((long long)req.len, fileSize - (long long)req.offs);
+            memcpy(req.buff, Pattern() + req.offs % 251, len);
+           }
+        XrdCl::AnyObject *rsp = new XrdCl::AnyObject;
+        rsp->Set(new XrdCl::ChunkInfo(req.offs, len, req.buff));
+        req.hP->HandleResponse(new XrdCl::XRootDStatus(), rsp);
+        lck.lock();
+        busy = false;
+        cv.notify_all();
+       }
+}
+
+std::mutex              mtx;
+std::condition_variable cv;
+std::deque<Req>         reqs;
+bool                    hold = false;
+bool                    busy = false;
+};
+
+Server &Srv()
+{
+  static Server *srv = new Server;
+  return *srv;
+}
+
+// The XrdCl file plug-in handing every read to the server above
+//
+class StubFile : public XrdCl::FilePlugIn
+{
+public:
+
+XrdCl::XRootDStatus Open(const std::string &, XrdCl::OpenFlags::Flags,
+                         XrdCl::Access::Mode, XrdCl::ResponseHandler *hP,
+                         uint16_t) override
+                        {hP->HandleResponse(new XrdCl::XRootDStatus(), 0);
+                         return XrdCl::XRootDStatus();
+                        }
+
+XrdCl::XRootDStatus Read(uint64_t offs, uint32_t len, void *buff,
+                         XrdCl::ResponseHandler *hP, uint16_t) override
+                        {Srv().Queue(offs, len, buff, hP);
+                         return XrdCl::XRootDStatus();
+                        }
+};
+
+class StubFactory : public XrdCl::PlugInFactory
+{
+public:
+XrdCl::FilePlugIn       *CreateFile(const std::string &) override
+                                   {return new StubFile;}
+XrdCl::FileSystemPlugIn *CreateFileSystem(const std::string &) override
+                                   {return 0;}
+};
+
+struct RaStats {long long fetched, hits, waste, mem;};
+
+class XrdPosixRdAheadTests : public Test
+{
+protected:
+
+void SetUp() override
+{
+  static bool regd = XrdCl::DefaultEnv::GetPlugInManager()
+                                    ->RegisterDefaultFactory(new StubFactory);
+  ASSERT_TRUE(regd);
+  Srv().Reset(0);
+  ASSERT_TRUE(file.Open("root://localhost//test",
+                        XrdCl::OpenFlags::Read).IsOK());
+  buff.resize(maxRead);
+}
+
+void TearDown() override
+{
+  Srv().Hold(false);
+  Srv().Drain();
+}
+
+RaStats Stats()
+{
+  char sbuff[256];
+  RaStats st{};
+  XrdPosixRdAhead::Stats(sbuff, sizeof(sbuff));
+  sscanf(sbuff, "<rdahead><fetched>%lld</fetched><hits>%lld</hits>"
+         "<waste>%lld</waste><mem>%lld</mem></rdahead>",
+         &st.fetched, &st.hits, &st.waste, &st.mem);
+  return st;
+}
+
+// Read as XrdPosixFile does, taking what read-ahead has and reading the rest;
+// returns the number of bytes taken from read-ahead.
+//
+int Read(XrdPosixRdAhead *raP, long long offs, int len)
+{
+  uint32_t bytes = 0;
+  bool eof;
+  int got = (raP ? raP->Read(buff.data(), offs, len, eof) : 0);
+  if (got < len)
+     {EXPECT_TRUE(file.Read(offs+got, len-got, buff.data()+got, bytes).IsOK());}
+  EXPECT_EQ(0, memcmp(buff.data(), Pattern() + offs % 251, len))
+            << "read at " << offs;
+  return got;
+}
+
+// Read the first total bytes sequentially; returns the MB/s achieved
+//
+double Stream(XrdPosixRdAhead *raP, int len, long long total)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (long long offs = 0; offs < total; offs += len) Read(raP, offs, len);
+  double secs = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+  return total / secs / (1024*1024);
+}
+
+XrdCl::File       file;
+std::vector<char> buff;
+};
+}
+
+// Each read served from prefetched data doubles the window, and with it the
+// size of the blocks prefetched, up to the maximum.
+//
+TEST_F(XrdPosixRdAheadTests, WindowDoubles)
+{
+  XrdPosixRdAhead::SetParms(64*kb, 1024*kb, 64*1024*kb);
+  XrdPosixRdAhead *raP = XrdPosixRdAhead::Attach(file, fileSize);
+  ASSERT_NE(nullptr, raP);
+  RaStats st = Stats();
+
+  EXPECT_EQ(0, Read(raP, 0, 16*kb));
+  Srv().Drain();
+  EXPECT_EQ(2, Srv().issued);
+  EXPECT_EQ((uint32_t)64*kb, Srv().maxLen);
+  int got = 0;
+  for (int i = 1; i < 200; i++) got += Read(raP, i*16*kb, 16*kb);
+  EXPECT_EQ((uint32_t)256*kb, Srv().maxLen);
+  EXPECT_EQ(199*16*kb, got);
+  EXPECT_EQ(st.hits + got, Stats().hits);
+  raP->Detach();
+}
+
+// A read elsewhere in the file collapses the window. Blocks in flight are
+// orphaned and freed as they arrive; nothing is prefetched until the file is
+// read sequentially again, and then a single minimum block at a time.
+//
+TEST_F(XrdPosixRdAheadTests, SeekCollapses)
+{
+  XrdPosixRdAhead::SetParms(64*kb, 1024*kb, 64*1024*kb);
+  XrdPosixRdAhead *raP = XrdPosixRdAhead::Attach(file, fileSize);
+  ASSERT_NE(nullptr, raP);
+  for (int i = 0; i < 100; i++) Read(raP, i*16*kb, 16*kb);
+  Srv().Drain();
+
+  bool eof;
+  int issued = Srv().issued;
+  Srv().Hold(true);
+  for (int i = 100; i < 116; i++)
+      EXPECT_EQ(16*kb, raP->Read(buff.data(), i*16*kb, 16*kb, eof));
+  EXPECT_LT(issued, Srv().issued);
+  RaStats st = Stats();
+  issued = Srv().issued;
+
+  EXPECT_EQ(0, raP->Read(buff.data(), 100*1024*kb, 16*kb, eof));
+  EXPECT_EQ(issued, Srv().issued);
+  EXPECT_LT(0, Stats().mem);
+  Srv().Hold(false);
+  Srv().Drain();
+  EXPECT_EQ(0, Stats().mem);
+  EXPECT_LT(st.waste, Stats().waste);
+
+  EXPECT_EQ(0, raP->Read(buff.data(), 100*1024*kb + 16*kb, 16*kb, eof));
+  EXPECT_EQ(issued + 1, Srv().issued);
+  EXPECT_EQ((uint32_t)64*kb, Srv().lastLen);
+  raP->Detach();
+}
+
+// All files share one memory budget and no prefetch is issued beyond it.
+//
+TEST_F(XrdPosixRdAheadTests, MemoryLimit)
+{
+  XrdPosixRdAhead::SetParms(64*kb, 1024*kb, 256*kb);
+  std::vector<XrdPosixRdAhead *> ra;
+  Srv().Hold(true);
+  for (int i = 0; i < 8; i++)
+      {ra.push_back(XrdPosixRdAhead::Attach(file, fileSize));
+       ASSERT_NE(nullptr, ra.back());
+       bool eof;
+       EXPECT_EQ(0, ra.back()->Read(buff.data(), 0, 16*kb, eof));
+      }
+  EXPECT_EQ(4, Srv().issued);
+  EXPECT_EQ(256*kb, Stats().mem);
+  Srv().Hold(false);
+
+  for (long long offs = 16*kb; offs < 4*1024*kb; offs += 16*kb)
+      {Read(ra[0], offs, 16*kb);
+       EXPECT_GE(256*kb, Stats().mem);
+      }
+  for (auto raP : ra) raP->Detach();
+  Srv().Drain();
+  EXPECT_EQ(0, Stats().mem);
+}
+
+// Detaching with prefetches in flight frees them, and the object, as they
+// complete.
+//
+TEST_F(XrdPosixRdAheadTests, DetachInFlight)
+{
+  XrdPosixRdAhead::SetParms(64*kb, 1024*kb, 64*1024*kb);
+  XrdPosixRdAhead *raP = XrdPosixRdAhead::Attach(file, fileSize);
+  ASSERT_NE(nullptr, raP);
+  for (int i = 0; i < 50; i++) Read(raP, i*16*kb, 16*kb);
+  Srv().Drain();
+
+  bool eof;
+  Srv().Hold(true);
+  int issued = Srv().issued;
+  for (int i = 50; i < 66; i++)
+      EXPECT_EQ(16*kb, raP->Read(buff.data(), i*16*kb, 16*kb, eof));
+  EXPECT_LT(issued, Srv().issued);
+  RaStats st = Stats();
+  raP->Detach();
+  EXPECT_LT(0, Stats().mem);
+  Srv().Hold(false);
+  Srv().Drain();
+  EXPECT_EQ(0, Stats().mem);
+  EXPECT_LT(st.waste, Stats().waste);
+}
+
+// Reads of at least a block are left to the caller; what was prefetched for
+// them is discarded.
+//
+TEST_F(XrdPosixRdAheadTests, LargeReadsBypass)
+{
+  XrdPosixRdAhead::SetParms(128*kb, 4096*kb, 64*1024*kb);
+  XrdPosixRdAhead *raP = XrdPosixRdAhead::Attach(file, fileSize);
+  ASSERT_NE(nullptr, raP);
+  RaStats st = Stats();
+
+  for (int i = 0; i < 32; i++) EXPECT_EQ(0, Read(raP, i*1024*kb, 1024*kb));
+  EXPECT_EQ(32, Srv().issued);
+  EXPECT_EQ(st.fetched, Stats().fetched);
+
+  long long offs = 32*1024*kb;
+  for (int i = 0; i < 4; i++, offs += 16*kb) Read(raP, offs, 16*kb);
+  Srv().Drain();
+  EXPECT_LT(0, Stats().mem);
+  int issued = Srv().issued;
+  EXPECT_EQ(0, Read(raP, offs, 1024*kb));
+  EXPECT_EQ(issued + 1, Srv().issued);
+  EXPECT_EQ(0, Stats().mem);
+  raP->Detach();
+}
+
+// Sequential throughput with and without read-ahead when each request takes
+// 200us to be answered.
+//
+TEST_F(XrdPosixRdAheadTests, Throughput)
+{
+  XrdPosixRdAhead::SetParms(128*kb, 4096*kb, 64*1024*kb);
+  Srv().Reset(200);
+
+  double small = Stream(0, 16*kb, 16*1024*kb);
+  XrdPosixRdAhead *raP = XrdPosixRdAhead::Attach(file, fileSize);
+  double smallRA = Stream(raP, 16*kb, 64*1024*kb);
+  raP->Detach();
+
+  double large = Stream(0, 1024*kb, 256*1024*kb);
+  raP = XrdPosixRdAhead::Attach(file, fileSize);
+  double largeRA = Stream(raP, 1024*kb, 256*1024*kb);
+  raP->Detach();
+
+  printf("16KB reads: %.0f MB/s, %.0f MB/s with read-ahead; "
+         "1MB reads: %.0f MB/s, %.0f MB/s with read-ahead\n",
+         small, smallRA, large, largeRA);
+  EXPECT_GT(smallRA, small * 2);
+}
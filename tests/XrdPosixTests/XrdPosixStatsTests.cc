@@ -0,0 +1,39 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include "XrdPosix/XrdPosixConfig.hh"
+#include "XrdPosix/XrdPosixRdAhead.hh"
+
+using namespace testing;
+
+// Format the statistics, with read-ahead enabled, into buffers of every size
+// up to the full length and check that nothing is written past the end.
+//
+TEST(XrdPosixStatsTests, Truncation) {
+  XrdPosixRdAhead::SetParms(64*1024, 1024*1024, 16*1024*1024);
+
+  int maxLen = XrdPosixConfig::Stats("test", 0, 0);
+  ASSERT_GT(maxLen, 0);
+
+  std::vector<char> full(maxLen);
+  int fLen = XrdPosixConfig::Stats("test", full.data(), maxLen);
+  ASSERT_GT(fLen, 0);
+  ASSERT_LT(fLen, maxLen);
+  ASSERT_NE(nullptr, strstr(full.data(), "<rdahead>"));
+  ASSERT_NE(nullptr, strstr(full.data(), "</stats>"));
+
+  for (int blen = 1; blen <= fLen+1; blen++)
+      {std::vector<char> buff(blen + 64, '#');
+       int n = XrdPosixConfig::Stats("test", buff.data(), blen);
+       ASSERT_GE(n, 0);
+       ASSERT_LT(n, blen);
+       ASSERT_EQ(n, (int)strlen(buff.data()));
+       ASSERT_EQ(0, strncmp(buff.data(), full.data(), n));
+       for (int i = blen; i < blen + 64; i++) ASSERT_EQ('#', buff[i]);
+      }
+
+  XrdPosixRdAhead::SetParms(0, 0, 0);
+}
@@ -0,0 +1,202 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "XrdSciTokens/XrdSciTokensCache.hh"
+
+using namespace testing;
+
+namespace
+{
+struct Claims
+{
+std::string subject;
+std::string scope;
+uint64_t    expiry;
+};
+
+// A local issuer that mints tokens and verifies them the way a plugin would,
+// with a deliberately slow keyed hash standing in for the signature check.
+//
+class LocalIssuer : public Test
+{
+protected:
+
+std::string Mint(const std::string &sub, const std::string &scope,
+                 uint64_t exp)
+           {std::string body = sub + "." + scope + "." + std::to_string(exp);
+            return body + "." + std::to_string(Sign(body));
+           }
+
+std::shared_ptr<Claims> Verify(const std::string &token)
+           {size_t dot = token.rfind('.');
+            if (dot == std::string::npos) return nullptr;
+            std::string body = token.substr(0, dot);
+            if (std::to_string(Sign(body)) != token.substr(dot+1)) return nullptr;
+            size_t d1 = body.find('.'), d2 = body.rfind('.');
+            return std::shared_ptr<Claims>(new Claims
+                   {body.substr(0, d1), body.substr(d1+1, d2-d1-1),
+                    std::stoull(body.substr(d2+1))});
+           }
+
+// Find the claims for a token, verifying and caching them when needed.
+//
+std::shared_ptr<Claims> Claim(XrdSciTokensCache<Claims> &cache,
+                              const std::string &token, uint64_t now)
+           {std::shared_ptr<Claims> cp = cache.Find(token, now);
+            if (cp) return cp;
+            auto t0 = std::chrono::steady_clock::now();
+            if (!(cp = Verify(token))) return nullptr;
+            auto t1 = std::chrono::steady_clock::now();
+            cache.Verified(std::chrono::duration_cast<std::chrono::nanoseconds>
+                           (t1 - t0).count());
+            cache.Add(token, cp, cp->expiry);
+            verifies++;
+            return cp;
+           }
+
+int verifies = 0;
+
+private:
+
+uint64_t Sign(const std::string &body)
+           {uint64_t h = 0x5ca1ab1e;
+            for (int r = 0; r < 2000; r++)
+                for (unsigned char c : body)
+                    {h ^= c + r; h *= 0x100000001b3ULL; h ^= h >> 29;}
+            return h;
+           }
+};
+}
+
+TEST_F(LocalIssuer, HitMiss)
+{
+  XrdSciTokensCache<Claims> cache("plugin=\"test1\"");
+  std::string tok = Mint("alice", "storage.read:/", 1000);
+
+  for (int i = 0; i < 10; i++)
+      {auto cp = Claim(cache, tok, 100);
+       ASSERT_TRUE(cp != nullptr);
+       EXPECT_EQ("alice", cp->subject);
+       EXPECT_EQ("storage.read:/", cp->scope);
+      }
+  EXPECT_EQ(1, verifies);
+
+  auto st = cache.GetStats();
+  EXPECT_EQ(9, st.hits);
+  EXPECT_EQ(1, st.misses);
+  EXPECT_EQ(1, st.entries);
+  EXPECT_EQ(1, st.verifies);
+  EXPECT_GT(st.verifyNS, 0);
+
+// A forged token is neither accepted nor cached
+//
+  std::string bad = tok;
+  bad[0] = 'b';
+  EXPECT_EQ(nullptr, Claim(cache, bad, 100));
+  EXPECT_EQ(1, cache.GetStats().entries);
+}
+
+TEST_F(LocalIssuer, Expiry)
+{
+  XrdSciTokensCache<Claims> cache("plugin=\"test2\"");
+  std::string tok1 = Mint("bob", "storage.read:/", 200);
+  std::string tok2 = Mint("bob", "storage.read:/", 500);
+
+  ASSERT_TRUE(Claim(cache, tok1, 100) != nullptr);
+  ASSERT_TRUE(Claim(cache, tok2, 100) != nullptr);
+  EXPECT_TRUE(cache.Find(tok1, 200) != nullptr);
+  EXPECT_EQ(nullptr, cache.Find(tok1, 201));
+  EXPECT_EQ(1, cache.GetStats().entries);
+
+  cache.Purge(501);
+  EXPECT_EQ(0, cache.GetStats().entries);
+  EXPECT_EQ(0, cache.GetStats().evicts);
+}
+
+TEST_F(LocalIssuer, Bounded)
+{
+  XrdSciTokensCache<Claims> cache("plugin=\"test3\"", 32);
+  std::string hot = Mint("hot", "storage.read:/", 1000);
+
+  ASSERT_TRUE(Claim(cache, hot, 0) != nullptr);
+  for (int i = 0; i < 1000; i++)
+      {ASSERT_TRUE(Claim(cache, Mint("u" + std::to_string(i),
+                                     "storage.read:/", 1000), 0) != nullptr);
+       ASSERT_TRUE(cache.Find(hot, 0) != nullptr);
+      }
+
+  auto st = cache.GetStats();
+  EXPECT_LE(st.entries, 32);
+  EXPECT_EQ(1001 - st.entries, st.evicts);
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.GetStats().entries);
+  EXPECT_EQ(nullptr, cache.Find(hot, 0));
+}
+
+TEST_F(LocalIssuer, Threads)
+{
+  XrdSciTokensCache<Claims> cache("plugin=\"test4\"", 64);
+  std::vector<std::string> toks;
+  std::atomic<int> wrong(0);
+
+  for (int i = 0; i < 200; i++)
+      toks.push_back(Mint("u" + std::to_string(i), "storage.read:/", 1000));
+
+  std::vector<std::thread> thr;
+  for (int t = 0; t < 8; t++)
+      thr.emplace_back([&, t]()
+          {for (int i = 0; i < 20000; i++)
+               {int k = (i * 7 + t * 13) % toks.size();
+                auto cp = cache.Find(toks[k], 0);
+                if (!cp)
+                   {size_t d1 = toks[k].find('.');
+                    cp.reset(new Claims{toks[k].substr(0, d1), "", 1000});
+                    cache.Add(toks[k], cp, 1000);
+                   }
+                if (cp->subject != "u" + std::to_string(k)) wrong++;
+               }
+          });
+  for (auto &th : thr) th.join();
+
+  EXPECT_EQ(0, wrong.load());
+  auto st = cache.GetStats();
+  EXPECT_EQ(8 * 20000, st.hits + st.misses);
+  EXPECT_LE(st.entries, 64);
+}
+
+TEST_F(LocalIssuer, Benchmark)
+{
+  XrdSciTokensCache<Claims> cache("plugin=\"test5\"");
+  std::vector<std::string> toks;
+  const int rounds = 50;
+
+  for (int i = 0; i < 100; i++)
+      toks.push_back(Mint("user" + std::to_string(i),
+                          "storage.read:/ storage.modify:/user" +
+                          std::to_string(i), 1000));
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (auto &tok : toks) ASSERT_TRUE(Claim(cache, tok, 0) != nullptr);
+  auto t1 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++)
+      for (auto &tok : toks) ASSERT_TRUE(Claim(cache, tok, 0) != nullptr);
+  auto t2 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(100, verifies);
+  double vns = std::chrono::duration<double, std::nano>(t1 - t0).count()
+             / toks.size();
+  double cns = std::chrono::duration<double, std::nano>(t2 - t1).count()
+             / (rounds * toks.size());
+  printf("verified %9.1f ns/request, cached %7.1f ns/request (%d requests)\n",
+         vns, cns, rounds * (int)toks.size());
+}
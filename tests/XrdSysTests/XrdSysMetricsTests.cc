@@ -0,0 +1,122 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "XrdSys/XrdSysMetrics.hh"
+
+using namespace testing;
+
+namespace
+{
+XrdSysMetrics::Counter   testCount("test_ops_total", "Operations.");
+XrdSysMetrics::Counter   testGauge("test_open", "Open things.", 0, true);
+XrdSysMetrics::Histogram testRead("test_latency_seconds", "Latency.",
+                                  "op=\"read\"");
+XrdSysMetrics::Histogram testWrite("test_latency_seconds", "Latency.",
+                                   "op=\"write\"");
+
+long long fortyTwo(void *) {return 42;}
+XrdSysMetrics::Probe     testProbe("test_probe", "Probed value.",
+                                   XrdSysMetrics::isGauge, fortyTwo);
+}
+
+TEST(XrdSysMetricsTests, CounterIsSummedAcrossThreads) {
+  long long before = testCount.Value();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++)
+    threads.emplace_back([]{for (int j = 0; j < 10000; j++) testCount.Add();});
+  for (auto &t : threads) t.join();
+  ASSERT_EQ(before + 80000, testCount.Value());
+
+  testGauge.Add(5);
+  testGauge.Sub(2);
+  ASSERT_EQ(3, testGauge.Value());
+}
+
+TEST(XrdSysMetricsTests, HistogramBins) {
+  using H = XrdSysMetrics::Histogram;
+  // Every value lands in a bin whose upper edge is above it and whose
+  // lower edge (the previous bin's upper edge) is at or below it.
+  for (unsigned long long us : {0ULL, 1ULL, 3ULL, 4ULL, 7ULL, 100ULL,
+                                12345ULL, 1000000ULL})
+    {
+      int bin = H::BinOf(us);
+      ASSERT_GT(H::BinUpper(bin), static_cast<double>(us));
+      if (bin > 0) {
+        ASSERT_LE(H::BinUpper(bin - 1), static_cast<double>(us));
+      }
+    }
+  ASSERT_EQ(H::numBins - 1, H::BinOf(~0ULL));
+
+  testRead.Record(1500000);   // 1.5ms
+  testRead.Record(3000);      // 3us
+  long long count, sum, bins[H::numBins];
+  testRead.Read(count, sum, bins);
+  ASSERT_EQ(2, count);
+  ASSERT_EQ(1503000, sum);
+  ASSERT_EQ(1, bins[3]);
+  ASSERT_EQ(1, bins[H::BinOf(1500)]);
+}
+
+TEST(XrdSysMetricsTests, PrometheusText) {
+  std::string text;
+  XrdSysMetrics::Prometheus(text);
+
+  ASSERT_NE(std::string::npos, text.find("# TYPE test_ops_total counter\n"));
+  ASSERT_NE(std::string::npos, text.find("# TYPE test_open gauge\n"));
+  ASSERT_NE(std::string::npos, text.find("test_probe 42\n"));
+  ASSERT_NE(std::string::npos,
+            text.find("test_latency_seconds_bucket{op=\"write\",le=\"+Inf\"} 0\n"));
+  ASSERT_NE(std::string::npos,
+            text.find("test_latency_seconds_count{op=\"write\"} 0\n"));
+
+  // Both label sets must be in a single family, announced once.
+  size_t first = text.find("# TYPE test_latency_seconds histogram");
+  ASSERT_NE(std::string::npos, first);
+  ASSERT_EQ(std::string::npos, text.find("# TYPE test_latency_seconds", first+1));
+  ASSERT_LT(text.find("{op=\"read\""), text.find("{op=\"write\""));
+}
+
+TEST(XrdSysMetricsTests, BinarySnapshot) {
+  int need = XrdSysMetrics::Binary(nullptr, 0);
+  ASSERT_GT(need, 32);
+  std::vector<int64_t> store(need / 8 + 1);
+  char *buff = reinterpret_cast<char *>(store.data());
+  ASSERT_EQ(need, XrdSysMetrics::Binary(buff, need));
+
+  ASSERT_EQ(0, memcmp(buff, "XRDM", 4));
+  uint32_t count, size;
+  memcpy(&count, buff + 24, 4);
+  memcpy(&size,  buff + 28, 4);
+  ASSERT_EQ(static_cast<uint32_t>(need), size);
+
+  // Walk the records looking for the probe.
+  bool found = false;
+  char *bP = buff + 32;
+  for (uint32_t i = 0; i < count; i++)
+    {
+      uint16_t kind, nlen;
+      uint32_t nvals;
+      memcpy(&kind, bP, 2); memcpy(&nlen, bP + 2, 2); memcpy(&nvals, bP + 4, 4);
+      const char *name = bP + 8;
+      int64_t *vals = reinterpret_cast<int64_t *>(bP + 8 + nlen);
+      if (!strcmp(name, "test_probe"))
+        {
+          found = true;
+          ASSERT_EQ(XrdSysMetrics::isGauge, kind);
+          ASSERT_EQ(1u, nvals);
+          ASSERT_EQ(42, vals[0]);
+        }
+      if (!strcmp(name, "test_latency_seconds{op=\"read\"}")) {
+        ASSERT_EQ(static_cast<uint32_t>(XrdSysMetrics::Histogram::numBins + 2), nvals);
+      }
+      bP += 8 + nlen + nvals * 8;
+    }
+  ASSERT_TRUE(found);
+  ASSERT_EQ(buff + need, bP);
+}
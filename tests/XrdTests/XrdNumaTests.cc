@@ -0,0 +1,136 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+
+#include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdNuma.hh"
+
+using namespace testing;
+
+namespace
+{
+// Build a small sysfs tree with two sparsely numbered nodes and a network
+// interface on the second one.
+//
+class XrdNumaTests : public Test
+{
+protected:
+
+void SetUp() override
+{
+  char tmpl[] = "/tmp/xrdnumaXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(tmpl));
+  root = tmpl;
+  MkFile("devices/system/node/node0/cpulist", "0-1,4\n");
+  MkFile("devices/system/node/node2/cpulist", "2-3\n");
+  MkFile("devices/system/node/online", "0,2\n");
+  MkFile("class/net/eth9/device/numa_node", "2\n");
+  MkFile("class/net/eth8/device/numa_node", "-1\n");
+  MkPath("class/net/lo");
+}
+
+void TearDown() override
+{
+  std::string cmd = "rm -rf " + root;
+  ASSERT_EQ(0, system(cmd.c_str()));
+  XrdNuma::Config(-1);
+}
+
+void MkPath(const std::string &path)
+{
+  std::string full = root;
+  size_t pos = 0;
+  while (pos != std::string::npos)
+       {pos = path.find('/', pos+1);
+        full = root + "/" + path.substr(0, pos);
+        mkdir(full.c_str(), 0755);
+       }
+}
+
+void MkFile(const std::string &path, const char *text)
+{
+  MkPath(path.substr(0, path.rfind('/')));
+  FILE *fP = fopen((root + "/" + path).c_str(), "w");
+  ASSERT_NE(nullptr, fP);
+  fputs(text, fP);
+  fclose(fP);
+}
+
+std::string root;
+};
+}
+
+TEST_F(XrdNumaTests, Topology) {
+  ASSERT_EQ(2, XrdNuma::Init(root.c_str()));
+
+  ASSERT_EQ(0, XrdNuma::NodeOfCPU(0));
+  ASSERT_EQ(0, XrdNuma::NodeOfCPU(1));
+  ASSERT_EQ(1, XrdNuma::NodeOfCPU(2));
+  ASSERT_EQ(1, XrdNuma::NodeOfCPU(3));
+  ASSERT_EQ(0, XrdNuma::NodeOfCPU(4));
+  ASSERT_EQ(-1, XrdNuma::NodeOfCPU(5));
+  ASSERT_EQ(-1, XrdNuma::NodeOfCPU(-1));
+
+  ASSERT_EQ(1, XrdNuma::NodeOfIF("eth9"));
+  ASSERT_EQ(-1, XrdNuma::NodeOfIF("eth8"));
+  ASSERT_EQ(-1, XrdNuma::NodeOfIF("lo"));
+}
+
+TEST_F(XrdNumaTests, Activation) {
+  XrdNuma::Config(-1);
+  ASSERT_EQ(2, XrdNuma::Init(root.c_str()));
+  ASSERT_FALSE(XrdNuma::Active());
+  ASSERT_EQ(0, XrdNuma::MyNode());
+  ASSERT_EQ(-1, XrdNuma::Pin());
+
+  XrdNuma::Config(0);
+  ASSERT_EQ(2, XrdNuma::Init(root.c_str()));
+  ASSERT_TRUE(XrdNuma::Active());
+  ASSERT_EQ(2, XrdNuma::Nodes());
+  ASSERT_EQ(-1, XrdNuma::Pin());
+
+  int node = XrdNuma::MyNode();
+  ASSERT_TRUE(node == 0 || node == 1);
+}
+
+TEST_F(XrdNumaTests, NoTopology) {
+  XrdNuma::Config(0);
+  ASSERT_EQ(0, XrdNuma::Init((root + "/missing").c_str()));
+  ASSERT_FALSE(XrdNuma::Active());
+  ASSERT_EQ(-1, XrdNuma::NodeOfCPU(0));
+  ASSERT_EQ(-1, XrdNuma::NodeOfSock(0));
+}
+
+TEST_F(XrdNumaTests, PinnedBuffers) {
+  char stats[1024];
+
+  // Put cpu 0, which always exists, on the first node so we can bind to it
+  //
+  MkFile("devices/system/node/node0/cpulist", "0\n");
+  XrdNuma::Config(1);
+  ASSERT_EQ(2, XrdNuma::Init(root.c_str()));
+
+  int node = XrdNuma::Pin();
+  ASSERT_EQ(0, node);
+  ASSERT_EQ(0, XrdNuma::MyNode());
+
+  // The buffer manager is never deleted as its reshaper thread refers to it
+  //
+  XrdBuffManager &bPool = *new XrdBuffManager;
+  bPool.Init();
+  XrdBuffer *bP = bPool.Obtain(8192);
+  ASSERT_NE(nullptr, bP);
+  bPool.Release(bP);
+  ASSERT_EQ(bP, bPool.Obtain(8192));
+  bPool.Release(bP);
+
+  ASSERT_GT(bPool.Stats(stats, sizeof(stats)), 0);
+  ASSERT_NE(nullptr, strstr(stats, "<numa><nodes>2</nodes><local>2</local>"
+                                   "<remote>0</remote></numa>")) << stats;
+  XrdNuma::Unpin(node);
+}
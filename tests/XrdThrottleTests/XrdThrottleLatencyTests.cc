@@ -0,0 +1,138 @@
+#undef NDEBUG
+
+#include "XrdThrottle/XrdThrottleLatency.hh"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <random>
+
+using namespace testing;
+
+class XrdThrottleLatencyTests : public Test {};
+
+namespace {
+
+// A small simulation of a server behind the throttle, used to tune the
+// latency controller offline.  Each interval, "opens" new files arrive, of
+// which the controller's fraction are shed; each admitted file then issues
+// "rate" IOs per interval for "lifetime" intervals.  The server completes
+// "capacity" IOs per interval; IO latency is modelled as the time to drain
+// any backlog plus an M/M/1 sojourn time at the current load.
+class ServerSim
+{
+public:
+   ServerSim(XrdThrottleLatency &ctl, double capacity, double rate, int lifetime)
+      : m_ctl(ctl), m_capacity(capacity), m_rate(rate), m_admitted(lifetime, 0) {}
+
+   // Run one interval; returns the p99 seen by the controller.
+   double Step(double opens)
+   {
+      m_admitted.pop_front();
+      m_admitted.push_back(opens * (1 - m_ctl.Fraction()));
+      double load = m_rate * std::accumulate(m_admitted.begin(), m_admitted.end(), 0.0);
+      m_backlog = std::max(0.0, m_backlog + load - m_capacity);
+      double spare = std::max(m_capacity - load, 0.02 * m_capacity);
+      std::exponential_distribution<double> sojourn(spare);
+      int samples = static_cast<int>(std::min(load, m_capacity));
+      for (int i = 0; i < samples; i++)
+         m_ctl.Record(m_backlog / m_capacity + sojourn(m_rng));
+      return m_ctl.Update();
+   }
+
+private:
+   XrdThrottleLatency &m_ctl;
+   double m_capacity;
+   double m_rate;
+   double m_backlog{0};
+   std::deque<double> m_admitted;
+   std::mt19937 m_rng{1234};
+};
+
+}
+
+TEST(XrdThrottleLatencyTests, intervals) {
+  XrdThrottleLatency ctl;
+  ctl.SetTarget(0.010);
+  // The histogram is cumulative but each update sees only its interval.
+  for (int i = 0; i < 30; i++) ctl.Record(0.100);
+  ctl.Update();
+  ASSERT_EQ(30u, ctl.Samples());
+  for (int i = 0; i < 25; i++) ctl.Record(0.001);
+  ASSERT_LT(ctl.Update(), 0.002);
+  ASSERT_EQ(25u, ctl.Samples());
+  ctl.Update();
+  ASSERT_EQ(0u, ctl.Samples());
+  // Controllers share one histogram; a new one starts from its current counts
+  // and one without a target records nothing.
+  for (int i = 0; i < 10; i++) ctl.Record(0.001);
+  XrdThrottleLatency other, off;
+  other.SetTarget(0.010);
+  for (int i = 0; i < 5; i++) off.Record(0.001);
+  ASSERT_EQ(0, off.Update());
+  ASSERT_EQ(0u, off.Samples());
+  other.Update();
+  ASSERT_EQ(0u, other.Samples());
+  ctl.Update();
+  ASSERT_EQ(10u, ctl.Samples());
+}
+
+TEST(XrdThrottleLatencyTests, percentile) {
+  XrdThrottleLatency ctl;
+  ctl.SetTarget(0.010);
+  for (int i = 0; i < 990; i++) ctl.Record(0.001);
+  for (int i = 0; i < 10; i++) ctl.Record(0.100);
+  // Exactly 1% of samples are slow: the p99 is in the fast bin.
+  ASSERT_LT(ctl.Update(), 0.002);
+  for (int i = 0; i < 980; i++) ctl.Record(0.001);
+  for (int i = 0; i < 20; i++) ctl.Record(0.100);
+  double p99 = ctl.Update();
+  ASSERT_GT(p99, 0.100);
+  ASSERT_LT(p99, 0.130);
+  // Too few samples to act on.
+  ctl.Record(1.0);
+  ASSERT_EQ(0, ctl.Update());
+}
+
+TEST(XrdThrottleLatencyTests, shedsUnderOverload) {
+  XrdThrottleLatency ctl;
+  ctl.SetTarget(0.050);
+  // Offered load is twice the capacity; meeting the target needs a little
+  // over half of the opens to be shed.
+  ServerSim sim(ctl, 1000, 10, 5);
+  double worst = 0, min_fraction = 1, max_fraction = 0;
+  for (int i = 0; i < 400; i++) {
+    double p99 = sim.Step(40);
+    if (i >= 300) {
+      worst = std::max(worst, p99);
+      min_fraction = std::min(min_fraction, ctl.Fraction());
+      max_fraction = std::max(max_fraction, ctl.Fraction());
+    }
+  }
+  ASSERT_LT(worst, 2 * ctl.Target());
+  ASSERT_GT(min_fraction, 0.45);
+  ASSERT_LT(max_fraction, 0.75);
+
+  // Once the overload goes away, so does the shedding.
+  for (int i = 0; i < 100; i++) sim.Step(10);
+  ASSERT_EQ(0, ctl.Fraction());
+}
+
+TEST(XrdThrottleLatencyTests, idleWithinTarget) {
+  XrdThrottleLatency ctl;
+  ctl.SetTarget(0.050);
+  ServerSim sim(ctl, 1000, 10, 5);
+  for (int i = 0; i < 200; i++) {
+    sim.Step(10);
+    ASSERT_EQ(0, ctl.Fraction());
+  }
+}
+
+TEST(XrdThrottleLatencyTests, maxFraction) {
+  XrdThrottleLatency ctl;
+  ctl.SetTarget(0.050, 0.2);
+  ServerSim sim(ctl, 1000, 10, 5);
+  for (int i = 0; i < 200; i++) sim.Step(40);
+  ASSERT_DOUBLE_EQ(0.2, ctl.Fraction());
+}
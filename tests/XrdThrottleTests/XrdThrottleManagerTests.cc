@@ -0,0 +1,191 @@
+#undef NDEBUG
+
+#include "XrdThrottle/XrdThrottleManager.hh"
+#include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+namespace {
+
+// The manager is driven directly, without Init(), so that no recompute
+// thread runs and classes stay active once they have seen a request.
+class XrdThrottleManagerTests : public Test
+{
+protected:
+
+   XrdThrottleManagerTests() : m_log(&m_logger, "test_"), m_trace(&m_log),
+                               m_mgr(&m_log, &m_trace) {}
+
+   // Throttle to the given data rate with a 100ms interval.
+   void Limit(float rate) {m_mgr.SetThrottles(rate, -1, -1, 0.1);}
+
+   // Issue requests of the given size on a file until the deadline; returns
+   // the bytes admitted.
+   double Stream(XrdThrottleManager::FileShare *share, int size, double secs)
+   {
+      auto end = Clock::now() + std::chrono::duration<double>(secs);
+      double bytes = 0;
+      while (Clock::now() < end)
+      {
+         m_mgr.Apply(size, 0, share);
+         bytes += size;
+      }
+      return bytes;
+   }
+
+   // Time taken to have count requests of the given size admitted.
+   double Elapsed(XrdThrottleManager::FileShare *share, int size, int count)
+   {
+      auto start = Clock::now();
+      for (int i = 0; i < count; i++) m_mgr.Apply(size, 0, share);
+      return std::chrono::duration<double>(Clock::now() - start).count();
+   }
+
+   using Clock = std::chrono::steady_clock;
+
+   XrdSysLogger       m_logger;
+   XrdSysError        m_log;
+   XrdOucTrace        m_trace;
+   XrdThrottleManager m_mgr;
+};
+
+}
+
+TEST_F(XrdThrottleManagerTests, Unthrottled)
+{
+   m_mgr.SetThrottles(-1, -1, -1, 0.1);
+   EXPECT_FALSE(m_mgr.IsThrottling());
+   auto share = m_mgr.OpenShare("cms", "alice");
+   for (int i = 0; i < 1000; i++) ASSERT_EQ(0, m_mgr.Apply(1 << 20, 1, share));
+   m_mgr.CloseShare(share);
+}
+
+// A file alone on the server may borrow the server's burst of one interval's
+// worth, after which it is paced at the full rate.
+TEST_F(XrdThrottleManagerTests, BurstThenPace)
+{
+   Limit(1e6);
+   EXPECT_TRUE(m_mgr.IsThrottling());
+   auto share = m_mgr.OpenShare("cms", "alice");
+   EXPECT_LT(Elapsed(share, 10000, 10), 0.02);
+   double secs = Elapsed(share, 10000, 40);
+   EXPECT_GT(secs, 0.35);
+   EXPECT_LT(secs, 0.5);
+   m_mgr.CloseShare(share);
+}
+
+// Without a share, requests are paced by the server bucket alone.
+TEST_F(XrdThrottleManagerTests, NoShare)
+{
+   Limit(1e6);
+   EXPECT_LT(Elapsed(nullptr, 10000, 10), 0.02);
+   double secs = Elapsed(nullptr, 10000, 40);
+   EXPECT_GT(secs, 0.35);
+   EXPECT_LT(secs, 0.5);
+}
+
+// Users of a VO share its rate equally, however many files each has open.
+TEST_F(XrdThrottleManagerTests, UserFairness)
+{
+   Limit(2e6);
+   std::vector<XrdThrottleManager::FileShare *> shares;
+   for (int i = 0; i < 3; i++) shares.push_back(m_mgr.OpenShare("cms", "alice"));
+   shares.push_back(m_mgr.OpenShare("cms", "bob"));
+
+   std::vector<double> bytes(shares.size());
+   std::vector<std::thread> threads;
+   for (size_t i = 0; i < shares.size(); i++)
+      threads.emplace_back([&, i]() {bytes[i] = Stream(shares[i], 5000, 0.8);});
+   for (auto &t : threads) t.join();
+
+   double alice = bytes[0] + bytes[1] + bytes[2], bob = bytes[3];
+   EXPECT_GT(alice / bob, 0.75);
+   EXPECT_LT(alice / bob, 1.33);
+   // The server as a whole stays within its limit, plus one interval's burst
+   EXPECT_LT(alice + bob, 2e6 * 0.9 + 2e6 * 0.1 * shares.size());
+   for (auto share : shares) m_mgr.CloseShare(share);
+}
+
+// VOs share the rate according to their weights.
+TEST_F(XrdThrottleManagerTests, VOWeights)
+{
+   std::string atlas = "atlas";
+   m_mgr.SetWeight(true, atlas, 3);
+   Limit(2e6);
+   auto heavy = m_mgr.OpenShare("atlas", "alice");
+   auto light = m_mgr.OpenShare("cms", "bob");
+
+   double hbytes = 0, lbytes = 0;
+   std::thread t1([&]() {hbytes = Stream(heavy, 5000, 0.8);});
+   std::thread t2([&]() {lbytes = Stream(light, 5000, 0.8);});
+   t1.join();
+   t2.join();
+
+   EXPECT_GT(hbytes / lbytes, 2.3);
+   EXPECT_LT(hbytes / lbytes, 3.9);
+   m_mgr.CloseShare(heavy);
+   m_mgr.CloseShare(light);
+}
+
+// A share left unused by an active class is borrowed by the busy one while
+// the server has capacity to spare.
+TEST_F(XrdThrottleManagerTests, Borrow)
+{
+   Limit(1e6);
+   auto busy = m_mgr.OpenShare("cms", "alice");
+   auto idle = m_mgr.OpenShare("cms", "bob");
+   m_mgr.Apply(1, 0, idle);
+
+   Elapsed(busy, 10000, 10);
+   double secs = Elapsed(busy, 10000, 40);
+   EXPECT_GT(secs, 0.35);
+   EXPECT_LT(secs, 0.55);
+   m_mgr.CloseShare(busy);
+   m_mgr.CloseShare(idle);
+}
+
+// Files are opened and closed while many users issue requests; the total
+// admitted stays within the server's limit, but for the first request on
+// each file, which is never delayed.
+TEST_F(XrdThrottleManagerTests, Concurrent)
+{
+   const int users = 16;
+   Limit(4e6);
+   std::atomic<bool> done{false};
+   std::atomic<int> opens{0};
+   std::vector<double> bytes(users);
+   std::vector<std::thread> threads;
+   for (int i = 0; i < users; i++)
+      threads.emplace_back([&, i]()
+         {std::string user = "user" + std::to_string(i);
+          while (!done)
+          {
+             auto share = m_mgr.OpenShare(i % 2 ? "cms" : "atlas", user);
+             opens++;
+             for (int k = 0; k < 5; k++)
+             {
+                m_mgr.Apply(4000, 0, share);
+                bytes[i] += 4000;
+             }
+             m_mgr.CloseShare(share);
+          }
+         });
+   auto start = Clock::now();
+   std::this_thread::sleep_for(std::chrono::milliseconds(600));
+   done = true;
+   for (auto &t : threads) t.join();
+   double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+   double total = 0;
+   for (auto b : bytes) total += b;
+   EXPECT_LT(total, 4e6 * (secs + 0.1) + opens * 4000);
+   EXPECT_GT(total, 4e6 * secs * 0.5);
+}
@@ -0,0 +1,306 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "XrdTls/XrdTlsContext.hh"
+#include "XrdTls/XrdTlsSocket.hh"
+
+using namespace testing;
+
+namespace
+{
+// Makes a self-signed certificate for the server, which the client also uses
+// as its CA file, and runs connections over socket pairs.
+//
+class TlsResume : public Test
+{
+protected:
+
+static void SetUpTestSuite()
+           {char dtemp[] = "/tmp/xrdtls-test-XXXXXX";
+            ASSERT_TRUE(mkdtemp(dtemp) != nullptr);
+            tDir = dtemp;
+            certFN = tDir + "/cert.pem";
+            keyFN  = tDir + "/key.pem";
+            ASSERT_TRUE(MakeCert());
+            unsetenv("X509_USER_PROXY");
+            unsetenv("X509_USER_KEY");
+           }
+
+static void TearDownTestSuite()
+           {unlink(certFN.c_str());
+            unlink(keyFN.c_str());
+            rmdir(tDir.c_str());
+           }
+
+XrdTlsContext *Server()
+           {XrdTlsContext *ctx = new XrdTlsContext(certFN.c_str(),
+                                   keyFN.c_str(), 0, 0, XrdTlsContext::servr);
+            EXPECT_TRUE(ctx->isOK());
+            ctx->SessionCache(XrdTlsContext::scSrvr, "xrdtls-test", 11);
+            return ctx;
+           }
+
+XrdTlsContext *Client()
+           {XrdTlsContext *ctx = new XrdTlsContext(0, 0, 0, certFN.c_str());
+            EXPECT_TRUE(ctx->isOK());
+            ctx->SessionCache(XrdTlsContext::scClnt);
+            return ctx;
+           }
+
+// Run one connection and exchange a byte each way, which also lets the
+// client receive any session tickets. Returns whether a session was offered.
+//
+bool Connect(XrdTlsContext &srv, XrdTlsContext &cln, const char *peer)
+           {int fd[2];
+            bool offered = false;
+            EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fd));
+
+            std::thread srvThread([&]()
+               {XrdTlsSocket sock(srv, fd[0], XrdTlsSocket::TLS_RBL_WBL,
+                                  XrdTlsSocket::TLS_HS_BLOCK, false);
+                char c;
+                int n;
+                EXPECT_EQ(XrdTls::TLS_AOK, sock.Accept(0));
+                EXPECT_EQ(XrdTls::TLS_AOK, sock.Read(&c, 1, n));
+                EXPECT_EQ(XrdTls::TLS_AOK, sock.Write(&c, 1, n));
+                sock.Shutdown();
+               });
+
+            {XrdTlsSocket sock(cln, fd[1], XrdTlsSocket::TLS_RBL_WBL,
+                               XrdTlsSocket::TLS_HS_BLOCK, true);
+             char c = 'x';
+             int n;
+             offered = sock.Resume(peer);
+             EXPECT_EQ(XrdTls::TLS_AOK, sock.Connect(0, 0));
+             EXPECT_EQ(XrdTls::TLS_AOK, sock.Write(&c, 1, n));
+             EXPECT_EQ(XrdTls::TLS_AOK, sock.Read(&c, 1, n));
+             sock.Shutdown();
+            }
+
+            srvThread.join();
+            close(fd[0]);
+            close(fd[1]);
+            return offered;
+           }
+
+// Handshakes since the last call.
+//
+XrdTlsContext::HSCounts Delta()
+           {XrdTlsContext::HSCounts now, d;
+            XrdTlsContext::HandShakes(now);
+            d.srvFull    = now.srvFull    - last.srvFull;
+            d.srvResumed = now.srvResumed - last.srvResumed;
+            d.clnFull    = now.clnFull    - last.clnFull;
+            d.clnResumed = now.clnResumed - last.clnResumed;
+            last = now;
+            return d;
+           }
+
+void ExpectFull()
+           {XrdTlsContext::HSCounts d = Delta();
+            EXPECT_EQ(1, d.srvFull);    EXPECT_EQ(0, d.srvResumed);
+            EXPECT_EQ(1, d.clnFull);    EXPECT_EQ(0, d.clnResumed);
+           }
+
+void ExpectResumed()
+           {XrdTlsContext::HSCounts d = Delta();
+            EXPECT_EQ(0, d.srvFull);    EXPECT_EQ(1, d.srvResumed);
+            EXPECT_EQ(0, d.clnFull);    EXPECT_EQ(1, d.clnResumed);
+           }
+
+XrdTlsContext::HSCounts last = XrdTlsContext::HSCounts();
+
+private:
+
+static bool MakeCert()
+           {EVP_PKEY *pkey = 0;
+            EVP_PKEY_CTX *kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, 0);
+            if (!kctx || EVP_PKEY_keygen_init(kctx) != 1
+            ||  EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx,
+                                          NID_X9_62_prime256v1) != 1
+            ||  EVP_PKEY_keygen(kctx, &pkey) != 1) return false;
+            EVP_PKEY_CTX_free(kctx);
+
+            X509 *x509 = X509_new();
+            X509_set_version(x509, 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(x509), 1);
+            X509_gmtime_adj(X509_getm_notBefore(x509), -60);
+            X509_gmtime_adj(X509_getm_notAfter(x509), 3600);
+            X509_set_pubkey(x509, pkey);
+            X509_NAME *name = X509_get_subject_name(x509);
+            X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                       (const unsigned char *)"localhost",
+                                       -1, -1, 0);
+            X509_set_issuer_name(x509, name);
+            if (!X509_sign(x509, pkey, EVP_sha256())) return false;
+
+            FILE *fp = fopen(keyFN.c_str(), "w");
+            if (!fp) return false;
+            fchmod(fileno(fp), S_IRUSR | S_IWUSR);
+            bool aOK = PEM_write_PrivateKey(fp, pkey, 0, 0, 0, 0, 0) == 1;
+            fclose(fp);
+            if (aOK && (fp = fopen(certFN.c_str(), "w")))
+               {fchmod(fileno(fp), S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+                aOK = PEM_write_X509(fp, x509) == 1;
+                fclose(fp);
+               } else aOK = false;
+
+            X509_free(x509);
+            EVP_PKEY_free(pkey);
+            return aOK;
+           }
+
+static std::string tDir, certFN, keyFN;
+};
+
+std::string TlsResume::tDir, TlsResume::certFN, TlsResume::keyFN;
+}
+
+TEST_F(TlsResume, Resume)
+{
+  XrdTlsContext *srv = Server(), *cln = Client();
+  Delta();
+
+  EXPECT_FALSE(Connect(*srv, *cln, "srv1:1094"));
+  ExpectFull();
+  EXPECT_TRUE(Connect(*srv, *cln, "srv1:1094"));
+  ExpectResumed();
+  EXPECT_TRUE(Connect(*srv, *cln, "srv1:1094"));
+  ExpectResumed();
+
+// Sessions are kept per peer
+//
+  EXPECT_FALSE(Connect(*srv, *cln, "srv2:1094"));
+  ExpectFull();
+
+  delete cln;
+  delete srv;
+}
+
+TEST_F(TlsResume, SingleUse)
+{
+  XrdTlsContext *srv = Server(), *cln = Client();
+
+  EXPECT_FALSE(Connect(*srv, *cln, "srv6:1094"));
+
+// A TLS 1.3 session is handed out once; the next connection to the peer
+// gets the renewed ticket only after the first one has completed
+//
+  void *ssl1 = cln->Session(), *ssl2 = cln->Session();
+  SSL_set_connect_state(static_cast<SSL *>(ssl1));
+  SSL_set_connect_state(static_cast<SSL *>(ssl2));
+  EXPECT_TRUE(XrdTlsContext::Resume(ssl1, "srv6:1094"));
+  EXPECT_FALSE(XrdTlsContext::Resume(ssl2, "srv6:1094"));
+  SSL_free(static_cast<SSL *>(ssl1));
+  SSL_free(static_cast<SSL *>(ssl2));
+
+  delete cln;
+  delete srv;
+}
+
+TEST_F(TlsResume, SharedAcrossContexts)
+{
+  XrdTlsContext *srv = Server(), *cln = Client();
+  Delta();
+
+  EXPECT_FALSE(Connect(*srv, *cln, "srv3:1094"));
+  ExpectFull();
+
+// A clone, as made when CRLs are refreshed, accepts the same tickets
+//
+  XrdTlsContext *clone = srv->Clone();
+  ASSERT_TRUE(clone != nullptr);
+  EXPECT_TRUE(Connect(*clone, *cln, "srv3:1094"));
+  ExpectResumed();
+
+// So does an unrelated server context with the same session id, and a new
+// client context finds the session made with the first one
+//
+  XrdTlsContext *srv2 = Server(), *cln2 = Client();
+  EXPECT_TRUE(Connect(*srv2, *cln2, "srv3:1094"));
+  ExpectResumed();
+
+// Without client mode sessions are not remembered
+//
+  XrdTlsContext *cln3 = new XrdTlsContext(0, 0, 0,
+                                          cln->GetParams()->cafile.c_str());
+  EXPECT_FALSE(Connect(*srv, *cln3, "srv3:1094"));
+  ExpectFull();
+
+  delete cln3;
+  delete cln2;
+  delete srv2;
+  delete clone;
+  delete cln;
+  delete srv;
+}
+
+TEST_F(TlsResume, KeyRotation)
+{
+  XrdTlsContext *srv = Server(), *cln = Client();
+  XrdTlsContext::SetTicketKeyLife(1);
+  Delta();
+
+  EXPECT_FALSE(Connect(*srv, *cln, "srv4:1094"));
+  ExpectFull();
+
+// After one rotation the previous key is still accepted and the ticket is
+// renewed with the current key
+//
+  std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+  EXPECT_TRUE(Connect(*srv, *cln, "srv4:1094"));
+  ExpectResumed();
+
+// Once both keys are too old the ticket is refused
+//
+  std::this_thread::sleep_for(std::chrono::milliseconds(2200));
+  EXPECT_TRUE(Connect(*srv, *cln, "srv4:1094"));
+  ExpectFull();
+
+  XrdTlsContext::SetTicketKeyLife(3600);
+  delete cln;
+  delete srv;
+}
+
+TEST_F(TlsResume, Benchmark)
+{
+  XrdTlsContext *srv = Server(), *cln = Client();
+  XrdTlsContext *cln2 = new XrdTlsContext(0, 0, 0,
+                                          cln->GetParams()->cafile.c_str());
+  const int conns = 200;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < conns; i++) Connect(*srv, *cln2, "srv5:1094");
+  auto t1 = std::chrono::steady_clock::now();
+  Connect(*srv, *cln, "srv5:1094");
+  Delta();
+  auto t2 = std::chrono::steady_clock::now();
+  for (int i = 0; i < conns; i++) Connect(*srv, *cln, "srv5:1094");
+  auto t3 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(conns, Delta().srvResumed);
+  double fus = std::chrono::duration<double, std::micro>(t1 - t0).count()
+             / conns;
+  double rus = std::chrono::duration<double, std::micro>(t3 - t2).count()
+             / conns;
+  printf("full %8.1f us/connection, resumed %8.1f us/connection (%d each)\n",
+         fus, rus, conns);
+
+  delete cln2;
+  delete cln;
+  delete srv;
+}
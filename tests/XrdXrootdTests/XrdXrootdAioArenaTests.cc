@@ -0,0 +1,111 @@
+#undef NDEBUG
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Xrd/XrdBuffer.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysMetrics.hh"
+#include "XrdXrootd/XrdXrootdAioArena.hh"
+
+using namespace testing;
+
+namespace
+{
+static const int slotSz = 64*1024;
+
+// The arena is process wide, so it is set up once; each test runs in its own
+// process when run by ctest but may share one otherwise.
+//
+void Arena()
+{
+  static bool done = false;
+  static XrdSysLogger logger;
+  static XrdSysError  eDest(&logger, "test_");
+
+  if (!done) {ASSERT_TRUE(XrdXrootdAioArena::Init(slotSz, slotSz, slotSz, eDest));
+              done = true;
+             }
+}
+
+// Take every free slot
+//
+std::vector<XrdBuffer *> Drain()
+{
+  std::vector<XrdBuffer *> bufs;
+  XrdBuffer *bP;
+  while ((bP = XrdXrootdAioArena::Obtain())) bufs.push_back(bP);
+  return bufs;
+}
+
+// The value of a metric as exported
+//
+long long Metric(const char *name)
+{
+  std::string text, what = std::string("\n") + name + ' ';
+  XrdSysMetrics::Prometheus(text);
+  size_t pos = text.find(what);
+  return (pos == std::string::npos ? -1
+                                   : atoll(text.c_str() + pos + what.size()));
+}
+}
+
+// Buffers from elsewhere are never taken for arena slots, so that callers
+// give them back to the buffer pool.
+//
+TEST(XrdXrootdAioArenaTests, ForeignBuffers)
+{
+  char *mem = static_cast<char *>(malloc(slotSz));
+  XrdBuffer *bP = new XrdBuffer(mem, slotSz, 0);
+
+  Arena();
+  EXPECT_FALSE(XrdXrootdAioArena::Owns(bP));
+  EXPECT_FALSE(XrdXrootdAioArena::Release(bP));
+  delete bP;
+}
+
+// The arena is sized in whole huge pages of page aligned slots; once they are
+// all in use there are no more until one is given back.
+//
+TEST(XrdXrootdAioArenaTests, Exhaustion)
+{
+  Arena();
+  std::vector<XrdBuffer *> bufs = Drain();
+  std::set<char *> seen;
+
+  ASSERT_EQ(2*1024*1024/slotSz, (int)bufs.size());
+  EXPECT_EQ((long long)bufs.size(), Metric("xrootd_aio_arena_slots"));
+  EXPECT_EQ((long long)bufs.size(), Metric("xrootd_aio_arena_slots_used"));
+  for (auto bP : bufs)
+      {EXPECT_TRUE(XrdXrootdAioArena::Owns(bP));
+       EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(bP->buff) % 4096);
+       EXPECT_EQ(slotSz, bP->bsize);
+       EXPECT_TRUE(seen.insert(bP->buff).second);
+      }
+
+// Callers now fall back to the buffer pool, which is counted as a miss
+//
+  long long misses = Metric("xrootd_aio_arena_misses_total");
+  EXPECT_EQ(nullptr, XrdXrootdAioArena::Obtain());
+  EXPECT_EQ(nullptr, XrdXrootdAioArena::Obtain());
+  EXPECT_EQ(misses + 2, Metric("xrootd_aio_arena_misses_total"));
+
+// A slot given back is the next one handed out
+//
+  XrdBuffer *bP = bufs.back();
+  bufs.pop_back();
+  ASSERT_TRUE(XrdXrootdAioArena::Release(bP));
+  EXPECT_EQ((long long)bufs.size(), Metric("xrootd_aio_arena_slots_used"));
+  EXPECT_EQ(bP, XrdXrootdAioArena::Obtain());
+  EXPECT_EQ(nullptr, XrdXrootdAioArena::Obtain());
+  bufs.push_back(bP);
+
+  for (auto bP : bufs) ASSERT_TRUE(XrdXrootdAioArena::Release(bP));
+  EXPECT_EQ(0, Metric("xrootd_aio_arena_slots_used"));
+  EXPECT_EQ(bufs.size(), Drain().size());
+}